@@ -0,0 +1,249 @@
+// main.c - boot graph benchmark with mocked init stages (linux target)
+#include <stdio.h>
+#include <stdlib.h>
+#include <esp_log.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "boot_graph.h"
+#include "trace_evt.h"
+
+#define TAG "BootBench"
+#define BENCH_INFO(fmt, ...) ESP_LOGI(TAG, fmt, ##__VA_ARGS__)
+#define BENCH_ERROR(fmt, ...) ESP_LOGE(TAG, fmt, ##__VA_ARGS__)
+
+#define BENCH_TRACE_FILE    "boot_trace.json"   // Overridden by $BOOT_BENCH_TRACE
+
+// A stage that takes delay_ms and fails its first fail_attempts calls of a run
+typedef struct {
+    uint32_t delay_ms;
+    uint8_t fail_attempts;
+    uint8_t calls;
+} bench_mock_t;
+
+/* -------------------------------------------------------------------------- */
+/* Mocked stages: the Lesson 10 graph, with device-like init times             */
+/* -------------------------------------------------------------------------- */
+
+enum {
+    STAGE_LDO = 0,
+    STAGE_I2C,
+    STAGE_TOUCH,
+    STAGE_DHT20_ASYNC,
+    STAGE_DHT20,
+    STAGE_DISPLAY,
+    STAGE_BACKLIGHT,
+    STAGE_LED,
+    STAGE_UI,
+    STAGE_HISTORY,
+    STAGE_SENSORS,
+    STAGE_COUNT,
+};
+
+static bench_mock_t s_mocks[STAGE_COUNT] = {
+    [STAGE_LDO]         = {.delay_ms = 5},
+    [STAGE_I2C]         = {.delay_ms = 10},
+    [STAGE_TOUCH]       = {.delay_ms = 120},
+    [STAGE_DHT20_ASYNC] = {.delay_ms = 5},
+    [STAGE_DHT20]       = {.delay_ms = 80, .fail_attempts = 1},     // Sensor still powering up
+    [STAGE_DISPLAY]     = {.delay_ms = 300},
+    [STAGE_BACKLIGHT]   = {.delay_ms = 10},
+    [STAGE_LED]         = {.delay_ms = 5},
+    [STAGE_UI]          = {.delay_ms = 150},
+    [STAGE_HISTORY]     = {.delay_ms = 5},
+    [STAGE_SENSORS]     = {.delay_ms = 1},
+};
+
+static esp_err_t bench_mock_init(void *ctx)
+{
+    bench_mock_t *mock = (bench_mock_t*)ctx;
+    vTaskDelay(pdMS_TO_TICKS(mock->delay_ms));
+    return mock->calls++ < mock->fail_attempts ? ESP_FAIL : ESP_OK;
+}
+
+static const boot_stage_t s_stages[STAGE_COUNT] = {
+    [STAGE_LDO]         = {.name = "ldo", .init = bench_mock_init, .ctx = &s_mocks[STAGE_LDO]},
+    [STAGE_I2C]         = {.name = "i2c", .init = bench_mock_init, .ctx = &s_mocks[STAGE_I2C]},
+    [STAGE_TOUCH]       = {.name = "touch", .init = bench_mock_init, .ctx = &s_mocks[STAGE_TOUCH],
+                           .deps = BOOT_DEP(STAGE_LDO) | BOOT_DEP(STAGE_I2C)},
+    [STAGE_DHT20_ASYNC] = {.name = "dht20_async", .init = bench_mock_init, .ctx = &s_mocks[STAGE_DHT20_ASYNC],
+                           .deps = BOOT_DEP(STAGE_LDO) | BOOT_DEP(STAGE_I2C), .optional = true},
+    [STAGE_DHT20]       = {.name = "dht20", .init = bench_mock_init, .ctx = &s_mocks[STAGE_DHT20],
+                           .deps = BOOT_DEP(STAGE_DHT20_ASYNC),
+                           .retries = 3, .retry_delay_ms = 100, .optional = true},
+    [STAGE_DISPLAY]     = {.name = "display", .init = bench_mock_init, .ctx = &s_mocks[STAGE_DISPLAY],
+                           .deps = BOOT_DEP(STAGE_LDO) | BOOT_DEP(STAGE_TOUCH)},
+    [STAGE_BACKLIGHT]   = {.name = "backlight", .init = bench_mock_init, .ctx = &s_mocks[STAGE_BACKLIGHT],
+                           .deps = BOOT_DEP(STAGE_DISPLAY)},
+    [STAGE_LED]         = {.name = "led", .init = bench_mock_init, .ctx = &s_mocks[STAGE_LED],
+                           .deps = BOOT_DEP(STAGE_LDO)},
+    [STAGE_UI]          = {.name = "ui", .init = bench_mock_init, .ctx = &s_mocks[STAGE_UI],
+                           .deps = BOOT_DEP(STAGE_DISPLAY) | BOOT_DEP(STAGE_LED)},
+    [STAGE_HISTORY]     = {.name = "history", .init = bench_mock_init, .ctx = &s_mocks[STAGE_HISTORY]},
+    [STAGE_SENSORS]     = {.name = "sensors", .init = bench_mock_init, .ctx = &s_mocks[STAGE_SENSORS],
+                           .deps = BOOT_DEP(STAGE_DHT20) | BOOT_DEP(STAGE_HISTORY) | BOOT_DEP(STAGE_UI),
+                           .optional = true},
+};
+
+/* -------------------------------------------------------------------------- */
+/* Scenarios                                                                  */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief Run the mocked graph once
+ * @param parallel Stage tasks, or one by one in this task
+ * @param report Receives a copy of the report
+ * @return esp_err_t Result of boot_graph_run()
+ */
+static esp_err_t bench_boot(bool parallel, boot_graph_report_t *report)
+{
+    boot_graph_config_t config = BOOT_GRAPH_DEFAULT_CONFIG();
+    config.parallel = parallel;
+    boot_graph_t *graph = boot_graph_create(&config);
+    if (graph == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        s_mocks[i].calls = 0;
+        boot_graph_add(graph, &s_stages[i]);
+    }
+    esp_err_t err = boot_graph_run(graph);
+    boot_graph_log_report(graph);
+    *report = *boot_graph_get_report(graph);
+    // The graph is kept: stage tasks of a timed out run may still use it
+    return err;
+}
+
+/**
+ * @brief Check that no stage started before the end of a dependency
+ */
+static bool bench_check_order(const boot_graph_report_t *report)
+{
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        for (int dep = 0; dep < i; dep++) {
+            if ((s_stages[i].deps & BOOT_DEP(dep)) && report->stages[i].state == BOOT_STAGE_OK &&
+                report->stages[i].start_us < report->stages[dep].end_us) {
+                BENCH_ERROR("%s started before %s finished", s_stages[i].name, s_stages[dep].name);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Serial against parallel boot of healthy stages; the DHT20 probe needs one retry
+ */
+static bool bench_speedup(void)
+{
+    boot_graph_report_t serial;
+    boot_graph_report_t parallel;
+    if (bench_boot(false, &serial) != ESP_OK || bench_boot(true, &parallel) != ESP_OK) {
+        BENCH_ERROR("Healthy boot failed");
+        return false;
+    }
+    bool ok = bench_check_order(&serial) && bench_check_order(&parallel);
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        if (parallel.stages[i].state != BOOT_STAGE_OK) {
+            BENCH_ERROR("%s did not succeed", s_stages[i].name);
+            ok = false;
+        }
+    }
+    if (parallel.stages[STAGE_DHT20].attempts != 2) {
+        BENCH_ERROR("dht20: %u attempts, expected 2", parallel.stages[STAGE_DHT20].attempts);
+        ok = false;
+    }
+    if (parallel.total_us >= serial.total_us) {
+        BENCH_ERROR("Parallel boot is not faster");
+        ok = false;
+    }
+    BENCH_INFO("scenario=speedup serial_ms=%.1f parallel_ms=%.1f speedup=%.2f reduction=%.0f%%",
+               serial.total_us / 1000.0, parallel.total_us / 1000.0, (double)serial.total_us / parallel.total_us,
+               100.0 * (serial.total_us - parallel.total_us) / serial.total_us);
+    return ok;
+}
+
+/**
+ * @brief A required stage fails: its dependents are skipped and the boot fails with its error
+ */
+static bool bench_required_failure(void)
+{
+    boot_graph_report_t report;
+    s_mocks[STAGE_TOUCH].fail_attempts = 1;
+    esp_err_t err = bench_boot(true, &report);
+    s_mocks[STAGE_TOUCH].fail_attempts = 0;
+
+    bool ok = err == ESP_FAIL && report.failed == STAGE_TOUCH &&
+              report.stages[STAGE_DISPLAY].state == BOOT_STAGE_SKIPPED &&
+              report.stages[STAGE_UI].state == BOOT_STAGE_SKIPPED &&
+              report.stages[STAGE_SENSORS].state == BOOT_STAGE_SKIPPED &&
+              report.stages[STAGE_DHT20_ASYNC].state == BOOT_STAGE_OK;
+    BENCH_INFO("scenario=required_failure err=%s failed_stage=%s result=%s", esp_err_to_name(err),
+               report.failed < 0 ? "-" : s_stages[report.failed].name, ok ? "pass" : "FAIL");
+    return ok;
+}
+
+/**
+ * @brief The optional sensor never answers: the panel still boots without it
+ */
+static bool bench_optional_failure(void)
+{
+    boot_graph_report_t report;
+    s_mocks[STAGE_DHT20].fail_attempts = 255;
+    esp_err_t err = bench_boot(true, &report);
+    s_mocks[STAGE_DHT20].fail_attempts = 1;
+
+    bool ok = err == ESP_OK && report.failed < 0 &&
+              report.stages[STAGE_DHT20].state == BOOT_STAGE_FAILED &&
+              report.stages[STAGE_DHT20].attempts == s_stages[STAGE_DHT20].retries + 1 &&
+              report.stages[STAGE_SENSORS].state == BOOT_STAGE_SKIPPED &&
+              report.stages[STAGE_UI].state == BOOT_STAGE_OK;
+    BENCH_INFO("scenario=optional_failure err=%s dht20_attempts=%u result=%s", esp_err_to_name(err),
+               report.stages[STAGE_DHT20].attempts, ok ? "pass" : "FAIL");
+    return ok;
+}
+
+/**
+ * @brief Save the stage spans of every run as Chrome trace JSON
+ */
+static bool bench_save_trace(trace_evt_t *trace)
+{
+    const char *path = getenv("BOOT_BENCH_TRACE");
+    if (path == NULL) path = BENCH_TRACE_FILE;
+
+    trace_evt_stats_t stats;
+    trace_evt_get_stats(trace, &stats);
+    BENCH_INFO("trace=%s events=%lu dropped=%lu", path, (unsigned long)stats.events, (unsigned long)stats.dropped);
+    // Each run: one span per stage that ran, plus the run itself
+    if (stats.events < 2 * STAGE_COUNT || stats.dropped) {
+        BENCH_ERROR("Incomplete trace");
+        return false;
+    }
+    return trace_evt_save(trace, path) == ESP_OK;
+}
+
+void app_main(void)
+{
+    trace_evt_config_t trace_config = TRACE_EVT_DEFAULT_CONFIG();
+    trace_evt_t *trace = trace_evt_create(&trace_config);
+    if (trace == NULL) {
+        BENCH_ERROR("Init failed");
+        exit(2);
+    }
+
+    uint32_t failures = 0;
+    if (!bench_speedup()) {
+        failures++;
+    }
+    if (!bench_required_failure()) {
+        failures++;
+    }
+    if (!bench_optional_failure()) {
+        failures++;
+    }
+    if (!bench_save_trace(trace)) {
+        failures++;
+    }
+    BENCH_INFO("%lu failure(s)", (unsigned long)failures);
+    exit(failures ? 1 : 0);    // Non-zero exit status fails a CI job
+}
@@ -0,0 +1,441 @@
+#include "dht20_async.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <sdkconfig.h>
+#include <esp_log.h>
+#include "trace_evt.h"
+#if CONFIG_IDF_TARGET_LINUX
+#include <time.h>
+#else
+#include <esp_timer.h>
+#endif
+
+#define TAG "DHT20Async"
+
+#define DHT20_STATUS_BUSY   0x80
+#define DHT20_CMD_STATUS    0x71
+
+#define DHT20_EVT_COLLECT   (1UL << 0)      // Timer expired: read the frame
+#define DHT20_EVT_STOP      (1UL << 1)
+#define DHT20_EVT_DONE      (1UL << 2)      // Collect task exited
+
+// ---------------------- Internal helper functions ----------------------
+
+static int64_t dht20_now_us(void)
+{
+#if CONFIG_IDF_TARGET_LINUX
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#else
+    return esp_timer_get_time();
+#endif
+}
+
+// ---------------------- Collect timer ----------------------
+
+#if CONFIG_IDF_TARGET_LINUX
+/**
+ * @brief Timer callback (FreeRTOS timer task): only wakes the collect task, like the esp_timer one
+ */
+static void dht20_timer_cb(TimerHandle_t timer)
+{
+    dht20_async_t *dht = (dht20_async_t*)pvTimerGetTimerID(timer);
+    xEventGroupSetBits(dht->events, DHT20_EVT_COLLECT);
+}
+
+static esp_err_t dht20_timer_create(dht20_async_t *dht)
+{
+    dht->timer = xTimerCreate("dht20_collect", 1, pdFALSE, dht, dht20_timer_cb);
+    return dht->timer ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+static esp_err_t dht20_timer_start(dht20_async_t *dht, uint32_t delay_ms)
+{
+    TickType_t ticks = pdMS_TO_TICKS(delay_ms);
+    // Changing the period also starts the timer
+    return xTimerChangePeriod(dht->timer, ticks ? ticks : 1, portMAX_DELAY) == pdPASS ? ESP_OK : ESP_FAIL;
+}
+
+static void dht20_timer_delete(dht20_async_t *dht)
+{
+    xTimerStop(dht->timer, portMAX_DELAY);
+    xTimerDelete(dht->timer, portMAX_DELAY);
+}
+#else
+/**
+ * @brief Timer callback (esp_timer task): only wakes the collect task, the bus may be queued behind other devices
+ */
+static void dht20_timer_cb(void *arg)
+{
+    dht20_async_t *dht = (dht20_async_t*)arg;
+    xEventGroupSetBits(dht->events, DHT20_EVT_COLLECT);
+}
+
+static esp_err_t dht20_timer_create(dht20_async_t *dht)
+{
+    // The timer callback only sets a bit: a bus read waiting behind other transfers
+    // would hold up every other esp_timer callback
+    const esp_timer_create_args_t timer_args = {
+        .callback = dht20_timer_cb,
+        .arg = dht,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "dht20_collect",
+    };
+    return esp_timer_create(&timer_args, &dht->timer);
+}
+
+static esp_err_t dht20_timer_start(dht20_async_t *dht, uint32_t delay_ms)
+{
+    return esp_timer_start_once(dht->timer, (uint64_t)delay_ms * 1000);
+}
+
+static void dht20_timer_delete(dht20_async_t *dht)
+{
+    esp_timer_stop(dht->timer);
+    esp_timer_delete(dht->timer);
+}
+#endif
+
+// ---------------------- Measurement steps ----------------------
+
+/**
+ * @brief CRC-8 of the sensor frame (polynomial 0x31, initial value 0xFF)
+ */
+static uint8_t dht20_crc8(const uint8_t *data, size_t len)
+{
+    uint8_t crc = 0xFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static void dht20_decode(const uint8_t *frame, dht20_async_result_t *result)
+{
+    uint32_t raw_humi = ((uint32_t)frame[1] << 12) | ((uint32_t)frame[2] << 4) | (frame[3] >> 4);
+    uint32_t raw_temp = ((uint32_t)(frame[3] & 0x0F) << 16) | ((uint32_t)frame[4] << 8) | frame[5];
+
+    result->humidity = (float)raw_humi * 100.0f / 1048576.0f;
+    result->temperature = (float)raw_temp * 200.0f / 1048576.0f - 50.0f;
+}
+
+/**
+ * @brief Run one bus transaction and account its duration to the current sample
+ */
+static esp_err_t dht20_bus_write(dht20_async_t *dht, const uint8_t *data, size_t len)
+{
+    int64_t start = dht20_now_us();
+    TRACE_BEGIN("dht20", "i2c_write");
+    esp_err_t err = dht->config.transport.write(dht->config.transport.ctx, data, len);
+    TRACE_END("dht20", "i2c_write");
+    dht->hold_us += (uint32_t)(dht20_now_us() - start);
+    return err;
+}
+
+static esp_err_t dht20_bus_read(dht20_async_t *dht, uint8_t *data, size_t len)
+{
+    int64_t start = dht20_now_us();
+    TRACE_BEGIN("dht20", "i2c_read");
+    esp_err_t err = dht->config.transport.read(dht->config.transport.ctx, data, len);
+    TRACE_END("dht20", "i2c_read");
+    dht->hold_us += (uint32_t)(dht20_now_us() - start);
+    return err;
+}
+
+/**
+ * @brief Deliver a result and return to idle
+ */
+static void dht20_finish(dht20_async_t *dht, dht20_async_result_t *result)
+{
+    result->timestamp_us = dht20_now_us();
+    result->bus_hold_us = dht->hold_us;
+    TRACE_COUNTER("dht20", "bus_hold_us", (int32_t)dht->hold_us);
+
+    portENTER_CRITICAL(&dht->lock);
+    dht->stats.samples++;
+    if (result->err != ESP_OK) {
+        dht->stats.errors++;
+    }
+    dht->stats.last_bus_hold_us = dht->hold_us;
+    dht->stats.bus_hold_us_total += dht->hold_us;
+    dht->state = DHT20_ASYNC_IDLE;
+    portEXIT_CRITICAL(&dht->lock);
+
+    if (dht->config.on_result) {
+        dht->config.on_result(result, dht->config.arg);
+    }
+    if (dht->config.queue) {
+        xQueueSend(dht->config.queue, result, 0);
+    }
+}
+
+/**
+ * @brief Collect step: read the frame, or re-arm while the sensor is still converting
+ */
+static void dht20_collect(dht20_async_t *dht)
+{
+    dht20_async_result_t result = {0};
+    uint8_t frame[7];
+
+    result.err = dht20_bus_read(dht, frame, sizeof(frame));
+    if (result.err == ESP_OK && (frame[0] & DHT20_STATUS_BUSY)) {
+        if (dht->busy_retries < DHT20_ASYNC_MAX_BUSY_RETRIES) {
+            dht->busy_retries++;
+            TRACE_INSTANT("dht20", "busy");
+            portENTER_CRITICAL(&dht->lock);
+            dht->stats.busy_retries++;
+            portEXIT_CRITICAL(&dht->lock);
+            dht20_timer_start(dht, DHT20_ASYNC_BUSY_RETRY_MS);
+            return;
+        }
+        result.err = ESP_ERR_TIMEOUT;
+    }
+    if (result.err == ESP_OK) {
+        if (dht20_crc8(frame, 6) != frame[6]) {
+            result.err = ESP_ERR_INVALID_CRC;
+        } else {
+            dht20_decode(frame, &result);
+        }
+    }
+    if (result.err != ESP_OK) {
+        ESP_LOGW(TAG, "Measurement failed: %s", esp_err_to_name(result.err));
+    }
+    dht20_finish(dht, &result);
+}
+
+static void dht20_collect_task(void *param)
+{
+    dht20_async_t *dht = (dht20_async_t*)param;
+
+    while (1) {
+        EventBits_t bits = xEventGroupWaitBits(dht->events, DHT20_EVT_COLLECT | DHT20_EVT_STOP,
+                                               pdTRUE, pdFALSE, portMAX_DELAY);
+        if (bits & DHT20_EVT_STOP) {
+            break;
+        }
+        if (bits & DHT20_EVT_COLLECT) {
+            dht20_collect(dht);
+        }
+    }
+    xEventGroupSetBits(dht->events, DHT20_EVT_DONE);
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Reload one calibration register (sequence from the sensor vendor's sample code)
+ */
+static esp_err_t dht20_reset_register(dht20_async_t *dht, uint8_t reg)
+{
+    const uint8_t select[] = {reg, 0x00, 0x00};
+    uint8_t value[3];
+
+    esp_err_t err = dht->config.transport.write(dht->config.transport.ctx, select, sizeof(select));
+    if (err != ESP_OK) {
+        return err;
+    }
+    vTaskDelay(pdMS_TO_TICKS(5));
+    err = dht->config.transport.read(dht->config.transport.ctx, value, sizeof(value));
+    if (err != ESP_OK) {
+        return err;
+    }
+    vTaskDelay(pdMS_TO_TICKS(10));
+    const uint8_t write_back[] = {(uint8_t)(0xB0 | reg), value[1], value[2]};
+    return dht->config.transport.write(dht->config.transport.ctx, write_back, sizeof(write_back));
+}
+
+static esp_err_t dht20_read_status(dht20_async_t *dht, uint8_t *status)
+{
+    const uint8_t cmd = DHT20_CMD_STATUS;
+    esp_err_t err = dht->config.transport.write(dht->config.transport.ctx, &cmd, 1);
+    if (err == ESP_OK) {
+        err = dht->config.transport.read(dht->config.transport.ctx, status, 1);
+    }
+    return err;
+}
+
+#if !CONFIG_IDF_TARGET_LINUX
+static esp_err_t dht20_i2c_write(void *ctx, const uint8_t *data, size_t len)
+{
+    return i2c_master_transmit((i2c_master_dev_handle_t)ctx, data, len, DHT20_ASYNC_I2C_TIMEOUT_MS);
+}
+
+static esp_err_t dht20_i2c_read(void *ctx, uint8_t *data, size_t len)
+{
+    return i2c_master_receive((i2c_master_dev_handle_t)ctx, data, len, DHT20_ASYNC_I2C_TIMEOUT_MS);
+}
+#endif
+
+// ---------------------- External API functions ----------------------
+
+dht20_async_t* dht20_async_create(const dht20_async_config_t *config)
+{
+    if (config == NULL || config->transport.write == NULL || config->transport.read == NULL) {
+        ESP_LOGE(TAG, "Invalid arguments");
+        return NULL;
+    }
+
+    dht20_async_t *dht = (dht20_async_t*)calloc(1, sizeof(dht20_async_t));
+    if (dht == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate dht20_async_t");
+        return NULL;
+    }
+    dht->config = *config;
+    portMUX_INITIALIZE(&dht->lock);
+
+    dht->events = xEventGroupCreate();
+    if (dht->events == NULL) {
+        ESP_LOGE(TAG, "Failed to create event group");
+        free(dht);
+        return NULL;
+    }
+
+    if (dht20_timer_create(dht) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to create timer");
+        vEventGroupDelete(dht->events);
+        free(dht);
+        return NULL;
+    }
+    if (xTaskCreate(dht20_collect_task, "dht20_collect", DHT20_ASYNC_STACK_SIZE, dht,
+                    DHT20_ASYNC_PRIORITY, &dht->task) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create collect task");
+        dht20_timer_delete(dht);
+        vEventGroupDelete(dht->events);
+        free(dht);
+        return NULL;
+    }
+    return dht;
+}
+
+#if !CONFIG_IDF_TARGET_LINUX
+dht20_async_t* dht20_async_create_i2c(i2c_master_bus_handle_t bus, const dht20_async_config_t *config)
+{
+    if (bus == NULL || config == NULL) {
+        ESP_LOGE(TAG, "Invalid arguments");
+        return NULL;
+    }
+
+    const i2c_device_config_t dev_config = {
+        .dev_addr_length = I2C_ADDR_BIT_LEN_7,
+        .device_address = DHT20_ASYNC_ADDRESS,
+        .scl_speed_hz = DHT20_ASYNC_I2C_SPEED_HZ,
+    };
+    i2c_master_dev_handle_t dev = NULL;
+    esp_err_t err = i2c_master_bus_add_device(bus, &dev_config, &dev);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to add device: %s", esp_err_to_name(err));
+        return NULL;
+    }
+
+    dht20_async_config_t i2c_config = *config;
+    i2c_config.transport.write = dht20_i2c_write;
+    i2c_config.transport.read = dht20_i2c_read;
+    i2c_config.transport.ctx = dev;
+
+    dht20_async_t *dht = dht20_async_create(&i2c_config);
+    if (dht == NULL) {
+        i2c_master_bus_rm_device(dev);
+        return NULL;
+    }
+    dht->dev = dev;
+    return dht;
+}
+#endif
+
+void dht20_async_destroy(dht20_async_t *dht)
+{
+    if (dht == NULL) {
+        return;
+    }
+    // A collect step in progress finishes first: it may re-arm the timer on a busy sensor, so the
+    // timer goes only once the collect task is gone
+    xEventGroupSetBits(dht->events, DHT20_EVT_STOP);
+    xEventGroupWaitBits(dht->events, DHT20_EVT_DONE, pdFALSE, pdTRUE, portMAX_DELAY);
+    dht20_timer_delete(dht);
+    vEventGroupDelete(dht->events);
+#if !CONFIG_IDF_TARGET_LINUX
+    if (dht->dev) {
+        i2c_master_bus_rm_device(dht->dev);
+    }
+#endif
+    free(dht);
+}
+
+esp_err_t dht20_async_init(dht20_async_t *dht)
+{
+    static const uint8_t calibration_regs[] = {0x1B, 0x1C, 0x1E};
+
+    if (dht == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL(&dht->lock);
+    dht20_async_state_t state = dht->state;
+    portEXIT_CRITICAL(&dht->lock);
+    if (state != DHT20_ASYNC_IDLE) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    uint8_t status = 0;
+    esp_err_t err = dht20_read_status(dht, &status);
+    if (err != ESP_OK || (status & DHT20_ASYNC_STATUS_CALIBRATED) == DHT20_ASYNC_STATUS_CALIBRATED) {
+        return err;
+    }
+    ESP_LOGW(TAG, "Not calibrated (status 0x%02x), reloading the calibration registers", status);
+    for (size_t i = 0; i < sizeof(calibration_regs) && err == ESP_OK; i++) {
+        err = dht20_reset_register(dht, calibration_regs[i]);
+    }
+    if (err != ESP_OK) {
+        return err;
+    }
+    vTaskDelay(pdMS_TO_TICKS(10));
+    err = dht20_read_status(dht, &status);
+    if (err == ESP_OK && (status & DHT20_ASYNC_STATUS_CALIBRATED) != DHT20_ASYNC_STATUS_CALIBRATED) {
+        err = ESP_FAIL;
+    }
+    return err;
+}
+
+esp_err_t dht20_async_trigger(dht20_async_t *dht)
+{
+    static const uint8_t trigger_cmd[] = {0xAC, 0x33, 0x00};
+
+    if (dht == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL(&dht->lock);
+    if (dht->state != DHT20_ASYNC_IDLE) {
+        portEXIT_CRITICAL(&dht->lock);
+        return ESP_ERR_INVALID_STATE;
+    }
+    dht->state = DHT20_ASYNC_CONVERTING;
+    portEXIT_CRITICAL(&dht->lock);
+
+    dht->hold_us = 0;
+    dht->busy_retries = 0;
+    esp_err_t err = dht20_bus_write(dht, trigger_cmd, sizeof(trigger_cmd));
+    if (err == ESP_OK) {
+        // The bus stays free for other devices (e.g. touch) during the conversion
+        err = dht20_timer_start(dht, DHT20_ASYNC_CONVERSION_MS);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Trigger failed: %s", esp_err_to_name(err));
+        portENTER_CRITICAL(&dht->lock);
+        dht->state = DHT20_ASYNC_IDLE;
+        portEXIT_CRITICAL(&dht->lock);
+    }
+    return err;
+}
+
+void dht20_async_get_stats(dht20_async_t *dht, dht20_async_stats_t *stats)
+{
+    if (dht == NULL || stats == NULL) {
+        return;
+    }
+    portENTER_CRITICAL(&dht->lock);
+    *stats = dht->stats;
+    portEXIT_CRITICAL(&dht->lock);
+}
@@ -0,0 +1,139 @@
+
+#ifndef _DHT20_ASYNC_H
+#define _DHT20_ASYNC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sdkconfig.h>
+#include <esp_err.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include <freertos/event_groups.h>
+#if CONFIG_IDF_TARGET_LINUX
+#include <freertos/timers.h>
+#else
+#include <driver/i2c_master.h>
+#endif
+
+
+#define DHT20_ASYNC_ADDRESS             0x38
+#define DHT20_ASYNC_CONVERSION_MS       80      // Datasheet conversion time after the trigger
+#define DHT20_ASYNC_BUSY_RETRY_MS       10      // Re-check period while the sensor still reports busy
+#define DHT20_ASYNC_MAX_BUSY_RETRIES    5
+#define DHT20_ASYNC_I2C_TIMEOUT_MS      50
+#define DHT20_ASYNC_I2C_SPEED_HZ        100000
+#define DHT20_ASYNC_STACK_SIZE          3072    // Collect task: bus read, CRC and the completion callback
+#define DHT20_ASYNC_PRIORITY            (configMAX_PRIORITIES - 4)
+#define DHT20_ASYNC_STATUS_CALIBRATED   0x18    // Status bits set once the calibration registers are loaded
+
+
+// Bus access used by the state machine; each call is one short transaction
+typedef struct {
+    esp_err_t (*write)(void *ctx, const uint8_t *data, size_t len);
+    esp_err_t (*read)(void *ctx, uint8_t *data, size_t len);
+    void *ctx;
+} dht20_async_transport_t;
+
+// One completed measurement
+typedef struct {
+    esp_err_t err;          // ESP_OK, ESP_ERR_TIMEOUT (still busy), ESP_ERR_INVALID_CRC or the bus error
+    float temperature;      // °C
+    float humidity;         // %RH
+    int64_t timestamp_us;   // esp_timer time of the collect step
+    uint32_t bus_hold_us;   // Time spent in bus transactions for this sample
+} dht20_async_result_t;
+
+// Completion callback, called from the collect task: keep it short
+typedef void (*dht20_async_cb_t)(const dht20_async_result_t *result, void *arg);
+
+typedef struct {
+    dht20_async_transport_t transport;
+    dht20_async_cb_t on_result;     // Optional
+    void *arg;                      // Passed to on_result
+    QueueHandle_t queue;            // Optional: receives dht20_async_result_t items (never blocks)
+} dht20_async_config_t;
+
+typedef struct {
+    uint32_t samples;               // Completed measurements (any result)
+    uint32_t errors;                // Bus or CRC errors
+    uint32_t busy_retries;          // Collect steps that found the sensor still converting
+    uint32_t last_bus_hold_us;
+    uint64_t bus_hold_us_total;
+} dht20_async_stats_t;
+
+typedef enum {
+    DHT20_ASYNC_IDLE = 0,
+    DHT20_ASYNC_CONVERTING,
+} dht20_async_state_t;
+
+// Measurement state machine: trigger, release the bus, collect when the timer wakes the collect task
+typedef struct {
+    dht20_async_config_t config;
+#if CONFIG_IDF_TARGET_LINUX
+    TimerHandle_t timer;            // Host build (no esp_timer): FreeRTOS one-shot timer, only wakes the collect task
+#else
+    struct esp_timer *timer;        // esp_timer_handle_t, only wakes the collect task
+#endif
+    TaskHandle_t task;              // Collect task: blocks on the bus so the timer task never does
+    EventGroupHandle_t events;
+#if !CONFIG_IDF_TARGET_LINUX
+    i2c_master_dev_handle_t dev;    // Set when created by dht20_async_create_i2c()
+#endif
+    portMUX_TYPE lock;
+    dht20_async_state_t state;
+    uint8_t busy_retries;
+    uint32_t hold_us;               // Bus time accumulated by the current sample
+    dht20_async_stats_t stats;
+} dht20_async_t;
+
+
+/**
+ * @brief Create a measurement state machine over any transport
+ * @param config Transport and completion settings
+ * @return dht20_async_t* Returns a pointer to the instance on success, NULL on failure
+ */
+dht20_async_t* dht20_async_create(const dht20_async_config_t *config);
+
+#if !CONFIG_IDF_TARGET_LINUX
+/**
+ * @brief Create a measurement state machine on an I2C master bus
+ * @param bus Bus the sensor is attached to (e.g. from i2c_master_get_bus_handle())
+ * @param config Completion settings (transport is filled in here)
+ * @return dht20_async_t* Returns a pointer to the instance on success, NULL on failure
+ */
+dht20_async_t* dht20_async_create_i2c(i2c_master_bus_handle_t bus, const dht20_async_config_t *config);
+#endif
+
+/**
+ * @brief Stop the timer and the collect task and release the instance (not from on_result)
+ * @param dht Instance pointer
+ */
+void dht20_async_destroy(dht20_async_t *dht);
+
+/**
+ * @brief Check the calibration status and reload the calibration registers when they are not set
+ *
+ * Uses the same transport as the measurements, so the bus scheduler orders these
+ * transfers too. Blocks for about 50 ms when the registers are reloaded.
+ * @param dht Instance pointer
+ * @return esp_err_t ESP_ERR_INVALID_STATE while a measurement is in progress,
+ *         ESP_FAIL when the sensor is still not calibrated, else the bus result
+ */
+esp_err_t dht20_async_init(dht20_async_t *dht);
+
+/**
+ * @brief Start a measurement; the bus is released until the collect step
+ * @param dht Instance pointer
+ * @return esp_err_t ESP_ERR_INVALID_STATE while a measurement is in progress
+ */
+esp_err_t dht20_async_trigger(dht20_async_t *dht);
+
+/**
+ * @brief Get the bus usage counters
+ * @param dht Instance pointer
+ * @param stats Stats output pointer
+ */
+void dht20_async_get_stats(dht20_async_t *dht, dht20_async_stats_t *stats);
+
+#endif // _DHT20_ASYNC_H
@@ -0,0 +1,362 @@
+#include "i2c_sched.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <sdkconfig.h>
+#include <esp_log.h>
+#if CONFIG_IDF_TARGET_LINUX
+#include <time.h>
+#else
+#include <esp_timer.h>
+#include <driver/i2c_master.h>
+#endif
+
+#define TAG "I2CSched"
+
+// One queued transfer; lives on the submitting task's stack until done is given
+typedef struct {
+    i2c_sched_device_t *device;
+    const uint8_t *tx;
+    size_t tx_len;
+    uint8_t *rx;
+    size_t rx_len;
+    int64_t enqueue_us;
+    esp_err_t err;
+    SemaphoreHandle_t done;
+    StaticSemaphore_t done_buf;
+} i2c_sched_req_t;
+
+static int64_t i2c_sched_now_us(void)
+{
+#if CONFIG_IDF_TARGET_LINUX
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#else
+    return esp_timer_get_time();
+#endif
+}
+
+#if !CONFIG_IDF_TARGET_LINUX
+// ---------------------- I2C master backend ----------------------
+
+static esp_err_t i2c_backend_transfer(void *dev_ctx, const uint8_t *tx, size_t tx_len, uint8_t *rx, size_t rx_len)
+{
+    i2c_master_dev_handle_t dev = (i2c_master_dev_handle_t)dev_ctx;
+
+    if (tx_len > 0 && rx_len > 0) {
+        return i2c_master_transmit_receive(dev, tx, tx_len, rx, rx_len, I2C_SCHED_I2C_TIMEOUT_MS);
+    }
+    if (rx_len > 0) {
+        return i2c_master_receive(dev, rx, rx_len, I2C_SCHED_I2C_TIMEOUT_MS);
+    }
+    return i2c_master_transmit(dev, tx, tx_len, I2C_SCHED_I2C_TIMEOUT_MS);
+}
+
+static const i2c_sched_backend_t s_i2c_backend = {
+    .transfer = i2c_backend_transfer,
+};
+#endif
+
+// ---------------------- Internal implementation functions ----------------------
+
+static bool is_register_read(const i2c_sched_req_t *req)
+{
+    return req->tx_len == 1 && req->rx_len > 0;
+}
+
+/**
+ * @brief Take the next transfer: highest priority first, unless a lower-priority
+ *        head has waited past the aging limit
+ * @return i2c_sched_req_t* NULL when every queue is empty
+ */
+static i2c_sched_req_t* sched_pick(i2c_sched_t *sched, int *prio)
+{
+    int64_t now = i2c_sched_now_us();
+    int pick = -1;
+    i2c_sched_req_t *head;
+
+    for (int p = 0; p < I2C_SCHED_PRIO_COUNT; p++) {
+        if (xQueuePeek(sched->queues[p], &head, 0) != pdTRUE) {
+            continue;
+        }
+        if (pick < 0) {
+            pick = p;
+        } else if (now - head->enqueue_us >= (int64_t)I2C_SCHED_AGING_MS * 1000) {
+            pick = p;   // Keep lower priorities from starving under constant high-priority traffic
+            break;
+        }
+    }
+    if (pick < 0 || xQueueReceive(sched->queues[pick], &head, 0) != pdTRUE) {
+        return NULL;
+    }
+    *prio = pick;
+    return head;
+}
+
+/**
+ * @brief Append queued reads of the following registers of the same device
+ * @return size_t Number of requests in the batch
+ */
+static size_t sched_collect_batch(i2c_sched_t *sched, int prio, i2c_sched_req_t **batch, size_t *total)
+{
+    i2c_sched_req_t *first = batch[0];
+    i2c_sched_req_t *next;
+    size_t n = 1;
+
+    *total = first->rx_len;
+    if (!is_register_read(first)) {
+        return n;
+    }
+    while (n < I2C_SCHED_BATCH_MAX_REQS && xQueuePeek(sched->queues[prio], &next, 0) == pdTRUE) {
+        if (next->device != first->device || !is_register_read(next) ||
+            (size_t)first->tx[0] + *total != next->tx[0] ||
+            *total + next->rx_len > I2C_SCHED_BATCH_MAX_BYTES) {
+            break;
+        }
+        xQueueReceive(sched->queues[prio], &next, 0);
+        xSemaphoreTake(sched->pending, 0);  // A missing count only causes one empty wake-up later
+        batch[n++] = next;
+        *total += next->rx_len;
+    }
+    return n;
+}
+
+static void sched_execute(i2c_sched_t *sched, i2c_sched_req_t **batch, size_t n, size_t total)
+{
+    i2c_sched_req_t *first = batch[0];
+    i2c_sched_device_t *device = first->device;
+    const i2c_sched_backend_t *backend = sched->config.backend;
+    int64_t start = i2c_sched_now_us();
+    esp_err_t err;
+
+    if (n == 1) {
+        err = backend->transfer(device->ctx, first->tx, first->tx_len, first->rx, first->rx_len);
+    } else {
+        uint8_t burst[I2C_SCHED_BATCH_MAX_BYTES];
+        err = backend->transfer(device->ctx, first->tx, 1, burst, total);
+        if (err == ESP_OK) {
+            size_t offset = 0;
+            for (size_t i = 0; i < n; i++) {
+                memcpy(batch[i]->rx, burst + offset, batch[i]->rx_len);
+                offset += batch[i]->rx_len;
+            }
+        }
+    }
+    uint32_t busy = (uint32_t)(i2c_sched_now_us() - start);
+
+    portENTER_CRITICAL(&sched->lock);
+    sched->busy_us_total += busy;
+    device->stats.busy_us_total += busy;
+    for (size_t i = 0; i < n; i++) {
+        uint32_t wait = (uint32_t)(start - batch[i]->enqueue_us);
+        device->stats.transfers++;
+        device->stats.wait_us_total += wait;
+        if (wait > device->stats.wait_us_max) {
+            device->stats.wait_us_max = wait;
+        }
+        if (n > 1) {
+            device->stats.batched++;
+        }
+        if (err != ESP_OK) {
+            device->stats.errors++;
+        }
+    }
+    portEXIT_CRITICAL(&sched->lock);
+
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "%s: transfer failed: %s", device->name, esp_err_to_name(err));
+    }
+    for (size_t i = 0; i < n; i++) {
+        batch[i]->err = err;
+        xSemaphoreGive(batch[i]->done);
+    }
+}
+
+static void i2c_sched_task(void *param)
+{
+    i2c_sched_t *sched = (i2c_sched_t*)param;
+    i2c_sched_req_t *batch[I2C_SCHED_BATCH_MAX_REQS];
+    int prio;
+    size_t total;
+
+    while (1) {
+        xSemaphoreTake(sched->pending, portMAX_DELAY);
+        batch[0] = sched_pick(sched, &prio);
+        if (batch[0] == NULL) {
+            portENTER_CRITICAL(&sched->lock);
+            bool stop = sched->stop;
+            portEXIT_CRITICAL(&sched->lock);
+            if (stop) {
+                break;
+            }
+            continue;
+        }
+        size_t n = sched_collect_batch(sched, prio, batch, &total);
+        sched_execute(sched, batch, n, total);
+    }
+    xSemaphoreGive(sched->stopped);
+    vTaskDelete(NULL);
+}
+
+// ---------------------- External API functions ----------------------
+
+#if !CONFIG_IDF_TARGET_LINUX
+const i2c_sched_backend_t* i2c_sched_backend_i2c(void)
+{
+    return &s_i2c_backend;
+}
+#endif
+
+i2c_sched_t* i2c_sched_create(const i2c_sched_config_t *config)
+{
+    if (config == NULL || config->backend == NULL || config->backend->transfer == NULL) {
+        ESP_LOGE(TAG, "Invalid arguments");
+        return NULL;
+    }
+
+    i2c_sched_t *sched = (i2c_sched_t*)calloc(1, sizeof(i2c_sched_t));
+    if (sched == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate i2c_sched_t");
+        return NULL;
+    }
+    sched->config = *config;
+    portMUX_INITIALIZE(&sched->lock);
+    sched->start_us = i2c_sched_now_us();
+
+    // One more count than queue slots: the stop request of i2c_sched_destroy()
+    sched->pending = xSemaphoreCreateCounting(I2C_SCHED_QUEUE_LEN * I2C_SCHED_PRIO_COUNT + 1, 0);
+    sched->stopped = xSemaphoreCreateBinary();
+    bool ok = sched->pending != NULL && sched->stopped != NULL;
+    for (int p = 0; p < I2C_SCHED_PRIO_COUNT && ok; p++) {
+        sched->queues[p] = xQueueCreate(I2C_SCHED_QUEUE_LEN, sizeof(i2c_sched_req_t*));
+        ok = sched->queues[p] != NULL;
+    }
+    if (ok) {
+        ok = xTaskCreate(i2c_sched_task, "i2c_sched", config->stack_size,
+                         sched, config->priority, &sched->task) == pdPASS;
+    }
+    if (!ok) {
+        ESP_LOGE(TAG, "Failed to create scheduler resources");
+        for (int p = 0; p < I2C_SCHED_PRIO_COUNT; p++) {
+            if (sched->queues[p]) {
+                vQueueDelete(sched->queues[p]);
+            }
+        }
+        if (sched->pending) {
+            vSemaphoreDelete(sched->pending);
+        }
+        if (sched->stopped) {
+            vSemaphoreDelete(sched->stopped);
+        }
+        free(sched);
+        return NULL;
+    }
+    return sched;
+}
+
+void i2c_sched_destroy(i2c_sched_t *sched)
+{
+    if (sched == NULL) {
+        return;
+    }
+    // The worker drains the queues first: it only stops on a wake-up that finds them empty
+    portENTER_CRITICAL(&sched->lock);
+    sched->stop = true;
+    portEXIT_CRITICAL(&sched->lock);
+    xSemaphoreGive(sched->pending);
+    xSemaphoreTake(sched->stopped, portMAX_DELAY);
+
+    for (int p = 0; p < I2C_SCHED_PRIO_COUNT; p++) {
+        vQueueDelete(sched->queues[p]);
+    }
+    vSemaphoreDelete(sched->pending);
+    vSemaphoreDelete(sched->stopped);
+    free(sched);
+}
+
+i2c_sched_device_t* i2c_sched_add_device(i2c_sched_t *sched, const char *name, void *dev_ctx, i2c_sched_prio_t prio)
+{
+    if (sched == NULL || prio >= I2C_SCHED_PRIO_COUNT) {
+        return NULL;
+    }
+    portENTER_CRITICAL(&sched->lock);
+    if (sched->device_count >= I2C_SCHED_MAX_DEVICES) {
+        portEXIT_CRITICAL(&sched->lock);
+        ESP_LOGE(TAG, "Device table full");
+        return NULL;
+    }
+    i2c_sched_device_t *device = &sched->devices[sched->device_count++];
+    portEXIT_CRITICAL(&sched->lock);
+
+    device->sched = sched;
+    device->name = name;
+    device->ctx = dev_ctx;
+    device->prio = prio;
+    return device;
+}
+
+esp_err_t i2c_sched_transfer(i2c_sched_device_t *device, const uint8_t *tx, size_t tx_len,
+                             uint8_t *rx, size_t rx_len, uint32_t queue_timeout_ms)
+{
+    if (device == NULL || (tx_len == 0 && rx_len == 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    i2c_sched_t *sched = device->sched;
+
+    i2c_sched_req_t req = {
+        .device = device,
+        .tx = tx,
+        .tx_len = tx_len,
+        .rx = rx,
+        .rx_len = rx_len,
+        .err = ESP_FAIL,
+    };
+    req.done = xSemaphoreCreateBinaryStatic(&req.done_buf);
+    req.enqueue_us = i2c_sched_now_us();
+
+    i2c_sched_req_t *ptr = &req;
+    TickType_t ticks = (queue_timeout_ms == I2C_SCHED_WAIT_FOREVER) ? portMAX_DELAY : pdMS_TO_TICKS(queue_timeout_ms);
+    if (xQueueSend(sched->queues[device->prio], &ptr, ticks) != pdTRUE) {
+        vSemaphoreDelete(req.done);
+        return ESP_ERR_TIMEOUT;
+    }
+    xSemaphoreGive(sched->pending);
+
+    // The request lives on this stack, so wait for the worker unconditionally
+    xSemaphoreTake(req.done, portMAX_DELAY);
+    vSemaphoreDelete(req.done);
+    return req.err;
+}
+
+esp_err_t i2c_sched_write(void *device, const uint8_t *data, size_t len)
+{
+    return i2c_sched_transfer((i2c_sched_device_t*)device, data, len, NULL, 0, I2C_SCHED_WAIT_FOREVER);
+}
+
+esp_err_t i2c_sched_read(void *device, uint8_t *data, size_t len)
+{
+    return i2c_sched_transfer((i2c_sched_device_t*)device, NULL, 0, data, len, I2C_SCHED_WAIT_FOREVER);
+}
+
+void i2c_sched_get_device_stats(i2c_sched_device_t *device, i2c_sched_device_stats_t *stats)
+{
+    if (device == NULL || stats == NULL) {
+        return;
+    }
+    portENTER_CRITICAL(&device->sched->lock);
+    *stats = device->stats;
+    portEXIT_CRITICAL(&device->sched->lock);
+}
+
+float i2c_sched_get_utilization(i2c_sched_t *sched)
+{
+    if (sched == NULL) {
+        return 0.0f;
+    }
+    int64_t elapsed = i2c_sched_now_us() - sched->start_us;
+    portENTER_CRITICAL(&sched->lock);
+    uint64_t busy = sched->busy_us_total;
+    portEXIT_CRITICAL(&sched->lock);
+    return elapsed > 0 ? (float)busy * 100.0f / (float)elapsed : 0.0f;
+}
@@ -0,0 +1,105 @@
+#include "i2c_sched_mock.h"
+
+#include <string.h>
+#include <sdkconfig.h>
+#if CONFIG_IDF_TARGET_LINUX
+#include <time.h>
+#else
+#include <esp_timer.h>
+#endif
+
+// ---------------------- Internal implementation functions ----------------------
+
+static int64_t mock_now_us(void)
+{
+#if CONFIG_IDF_TARGET_LINUX
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#else
+    return esp_timer_get_time();
+#endif
+}
+
+/**
+ * @brief Register file: a 1-byte tx selects a register, longer ones write from it, reads continue from it
+ */
+static void mock_regs_transfer(i2c_sched_mock_device_t *dev, const uint8_t *tx, size_t tx_len,
+                               uint8_t *rx, size_t rx_len)
+{
+    if (tx_len > 0) {
+        dev->reg_ptr = tx[0];
+        for (size_t i = 1; i < tx_len; i++) {
+            dev->regs[dev->reg_ptr++] = tx[i];
+        }
+    }
+    for (size_t i = 0; i < rx_len; i++) {
+        rx[i] = dev->regs[dev->reg_ptr++];
+    }
+}
+
+/**
+ * @brief Run the device model, then keep the bus busy (polled, like the driver) until the bytes are clocked out
+ */
+static esp_err_t mock_transfer(void *dev_ctx, const uint8_t *tx, size_t tx_len, uint8_t *rx, size_t rx_len)
+{
+    i2c_sched_mock_device_t *dev = (i2c_sched_mock_device_t*)dev_ctx;
+    i2c_sched_mock_bus_t *bus = dev->bus;
+    int64_t start = mock_now_us();
+
+    portENTER_CRITICAL(&bus->lock);
+    if (bus->active) {
+        bus->overlaps++;
+    }
+    bus->active = true;
+    portEXIT_CRITICAL(&bus->lock);
+
+    esp_err_t err = ESP_OK;
+    if (dev->handler) {
+        err = dev->handler(dev->arg, tx, tx_len, rx, rx_len);
+    } else {
+        mock_regs_transfer(dev, tx, tx_len, rx, rx_len);
+    }
+    int64_t end = start + i2c_sched_mock_transfer_us(bus, tx_len, rx_len);
+    while (mock_now_us() < end) {
+    }
+    uint32_t busy = (uint32_t)(mock_now_us() - start);
+
+    portENTER_CRITICAL(&bus->lock);
+    bus->active = false;
+    bus->transfers++;
+    bus->busy_us_total += busy;
+    portEXIT_CRITICAL(&bus->lock);
+    return err;
+}
+
+static const i2c_sched_backend_t s_mock_backend = {
+    .transfer = mock_transfer,
+};
+
+// ---------------------- External API functions ----------------------
+
+const i2c_sched_backend_t* i2c_sched_backend_mock(void)
+{
+    return &s_mock_backend;
+}
+
+void i2c_sched_mock_bus_init(i2c_sched_mock_bus_t *bus, uint32_t scl_hz, uint32_t overhead_us)
+{
+    memset(bus, 0, sizeof(*bus));
+    bus->scl_hz = scl_hz ? scl_hz : I2C_SCHED_MOCK_SCL_HZ;
+    bus->overhead_us = overhead_us;
+    portMUX_INITIALIZE(&bus->lock);
+}
+
+uint32_t i2c_sched_mock_transfer_us(const i2c_sched_mock_bus_t *bus, size_t tx_len, size_t rx_len)
+{
+    uint32_t clocks = 2;    // Start and stop
+    if (tx_len > 0) {
+        clocks += (uint32_t)(1 + tx_len) * 9;
+    }
+    if (rx_len > 0) {
+        clocks += (uint32_t)(1 + rx_len) * 9;
+    }
+    return bus->overhead_us + (uint32_t)((uint64_t)clocks * 1000000 / bus->scl_hz);
+}
@@ -0,0 +1,179 @@
+
+#ifndef _I2C_SCHED_H
+#define _I2C_SCHED_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <sdkconfig.h>
+#include <esp_err.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+
+#define I2C_SCHED_MAX_DEVICES       8
+#define I2C_SCHED_QUEUE_LEN         8       // Pending transfers per priority
+#define I2C_SCHED_AGING_MS          50      // A lower-priority transfer waiting this long runs next
+#define I2C_SCHED_BATCH_MAX_REQS    4       // Register reads merged into one burst
+#define I2C_SCHED_BATCH_MAX_BYTES   32
+#define I2C_SCHED_I2C_TIMEOUT_MS    50      // Per-transfer timeout of the I2C backend
+#define I2C_SCHED_WAIT_FOREVER      UINT32_MAX
+#define I2C_SCHED_STACK_SIZE        3072
+#define I2C_SCHED_PRIORITY          (configMAX_PRIORITIES - 3)
+
+
+// Priorities, highest first
+typedef enum {
+    I2C_SCHED_PRIO_HIGH = 0,
+    I2C_SCHED_PRIO_NORMAL,
+    I2C_SCHED_PRIO_LOW,
+    I2C_SCHED_PRIO_COUNT,
+} i2c_sched_prio_t;
+
+// Bus access: one transaction on a backend device. tx only, rx only, or
+// tx followed by a repeated-start rx when both lengths are non-zero.
+typedef struct {
+    esp_err_t (*transfer)(void *dev_ctx, const uint8_t *tx, size_t tx_len, uint8_t *rx, size_t rx_len);
+} i2c_sched_backend_t;
+
+typedef struct {
+    const i2c_sched_backend_t *backend;     // e.g. i2c_sched_backend_i2c()
+    uint32_t stack_size;                    // Worker task stack size in bytes
+    UBaseType_t priority;                   // Worker task priority
+} i2c_sched_config_t;
+
+// The host build (linux target) has no I2C driver: its transfers go to the mock bus
+#if CONFIG_IDF_TARGET_LINUX
+#define I2C_SCHED_DEFAULT_BACKEND() i2c_sched_backend_mock()
+#else
+#define I2C_SCHED_DEFAULT_BACKEND() i2c_sched_backend_i2c()
+#endif
+
+#define I2C_SCHED_DEFAULT_CONFIG() {            \
+        .backend = I2C_SCHED_DEFAULT_BACKEND(), \
+        .stack_size = I2C_SCHED_STACK_SIZE,     \
+        .priority = I2C_SCHED_PRIORITY,         \
+    }
+
+typedef struct {
+    uint32_t transfers;
+    uint32_t errors;
+    uint32_t batched;           // Transfers served as part of a merged burst
+    uint32_t wait_us_max;       // Longest queueing delay
+    uint64_t wait_us_total;     // Queueing delay (submit to start of transfer)
+    uint64_t busy_us_total;     // Bus time used by this device
+} i2c_sched_device_stats_t;
+
+typedef struct i2c_sched i2c_sched_t;
+
+typedef struct {
+    i2c_sched_t *sched;
+    const char *name;
+    void *ctx;                  // Backend device (i2c_master_dev_handle_t for the I2C backend)
+    i2c_sched_prio_t prio;
+    i2c_sched_device_stats_t stats;
+} i2c_sched_device_t;
+
+// Scheduler: one worker task serves the queued transfers of its devices by priority.
+// Priorities, aging and batching only order transfers submitted here. Devices driven
+// elsewhere (the BSP's GT911 touch controller) bypass the queues: the i2c_master bus
+// lock serializes their transfers with the scheduler's, first come first served.
+// On the board the DHT20 is the only scheduled device, so the priority behavior is
+// only exercised on the mock bus (Sensor_Bench).
+struct i2c_sched {
+    i2c_sched_config_t config;
+    QueueHandle_t queues[I2C_SCHED_PRIO_COUNT];     // Pending transfers (pointers) per priority
+    SemaphoreHandle_t pending;                      // Counts queued transfers
+    portMUX_TYPE lock;                              // Guards the counters
+    i2c_sched_device_t devices[I2C_SCHED_MAX_DEVICES];
+    uint8_t device_count;
+    int64_t start_us;
+    uint64_t busy_us_total;
+    TaskHandle_t task;
+    bool stop;                                      // Set by i2c_sched_destroy()
+    SemaphoreHandle_t stopped;                      // Given by the worker when it exits
+};
+
+
+#if !CONFIG_IDF_TARGET_LINUX
+/**
+ * @brief Get the backend driving i2c_master devices
+ * @return const i2c_sched_backend_t*
+ */
+const i2c_sched_backend_t* i2c_sched_backend_i2c(void);
+#endif
+
+/**
+ * @brief Get the backend driving simulated devices (i2c_sched_mock_device_t, see i2c_sched_mock.h)
+ * @return const i2c_sched_backend_t*
+ */
+const i2c_sched_backend_t* i2c_sched_backend_mock(void);
+
+/**
+ * @brief Create a scheduler and start its worker task
+ * @param config Scheduler settings
+ * @return i2c_sched_t* Returns a pointer to the instance on success, NULL on failure
+ */
+i2c_sched_t* i2c_sched_create(const i2c_sched_config_t *config);
+
+/**
+ * @brief Serve the transfers still queued, stop the worker task and release the instance
+ *
+ * Call it once no task submits transfers any more.
+ * @param sched Instance pointer
+ */
+void i2c_sched_destroy(i2c_sched_t *sched);
+
+/**
+ * @brief Register a device (call before submitting transfers)
+ * @param sched Instance pointer
+ * @param name Name used in logs (must stay valid)
+ * @param dev_ctx Backend device
+ * @param prio Priority of all transfers to this device
+ * @return i2c_sched_device_t* Returns NULL when the device table is full
+ */
+i2c_sched_device_t* i2c_sched_add_device(i2c_sched_t *sched, const char *name, void *dev_ctx, i2c_sched_prio_t prio);
+
+/**
+ * @brief Queue a transfer and wait for it to complete
+ *
+ * Register reads (a 1-byte tx followed by rx) queued back to back for
+ * contiguous registers of the same device are merged into one burst.
+ * @param device Device pointer
+ * @param tx Bytes to write (may be NULL when tx_len is 0)
+ * @param tx_len Number of bytes to write
+ * @param rx Read buffer (may be NULL when rx_len is 0)
+ * @param rx_len Number of bytes to read
+ * @param queue_timeout_ms Maximum wait for a free queue slot (I2C_SCHED_WAIT_FOREVER to block)
+ * @return esp_err_t ESP_ERR_TIMEOUT when the queue stayed full, else the bus result
+ */
+esp_err_t i2c_sched_transfer(i2c_sched_device_t *device, const uint8_t *tx, size_t tx_len,
+                             uint8_t *rx, size_t rx_len, uint32_t queue_timeout_ms);
+
+/**
+ * @brief Write-only transfer, usable as a transport callback (ctx is the device)
+ */
+esp_err_t i2c_sched_write(void *device, const uint8_t *data, size_t len);
+
+/**
+ * @brief Read-only transfer, usable as a transport callback (ctx is the device)
+ */
+esp_err_t i2c_sched_read(void *device, uint8_t *data, size_t len);
+
+/**
+ * @brief Copy the counters of a device
+ * @param device Device pointer
+ * @param stats Stats output pointer
+ */
+void i2c_sched_get_device_stats(i2c_sched_device_t *device, i2c_sched_device_stats_t *stats);
+
+/**
+ * @brief Get the share of time the bus was busy since creation
+ * @param sched Instance pointer
+ * @return float Utilization in percent
+ */
+float i2c_sched_get_utilization(i2c_sched_t *sched);
+
+#endif // _I2C_SCHED_H
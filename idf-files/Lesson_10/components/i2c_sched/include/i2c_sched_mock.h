@@ -0,0 +1,57 @@
+#ifndef _I2C_SCHED_MOCK_H
+#define _I2C_SCHED_MOCK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <esp_err.h>
+#include "i2c_sched.h"
+
+
+#define I2C_SCHED_MOCK_SCL_HZ       100000  // Default bus clock (the DHT20 and GT911 share a 100 kHz bus)
+#define I2C_SCHED_MOCK_REGS         256
+
+
+// Device model: runs while the device holds the bus; the time it takes counts as bus time
+typedef esp_err_t (*i2c_sched_mock_handler_t)(void *arg, const uint8_t *tx, size_t tx_len,
+                                              uint8_t *rx, size_t rx_len);
+
+// Simulated bus: each transfer keeps it busy for as long as its bytes take at scl_hz
+typedef struct {
+    uint32_t scl_hz;
+    uint32_t overhead_us;           // Fixed cost per transfer (driver, start and stop)
+    portMUX_TYPE lock;
+    bool active;                    // A transfer is on the bus
+    uint32_t transfers;
+    uint32_t overlaps;              // Transfers started while another was on the bus
+    uint64_t busy_us_total;
+} i2c_sched_mock_bus_t;
+
+// Simulated device, the dev_ctx of i2c_sched_add_device() with the mock backend
+typedef struct {
+    i2c_sched_mock_bus_t *bus;
+    i2c_sched_mock_handler_t handler;       // Optional: NULL makes the device a register file
+    void *arg;                              // Passed to handler
+    uint8_t regs[I2C_SCHED_MOCK_REGS];      // Register file: tx[0] selects, then reads and writes auto-increment
+    uint8_t reg_ptr;
+} i2c_sched_mock_device_t;
+
+
+/**
+ * @brief Initialize a simulated bus
+ * @param bus Bus pointer
+ * @param scl_hz Bus clock (0 for I2C_SCHED_MOCK_SCL_HZ)
+ * @param overhead_us Fixed cost per transfer
+ */
+void i2c_sched_mock_bus_init(i2c_sched_mock_bus_t *bus, uint32_t scl_hz, uint32_t overhead_us);
+
+/**
+ * @brief Bus time of one transfer: address and data bytes at 9 clocks each, plus start and stop
+ * @param bus Bus pointer
+ * @param tx_len Number of bytes written
+ * @param rx_len Number of bytes read (after a repeated start when tx_len is non-zero)
+ * @return uint32_t Time in microseconds
+ */
+uint32_t i2c_sched_mock_transfer_us(const i2c_sched_mock_bus_t *bus, size_t tx_len, size_t rx_len);
+
+#endif // _I2C_SCHED_MOCK_H
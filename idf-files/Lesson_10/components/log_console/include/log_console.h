@@ -0,0 +1,95 @@
+
+#ifndef _LOG_CONSOLE_H
+#define _LOG_CONSOLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include "lvgl.h"
+
+
+#define LOG_CONSOLE_RING_SIZE       128     // Records kept, must be a power of two
+#define LOG_CONSOLE_LINE_SIZE       128     // Bytes per record, longer lines are truncated
+#define LOG_CONSOLE_VIEW_MAX_LINES  16
+#define LOG_CONSOLE_VIEW_PERIOD_MS  200     // Default view refresh period
+
+
+// One log line; seq is odd while a producer writes it, 2 * position + 2 once complete
+typedef struct {
+    atomic_uint_fast32_t seq;
+    uint16_t len;
+    char text[LOG_CONSOLE_LINE_SIZE];
+} log_console_record_t;
+
+// Overwrite ring of log lines: producers never block, the oldest lines are replaced
+typedef struct {
+    log_console_record_t *records;      // LOG_CONSOLE_RING_SIZE records (PSRAM when available)
+    atomic_uint_fast32_t write_pos;     // Next position to claim
+    atomic_uint_fast32_t written;
+    atomic_uint_fast32_t dropped;       // Slot still being written by a producer one lap behind
+} log_console_t;
+
+// Scrolling view: a fixed pool of labels, the oldest one is reused for each new line
+typedef struct {
+    log_console_t *console;
+    lv_obj_t *cont;
+    lv_obj_t *labels[LOG_CONSOLE_VIEW_MAX_LINES];
+    uint8_t line_count;
+    uint8_t oldest;                     // Label holding the oldest line
+    uint32_t read_pos;
+    uint32_t lost;                      // Lines overwritten or skipped before they were shown
+    lv_timer_t *timer;
+} log_console_view_t;
+
+
+/**
+ * @brief Create a log console ring
+ * @return log_console_t* Returns a pointer to the instance on success, NULL on failure
+ */
+log_console_t* log_console_create(void);
+
+/**
+ * @brief Append a line (wait-free: one atomic claim and a memcpy)
+ * @param console Instance pointer
+ * @param text Line text
+ * @param len Text length in bytes
+ */
+void log_console_write(log_console_t *console, const char *text, size_t len);
+
+/**
+ * @brief Append a formatted line, formatted directly into the ring
+ * @param console Instance pointer
+ * @param fmt Format string
+ * @param args Arguments
+ */
+void log_console_vprintf(log_console_t *console, const char *fmt, va_list args);
+
+/**
+ * @brief Copy the next line after a read position
+ * @param console Instance pointer
+ * @param pos Read position, advanced past the returned line and any lost lines
+ * @param out Output buffer (LOG_CONSOLE_LINE_SIZE bytes)
+ * @param lost Incremented by the number of lines overwritten before they were read (optional)
+ * @return bool Returns false when no complete line is available yet
+ */
+bool log_console_read(log_console_t *console, uint32_t *pos, char *out, uint32_t *lost);
+
+/**
+ * @brief Route esp_log output into the console too (the previous output is kept)
+ * @param console Instance pointer
+ */
+void log_console_install_hook(log_console_t *console);
+
+/**
+ * @brief Create a scrolling view (call with the LVGL lock held)
+ * @param console Instance pointer
+ * @param parent Parent object
+ * @param lines Number of visible lines (at most LOG_CONSOLE_VIEW_MAX_LINES)
+ * @param period_ms Refresh period, bounds the UI cost of log bursts
+ * @return log_console_view_t* Returns a pointer to the view on success, NULL on failure
+ */
+log_console_view_t* log_console_view_create(log_console_t *console, lv_obj_t *parent, uint8_t lines, uint32_t period_ms);
+
+#endif // _LOG_CONSOLE_H
@@ -0,0 +1,179 @@
+#include "log_console.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <esp_log.h>
+#include <esp_heap_caps.h>
+
+#define TAG "LogConsole"
+
+#define LOG_CONSOLE_MASK    (LOG_CONSOLE_RING_SIZE - 1)
+
+_Static_assert((LOG_CONSOLE_RING_SIZE & LOG_CONSOLE_MASK) == 0, "LOG_CONSOLE_RING_SIZE must be a power of two");
+
+static log_console_t *s_hook_console = NULL;
+static vprintf_like_t s_prev_vprintf = NULL;
+
+// ---------------------- Internal implementation functions ----------------------
+
+/**
+ * @brief Claim the record for a position
+ * @return log_console_record_t* NULL when a producer one lap behind still writes the slot
+ */
+static log_console_record_t* log_console_claim(log_console_t *console, uint32_t *claim)
+{
+    uint32_t pos = (uint32_t)atomic_fetch_add_explicit(&console->write_pos, 1, memory_order_relaxed);
+    log_console_record_t *record = &console->records[pos & LOG_CONSOLE_MASK];
+    uint_fast32_t cur = atomic_load_explicit(&record->seq, memory_order_relaxed);
+
+    *claim = 2 * pos + 1;
+    do {
+        // Never wait for (or overwrite) another producer: drop the line instead
+        if ((cur & 1) || (int32_t)((uint32_t)cur - *claim) >= 0) {
+            atomic_fetch_add_explicit(&console->dropped, 1, memory_order_relaxed);
+            return NULL;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&record->seq, &cur, *claim,
+                                                    memory_order_acquire, memory_order_relaxed));
+    return record;
+}
+
+static void log_console_publish(log_console_t *console, log_console_record_t *record, uint32_t claim)
+{
+    atomic_store_explicit(&record->seq, claim + 1, memory_order_release);
+    atomic_fetch_add_explicit(&console->written, 1, memory_order_relaxed);
+}
+
+static int log_console_vprintf_hook(const char *fmt, va_list args)
+{
+    va_list copy;
+    va_copy(copy, args);
+    log_console_vprintf(s_hook_console, fmt, copy);
+    va_end(copy);
+    return s_prev_vprintf ? s_prev_vprintf(fmt, args) : vprintf(fmt, args);
+}
+
+// ---------------------- External API functions ----------------------
+
+log_console_t* log_console_create(void)
+{
+    log_console_t *console = (log_console_t*)calloc(1, sizeof(log_console_t));
+    if (console == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate log_console_t");
+        return NULL;
+    }
+
+    size_t size = LOG_CONSOLE_RING_SIZE * sizeof(log_console_record_t);
+    console->records = (log_console_record_t*)heap_caps_calloc(1, size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (console->records == NULL) {
+        console->records = (log_console_record_t*)calloc(1, size);
+    }
+    if (console->records == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate %u bytes of records", (unsigned)size);
+        free(console);
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < LOG_CONSOLE_RING_SIZE; i++) {
+        // "Completed one lap ago": below every claim of the first lap
+        atomic_init(&console->records[i].seq, (uint32_t)(2 * (i - LOG_CONSOLE_RING_SIZE) + 2));
+    }
+    atomic_init(&console->write_pos, 0);
+    atomic_init(&console->written, 0);
+    atomic_init(&console->dropped, 0);
+    return console;
+}
+
+void log_console_write(log_console_t *console, const char *text, size_t len)
+{
+    if (console == NULL || text == NULL) {
+        return;
+    }
+    uint32_t claim;
+    log_console_record_t *record = log_console_claim(console, &claim);
+    if (record == NULL) {
+        return;
+    }
+    if (len > LOG_CONSOLE_LINE_SIZE - 1) {
+        len = LOG_CONSOLE_LINE_SIZE - 1;
+    }
+    memcpy(record->text, text, len);
+    record->text[len] = '\0';
+    record->len = (uint16_t)len;
+    log_console_publish(console, record, claim);
+}
+
+void log_console_vprintf(log_console_t *console, const char *fmt, va_list args)
+{
+    if (console == NULL || fmt == NULL) {
+        return;
+    }
+    uint32_t claim;
+    log_console_record_t *record = log_console_claim(console, &claim);
+    if (record == NULL) {
+        return;
+    }
+    int len = vsnprintf(record->text, LOG_CONSOLE_LINE_SIZE, fmt, args);
+    if (len < 0) {
+        len = 0;
+        record->text[0] = '\0';
+    } else if (len > LOG_CONSOLE_LINE_SIZE - 1) {
+        len = LOG_CONSOLE_LINE_SIZE - 1;
+    }
+    record->len = (uint16_t)len;
+    log_console_publish(console, record, claim);
+}
+
+bool log_console_read(log_console_t *console, uint32_t *pos, char *out, uint32_t *lost)
+{
+    if (console == NULL || pos == NULL || out == NULL) {
+        return false;
+    }
+
+    while (1) {
+        uint32_t write_pos = (uint32_t)atomic_load_explicit(&console->write_pos, memory_order_acquire);
+        if (*pos == write_pos) {
+            return false;
+        }
+        if (write_pos - *pos > LOG_CONSOLE_RING_SIZE) {
+            // Reader fell more than a lap behind
+            if (lost) *lost += write_pos - LOG_CONSOLE_RING_SIZE - *pos;
+            *pos = write_pos - LOG_CONSOLE_RING_SIZE;
+        }
+
+        log_console_record_t *record = &console->records[*pos & LOG_CONSOLE_MASK];
+        uint32_t expected = 2 * *pos + 2;
+        uint32_t seq = (uint32_t)atomic_load_explicit(&record->seq, memory_order_acquire);
+        int32_t diff = (int32_t)(seq - expected);
+
+        if (diff < 0) {
+            // Not written yet; keep the order unless its producer dropped it
+            // (stale seq) and later lines are piling up
+            if (diff == -1 || write_pos - *pos < LOG_CONSOLE_RING_SIZE / 2) {
+                return false;
+            }
+        } else if (diff == 0) {
+            memcpy(out, record->text, LOG_CONSOLE_LINE_SIZE);
+            out[LOG_CONSOLE_LINE_SIZE - 1] = '\0';
+            // Seqlock check: the slot must not have been reclaimed during the copy
+            atomic_thread_fence(memory_order_acquire);
+            if (atomic_load_explicit(&record->seq, memory_order_relaxed) == seq) {
+                (*pos)++;
+                return true;
+            }
+        }
+        // Overwritten, dropped or torn: skip it
+        if (lost) (*lost)++;
+        (*pos)++;
+    }
+}
+
+void log_console_install_hook(log_console_t *console)
+{
+    if (console == NULL || s_hook_console != NULL) {
+        return;
+    }
+    s_hook_console = console;
+    s_prev_vprintf = esp_log_set_vprintf(log_console_vprintf_hook);
+}
@@ -0,0 +1,116 @@
+#include "log_console.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <esp_log.h>
+
+#define TAG "LogConsoleView"
+
+// ---------------------- Internal helper functions ----------------------
+
+/**
+ * @brief Remove ANSI color sequences and the trailing newline added by esp_log
+ * @return char Level letter of an esp_log line ('E', 'W', 'I', ...), 0 otherwise
+ */
+static char log_console_clean_line(char *line)
+{
+    char *dst = line;
+    for (const char *src = line; *src; src++) {
+        if (src[0] == '\033' && src[1] == '[') {
+            src += 2;
+            while (*src && *src != 'm') {
+                src++;
+            }
+            if (*src == '\0') {
+                break;
+            }
+            continue;
+        }
+        *dst++ = *src;
+    }
+    while (dst > line && (dst[-1] == '\n' || dst[-1] == '\r')) {
+        dst--;
+    }
+    *dst = '\0';
+
+    // esp_log lines look like "I (1234) TAG: message"
+    if (line[0] != '\0' && line[1] == ' ' && line[2] == '(') {
+        return line[0];
+    }
+    return 0;
+}
+
+static lv_color_t log_console_level_color(char level)
+{
+    switch (level) {
+        case 'E': return lv_color_hex(0xD32F2F);
+        case 'W': return lv_color_hex(0xF57C00);
+        default:  return lv_color_hex(0x000000);
+    }
+}
+
+/**
+ * @brief Show new lines: each one reuses the oldest label, moved to the bottom
+ */
+static void log_console_view_timer_cb(lv_timer_t *timer)
+{
+    log_console_view_t *view = (log_console_view_t*)timer->user_data;
+    uint32_t write_pos = (uint32_t)atomic_load_explicit(&view->console->write_pos, memory_order_relaxed);
+
+    // Bound the work per refresh: lines that would scroll out immediately are skipped
+    if (write_pos - view->read_pos > view->line_count) {
+        view->lost += write_pos - view->line_count - view->read_pos;
+        view->read_pos = write_pos - view->line_count;
+    }
+
+    char line[LOG_CONSOLE_LINE_SIZE];
+    for (uint8_t i = 0; i < view->line_count; i++) {
+        if (!log_console_read(view->console, &view->read_pos, line, &view->lost)) {
+            break;
+        }
+        char level = log_console_clean_line(line);
+        lv_obj_t *label = view->labels[view->oldest];
+        lv_label_set_text(label, line);
+        lv_obj_set_style_text_color(label, log_console_level_color(level), 0);
+        lv_obj_move_foreground(label);
+        view->oldest = (view->oldest + 1) % view->line_count;
+    }
+}
+
+// ---------------------- External API functions ----------------------
+
+log_console_view_t* log_console_view_create(log_console_t *console, lv_obj_t *parent, uint8_t lines, uint32_t period_ms)
+{
+    if (console == NULL || parent == NULL || lines == 0 || lines > LOG_CONSOLE_VIEW_MAX_LINES) {
+        ESP_LOGE(TAG, "Invalid arguments");
+        return NULL;
+    }
+
+    log_console_view_t *view = (log_console_view_t*)calloc(1, sizeof(log_console_view_t));
+    if (view == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate log_console_view_t");
+        return NULL;
+    }
+    view->console = console;
+    view->line_count = lines;
+
+    view->cont = lv_obj_create(parent);
+    lv_obj_set_flex_flow(view->cont, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_style_pad_row(view->cont, 0, 0);
+    lv_obj_clear_flag(view->cont, LV_OBJ_FLAG_SCROLLABLE);
+    for (uint8_t i = 0; i < lines; i++) {
+        view->labels[i] = lv_label_create(view->cont);
+        lv_label_set_long_mode(view->labels[i], LV_LABEL_LONG_CLIP);
+        lv_obj_set_width(view->labels[i], LV_PCT(100));
+        lv_label_set_text(view->labels[i], "");
+    }
+
+    view->timer = lv_timer_create(log_console_view_timer_cb, period_ms, view);
+    if (view->timer == NULL) {
+        ESP_LOGE(TAG, "Failed to create refresh timer");
+        lv_obj_del(view->cont);
+        free(view);
+        return NULL;
+    }
+    return view;
+}
@@ -0,0 +1,53 @@
+
+#ifndef _SENSOR_DHT20_H
+#define _SENSOR_DHT20_H
+
+#include <stdint.h>
+#include <esp_err.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include "sensor_sched.h"
+#include "dht20_async.h"
+
+
+#define SENSOR_DHT20_PERIOD_MS      1000
+#define SENSOR_DHT20_CONVERT_MS     (DHT20_ASYNC_CONVERSION_MS + 5)     // Lets the collect step finish its bus read
+// Longest the read step waits for the result: every busy retry, then a bus timeout
+#define SENSOR_DHT20_READ_TIMEOUT_MS    (DHT20_ASYNC_MAX_BUSY_RETRIES * DHT20_ASYNC_BUSY_RETRY_MS + DHT20_ASYNC_I2C_TIMEOUT_MS)
+
+#define SENSOR_DHT20_DEFAULT_CONFIG() {     \
+    .dht = NULL,                            \
+    .queue = NULL,                          \
+    .period_ms = SENSOR_DHT20_PERIOD_MS,    \
+    .ensure_ready = NULL,                   \
+}
+
+
+// Entries of sensor_reading_t.values
+enum {
+    SENSOR_DHT20_TEMPERATURE = 0,   // °C
+    SENSOR_DHT20_HUMIDITY,          // %RH
+};
+
+typedef struct {
+    dht20_async_t *dht;                 // Measurement state machine
+    QueueHandle_t queue;                // Its result queue (dht20_async_config_t.queue)
+    uint32_t period_ms;
+    esp_err_t (*ensure_ready)(void);    // Optional, before every trigger: e.g. check the calibration
+} sensor_dht20_config_t;
+
+// DHT20 driver for sensor_sched: triggers, lets the other sensors run during the conversion, then collects
+typedef struct {
+    sensor_driver_t driver;     // Register &dht20->driver with dht20 as the context
+    sensor_dht20_config_t config;
+} sensor_dht20_t;
+
+
+/**
+ * @brief Create the DHT20 driver
+ * @param config Configuration pointer
+ * @return sensor_dht20_t* Returns a pointer to the instance on success, NULL on failure
+ */
+sensor_dht20_t* sensor_dht20_create(const sensor_dht20_config_t *config);
+
+#endif // _SENSOR_DHT20_H
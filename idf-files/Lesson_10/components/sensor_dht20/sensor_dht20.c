@@ -0,0 +1,64 @@
+#include "sensor_dht20.h"
+
+#include <stdlib.h>
+#include <esp_log.h>
+
+#define TAG "SensorDHT20"
+
+// ---------------------- Internal implementation functions ----------------------
+
+static esp_err_t sensor_dht20_start(void *ctx)
+{
+    sensor_dht20_t *dht20 = (sensor_dht20_t*)ctx;
+
+    if (dht20->config.ensure_ready) {
+        esp_err_t err = dht20->config.ensure_ready();
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+    // A result that arrived after the last read timed out belongs to no sample
+    xQueueReset(dht20->config.queue);
+    return dht20_async_trigger(dht20->config.dht);
+}
+
+static esp_err_t sensor_dht20_read(void *ctx, sensor_reading_t *reading)
+{
+    sensor_dht20_t *dht20 = (sensor_dht20_t*)ctx;
+    dht20_async_result_t result;
+
+    if (xQueueReceive(dht20->config.queue, &result, pdMS_TO_TICKS(SENSOR_DHT20_READ_TIMEOUT_MS)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    if (result.err != ESP_OK) {
+        return result.err;
+    }
+    reading->values[SENSOR_DHT20_TEMPERATURE] = result.temperature;
+    reading->values[SENSOR_DHT20_HUMIDITY] = result.humidity;
+    reading->count = 2;
+    return ESP_OK;
+}
+
+// ---------------------- External API functions ----------------------
+
+sensor_dht20_t* sensor_dht20_create(const sensor_dht20_config_t *config)
+{
+    if (config == NULL || config->dht == NULL || config->queue == NULL || config->period_ms == 0) {
+        ESP_LOGE(TAG, "Invalid config");
+        return NULL;
+    }
+    sensor_dht20_t *dht20 = (sensor_dht20_t*)calloc(1, sizeof(sensor_dht20_t));
+    if (dht20 == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate sensor_dht20_t");
+        return NULL;
+    }
+    dht20->config = *config;
+    dht20->driver = (sensor_driver_t){
+        .name = "dht20",
+        .period_ms = config->period_ms,
+        .convert_ms = SENSOR_DHT20_CONVERT_MS,
+        .start = sensor_dht20_start,
+        .read = sensor_dht20_read,
+    };
+    return dht20;
+}
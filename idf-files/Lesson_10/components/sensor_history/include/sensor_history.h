@@ -0,0 +1,107 @@
+
+#ifndef _SENSOR_HISTORY_H
+#define _SENSOR_HISTORY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+
+#define SENSOR_HISTORY_MAX_TIERS    5
+
+// Default tiers: raw samples for 1 hour, then 1 min for a day,
+// 15 min for a week and 1 h for 30 days (about 100 KB per series)
+#define SENSOR_HISTORY_DEFAULT_TIERS() {        \
+        { .resolution_s = 0,    .capacity = 3600 }, \
+        { .resolution_s = 60,   .capacity = 1440 }, \
+        { .resolution_s = 900,  .capacity = 672 },  \
+        { .resolution_s = 3600, .capacity = 720 },  \
+    }
+
+
+// One stored point: a raw sample (count 1) or a rollup bucket
+typedef struct {
+    uint32_t time;      // Sample time, or start of the bucket (seconds)
+    float min;
+    float max;
+    float avg;
+} sensor_history_point_t;
+
+typedef struct {
+    uint32_t resolution_s;  // Bucket width in seconds, 0 keeps raw samples
+    uint32_t capacity;      // Points retained
+} sensor_history_tier_config_t;
+
+// One resolution level: a ring of closed buckets plus the bucket being filled
+typedef struct {
+    uint32_t resolution_s;
+    uint32_t capacity;
+    sensor_history_point_t *ring;
+    uint32_t head;          // Next write index
+    uint32_t count;         // Points stored
+    bool open;              // The accumulator below holds samples
+    uint32_t bucket_start;
+    float min;
+    float max;
+    double sum;
+    uint32_t n;
+} sensor_history_tier_t;
+
+// Time series of one quantity (e.g. temperature), tiers from finest to coarsest
+typedef struct {
+    sensor_history_tier_t tiers[SENSOR_HISTORY_MAX_TIERS];
+    uint8_t tier_count;
+    SemaphoreHandle_t lock;
+} sensor_history_t;
+
+
+/**
+ * @brief Create a time series store (ring buffers in PSRAM when available)
+ * @param tiers Tier settings, finest first
+ * @param tier_count Number of tiers (at most SENSOR_HISTORY_MAX_TIERS)
+ * @return sensor_history_t* Returns a pointer to the instance on success, NULL on failure
+ */
+sensor_history_t* sensor_history_create(const sensor_history_tier_config_t *tiers, size_t tier_count);
+
+/**
+ * @brief Release a time series store
+ * @param history Instance pointer
+ */
+void sensor_history_destroy(sensor_history_t *history);
+
+/**
+ * @brief Add a sample, updating every tier in constant time
+ * @param history Instance pointer
+ * @param time Sample time in seconds (non-decreasing)
+ * @param value Sample value
+ */
+void sensor_history_add(sensor_history_t *history, uint32_t time, float value);
+
+/**
+ * @brief Get a time range at the finest resolution that covers it within max_points
+ *
+ * The bucket still being filled is returned as the last (partial) point.
+ * @param history Instance pointer
+ * @param from Range start in seconds (inclusive)
+ * @param to Range end in seconds (inclusive)
+ * @param points Output array, oldest first
+ * @param max_points Output array capacity
+ * @param resolution_s Resolution of the returned points (optional, 0 means raw)
+ * @return size_t Number of points written
+ */
+size_t sensor_history_query(sensor_history_t *history, uint32_t from, uint32_t to,
+                            sensor_history_point_t *points, size_t max_points, uint32_t *resolution_s);
+
+/**
+ * @brief Aggregate min/max/avg over a time range
+ * @param history Instance pointer
+ * @param from Range start in seconds (inclusive)
+ * @param to Range end in seconds (inclusive)
+ * @param summary Output point (time is the first covered time)
+ * @return bool Returns false if the range holds no data
+ */
+bool sensor_history_summary(sensor_history_t *history, uint32_t from, uint32_t to, sensor_history_point_t *summary);
+
+#endif // _SENSOR_HISTORY_H
@@ -0,0 +1,318 @@
+#include "sensor_history.h"
+
+#include <string.h>
+#include <float.h>
+#include <esp_log.h>
+#include <esp_heap_caps.h>
+
+#define TAG "SensorHistory"
+
+#define SENSOR_HISTORY_SUMMARY_POINTS   256     // Point budget when picking the tier for a summary
+
+// ---------------------- Internal helper functions ----------------------
+
+/**
+ * @brief Prefer PSRAM for the rings, fall back to internal RAM
+ */
+static void* history_alloc(size_t size)
+{
+    void *ptr = heap_caps_calloc(1, size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (ptr == NULL) {
+        ptr = calloc(1, size);
+    }
+    return ptr;
+}
+
+static void tier_push(sensor_history_tier_t *tier, const sensor_history_point_t *point)
+{
+    tier->ring[tier->head] = *point;
+    tier->head = (tier->head + 1) % tier->capacity;
+    if (tier->count < tier->capacity) {
+        tier->count++;
+    }
+}
+
+/**
+ * @brief Move the accumulated bucket into the ring
+ */
+static void tier_close_bucket(sensor_history_tier_t *tier)
+{
+    sensor_history_point_t point = {
+        .time = tier->bucket_start,
+        .min = tier->min,
+        .max = tier->max,
+        .avg = (float)(tier->sum / tier->n),
+    };
+    tier_push(tier, &point);
+    tier->open = false;
+}
+
+static void tier_add(sensor_history_tier_t *tier, uint32_t time, float value)
+{
+    if (tier->resolution_s == 0) {
+        sensor_history_point_t point = { .time = time, .min = value, .max = value, .avg = value };
+        tier_push(tier, &point);
+        return;
+    }
+
+    uint32_t bucket_start = time - time % tier->resolution_s;
+    if (tier->open && bucket_start != tier->bucket_start) {
+        tier_close_bucket(tier);
+    }
+    if (!tier->open) {
+        tier->open = true;
+        tier->bucket_start = bucket_start;
+        tier->min = value;
+        tier->max = value;
+        tier->sum = 0;
+        tier->n = 0;
+    }
+    if (value < tier->min) tier->min = value;
+    if (value > tier->max) tier->max = value;
+    tier->sum += value;
+    tier->n++;
+}
+
+/**
+ * @brief Get the i-th stored point, oldest first
+ */
+static const sensor_history_point_t* tier_at(const sensor_history_tier_t *tier, uint32_t i)
+{
+    uint32_t oldest = (tier->head + tier->capacity - tier->count) % tier->capacity;
+    return &tier->ring[(oldest + i) % tier->capacity];
+}
+
+/**
+ * @brief Earliest time a tier still holds, including its open bucket
+ */
+static bool tier_oldest(const sensor_history_tier_t *tier, uint32_t *time)
+{
+    if (tier->count > 0) {
+        *time = tier_at(tier, 0)->time;
+        return true;
+    }
+    if (tier->open) {
+        *time = tier->bucket_start;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Index of the first stored point at or after a time (binary search, times are sorted)
+ */
+static uint32_t tier_lower_bound(const sensor_history_tier_t *tier, uint32_t time)
+{
+    uint32_t lo = 0, hi = tier->count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (tier_at(tier, mid)->time < time) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+ * @brief Pick the finest tier that covers the range start within max_points
+ *
+ * Rollup buckets are matched by their start, so a range starting inside a
+ * bucket includes that bucket.
+ */
+static const sensor_history_tier_t* history_select_tier(const sensor_history_t *history,
+                                                        uint32_t from, uint32_t to, size_t max_points)
+{
+    const sensor_history_tier_t *fallback = NULL;
+
+    for (uint8_t i = 0; i < history->tier_count; i++) {
+        const sensor_history_tier_t *tier = &history->tiers[i];
+        uint32_t oldest;
+        if (!tier_oldest(tier, &oldest)) {
+            continue;
+        }
+        fallback = tier;
+
+        uint32_t start = from - (tier->resolution_s ? from % tier->resolution_s : 0);
+        bool covers = oldest <= start || tier->count < tier->capacity;  // Not wrapped yet: holds everything
+        if (!covers) {
+            continue;
+        }
+        // Upper bound of the number of points in range
+        uint64_t span = (uint64_t)to - start;
+        uint64_t needed = tier->resolution_s ? span / tier->resolution_s + 1 : span + 1;
+        if (needed <= max_points) {
+            return tier;
+        }
+        // Raw samples may be sparser than one per second: count exactly
+        if (tier->resolution_s == 0) {
+            uint32_t end = (to == UINT32_MAX) ? tier->count : tier_lower_bound(tier, to + 1);
+            if (end - tier_lower_bound(tier, start) <= max_points) {
+                return tier;
+            }
+        }
+    }
+    return fallback;
+}
+
+// Iteration state over the points of one tier within a range
+typedef struct {
+    uint32_t index;
+    bool started;
+    bool done;
+} tier_cursor_t;
+
+/**
+ * @brief Get the next point of a tier within [from, to], ending with the open bucket
+ * @return bool Returns false when the range is exhausted
+ */
+static bool tier_next(const sensor_history_tier_t *tier, uint32_t from, uint32_t to,
+                      tier_cursor_t *cursor, sensor_history_point_t *point)
+{
+    uint32_t start = from - (tier->resolution_s ? from % tier->resolution_s : 0);
+
+    if (cursor->done) {
+        return false;
+    }
+    if (!cursor->started) {
+        cursor->index = tier_lower_bound(tier, start);
+        cursor->started = true;
+    }
+    if (cursor->index < tier->count && tier_at(tier, cursor->index)->time <= to) {
+        *point = *tier_at(tier, cursor->index++);
+        return true;
+    }
+
+    cursor->done = true;
+    if (tier->open && tier->bucket_start >= start && tier->bucket_start <= to) {
+        point->time = tier->bucket_start;
+        point->min = tier->min;
+        point->max = tier->max;
+        point->avg = (float)(tier->sum / tier->n);
+        return true;
+    }
+    return false;
+}
+
+// ---------------------- External API functions ----------------------
+
+sensor_history_t* sensor_history_create(const sensor_history_tier_config_t *tiers, size_t tier_count)
+{
+    if (tiers == NULL || tier_count == 0 || tier_count > SENSOR_HISTORY_MAX_TIERS) {
+        ESP_LOGE(TAG, "Invalid tier configuration");
+        return NULL;
+    }
+
+    sensor_history_t *history = (sensor_history_t*)calloc(1, sizeof(sensor_history_t));
+    if (history == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate sensor_history_t");
+        return NULL;
+    }
+    history->lock = xSemaphoreCreateMutex();
+    if (history->lock == NULL) {
+        ESP_LOGE(TAG, "Failed to create mutex");
+        free(history);
+        return NULL;
+    }
+
+    size_t total = 0;
+    for (size_t i = 0; i < tier_count; i++) {
+        sensor_history_tier_t *tier = &history->tiers[i];
+        tier->resolution_s = tiers[i].resolution_s;
+        tier->capacity = tiers[i].capacity;
+        tier->ring = (sensor_history_point_t*)history_alloc(tier->capacity * sizeof(sensor_history_point_t));
+        history->tier_count = i + 1;
+        if (tier->capacity == 0 || tier->ring == NULL) {
+            ESP_LOGE(TAG, "Failed to allocate tier %u", (unsigned)i);
+            sensor_history_destroy(history);
+            return NULL;
+        }
+        total += tier->capacity * sizeof(sensor_history_point_t);
+    }
+    ESP_LOGI(TAG, "Created with %u tiers, %u bytes", (unsigned)tier_count, (unsigned)total);
+    return history;
+}
+
+void sensor_history_destroy(sensor_history_t *history)
+{
+    if (history == NULL) {
+        return;
+    }
+    for (uint8_t i = 0; i < history->tier_count; i++) {
+        free(history->tiers[i].ring);  // heap_caps memory is released by free() too
+    }
+    if (history->lock) {
+        vSemaphoreDelete(history->lock);
+    }
+    free(history);
+}
+
+void sensor_history_add(sensor_history_t *history, uint32_t time, float value)
+{
+    if (history == NULL) {
+        return;
+    }
+    xSemaphoreTake(history->lock, portMAX_DELAY);
+    for (uint8_t i = 0; i < history->tier_count; i++) {
+        tier_add(&history->tiers[i], time, value);
+    }
+    xSemaphoreGive(history->lock);
+}
+
+size_t sensor_history_query(sensor_history_t *history, uint32_t from, uint32_t to,
+                            sensor_history_point_t *points, size_t max_points, uint32_t *resolution_s)
+{
+    if (history == NULL || points == NULL || max_points == 0 || from > to) {
+        return 0;
+    }
+
+    size_t n = 0;
+    xSemaphoreTake(history->lock, portMAX_DELAY);
+    const sensor_history_tier_t *tier = history_select_tier(history, from, to, max_points);
+    if (tier != NULL) {
+        tier_cursor_t cursor = {0};
+        while (n < max_points && tier_next(tier, from, to, &cursor, &points[n])) {
+            n++;
+        }
+        if (resolution_s) {
+            *resolution_s = tier->resolution_s;
+        }
+    }
+    xSemaphoreGive(history->lock);
+    return n;
+}
+
+bool sensor_history_summary(sensor_history_t *history, uint32_t from, uint32_t to, sensor_history_point_t *summary)
+{
+    if (history == NULL || summary == NULL || from > to) {
+        return false;
+    }
+
+    // Aggregating buckets weights each one equally, which matches the
+    // sample-weighted average for a sensor read at a fixed rate
+    double sum = 0;
+    uint32_t n = 0;
+    summary->min = FLT_MAX;
+    summary->max = -FLT_MAX;
+
+    xSemaphoreTake(history->lock, portMAX_DELAY);
+    const sensor_history_tier_t *tier = history_select_tier(history, from, to, SENSOR_HISTORY_SUMMARY_POINTS);
+    if (tier != NULL) {
+        tier_cursor_t cursor = {0};
+        sensor_history_point_t point;
+        while (tier_next(tier, from, to, &cursor, &point)) {
+            if (n++ == 0) summary->time = point.time;
+            if (point.min < summary->min) summary->min = point.min;
+            if (point.max > summary->max) summary->max = point.max;
+            sum += point.avg;
+        }
+    }
+    xSemaphoreGive(history->lock);
+
+    if (n == 0) {
+        return false;
+    }
+    summary->avg = (float)(sum / n);
+    return true;
+}
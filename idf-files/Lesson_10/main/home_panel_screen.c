@@ -0,0 +1,22 @@
+// home_panel_screen.c
+#include "home_panel_screen.h"
+#include "ui/home_panel_layout.h"
+
+esp_err_t home_panel_screen_create(lv_obj_t *scr, lv_event_cb_t on_cb, lv_event_cb_t off_cb, home_panel_screen_t *screen)
+{
+    // Screen layout lives in ui/home_panel_layout.json, compiled to const tables by tools/ui_layout.py
+    lv_obj_t *objs[HOME_PANEL_LAYOUT_COUNT];
+    esp_err_t err = ui_layout_build(&home_panel_layout, scr, objs);
+    if (err != ESP_OK) {
+        return err;
+    }
+    if (on_cb) {
+        lv_obj_add_event_cb(objs[HOME_PANEL_LAYOUT_BTN_ON], on_cb, LV_EVENT_CLICKED, NULL);
+    }
+    if (off_cb) {
+        lv_obj_add_event_cb(objs[HOME_PANEL_LAYOUT_BTN_OFF], off_cb, LV_EVENT_CLICKED, NULL);
+    }
+    screen->led_status_label = objs[HOME_PANEL_LAYOUT_STATUS];
+    screen->dht20_label = objs[HOME_PANEL_LAYOUT_DHT20];
+    return ESP_OK;
+}
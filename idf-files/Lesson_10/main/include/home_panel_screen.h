@@ -0,0 +1,27 @@
+
+#ifndef _HOME_PANEL_SCREEN_H
+#define _HOME_PANEL_SCREEN_H
+
+#include <esp_err.h>
+#include "lvgl.h"
+
+
+// Labels updated at run time
+typedef struct {
+    lv_obj_t *led_status_label;
+    lv_obj_t *dht20_label;
+} home_panel_screen_t;
+
+
+/**
+ * @brief Build the Home Panel screen from ui/home_panel_layout.json (LVGL and ui_layout only, also used by
+ * the Render_Bench host build)
+ * @param scr Screen to draw on, called with the LVGL lock held
+ * @param on_cb Clicked callback of the "LED ON" button (optional)
+ * @param off_cb Clicked callback of the "LED OFF" button (optional)
+ * @param screen Output of the labels updated at run time
+ * @return esp_err_t ESP_OK on success, otherwise the error of ui_layout_build()
+ */
+esp_err_t home_panel_screen_create(lv_obj_t *scr, lv_event_cb_t on_cb, lv_event_cb_t off_cb, home_panel_screen_t *screen);
+
+#endif // _HOME_PANEL_SCREEN_H
@@ -1,9 +1,23 @@
 // main.c
+#include <string.h>
 #include "main.h"
-#include "bsp_dht20.h"
-
-/* Log monitor on Panel - For Debug Only */
-static lv_obj_t *s_log_label = NULL;
+#include "sensor_history.h"
+#include "dht20_async.h"
+#include "sensor_sched.h"
+#include "sensor_dht20.h"
+#include "i2c_sched.h"
+#include "log_console.h"
+#include "ui_bind.h"
+#include "home_panel_screen.h"
+#include "lv_perf.h"
+#include "boot_graph.h"
+#include "trace_evt.h"
+#include "sys_profiler.h"
+
+/* Log console on Panel (ui_log() and esp_log output) - For Debug Only */
+#define LOG_VIEW_LINES  6
+static log_console_t *s_log_console = NULL;
+static log_console_view_t *s_log_view = NULL;
 
 /* Status Window */
 static bool s_led_on = false;
@@ -12,6 +26,49 @@ static lv_obj_t *s_led_status_label = NULL;
 /* DHT20 label */
 static lv_obj_t *s_dht20_label = NULL;
 
+/* Label bindings: any task posts values through a ui_cmd queue, the LVGL task redraws once per frame
+ * and only when the shown text changes */
+static ui_bind_group_t *s_ui_bind = NULL;
+static ui_bind_t *s_led_status_bind = NULL;
+static ui_bind_t *s_dht20_bind = NULL;
+
+/* DHT20 measurement state machine (bus released during conversion); probe, calibration and samples go through i2c_sched */
+#define DHT20_I2C_PORT          I2C_NUM_0
+static dht20_async_t *s_dht20 = NULL;
+static QueueHandle_t s_dht20_queue = NULL;
+
+/* Sensor scheduler: one task samples every sensor on its own period, without drift */
+static sensor_sched_t *s_sensor_sched = NULL;
+static sensor_dht20_t *s_dht20_sensor = NULL;
+
+/* I2C bus scheduler (DHT20 transfers and bus counters; the BSP's touch driver uses the bus directly, outside its priorities) */
+static i2c_sched_t *s_i2c_sched = NULL;
+static i2c_sched_device_t *s_dht20_dev = NULL;
+
+/* DHT20 history (temperature and humidity) */
+#define HISTORY_LOG_PERIOD_S    60
+static sensor_history_t *s_temp_history = NULL;
+static sensor_history_t *s_humi_history = NULL;
+
+/* Frame instrumentation (PERF_ENABLE 0 leaves the display driver untouched; set it to 1 to log frame times) */
+#define PERF_ENABLE     0
+#define PERF_OVERLAY    0       // Corner overlay, its own redraws show up in the numbers
+#define PERF_PERIOD_MS  5000
+static lv_perf_t *s_perf = NULL;
+
+/* Event tracing: boot stages, frames and DHT20 samples, printed once as Chrome trace JSON (TRACE_ENABLE 0: no rings).
+ * Off by default: every frame and sample records events; set it to 1 to capture a trace. */
+#define TRACE_ENABLE        0
+#define TRACE_DUMP_AFTER_MS 15000
+static trace_evt_t *s_trace = NULL;
+
+/* Task CPU shares, stack high-water marks and heaps, logged as key=value lines (PROFILER_ENABLE 0: nothing sampled).
+ * Off by default: its timer wakes every period and the log lines crowd the sensor output; set it to 1 when tuning. */
+#define PROFILER_ENABLE     0
+#define PROFILER_DASHBOARD  0   // Task table on the top layer
+#define PROFILER_PERIOD_MS  10000
+static sys_profiler_t *s_profiler = NULL;
+
 /* LDO channel handle */
 static esp_ldo_channel_handle_t ldo3 = NULL;
 static esp_ldo_channel_handle_t ldo4 = NULL;
@@ -19,8 +76,9 @@ static esp_ldo_channel_handle_t ldo4 = NULL;
 /* Forward declarations */
 static void update_led_status_label(void);
 static void update_dht20_value(float temperature, float humidity);
-static void dht20_read_task(void *param);
+static void dht20_on_reading(const sensor_driver_t *driver, const sensor_reading_t *reading, void *arg);
 static void ui_log(const char *msg);
+static void history_log_summary(uint32_t now);
 
 /* -------------------------------------------------------------------------- */
 /* Button callbacks                                                           */
@@ -55,68 +113,34 @@ static void create_led_control_ui(void)
         return;
     }
 
+    /* Screen layout lives in ui/home_panel_layout.json, built by home_panel_screen.c */
     lv_obj_t *scr = lv_scr_act();
-    lv_obj_set_style_bg_color(scr, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, LV_PART_MAIN);
-
-    /* Title */
-    lv_obj_t *label = lv_label_create(scr);
-    lv_label_set_text(label, "HOME Panel Controller");
-    lv_obj_align(label, LV_ALIGN_TOP_MID, 0, 50);
-    lv_obj_set_style_text_font(label, &lv_font_montserrat_24, 0);
-
-    /* LED ON button */
-    lv_obj_t *btn_on = lv_btn_create(scr);
-    lv_obj_set_size(btn_on, 120, 50);
-    lv_obj_align(btn_on, LV_ALIGN_CENTER, 0, -40);
-    lv_obj_add_event_cb(btn_on, btn_on_click_event, LV_EVENT_CLICKED, NULL);
-    lv_obj_t *label_on = lv_label_create(btn_on);
-    lv_label_set_text(label_on, "LED ON");
-
-    /* LED OFF button */
-    lv_obj_t *btn_off = lv_btn_create(scr);
-    lv_obj_set_size(btn_off, 120, 50);
-    lv_obj_align(btn_off, LV_ALIGN_CENTER, 0, 40);
-    lv_obj_add_event_cb(btn_off, btn_off_click_event, LV_EVENT_CLICKED, NULL);
-    lv_obj_t *label_off = lv_label_create(btn_off);
-    lv_label_set_text(label_off, "LED OFF");
-
-    /* Status window */
-    static lv_style_t status_style;
-    static bool status_style_inited = false;
-    if (!status_style_inited) {
-        lv_style_init(&status_style);
-        lv_style_set_border_width(&status_style, 2);
-        lv_style_set_border_color(&status_style, LV_COLOR_BLACK);
-        lv_style_set_border_opa(&status_style, LV_OPA_COVER);
-        lv_style_set_pad_all(&status_style, 8);
-        lv_style_set_bg_opa(&status_style, LV_OPA_TRANSP);
-        status_style_inited = true;
+    home_panel_screen_t screen;
+    if (home_panel_screen_create(scr, btn_on_click_event, btn_off_click_event, &screen) != ESP_OK) {
+        MAIN_ERROR("Home panel layout failed");
+        lvgl_port_unlock();
+        return;
+    }
+    s_led_status_label = screen.led_status_label;
+    s_dht20_label = screen.dht20_label;
+
+    /* Log console at bottom-left */
+    s_log_view = log_console_view_create(s_log_console, scr, LOG_VIEW_LINES, LOG_CONSOLE_VIEW_PERIOD_MS);
+    if (s_log_view) {
+        lv_obj_set_size(s_log_view->cont, 400, LOG_VIEW_LINES * 18 + 16);
+        lv_obj_set_style_pad_all(s_log_view->cont, 8, 0);
+        lv_obj_set_style_text_font(s_log_view->cont, &lv_font_montserrat_14, 0);
+        lv_obj_align(s_log_view->cont, LV_ALIGN_BOTTOM_LEFT, 10, -10);
     }
 
-    lv_obj_t *status_cont = lv_obj_create(scr);
-    lv_obj_add_style(status_cont, &status_style, LV_PART_MAIN);
-    lv_obj_set_size(status_cont, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
-    lv_obj_align(status_cont, LV_ALIGN_BOTTOM_MID, 0, -20);
-
-    s_led_status_label = lv_label_create(status_cont);
-    lv_label_set_text(s_led_status_label, "LED Status: OFF");
-    lv_obj_center(s_led_status_label);
-
-    /* Log label at bottom-left */
-    s_log_label = lv_label_create(scr);
-    lv_obj_set_style_text_font(s_log_label, &lv_font_montserrat_14, 0);
-    lv_obj_set_style_text_color(s_log_label, lv_color_hex(0x000000), 0);
-    lv_label_set_text(s_log_label, "Log: ready");
-    lv_obj_align(s_log_label, LV_ALIGN_BOTTOM_LEFT, 10, -10);
-
-    /* DHT20 label*/
-    s_dht20_label = lv_label_create(scr);
-    lv_obj_set_style_text_font(s_dht20_label, &lv_font_montserrat_20, 0);
-    lv_obj_set_style_text_color(s_dht20_label, lv_color_hex(0x000000), 0);
-    lv_label_set_text(s_dht20_label,
-                      "Temperature = 0.0 C  Humidity = 0.0 %");
-    lv_obj_align(s_dht20_label, LV_ALIGN_CENTER, 0, -150);
+    s_ui_bind = ui_bind_group_create();
+    if (!s_ui_bind) {
+        MAIN_ERROR("UI binding group creation failed");
+    }
+    s_led_status_bind = ui_bind_bool(s_ui_bind, s_led_status_label, "LED Status: ON", "LED Status: OFF");
+    s_dht20_bind = ui_bind_float(s_ui_bind, s_dht20_label,
+                                 "Temperature = %.1f C  Humidity = %.1f %%", 1, 2,
+                                 "dht20 read data error");
 
     lvgl_port_unlock();
 }
@@ -127,33 +151,35 @@ static void create_led_control_ui(void)
 
 static void update_led_status_label(void)
 {
-    if (!s_led_status_label) return;
-
-    if (s_led_on) {
-        lv_label_set_text(s_led_status_label, "LED Status: ON");
-    } else {
-        lv_label_set_text(s_led_status_label, "LED Status: OFF");
-    }
+    ui_bind_set_bool(s_led_status_bind, s_led_on);
 }
 
 static void update_dht20_value(float temperature, float humidity)
 {
-    if (!s_dht20_label) return;
-
-    char buffer[64];
-    snprintf(buffer, sizeof(buffer),
-             "Temperature = %.1f C  Humidity = %.1f %%",
-             temperature, humidity);  // note the double %%
-    lv_label_set_text(s_dht20_label, buffer);
+    /* Redrawn only when the value changes at the shown precision */
+    ui_bind_set_float2(s_dht20_bind, temperature, humidity);
 }
 
 static void ui_log(const char *msg)
 {
-    if (!s_log_label) return;
+    /* Never blocks: the log view picks it up on its next refresh */
+    log_console_write(s_log_console, msg, strlen(msg));
+}
+
+static uint32_t history_now(void)
+{
+    return (uint32_t)(esp_timer_get_time() / 1000000);
+}
 
-    if (lvgl_port_lock(0)) {
-        lv_label_set_text(s_log_label, msg);
-        lvgl_port_unlock();
+static void history_log_summary(uint32_t now)
+{
+    sensor_history_point_t temp, humi;
+    uint32_t from = now > 3600 ? now - 3600 : 0;
+
+    if (sensor_history_summary(s_temp_history, from, now, &temp) &&
+        sensor_history_summary(s_humi_history, from, now, &humi)) {
+        MAIN_INFO("Last hour: T min %.1f max %.1f avg %.1f C, H min %.1f max %.1f avg %.1f %%",
+                  temp.min, temp.max, temp.avg, humi.min, humi.max, humi.avg);
     }
 }
 
@@ -170,124 +196,298 @@ static void init_fail_handler(const char *module_name, esp_err_t err)
 }
 
 /* -------------------------------------------------------------------------- */
-/* System init                                                                */
+/* Boot stages                                                                */
 /* -------------------------------------------------------------------------- */
 
-static void system_init(void)
+static esp_err_t boot_ldo(void *ctx)
 {
+    (void)ctx;
     esp_err_t err = ESP_OK;
-
-    /* 1. LDOs */
     esp_ldo_channel_config_t ldo3_cof = {
         .chan_id = 3,
         .voltage_mv = 2500,
     };
-    err = esp_ldo_acquire_channel(&ldo3_cof, &ldo3);
-    if (err != ESP_OK) init_fail_handler("ldo3", err);
+    if (!ldo3 && (err = esp_ldo_acquire_channel(&ldo3_cof, &ldo3)) != ESP_OK) return err;
 
     esp_ldo_channel_config_t ldo4_cof = {
         .chan_id = 4,
         .voltage_mv = 3300,
     };
-    err = esp_ldo_acquire_channel(&ldo4_cof, &ldo4);
-    if (err != ESP_OK) init_fail_handler("ldo4", err);
+    if (!ldo4 && (err = esp_ldo_acquire_channel(&ldo4_cof, &ldo4)) != ESP_OK) return err;
     ui_log("LDO3 and LDO4 init success");
+    return ESP_OK;
+}
+
+static esp_err_t boot_i2c(void *ctx)
+{
+    (void)ctx;
+    esp_err_t err = i2c_init();
+    if (err == ESP_OK) ui_log("I2C init success");
+    return err;
+}
+
+static esp_err_t boot_touch(void *ctx)
+{
+    (void)ctx;
+    esp_err_t err = touch_init();
+    if (err == ESP_OK) ui_log("Touch panel init success");
+    return err;
+}
 
-    /* 2. I2C */
-    ui_log("Initializing I2C...");
-    err = i2c_init();
-    if (err != ESP_OK) init_fail_handler("I2C", err);
-    ui_log("I2C init success");
-
-    /* 3. Touch */
-    ui_log("Initializing touch panel...");
-    err = touch_init();
-    if (err != ESP_OK) init_fail_handler("Touch", err);
-    ui_log("Touch panel init success");
-
-    /* 4. DHT20 sensor */
-    ui_log("Initializing DHT20 sensor...");
-    err = dht20_begin();
-    if (err != ESP_OK) init_fail_handler("DHT20", err);
-    ui_log("DHT20 init success");
-
-    /* 5. Display + LVGL */
-    err = display_init();
-    if (err != ESP_OK) init_fail_handler("LCD", err);
+static esp_err_t boot_dht20_async(void *ctx)
+{
+    (void)ctx;
+    i2c_master_bus_handle_t i2c_bus = NULL;
+    esp_err_t err = i2c_master_get_bus_handle(DHT20_I2C_PORT, &i2c_bus);
+    if (err != ESP_OK) return err;
+    const i2c_sched_config_t sched_config = I2C_SCHED_DEFAULT_CONFIG();
+    s_i2c_sched = i2c_sched_create(&sched_config);
+    if (!s_i2c_sched) return ESP_FAIL;
+
+    const i2c_device_config_t dht20_dev_config = {
+        .dev_addr_length = I2C_ADDR_BIT_LEN_7,
+        .device_address = DHT20_ASYNC_ADDRESS,
+        .scl_speed_hz = DHT20_ASYNC_I2C_SPEED_HZ,
+    };
+    i2c_master_dev_handle_t dht20_i2c_dev = NULL;
+    err = i2c_master_bus_add_device(i2c_bus, &dht20_dev_config, &dht20_i2c_dev);
+    if (err != ESP_OK) return err;
+    s_dht20_dev = i2c_sched_add_device(s_i2c_sched, "dht20", dht20_i2c_dev, I2C_SCHED_PRIO_NORMAL);
+    if (!s_dht20_dev) return ESP_ERR_NO_MEM;
+
+    s_dht20_queue = xQueueCreate(1, sizeof(dht20_async_result_t));
+    if (!s_dht20_queue) return ESP_ERR_NO_MEM;
+    dht20_async_config_t dht20_config = {
+        .transport = {
+            .write = i2c_sched_write,
+            .read = i2c_sched_read,
+            .ctx = s_dht20_dev,
+        },
+        .queue = s_dht20_queue,
+    };
+    s_dht20 = dht20_async_create(&dht20_config);
+    return s_dht20 ? ESP_OK : ESP_FAIL;
+}
+
+/* The sensor may still be powering up: this stage is retried */
+static esp_err_t boot_dht20(void *ctx)
+{
+    (void)ctx;
+    esp_err_t err = dht20_async_init(s_dht20);
+    if (err == ESP_OK) ui_log("DHT20 init success");
+    return err;
+}
+
+static esp_err_t boot_display(void *ctx)
+{
+    (void)ctx;
+    esp_err_t err = display_init();
+    if (err != ESP_OK) return err;
     ui_log("LCD init success");
 
-    /* 6. Backlight */
-    err = set_lcd_blight(100);
-    if (err != ESP_OK) init_fail_handler("LCD Backlight", err);
-    ui_log("LCD backlight opened (100)");
+    if (lvgl_port_lock(0)) {
+        lv_perf_config_t perf_config = LV_PERF_DEFAULT_CONFIG();
+        perf_config.period_ms = PERF_PERIOD_MS;
+        perf_config.overlay = PERF_OVERLAY;
+        s_perf = lv_perf_create(&perf_config);
+        lv_perf_enable(s_perf, PERF_ENABLE);
+        if (PROFILER_ENABLE) {
+            sys_profiler_config_t profiler_config = SYS_PROFILER_DEFAULT_CONFIG();
+            profiler_config.period_ms = PROFILER_PERIOD_MS;
+            profiler_config.dashboard = PROFILER_DASHBOARD;
+            s_profiler = sys_profiler_create(&profiler_config);
+        }
+        lvgl_port_unlock();
+    }
+    return ESP_OK;
+}
+
+static esp_err_t boot_backlight(void *ctx)
+{
+    (void)ctx;
+    esp_err_t err = set_lcd_blight(100);
+    if (err == ESP_OK) ui_log("LCD backlight opened (100)");
+    return err;
+}
 
-    /* 7. LED GPIO */
-    ui_log("Initializing GPIO48 for LED...");
-    err = gpio_extra_init();
-    if (err != ESP_OK) init_fail_handler("GPIO48", err);
+static esp_err_t boot_led(void *ctx)
+{
+    (void)ctx;
+    esp_err_t err = gpio_extra_init();
+    if (err != ESP_OK) return err;
     gpio_extra_set_level(false);
     s_led_on = false;
     ui_log("LED initialized to OFF");
+    return ESP_OK;
+}
 
-    /* 8. UI */
+static esp_err_t boot_ui(void *ctx)
+{
+    (void)ctx;
     create_led_control_ui();
     ui_log("UI created");
     update_led_status_label();
+    return ESP_OK;
+}
+
+static esp_err_t boot_history(void *ctx)
+{
+    (void)ctx;
+    const sensor_history_tier_config_t tiers[] = SENSOR_HISTORY_DEFAULT_TIERS();
+    s_temp_history = sensor_history_create(tiers, sizeof(tiers) / sizeof(tiers[0]));
+    s_humi_history = sensor_history_create(tiers, sizeof(tiers) / sizeof(tiers[0]));
+    if (!s_temp_history || !s_humi_history) return ESP_ERR_NO_MEM;
+    ui_log("DHT20 history created");
+    return ESP_OK;
+}
+
+/* Before every trigger: one status read, the calibration is reloaded only if the sensor lost it */
+static esp_err_t dht20_ensure_ready(void)
+{
+    esp_err_t err = dht20_async_init(s_dht20);
+    if (err != ESP_OK) MAIN_ERROR("dht20 init again failed: %s", esp_err_to_name(err));
+    return err;
+}
 
-    /* 9. DHT20 task */
-    xTaskCreate(dht20_read_task,
-                "dht20_task",
-                4096,
-                NULL,
-                configMAX_PRIORITIES - 5,
-                NULL);
-    ui_log("DHT20 task started");
+static esp_err_t boot_sensors(void *ctx)
+{
+    (void)ctx;
+    sensor_dht20_config_t dht20_config = SENSOR_DHT20_DEFAULT_CONFIG();
+    dht20_config.dht = s_dht20;
+    dht20_config.queue = s_dht20_queue;
+    dht20_config.ensure_ready = dht20_ensure_ready;
+    s_dht20_sensor = sensor_dht20_create(&dht20_config);
+    if (!s_dht20_sensor) return ESP_ERR_NO_MEM;
+
+    const sensor_sched_config_t sched_config = SENSOR_SCHED_DEFAULT_CONFIG();
+    s_sensor_sched = sensor_sched_create(&sched_config);
+    if (!s_sensor_sched) return ESP_ERR_NO_MEM;
+    if (sensor_sched_add(s_sensor_sched, &s_dht20_sensor->driver, s_dht20_sensor, dht20_on_reading, NULL) < 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t err = sensor_sched_start(s_sensor_sched);
+    if (err == ESP_OK) ui_log("Sensor scheduler started");
+    return err;
 }
 
 /* -------------------------------------------------------------------------- */
-/* DHT20 task                                                                 */
+/* System init                                                                */
 /* -------------------------------------------------------------------------- */
 
-static void dht20_read_task(void *param)
+/* Each stage starts as soon as the stages it lists have succeeded: the DHT20
+   probe runs while the display comes up. Without a sensor the panel still boots. */
+enum {
+    STAGE_LDO = 0,
+    STAGE_I2C,
+    STAGE_TOUCH,
+    STAGE_DHT20_ASYNC,
+    STAGE_DHT20,
+    STAGE_DISPLAY,
+    STAGE_BACKLIGHT,
+    STAGE_LED,
+    STAGE_UI,
+    STAGE_HISTORY,
+    STAGE_SENSORS,
+};
+
+static const boot_stage_t s_boot_stages[] = {
+    [STAGE_LDO]         = {.name = "ldo", .init = boot_ldo},
+    [STAGE_I2C]         = {.name = "i2c", .init = boot_i2c},
+    [STAGE_TOUCH]       = {.name = "touch", .init = boot_touch, .deps = BOOT_DEP(STAGE_LDO) | BOOT_DEP(STAGE_I2C)},
+    [STAGE_DHT20_ASYNC] = {.name = "dht20_async", .init = boot_dht20_async,
+                           .deps = BOOT_DEP(STAGE_LDO) | BOOT_DEP(STAGE_I2C), .optional = true},
+    [STAGE_DHT20]       = {.name = "dht20", .init = boot_dht20, .deps = BOOT_DEP(STAGE_DHT20_ASYNC),
+                           .retries = 3, .retry_delay_ms = 100, .optional = true},
+    [STAGE_DISPLAY]     = {.name = "display", .init = boot_display, .deps = BOOT_DEP(STAGE_LDO) | BOOT_DEP(STAGE_TOUCH),
+                           .stack_size = 6144},
+    [STAGE_BACKLIGHT]   = {.name = "backlight", .init = boot_backlight, .deps = BOOT_DEP(STAGE_DISPLAY)},
+    [STAGE_LED]         = {.name = "led", .init = boot_led, .deps = BOOT_DEP(STAGE_LDO)},
+    [STAGE_UI]          = {.name = "ui", .init = boot_ui, .deps = BOOT_DEP(STAGE_DISPLAY) | BOOT_DEP(STAGE_LED)},
+    [STAGE_HISTORY]     = {.name = "history", .init = boot_history},
+    [STAGE_SENSORS]     = {.name = "sensors", .init = boot_sensors, .optional = true,
+                           .deps = BOOT_DEP(STAGE_DHT20) | BOOT_DEP(STAGE_HISTORY) | BOOT_DEP(STAGE_UI)},
+};
+
+static void system_init(void)
 {
-    (void)param;
-    dht20_data_t measurements;
+    /* Log console first: it keeps boot messages until the view exists */
+    s_log_console = log_console_create();
+    if (s_log_console) {
+        log_console_install_hook(s_log_console);
+    }
+    if (TRACE_ENABLE) {
+        trace_evt_config_t trace_config = TRACE_EVT_DEFAULT_CONFIG();
+        s_trace = trace_evt_create(&trace_config);
+    }
 
-    while (1) {
-        if (dht20_is_calibrated() != ESP_OK) {
-            ui_log("DHT20 not calibrated, reinit...");
-            if (dht20_begin() != ESP_OK) {
-                MAIN_ERROR("dht20 init again failed");
-                vTaskDelay(pdMS_TO_TICKS(100));
-                continue;
-            }
-        }
+    boot_graph_config_t boot_config = BOOT_GRAPH_DEFAULT_CONFIG();
+    boot_graph_t *boot = boot_graph_create(&boot_config);
+    if (!boot) init_fail_handler("Boot graph", ESP_ERR_NO_MEM);
+    for (size_t i = 0; i < sizeof(s_boot_stages) / sizeof(s_boot_stages[0]); i++) {
+        if (boot_graph_add(boot, &s_boot_stages[i]) != (int)i) init_fail_handler(s_boot_stages[i].name, ESP_ERR_INVALID_ARG);
+    }
 
-        if (dht20_read_data(&measurements) != ESP_OK) {
-            MAIN_ERROR("dht20 read data error");
-            if (lvgl_port_lock(0)) {
-                if (s_dht20_label) {
-                    lv_label_set_text(s_dht20_label,
-                                      "dht20 read data error");
-                }
-                lvgl_port_unlock();
-            }
-            ui_log("DHT20 read error");
-        } else {
-            if (lvgl_port_lock(0)) {
-                update_dht20_value(measurements.temperature,
-                                   measurements.humidity);
-                lvgl_port_unlock();
-            }
-
-            char msg[64];
-            snprintf(msg, sizeof(msg), "T=%.1fC H=%.1f%%",
-                     measurements.temperature, measurements.humidity);
-            ui_log(msg);
-        }
+    esp_err_t err = boot_graph_run(boot);
+    boot_graph_log_report(boot);
+    if (err != ESP_OK) {
+        const boot_graph_report_t *report = boot_graph_get_report(boot);
+        init_fail_handler(report->failed >= 0 ? s_boot_stages[report->failed].name : "boot", err);
+    }
+}
 
-        vTaskDelay(pdMS_TO_TICKS(1000));
+/* -------------------------------------------------------------------------- */
+/* DHT20 readings                                                             */
+/* -------------------------------------------------------------------------- */
+
+/* Runs in the sensor scheduler task, once per sample */
+static void dht20_on_reading(const sensor_driver_t *driver, const sensor_reading_t *reading, void *arg)
+{
+    (void)driver;
+    (void)arg;
+    static uint32_t last_summary = 0;
+
+    if (reading->err != ESP_OK) {
+        TRACE_INSTANT("dht20", "error");
+        MAIN_ERROR("dht20 read data error");
+        ui_bind_set_invalid(s_dht20_bind);
+        ui_log("DHT20 read error");
+        return;
+    }
+    float temperature = reading->values[SENSOR_DHT20_TEMPERATURE];
+    float humidity = reading->values[SENSOR_DHT20_HUMIDITY];
+    uint32_t now = history_now();
+    sensor_history_add(s_temp_history, now, temperature);
+    sensor_history_add(s_humi_history, now, humidity);
+    if (now - last_summary >= HISTORY_LOG_PERIOD_S) {
+        history_log_summary(now);
+        dht20_async_stats_t stats;
+        dht20_async_get_stats(s_dht20, &stats);
+        MAIN_INFO("DHT20 bus hold: last %lu us, avg %lu us/sample (%lu samples, %lu busy retries)",
+                  (unsigned long)stats.last_bus_hold_us,
+                  (unsigned long)(stats.samples ? stats.bus_hold_us_total / stats.samples : 0),
+                  (unsigned long)stats.samples, (unsigned long)stats.busy_retries);
+        i2c_sched_device_stats_t bus_stats;
+        i2c_sched_get_device_stats(s_dht20_dev, &bus_stats);
+        MAIN_INFO("I2C bus: %.2f%% busy, dht20 wait avg %lu us max %lu us",
+                  i2c_sched_get_utilization(s_i2c_sched),
+                  (unsigned long)(bus_stats.transfers ? bus_stats.wait_us_total / bus_stats.transfers : 0),
+                  (unsigned long)bus_stats.wait_us_max);
+        ui_bind_stats_t bind_stats = {0};
+        ui_bind_get_stats(s_ui_bind, &bind_stats);
+        MAIN_INFO("UI bindings: %lu sets, %lu dropped, %lu redraws, %lu avoided, drain max %lu us",
+                  (unsigned long)bind_stats.sets, (unsigned long)bind_stats.dropped,
+                  (unsigned long)bind_stats.redraws,
+                  (unsigned long)(bind_stats.unchanged + bind_stats.coalesced + bind_stats.same_text),
+                  (unsigned long)bind_stats.drain_us_max);
+        sensor_sched_log_stats(s_sensor_sched);
+        last_summary = now;
     }
+
+    update_dht20_value(temperature, humidity);
+
+    char msg[64];
+    snprintf(msg, sizeof(msg), "T=%.1fC H=%.1f%%", temperature, humidity);
+    ui_log(msg);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -300,6 +500,12 @@ void app_main(void)
     system_init();
     MAIN_INFO("System initialized");
 
+    if (s_trace) {
+        /* Boot plus the first samples and frames; copy the lines between the markers into a .json file */
+        vTaskDelay(pdMS_TO_TICKS(TRACE_DUMP_AFTER_MS));
+        trace_evt_dump(s_trace);
+    }
+
     while (1) {
         vTaskDelay(pdMS_TO_TICKS(1000));
     }
@@ -0,0 +1,54 @@
+// Generated by idf-files/tools/ui_layout.py from home_panel_layout.json, do not edit
+#include "home_panel_layout.h"
+
+static const lv_style_const_prop_t home_panel_layout_screen_props[] = {
+    LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(0xFF, 0xFF, 0xFF)),
+    LV_STYLE_CONST_BG_OPA(LV_OPA_COVER),
+    LV_STYLE_PROP_INV,
+};
+static LV_STYLE_CONST_INIT(home_panel_layout_screen, home_panel_layout_screen_props);
+
+static const lv_style_const_prop_t home_panel_layout_title_props[] = {
+    LV_STYLE_CONST_TEXT_FONT(&lv_font_montserrat_24),
+    LV_STYLE_PROP_INV,
+};
+static LV_STYLE_CONST_INIT(home_panel_layout_title, home_panel_layout_title_props);
+
+static const lv_style_const_prop_t home_panel_layout_status_props[] = {
+    LV_STYLE_CONST_BORDER_WIDTH(2),
+    LV_STYLE_CONST_BORDER_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+    LV_STYLE_CONST_BORDER_OPA(LV_OPA_COVER),
+    LV_STYLE_CONST_PAD_TOP(8),
+    LV_STYLE_CONST_PAD_BOTTOM(8),
+    LV_STYLE_CONST_PAD_LEFT(8),
+    LV_STYLE_CONST_PAD_RIGHT(8),
+    LV_STYLE_CONST_BG_OPA(LV_OPA_TRANSP),
+    LV_STYLE_PROP_INV,
+};
+static LV_STYLE_CONST_INIT(home_panel_layout_status, home_panel_layout_status_props);
+
+static const lv_style_const_prop_t home_panel_layout_dht20_props[] = {
+    LV_STYLE_CONST_TEXT_FONT(&lv_font_montserrat_20),
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+    LV_STYLE_PROP_INV,
+};
+static LV_STYLE_CONST_INIT(home_panel_layout_dht20, home_panel_layout_dht20_props);
+
+// type, parent, align_to, align, x, y, w, h, style, text
+static const ui_layout_obj_t home_panel_layout_objs[] = {
+    {UI_LAYOUT_LABEL, UI_LAYOUT_ROOT, UI_LAYOUT_ROOT, LV_ALIGN_TOP_MID, 0, 50, 0, 0, &home_panel_layout_title, "HOME Panel Controller"},  // title
+    {UI_LAYOUT_BTN, UI_LAYOUT_ROOT, UI_LAYOUT_ROOT, LV_ALIGN_CENTER, 0, -40, 120, 50, NULL, NULL},  // btn_on
+    {UI_LAYOUT_LABEL, 1, UI_LAYOUT_ROOT, LV_ALIGN_DEFAULT, 0, 0, 0, 0, NULL, "LED ON"},
+    {UI_LAYOUT_BTN, UI_LAYOUT_ROOT, UI_LAYOUT_ROOT, LV_ALIGN_CENTER, 0, 40, 120, 50, NULL, NULL},  // btn_off
+    {UI_LAYOUT_LABEL, 3, UI_LAYOUT_ROOT, LV_ALIGN_DEFAULT, 0, 0, 0, 0, NULL, "LED OFF"},
+    {UI_LAYOUT_OBJ, UI_LAYOUT_ROOT, UI_LAYOUT_ROOT, LV_ALIGN_BOTTOM_MID, 0, -20, LV_SIZE_CONTENT, LV_SIZE_CONTENT, &home_panel_layout_status, NULL},  // status_frame
+    {UI_LAYOUT_LABEL, 5, UI_LAYOUT_ROOT, LV_ALIGN_CENTER, 0, 0, 0, 0, NULL, "LED Status: OFF"},  // status
+    {UI_LAYOUT_LABEL, UI_LAYOUT_ROOT, UI_LAYOUT_ROOT, LV_ALIGN_CENTER, 0, -150, 0, 0, &home_panel_layout_dht20, "Temperature = 0.0 C  Humidity = 0.0 %"},  // dht20
+};
+
+const ui_layout_t home_panel_layout = {
+    .name = "home_panel_layout",
+    .root_style = &home_panel_layout_screen,
+    .objs = home_panel_layout_objs,
+    .count = sizeof(home_panel_layout_objs) / sizeof(home_panel_layout_objs[0]),
+};
@@ -0,0 +1,17 @@
+// Generated by idf-files/tools/ui_layout.py from home_panel_layout.json, do not edit
+#ifndef _HOME_PANEL_LAYOUT_H
+#define _HOME_PANEL_LAYOUT_H
+
+#include "ui_layout.h"
+
+#define HOME_PANEL_LAYOUT_TITLE 0
+#define HOME_PANEL_LAYOUT_BTN_ON 1
+#define HOME_PANEL_LAYOUT_BTN_OFF 3
+#define HOME_PANEL_LAYOUT_STATUS_FRAME 5
+#define HOME_PANEL_LAYOUT_STATUS 6
+#define HOME_PANEL_LAYOUT_DHT20 7
+#define HOME_PANEL_LAYOUT_COUNT 8
+
+UI_LAYOUT_DECLARE(home_panel_layout);
+
+#endif // _HOME_PANEL_LAYOUT_H
@@ -0,0 +1,84 @@
+
+#ifndef _JSON_STREAM_H
+#define _JSON_STREAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+
+// Parser limits (all state lives inside json_stream_t, no heap is used)
+#define JSON_STREAM_MAX_DEPTH   8     // Maximum nesting of objects/arrays
+#define JSON_STREAM_PATH_MAX    64    // Maximum length of a dotted key path
+
+
+// Called for every scalar matching a streaming field (value is NUL terminated)
+typedef void (*json_stream_value_cb_t)(const char *value, size_t len, void *arg);
+
+// One key path to extract, e.g. "data.temp"
+// Arrays are transparent in paths: "weather.description" matches the
+// "description" member of the first object inside the "weather" array,
+// and "hourly.temperature_2m" matches every element of that array.
+typedef struct {
+    const char *path;     // Dotted key path to match
+    char *value;          // Output buffer for the raw scalar text (strings are unescaped)
+    size_t value_size;    // Size of the output buffer, including the terminator
+    bool found;           // Set once the first matching scalar has been captured
+    json_stream_value_cb_t on_value;  // Optional: stream every match through this callback instead
+    void *arg;            // Passed to on_value
+} json_stream_field_t;
+
+typedef struct {
+    json_stream_field_t *fields;   // Fields to extract
+    size_t field_count;            // Number of fields
+    size_t found_count;            // Number of fields already captured
+
+    uint8_t state;                 // Tokenizer state
+    uint8_t depth;                 // Current container depth
+    uint8_t string_is_key;         // The string being scanned is an object key
+    uint8_t unicode_left;          // Remaining hex digits of a \uXXXX escape
+    uint16_t unicode_value;        // Accumulated \uXXXX code unit
+    uint32_t array_mask;           // Bit n set: container at depth n is an array
+    uint8_t key_start[JSON_STREAM_MAX_DEPTH + 1]; // Path length before the member key at each depth
+    uint8_t overflow_depth;        // Depth of the key that did not fit into path[], 0 if none
+
+    char path[JSON_STREAM_PATH_MAX];   // Dotted path of the current member
+    uint8_t path_len;
+
+    json_stream_field_t *capture;  // Field receiving the current scalar, if any
+    size_t capture_len;
+} json_stream_t;
+
+
+/**
+ * @brief Initialize a streaming extractor
+ * @param parser Parser instance
+ * @param fields Fields to extract (their found flags are cleared)
+ * @param field_count Number of fields
+ */
+void json_stream_init(json_stream_t *parser, json_stream_field_t *fields, size_t field_count);
+
+/**
+ * @brief Reset the parser state and the found flags to parse a new document
+ * @param parser Parser instance
+ */
+void json_stream_reset(json_stream_t *parser);
+
+/**
+ * @brief Feed the next chunk of the JSON document
+ * @param parser Parser instance
+ * @param data Chunk data (not NUL terminated)
+ * @param len Chunk length
+ * @return bool Returns false if the document is malformed or nested too deep
+ */
+bool json_stream_feed(json_stream_t *parser, const char *data, size_t len);
+
+/**
+ * @brief Check whether every configured field has been captured
+ * (never true while streaming fields with on_value are configured)
+ * @param parser Parser instance
+ * @return bool Returns true when all fields were found
+ */
+bool json_stream_complete(const json_stream_t *parser);
+
+#endif // _JSON_STREAM_H
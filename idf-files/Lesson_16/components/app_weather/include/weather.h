@@ -7,18 +7,71 @@
 #include <stdlib.h> // For malloc/free
 #include <stdbool.h> // For bool type
 
+#include "json_stream.h"
+#include "weather_provider.h"
+#include "weather_forecast.h"
+#include "weather_async.h"
 
-// Define JSON buffer size and URL
-#define JSON_BUFFER_SIZE    256
-#define WEATHER_JSON_URL    "http://service.thinknode.cc/api/users/weather"
-// #define WEATHER_JSON_URL    "https://api.openweathermap.org/data/2.5/weather?q=Rio%20de%20Janeiro,BR&units=metric&appid=TOKEN"
-// Rio de Janeiro coords, metric units, current weather only
-// #define WEATHER_JSON_URL  "https://api.open-meteo.com/v1/forecast?latitude=-22.90&longitude=-43.20&current=temperature_2m"
 
+// The backend (URL, key paths, conversions) is selected in menuconfig,
+// see weather_provider.h
+
+// Size of the weather description buffer passed to weather_get_weather()
+#define WEATHER_TEXT_SIZE   64
+
+// HTTP session settings
+#define WEATHER_HTTP_TIMEOUT_MS     10000
+#define WEATHER_ETAG_SIZE           64    // Buffer for the ETag validator
+#define WEATHER_DATE_SIZE           40    // Buffer for the Last-Modified validator (RFC 1123 date)
+
+// Indexes into weather_t::fields
+enum {
+    WEATHER_FIELD_TEMP = 0,
+    WEATHER_FIELD_TEXT,
+    WEATHER_FIELD_TIMESTAMP,
+    WEATHER_FIELD_COUNT,
+};
+
+
+// Session counters, see weather_get_stats()
+typedef struct {
+    uint32_t requests;          // Requests sent (retries included)
+    uint32_t connections;       // TCP connections opened
+    uint32_t reused;            // Requests served over an already open connection
+    uint32_t not_modified;      // 304 responses (parsing skipped)
+    uint32_t failures;          // Requests that failed after the reconnect attempt
+    int64_t last_latency_us;    // Wall time of the last request
+    int64_t last_connect_us;    // DNS + TCP connect + TLS handshake time of the last new connection
+    int64_t connect_us_total;   // Sum over all new connections (average = total / connections)
+} weather_stats_t;
 
 // “Object” handle in C language
 typedef struct {
-    char *json_response;  // Buffer to store JSON response
+    const weather_provider_t *provider;             // Backend descriptor (WEATHER_PROVIDER)
+    struct esp_http_client *client;                 // Long-lived keep-alive client (esp_http_client_handle_t)
+    bool request_connected;                         // A new connection was opened by the current request
+    int64_t request_start_us;                       // Start of the current request
+    int64_t response_start_us;                      // First response header of the current request, 0 before
+
+    char etag[WEATHER_ETAG_SIZE];                   // Validators of the last accepted response
+    char last_modified[WEATHER_DATE_SIZE];
+    char pending_etag[WEATHER_ETAG_SIZE];           // Validators of the response in flight
+    char pending_last_modified[WEATHER_DATE_SIZE];
+
+    bool has_result;                                // Last decoded result, returned again on 304
+    double temp_c;
+    char weather_text[WEATHER_TEXT_SIZE];
+    int timestamp;
+
+    weather_stats_t stats;
+    weather_async_t *async;                         // Engine of weather_get_weather_and_forecast(), created on first use
+
+    json_stream_t parser;                           // Streaming extractor of the current weather
+    json_stream_t *active_parser;                   // Parser fed from HTTP_EVENT_ON_DATA
+    json_stream_field_t fields[WEATHER_FIELD_COUNT];
+    char temp_value[24];                            // Raw scalar text of each field
+    char text_value[WEATHER_TEXT_SIZE];
+    char timestamp_value[24];
 } weather_t;
 
 
@@ -28,6 +81,13 @@ typedef struct {
  */
 weather_t* weather_create(void);
 
+/**
+ * @brief Create a Weather module instance for a given backend (e.g. a local test server)
+ * @param provider Backend descriptor, must outlive the instance
+ * @return weather_t* Returns a pointer to the instance on success, NULL on failure
+ */
+weather_t* weather_create_with_provider(const weather_provider_t *provider);
+
 /**
  * @brief Release resources occupied by the Weather module instance
  * @param weather Pointer to the instance to be destroyed
@@ -36,12 +96,53 @@ void weather_destroy(weather_t* weather);
 
 /**
  * @brief Main function to get weather information
+ *
+ * The request reuses the instance's keep-alive connection and is sent with
+ * If-None-Match/If-Modified-Since; a 304 answer returns the previous result
+ * without parsing.
  * @param weather Instance pointer
  * @param temp_c Temperature output pointer (double*)
- * @param weather_text Weather description output buffer (char*)
+ * @param weather_text Weather description output buffer (char*, at least WEATHER_TEXT_SIZE bytes)
  * @param timestamp Timestamp output pointer (int*)
  * @return bool Returns true (1) on success, false (0) on failure
  */
 bool weather_get_weather(weather_t* weather, double *temp_c, char *weather_text, int *timestamp);
 
+/**
+ * @brief Fetch the provider's forecast timeline over the same session
+ *
+ * Array elements are streamed straight into the struct-of-arrays buffers;
+ * readers can follow the published count while the body is still arriving.
+ * @param weather Instance pointer
+ * @param forecast Timeline to fill (restarted by this call)
+ * @return bool Returns false on failure or if the provider has no forecast
+ */
+bool weather_get_forecast(weather_t* weather, weather_forecast_t *forecast);
+
+/**
+ * @brief Fetch the current weather and the forecast with both requests in flight at once
+ *
+ * The requests run on the instance's async engine, each over its own connection,
+ * so the wait is that of the slower one instead of the sum. esp_http_client only
+ * supports async requests over HTTPS: for a plain HTTP provider (the thinknode
+ * default) or one without a forecast, this falls back to weather_get_weather()
+ * followed by weather_get_forecast() over the keep-alive session.
+ * @param weather Instance pointer
+ * @param forecast Timeline to fill (restarted by this call)
+ * @param temp_c Temperature output pointer (double*)
+ * @param weather_text Weather description output buffer (char*, at least WEATHER_TEXT_SIZE bytes)
+ * @param timestamp Timestamp output pointer (int*)
+ * @param forecast_ok Set when the forecast was fetched
+ * @return bool Returns true (1) if the current weather was fetched, false (0) on failure
+ */
+bool weather_get_weather_and_forecast(weather_t* weather, weather_forecast_t *forecast,
+                                      double *temp_c, char *weather_text, int *timestamp, bool *forecast_ok);
+
+/**
+ * @brief Get the HTTP session counters
+ * @param weather Instance pointer
+ * @param stats Counters output pointer
+ */
+void weather_get_stats(const weather_t* weather, weather_stats_t *stats);
+
 #endif // _WEATHER_H
@@ -0,0 +1,92 @@
+
+#ifndef _WEATHER_ASYNC_H
+#define _WEATHER_ASYNC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <esp_err.h>
+
+
+// Engine limits
+#define WEATHER_ASYNC_MAX_REQUESTS      4     // Requests in flight per engine
+#define WEATHER_ASYNC_IO_TIMEOUT_MS     10    // Socket wait per poll step before yielding to the next request
+
+
+// Body chunk callback, e.g. a wrapper around json_stream_feed()
+typedef void (*weather_async_data_cb_t)(const char *data, int len, void *arg);
+
+// Response header callback, e.g. to keep the ETag of the response
+typedef void (*weather_async_header_cb_t)(const char *key, const char *value, void *arg);
+
+// Completion callback: err is ESP_OK with the HTTP status, ESP_ERR_TIMEOUT on deadline, or the client error
+typedef void (*weather_async_done_cb_t)(esp_err_t err, int status, void *arg);
+
+// esp_http_client only implements is_async over TLS: the URL must be https://
+typedef struct {
+    const char *url;
+    const char *cert_pem;               // Optional server certificate (PEM), NULL verifies against the CA bundle
+    const char *if_none_match;          // Optional validators of a conditional request
+    const char *if_modified_since;
+    uint32_t timeout_ms;                // Deadline for the whole request
+    weather_async_header_cb_t on_header; // Optional
+    weather_async_data_cb_t on_data;    // Optional
+    weather_async_done_cb_t on_done;    // Optional
+    void *arg;                          // Passed to every callback
+} weather_async_request_t;
+
+// One request in flight
+typedef struct {
+    struct esp_http_client *client;     // Non-blocking client (esp_http_client_handle_t)
+    weather_async_request_t request;
+    int64_t deadline_us;
+    bool active;
+} weather_async_slot_t;
+
+// Engine: multiplexes several requests from a single task
+typedef struct {
+    weather_async_slot_t slots[WEATHER_ASYNC_MAX_REQUESTS];
+    uint32_t active_count;
+} weather_async_t;
+
+
+/**
+ * @brief Create an async fetch engine
+ * @return weather_async_t* Returns a pointer to the instance on success, NULL on failure
+ */
+weather_async_t* weather_async_create(void);
+
+/**
+ * @brief Abort pending requests (without callbacks) and release the engine
+ * @param engine Instance pointer
+ */
+void weather_async_destroy(weather_async_t *engine);
+
+/**
+ * @brief Check whether a URL can be fetched by the engine (HTTPS only)
+ * @param url Request URL
+ * @return bool Returns false for plain HTTP, which must use a blocking client
+ */
+bool weather_async_supported(const char *url);
+
+/**
+ * @brief Queue a request; it starts on the next poll
+ * @param engine Instance pointer
+ * @param request Request settings (strings must stay valid until completion)
+ * @return esp_err_t ESP_ERR_NO_MEM when all slots are busy, ESP_ERR_NOT_SUPPORTED for a plain HTTP URL
+ */
+esp_err_t weather_async_submit(weather_async_t *engine, const weather_async_request_t *request);
+
+/**
+ * @brief Advance every pending request without blocking longer than one I/O step each
+ * @param engine Instance pointer
+ * @return uint32_t Number of requests still pending
+ */
+uint32_t weather_async_poll(weather_async_t *engine);
+
+/**
+ * @brief Poll until every pending request has completed
+ * @param engine Instance pointer
+ */
+void weather_async_run(weather_async_t *engine);
+
+#endif // _WEATHER_ASYNC_H
@@ -0,0 +1,53 @@
+
+#ifndef _WEATHER_CACHE_H
+#define _WEATHER_CACHE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <esp_err.h>
+
+#include "weather.h"
+
+
+// The record is kept as one NVS blob. On the ESP-IDF linux target the NVS
+// partition is emulated by a file, which serves as the host-side store.
+#define WEATHER_CACHE_NAMESPACE     "weather"
+#define WEATHER_CACHE_KEY           "last"
+#define WEATHER_CACHE_VERSION       1
+#define WEATHER_CACHE_TTL_S         (30 * 60)   // Age after which the record must be revalidated
+
+
+// Last decoded weather record
+typedef struct {
+    uint32_t version;                       // WEATHER_CACHE_VERSION, older layouts are ignored
+    double temp_c;
+    char weather_text[WEATHER_TEXT_SIZE];
+    int32_t timestamp;                      // Server timestamp of the data
+    int64_t fetched_at;                     // Wall clock (epoch seconds) when it was fetched
+    uint32_t ttl_s;                         // Freshness lifetime in seconds
+} weather_cache_record_t;
+
+
+/**
+ * @brief Load the cached record
+ * @param record Record output pointer
+ * @return esp_err_t ESP_ERR_NOT_FOUND if nothing valid is stored
+ */
+esp_err_t weather_cache_load(weather_cache_record_t *record);
+
+/**
+ * @brief Store a record (version is filled in here)
+ * @param record Record to store
+ * @return esp_err_t
+ */
+esp_err_t weather_cache_store(const weather_cache_record_t *record);
+
+/**
+ * @brief Check whether a record is still within its TTL
+ * @param record Record to check
+ * @param now Current wall clock in epoch seconds
+ * @return bool Returns false when stale or when the clock is not set yet
+ */
+bool weather_cache_is_fresh(const weather_cache_record_t *record, int64_t now);
+
+#endif // _WEATHER_CACHE_H
@@ -0,0 +1,87 @@
+
+#ifndef _WEATHER_FORECAST_H
+#define _WEATHER_FORECAST_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+
+#define WEATHER_FORECAST_CAPACITY   (7 * 24)    // A week of hourly points
+
+
+// Forecast timeline as fixed-capacity struct-of-arrays buffers (PSRAM when available).
+// One writer (the fetching task) appends while the body streams in; readers may
+// follow the published count to draw points incrementally.
+typedef struct {
+    uint16_t capacity;
+    int32_t *time;                      // Seconds since the epoch
+    int16_t *temp_dc;                   // Temperature in tenths of a degree Celsius
+    uint16_t time_count;                // Writer progress of each array
+    uint16_t temp_count;
+    atomic_uint_fast32_t generation;    // Bumped when a new timeline starts
+    atomic_uint_fast16_t count;         // Points with both time and temperature written
+} weather_forecast_t;
+
+// Consistent view of the published timeline
+typedef struct {
+    uint32_t generation;
+    uint16_t count;
+} weather_forecast_state_t;
+
+
+/**
+ * @brief Create a forecast timeline
+ * @param capacity Maximum number of points
+ * @return weather_forecast_t* Returns a pointer to the instance on success, NULL on failure
+ */
+weather_forecast_t* weather_forecast_create(uint16_t capacity);
+
+/**
+ * @brief Release a forecast timeline
+ * @param forecast Instance pointer
+ */
+void weather_forecast_destroy(weather_forecast_t *forecast);
+
+/**
+ * @brief Writer: start a new timeline (readers see a new generation)
+ * @param forecast Instance pointer
+ */
+void weather_forecast_begin(weather_forecast_t *forecast);
+
+/**
+ * @brief Writer: append the next time value
+ * @param forecast Instance pointer
+ * @param time Seconds since the epoch
+ */
+void weather_forecast_push_time(weather_forecast_t *forecast, int32_t time);
+
+/**
+ * @brief Writer: append the next temperature value
+ * @param forecast Instance pointer
+ * @param temp_c Temperature in degrees Celsius
+ */
+void weather_forecast_push_temp(weather_forecast_t *forecast, double temp_c);
+
+/**
+ * @brief Reader: get the current generation and published point count
+ * @param forecast Instance pointer
+ * @param state State output pointer
+ */
+void weather_forecast_get_state(const weather_forecast_t *forecast, weather_forecast_state_t *state);
+
+/**
+ * @brief Reader: copy published points of the given generation
+ * @param forecast Instance pointer
+ * @param state State obtained from weather_forecast_get_state()
+ * @param start Index of the first point
+ * @param max Maximum number of points to copy
+ * @param time Time output array (may be NULL)
+ * @param temp_dc Temperature output array (may be NULL)
+ * @return size_t Number of points copied, 0 if a new generation started meanwhile
+ */
+size_t weather_forecast_copy(const weather_forecast_t *forecast, const weather_forecast_state_t *state,
+                             size_t start, size_t max, int32_t *time, int16_t *temp_dc);
+
+#endif // _WEATHER_FORECAST_H
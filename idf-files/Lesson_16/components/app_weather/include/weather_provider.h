@@ -0,0 +1,82 @@
+
+#ifndef _WEATHER_PROVIDER_H
+#define _WEATHER_PROVIDER_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "sdkconfig.h"
+
+
+// How the timestamp field is encoded
+typedef enum {
+    WEATHER_TIME_UNIX_S = 0,    // Seconds since the epoch
+    WEATHER_TIME_UNIX_MS,       // Milliseconds since the epoch
+    WEATHER_TIME_ISO8601,       // "2025-12-17T14:00[:SS]", UTC
+} weather_time_format_t;
+
+// How the description field is encoded
+typedef enum {
+    WEATHER_TEXT_STRING = 0,    // Human readable string
+    WEATHER_TEXT_WMO_CODE,      // WMO weather interpretation code (number)
+} weather_text_format_t;
+
+// Backend descriptor: everything that differs between weather APIs
+typedef struct {
+    const char *name;
+    const char *url;                    // Request URL, fully expanded at compile time
+    const char *temp_path;              // Key paths, see json_stream.h for the syntax
+    const char *text_path;
+    const char *time_path;
+    double temp_scale;                  // temp_c = value * temp_scale + temp_offset
+    double temp_offset;
+    weather_text_format_t text_format;
+    weather_time_format_t time_format;      // Also used for forecast times
+    const char *forecast_url;               // NULL if the backend has no forecast
+    const char *forecast_time_path;         // Arrays of times and temperatures
+    const char *forecast_temp_path;
+    const char *cert_pem;                   // Server certificate (PEM) to trust, NULL verifies against the CA bundle
+} weather_provider_t;
+
+extern const weather_provider_t weather_provider_thinknode;
+extern const weather_provider_t weather_provider_open_meteo;
+extern const weather_provider_t weather_provider_openweathermap;
+
+// Provider used by the weather component, selected in menuconfig
+#if CONFIG_WEATHER_PROVIDER_OPEN_METEO
+#define WEATHER_PROVIDER    (&weather_provider_open_meteo)
+#elif CONFIG_WEATHER_PROVIDER_OPENWEATHERMAP
+#define WEATHER_PROVIDER    (&weather_provider_openweathermap)
+#else
+#define WEATHER_PROVIDER    (&weather_provider_thinknode)
+#endif
+
+
+/**
+ * @brief Convert a raw temperature field to degrees Celsius
+ * @param provider Provider descriptor
+ * @param text Raw field text
+ * @param temp_c Temperature output pointer
+ * @return bool Returns false if the field is not a number
+ */
+bool weather_provider_parse_temp(const weather_provider_t *provider, const char *text, double *temp_c);
+
+/**
+ * @brief Convert a raw description field to display text
+ * @param provider Provider descriptor
+ * @param text Raw field text
+ * @param out Output buffer
+ * @param size Output buffer size
+ * @return bool Returns false if the field cannot be converted
+ */
+bool weather_provider_parse_text(const weather_provider_t *provider, const char *text, char *out, size_t size);
+
+/**
+ * @brief Convert a raw timestamp field to seconds since the epoch
+ * @param provider Provider descriptor
+ * @param text Raw field text
+ * @param timestamp Timestamp output pointer
+ * @return bool Returns false if the field cannot be converted
+ */
+bool weather_provider_parse_time(const weather_provider_t *provider, const char *text, int *timestamp);
+
+#endif // _WEATHER_PROVIDER_H
@@ -0,0 +1,97 @@
+
+#ifndef _WEATHER_REFRESH_H
+#define _WEATHER_REFRESH_H
+
+#include <stdatomic.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "weather.h"
+#include "weather_cache.h"
+
+
+// Default refresh task settings
+#define WEATHER_REFRESH_PERIOD_MS       (10 * 60 * 1000)  // Poll period after a successful fetch
+#define WEATHER_REFRESH_RETRY_MS        (5 * 1000)        // Retry period after a failure
+#define WEATHER_REFRESH_FORECAST_MS     (60 * 60 * 1000)  // Forecast period (hourly data)
+#define WEATHER_REFRESH_STACK_SIZE      6144
+#define WEATHER_REFRESH_PRIORITY        5
+
+
+// One published weather state, ready to be shown
+typedef struct {
+    uint32_t seq;                           // Publication number, 0 means no data yet
+    bool from_cache;                        // Loaded from the persistent cache, not yet revalidated
+    double temp_c;
+    int timestamp;
+    char temp_text[32];                     // for example "25.4°C"
+    char weather_text[WEATHER_TEXT_SIZE];   // for example "Partly Cloudy"
+    char date_str[32];                      // for example "2025/12/17"
+    char week_str[32];                      // for example "Wednesday"
+} weather_snapshot_t;
+
+typedef struct {
+    uint32_t period_ms;             // Refresh period after a successful fetch
+    uint32_t retry_ms;              // Refresh period after a failure or while the network is down
+    bool (*network_ready)(void);    // Optional: return false to skip fetching (e.g. Wi-Fi not connected)
+    bool use_cache;                 // Publish the persisted record at creation and persist new results
+    uint32_t cache_ttl_s;           // Freshness lifetime of persisted records
+    weather_forecast_t *forecast;   // Optional: timeline fetched together with the current weather when due
+    uint32_t forecast_period_ms;    // Forecast refresh period
+    uint32_t stack_size;            // Refresh task stack size in bytes
+    UBaseType_t priority;           // Refresh task priority
+} weather_refresh_config_t;
+
+#define WEATHER_REFRESH_DEFAULT_CONFIG() {          \
+        .period_ms = WEATHER_REFRESH_PERIOD_MS,     \
+        .retry_ms = WEATHER_REFRESH_RETRY_MS,       \
+        .network_ready = NULL,                      \
+        .use_cache = true,                          \
+        .cache_ttl_s = WEATHER_CACHE_TTL_S,         \
+        .forecast = NULL,                           \
+        .forecast_period_ms = WEATHER_REFRESH_FORECAST_MS, \
+        .stack_size = WEATHER_REFRESH_STACK_SIZE,   \
+        .priority = WEATHER_REFRESH_PRIORITY,       \
+    }
+
+// Refresher: a task fetches into the back snapshot, then swaps the published index
+typedef struct {
+    weather_t *weather;
+    weather_refresh_config_t config;
+    weather_snapshot_t snapshots[2];    // Front/back buffers
+    atomic_uint_fast32_t published;     // Publication count, front snapshot = published & 1
+    int last_timestamp;                 // Server timestamp the clock was last set from
+    weather_cache_record_t cached;      // Record last loaded from or written to the cache
+    bool has_cached;
+    uint32_t first_wait_ms;             // Delay before the first fetch (fresh cached record)
+    int64_t forecast_due_us;            // Next forecast fetch (esp_timer time)
+    TaskHandle_t task;
+} weather_refresh_t;
+
+
+/**
+ * @brief Create a refresher and start its task
+ *
+ * With use_cache set, the persisted record is published before this returns
+ * (stale-while-revalidate) so the UI can draw it immediately.
+ * @param weather Weather instance used for fetching (owned by the caller)
+ * @param config Refresh settings
+ * @return weather_refresh_t* Returns a pointer to the instance on success, NULL on failure
+ */
+weather_refresh_t* weather_refresh_create(weather_t *weather, const weather_refresh_config_t *config);
+
+/**
+ * @brief Wake the refresh task to fetch immediately
+ * @param refresh Instance pointer
+ */
+void weather_refresh_trigger(weather_refresh_t *refresh);
+
+/**
+ * @brief Copy the latest published snapshot (never blocks, safe from any task)
+ * @param refresh Instance pointer
+ * @param snapshot Snapshot output pointer
+ * @return bool Returns false while nothing has been published yet
+ */
+bool weather_refresh_read(weather_refresh_t *refresh, weather_snapshot_t *snapshot);
+
+#endif // _WEATHER_REFRESH_H
@@ -0,0 +1,365 @@
+#include "json_stream.h"
+
+#include <string.h>
+
+// Tokenizer states
+enum {
+    ST_VALUE = 0,       // Expecting any value
+    ST_VALUE_OR_END,    // After '[': value or ']'
+    ST_KEY_OR_END,      // After '{': key or '}'
+    ST_KEY,             // After ',' inside an object: key
+    ST_COLON,           // After a key: ':'
+    ST_COMMA_OR_END,    // After a value: ',' or the closing bracket
+    ST_STRING,          // Inside a string (key or value)
+    ST_ESCAPE,          // After '\' inside a string
+    ST_UNICODE,         // Inside a \uXXXX escape
+    ST_LITERAL,         // Inside a number, true, false or null
+    ST_DONE,            // Root value complete, only whitespace may follow
+    ST_ERROR,
+};
+
+// ---------------------- Internal helper functions ----------------------
+
+static bool is_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static bool is_literal_char(char c)
+{
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+           c == '-' || c == '+' || c == '.';
+}
+
+static bool in_array(const json_stream_t *parser)
+{
+    return (parser->array_mask >> parser->depth) & 1u;
+}
+
+/**
+ * @brief Select the field that should receive the scalar starting at the current path
+ */
+static void begin_scalar(json_stream_t *parser)
+{
+    parser->capture = NULL;
+    parser->capture_len = 0;
+    if (parser->overflow_depth != 0) {
+        return;
+    }
+    for (size_t i = 0; i < parser->field_count; i++) {
+        json_stream_field_t *field = &parser->fields[i];
+        if (!field->found && strcmp(field->path, parser->path) == 0) {
+            parser->capture = field;
+            return;
+        }
+    }
+}
+
+static void capture_char(json_stream_t *parser, char c)
+{
+    json_stream_field_t *field = parser->capture;
+    // Values longer than the output buffer are truncated
+    if (field != NULL && parser->capture_len + 1 < field->value_size) {
+        field->value[parser->capture_len++] = c;
+    }
+}
+
+static void key_char(json_stream_t *parser, char c)
+{
+    if (parser->overflow_depth != 0) {
+        return;
+    }
+    if (parser->path_len + 1 < JSON_STREAM_PATH_MAX) {
+        parser->path[parser->path_len++] = c;
+        parser->path[parser->path_len] = '\0';
+    } else {
+        parser->overflow_depth = parser->depth;
+    }
+}
+
+static void string_char(json_stream_t *parser, char c)
+{
+    if (parser->string_is_key) {
+        key_char(parser, c);
+    } else {
+        capture_char(parser, c);
+    }
+}
+
+/**
+ * @brief Emit a \uXXXX code unit as UTF-8 (surrogate pairs are replaced by '?')
+ */
+static void string_unicode(json_stream_t *parser, uint16_t cp)
+{
+    if (cp < 0x80) {
+        string_char(parser, (char)cp);
+    } else if (cp < 0x800) {
+        string_char(parser, (char)(0xC0 | (cp >> 6)));
+        string_char(parser, (char)(0x80 | (cp & 0x3F)));
+    } else if (cp >= 0xD800 && cp <= 0xDFFF) {
+        string_char(parser, '?');
+    } else {
+        string_char(parser, (char)(0xE0 | (cp >> 12)));
+        string_char(parser, (char)(0x80 | ((cp >> 6) & 0x3F)));
+        string_char(parser, (char)(0x80 | (cp & 0x3F)));
+    }
+}
+
+static void begin_key(json_stream_t *parser)
+{
+    parser->key_start[parser->depth] = parser->path_len;
+    if (parser->path_len > 0) {
+        key_char(parser, '.');
+    }
+    parser->string_is_key = 1;
+    parser->state = ST_STRING;
+}
+
+/**
+ * @brief A value (scalar or container) finished: drop its key from the path
+ */
+static void end_value(json_stream_t *parser)
+{
+    json_stream_field_t *field = parser->capture;
+    if (field != NULL) {
+        field->value[parser->capture_len] = '\0';
+        if (field->on_value != NULL) {
+            // Streaming fields stay armed for the next match
+            field->on_value(field->value, parser->capture_len, field->arg);
+        } else {
+            field->found = true;
+            parser->found_count++;
+        }
+        parser->capture = NULL;
+    }
+
+    if (parser->depth == 0) {
+        parser->state = ST_DONE;
+        return;
+    }
+    if (!in_array(parser)) {
+        if (parser->overflow_depth == parser->depth) {
+            parser->overflow_depth = 0;
+        }
+        parser->path_len = parser->key_start[parser->depth];
+        parser->path[parser->path_len] = '\0';
+    }
+    parser->state = ST_COMMA_OR_END;
+}
+
+static bool open_container(json_stream_t *parser, bool array)
+{
+    if (parser->depth >= JSON_STREAM_MAX_DEPTH) {
+        return false;
+    }
+    parser->depth++;
+    if (array) {
+        parser->array_mask |= 1u << parser->depth;
+        parser->state = ST_VALUE_OR_END;
+    } else {
+        parser->array_mask &= ~(1u << parser->depth);
+        parser->state = ST_KEY_OR_END;
+    }
+    return true;
+}
+
+static bool close_container(json_stream_t *parser, bool array)
+{
+    if (parser->depth == 0 || in_array(parser) != array) {
+        return false;
+    }
+    parser->depth--;
+    end_value(parser);
+    return true;
+}
+
+static bool begin_value(json_stream_t *parser, char c)
+{
+    switch (c) {
+        case '{':
+            return open_container(parser, false);
+        case '[':
+            return open_container(parser, true);
+        case '"':
+            begin_scalar(parser);
+            parser->string_is_key = 0;
+            parser->state = ST_STRING;
+            return true;
+        default:
+            if (c == '-' || (c >= '0' && c <= '9') || c == 't' || c == 'f' || c == 'n') {
+                begin_scalar(parser);
+                capture_char(parser, c);
+                parser->state = ST_LITERAL;
+                return true;
+            }
+            return false;
+    }
+}
+
+static int hex_value(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/**
+ * @brief Advance the tokenizer by one character
+ * @return bool Returns false on a syntax error
+ */
+static bool step(json_stream_t *parser, char c)
+{
+    switch (parser->state) {
+        case ST_STRING:
+            if (c == '"') {
+                if (parser->string_is_key) {
+                    parser->state = ST_COLON;
+                } else {
+                    end_value(parser);
+                }
+            } else if (c == '\\') {
+                parser->state = ST_ESCAPE;
+            } else {
+                string_char(parser, c);
+            }
+            return true;
+
+        case ST_ESCAPE:
+            parser->state = ST_STRING;
+            switch (c) {
+                case 'n': string_char(parser, '\n'); break;
+                case 't': string_char(parser, '\t'); break;
+                case 'r': string_char(parser, '\r'); break;
+                case 'b': string_char(parser, '\b'); break;
+                case 'f': string_char(parser, '\f'); break;
+                case 'u':
+                    parser->unicode_left = 4;
+                    parser->unicode_value = 0;
+                    parser->state = ST_UNICODE;
+                    break;
+                default:  string_char(parser, c); break; // '"', '\\' and '/'
+            }
+            return true;
+
+        case ST_UNICODE: {
+            int v = hex_value(c);
+            if (v < 0) {
+                return false;
+            }
+            parser->unicode_value = (uint16_t)((parser->unicode_value << 4) | v);
+            if (--parser->unicode_left == 0) {
+                string_unicode(parser, parser->unicode_value);
+                parser->state = ST_STRING;
+            }
+            return true;
+        }
+
+        case ST_LITERAL:
+            if (is_literal_char(c)) {
+                capture_char(parser, c);
+                return true;
+            }
+            // The delimiter belongs to the enclosing container
+            end_value(parser);
+            return step(parser, c);
+
+        default:
+            break;
+    }
+
+    if (is_space(c)) {
+        return true;
+    }
+
+    switch (parser->state) {
+        case ST_VALUE:
+            return begin_value(parser, c);
+        case ST_VALUE_OR_END:
+            if (c == ']') {
+                return close_container(parser, true);
+            }
+            return begin_value(parser, c);
+        case ST_KEY_OR_END:
+            if (c == '}') {
+                return close_container(parser, false);
+            }
+            // fall through
+        case ST_KEY:
+            if (c != '"') {
+                return false;
+            }
+            begin_key(parser);
+            return true;
+        case ST_COLON:
+            if (c != ':') {
+                return false;
+            }
+            parser->state = ST_VALUE;
+            return true;
+        case ST_COMMA_OR_END:
+            if (c == ',') {
+                parser->state = in_array(parser) ? ST_VALUE : ST_KEY;
+                return true;
+            }
+            if (c == ']' || c == '}') {
+                return close_container(parser, c == ']');
+            }
+            return false;
+        case ST_DONE:
+        default:
+            return false;
+    }
+}
+
+// ---------------------- External API functions ----------------------
+
+void json_stream_init(json_stream_t *parser, json_stream_field_t *fields, size_t field_count)
+{
+    memset(parser, 0, sizeof(*parser));
+    parser->fields = fields;
+    parser->field_count = field_count;
+    json_stream_reset(parser);
+}
+
+void json_stream_reset(json_stream_t *parser)
+{
+    parser->found_count = 0;
+    parser->state = ST_VALUE;
+    parser->depth = 0;
+    parser->array_mask = 0;
+    parser->overflow_depth = 0;
+    parser->path[0] = '\0';
+    parser->path_len = 0;
+    parser->capture = NULL;
+    parser->capture_len = 0;
+    for (size_t i = 0; i < parser->field_count; i++) {
+        parser->fields[i].found = false;
+        if (parser->fields[i].value_size > 0) {
+            parser->fields[i].value[0] = '\0';
+        }
+    }
+}
+
+bool json_stream_feed(json_stream_t *parser, const char *data, size_t len)
+{
+    if (parser->state == ST_ERROR) {
+        return false;
+    }
+    // Nothing left to extract: skip the rest of the body
+    if (json_stream_complete(parser)) {
+        return true;
+    }
+    for (size_t i = 0; i < len; i++) {
+        if (!step(parser, data[i])) {
+            parser->state = ST_ERROR;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool json_stream_complete(const json_stream_t *parser)
+{
+    return parser->found_count == parser->field_count;
+}
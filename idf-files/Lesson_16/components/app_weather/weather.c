@@ -1,7 +1,10 @@
 #include "weather.h"
 
+#include <strings.h>
 #include <esp_http_client.h>
-#include <cJSON.h>
+#include <esp_timer.h>
+#include <esp_crt_bundle.h>
+#include "trace_evt.h"
 
 #define TAG "WeatherC"
 
@@ -9,56 +12,134 @@
 
 weather_t* weather_create(void)
 {
+    return weather_create_with_provider(WEATHER_PROVIDER);
+}
+
+weather_t* weather_create_with_provider(const weather_provider_t *provider)
+{
+    if (provider == NULL) {
+        ESP_LOGE(TAG, "Invalid provider");
+        return NULL;
+    }
     weather_t* weather = (weather_t*)malloc(sizeof(weather_t));
     if (weather == NULL) {
         ESP_LOGE(TAG, "Failed to allocate weather_t");
         return NULL;
     }
+    memset(weather, 0, sizeof(weather_t));
+    weather->provider = provider;
+    ESP_LOGI(TAG, "Weather provider: %s", weather->provider->name);
 
-    // Replacement for new char[] in C++ constructor
-    weather->json_response = (char*)malloc(JSON_BUFFER_SIZE);
-    if (weather->json_response == NULL) {
-        ESP_LOGE(TAG, "Failed to allocate json_response buffer");
-        free(weather);
-        return NULL;
-    }
-    
-    // Initialize buffer
-    memset(weather->json_response, 0, JSON_BUFFER_SIZE);
+    // Each field is captured into a small fixed buffer, the body itself is never stored
+    weather->fields[WEATHER_FIELD_TEMP] = (json_stream_field_t){
+        .path = weather->provider->temp_path,
+        .value = weather->temp_value,
+        .value_size = sizeof(weather->temp_value),
+    };
+    weather->fields[WEATHER_FIELD_TEXT] = (json_stream_field_t){
+        .path = weather->provider->text_path,
+        .value = weather->text_value,
+        .value_size = sizeof(weather->text_value),
+    };
+    weather->fields[WEATHER_FIELD_TIMESTAMP] = (json_stream_field_t){
+        .path = weather->provider->time_path,
+        .value = weather->timestamp_value,
+        .value_size = sizeof(weather->timestamp_value),
+    };
+    json_stream_init(&weather->parser, weather->fields, WEATHER_FIELD_COUNT);
     return weather;
 }
 
 void weather_destroy(weather_t* weather)
 {
     if (weather) {
-        // Replacement for delete[] in C++ destructor
-        if (weather->json_response) {
-            free(weather->json_response);
+        if (weather->client) {
+            esp_http_client_cleanup(weather->client);
         }
+        weather_async_destroy(weather->async);
         free(weather); // Free the structure itself
     }
 }
 
 // ---------------------- Internal implementation functions ----------------------
 
+// One GET over the session
+typedef struct {
+    const char *url;
+    json_stream_t *parser;          // Receives the body
+    bool conditional;               // Send the validators of the last accepted response
+    void (*on_start)(void *arg);    // Optional: called before each attempt (a retry restarts the body)
+    void *arg;
+} weather_http_request_t;
+
+// Forecast ingestion context: each array element is pushed straight into the timeline
+typedef struct {
+    const weather_provider_t *provider;
+    weather_forecast_t *forecast;
+    char time_value[32];
+    char temp_value[16];
+    json_stream_field_t fields[2];
+    json_stream_t parser;
+} weather_forecast_ctx_t;
+
+// One request of weather_get_weather_and_forecast()
+typedef struct {
+    weather_t *weather;
+    json_stream_t *parser;          // Receives the body
+    esp_err_t err;
+    int status;
+} weather_async_ctx_t;
+
+/**
+ * @brief Copy a header value into a fixed buffer (truncated values are dropped)
+ */
+static void weather_copy_header(char *dst, size_t size, const char *value)
+{
+    if (strlen(value) < size) {
+        strcpy(dst, value);
+    } else {
+        dst[0] = '\0';
+    }
+}
+
 /**
  * @brief HTTP response callback function (keep C-style signature)
  * @param evt HTTP event structure
- * @return esp_err_t 
+ * @return esp_err_t
  */
 static esp_err_t http_event_handler(esp_http_client_event_t *evt)
 {
     // Key point: get weather_t instance pointer from evt->user_data
     weather_t *weather_inst = (weather_t*)evt->user_data;
-    if (weather_inst == NULL || weather_inst->json_response == NULL) {
+    if (weather_inst == NULL) {
         return ESP_FAIL;
     }
     switch (evt->event_id) {
+        case HTTP_EVENT_ON_CONNECTED:
+            // Only fires when a new connection is opened, not when one is reused.
+            // For HTTPS the time includes the (possibly resumed) TLS handshake.
+            weather_inst->request_connected = true;
+            weather_inst->stats.connections++;
+            weather_inst->stats.last_connect_us = esp_timer_get_time() - weather_inst->request_start_us;
+            weather_inst->stats.connect_us_total += weather_inst->stats.last_connect_us;
+            ESP_LOGI(TAG, "Connected in %lld ms", (long long)(weather_inst->stats.last_connect_us / 1000));
+            TRACE_COMPLETE("weather", "connect", (int32_t)weather_inst->stats.last_connect_us);
+            break;
+        case HTTP_EVENT_ON_HEADER:
+            if (weather_inst->response_start_us == 0) {
+                weather_inst->response_start_us = esp_timer_get_time();
+            }
+            if (strcasecmp(evt->header_key, "ETag") == 0) {
+                weather_copy_header(weather_inst->pending_etag, WEATHER_ETAG_SIZE, evt->header_value);
+            } else if (strcasecmp(evt->header_key, "Last-Modified") == 0) {
+                weather_copy_header(weather_inst->pending_last_modified, WEATHER_DATE_SIZE, evt->header_value);
+            }
+            break;
         case HTTP_EVENT_ON_DATA:
-            // Copy received data into buffer
-            if (evt->data_len < JSON_BUFFER_SIZE - strlen(weather_inst->json_response) - 1) {
-                // Use strncat to safely concatenate strings
-                strncat(weather_inst->json_response, (char*)evt->data, evt->data_len);
+            // Feed each chunk straight into the extractor, nothing is buffered
+            if (weather_inst->active_parser != NULL &&
+                !json_stream_feed(weather_inst->active_parser, (const char*)evt->data, evt->data_len)) {
+                ESP_LOGD(TAG, "Malformed JSON chunk (%d bytes)", evt->data_len);
             }
             break;
         default:
@@ -68,109 +149,289 @@ static esp_err_t http_event_handler(esp_http_client_event_t *evt)
 }
 
 /**
- * @brief Send HTTP request and get JSON
+ * @brief Create the long-lived keep-alive client on first use
  * @param weather Instance pointer (replacement for this)
- * @return bool 
+ * @return bool
  */
-static bool weather_http_get_json(weather_t* weather)
+static bool weather_http_open(weather_t* weather)
 {
-    // Clear buffer
-    memset(weather->json_response, 0, JSON_BUFFER_SIZE); 
-    
+    if (weather->client != NULL) {
+        return true;
+    }
+
     // Note: In C language, struct initialization usually requires explicitly
     // specifying all members, or using {0} for initialization
     esp_http_client_config_t config = {
-        .url = WEATHER_JSON_URL,
+        .url = weather->provider->url,
+        .timeout_ms = WEATHER_HTTP_TIMEOUT_MS,
+        .keep_alive_enable = true,           // TCP keep-alive probes detect dead idle connections
+        .cert_pem = weather->provider->cert_pem,
+        // Verify HTTPS providers against the CA bundle unless the descriptor brings its certificate
+        .crt_bundle_attach = weather->provider->cert_pem ? NULL : esp_crt_bundle_attach,
+#if CONFIG_WEATHER_TLS_RESUMPTION
+        .save_client_session = true,         // Reconnects offer the saved session ticket
+#endif
         .event_handler = http_event_handler, // Use C-style function
         .user_data = weather,  // Pass current weather_t instance pointer
     };
 
-    esp_http_client_handle_t client = esp_http_client_init(&config);
-    if (client == NULL) {
+    weather->client = esp_http_client_init(&config);
+    if (weather->client == NULL) {
         ESP_LOGE(TAG, "Failed to init HTTP client");
         return false;
     }
+    return true;
+}
+
+/**
+ * @brief Send one GET over the session (conditional when validators are known)
+ * @param weather Instance pointer (replacement for this)
+ * @param request Request description
+ * @param status HTTP status code output pointer
+ * @return esp_err_t
+ */
+static esp_err_t weather_http_perform(weather_t* weather, const weather_http_request_t *request, int *status)
+{
+    esp_http_client_handle_t client = weather->client;
+    bool conditional = request->conditional && weather->has_result;
+
+    // Start a new document
+    json_stream_reset(request->parser);
+    weather->active_parser = request->parser;
+    if (request->on_start) {
+        request->on_start(request->arg);
+    }
+    weather->pending_etag[0] = '\0';
+    weather->pending_last_modified[0] = '\0';
+    weather->request_connected = false;
+    weather->request_start_us = esp_timer_get_time();
+    weather->response_start_us = 0;
+
+    // Same host: the open connection is kept
+    esp_http_client_set_url(client, request->url);
+    if (conditional && weather->etag[0] != '\0') {
+        esp_http_client_set_header(client, "If-None-Match", weather->etag);
+    } else {
+        esp_http_client_delete_header(client, "If-None-Match");
+    }
+    if (conditional && weather->last_modified[0] != '\0') {
+        esp_http_client_set_header(client, "If-Modified-Since", weather->last_modified);
+    } else {
+        esp_http_client_delete_header(client, "If-Modified-Since");
+    }
 
+    weather->stats.requests++;
+    TRACE_BEGIN("weather", "request");
     esp_err_t err = esp_http_client_perform(client);
-    bool success = false;
-    
+    TRACE_END("weather", "request");
+    if (weather->response_start_us) {
+        // Headers and body, the fields being extracted as the chunks arrive
+        TRACE_COMPLETE("weather", "receive", (int32_t)(esp_timer_get_time() - weather->response_start_us));
+    }
     if (err == ESP_OK) {
-        ESP_LOGI(TAG, "HTTP status code: %d", esp_http_client_get_status_code(client));
-        ESP_LOGI(TAG, "Received JSON response:\n%s", weather->json_response);
-        success = true;
-    } else {
-        ESP_LOGE(TAG, "HTTP request failed: %s", esp_err_to_name(err));
+        *status = esp_http_client_get_status_code(client);
+        if (!weather->request_connected) {
+            weather->stats.reused++;
+        }
     }
-    
-    // Clean up resources
-    esp_http_client_cleanup(client);
-    return success;
+    return err;
 }
 
 /**
- * @brief Parse temperature and weather condition from JSON string
+ * @brief Send HTTP request and extract the configured JSON fields
  * @param weather Instance pointer (replacement for this)
- * @param json_str JSON string
- * @param temp_c Temperature output pointer
- * @param weather_text Weather description output buffer
- * @param timestamp Timestamp output pointer
- * @return bool 
+ * @param request Request description
+ * @param not_modified Set when the server answered 304
+ * @return bool
  */
-static bool weather_analyse_weather_json(weather_t *weather, const char *json_str, double *temp_c, char* const weather_text, int *timestamp)
+static bool weather_http_get_json(weather_t* weather, const weather_http_request_t *request, bool *not_modified)
 {
-    // C language does not require the first weather parameter,
-    // but it is kept for method consistency and not actually used
-    (void)weather; // Avoid unused variable warning
+    *not_modified = false;
+    if (!weather_http_open(weather)) {
+        return false;
+    }
 
-    cJSON *root = cJSON_Parse(json_str);
-    if (root == NULL) {
-        ESP_LOGE(TAG, "JSON parse failed: %s", cJSON_GetErrorPtr());
+    int64_t start_us = esp_timer_get_time();
+    int status = 0;
+    esp_err_t err = weather_http_perform(weather, request, &status);
+    if (err != ESP_OK) {
+        // The server may have closed the idle connection: reconnect once
+        ESP_LOGW(TAG, "HTTP request failed (%s), reconnecting", esp_err_to_name(err));
+        esp_http_client_close(weather->client);
+        err = weather_http_perform(weather, request, &status);
+    }
+    weather->stats.last_latency_us = esp_timer_get_time() - start_us;
+
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "HTTP request failed: %s", esp_err_to_name(err));
+        esp_http_client_close(weather->client);
+        weather->stats.failures++;
         return false;
     }
 
-    // 2.1 Get data node
-    cJSON *data_node = cJSON_GetObjectItemCaseSensitive(root, "data");
-    if (!cJSON_IsObject(data_node)) {
-        ESP_LOGE(TAG, "Valid data node not found");
-        cJSON_Delete(root);
+    ESP_LOGI(TAG, "HTTP status code: %d in %lld ms (%s connection, opened %lu, reused %lu)",
+             status, (long long)(weather->stats.last_latency_us / 1000),
+             weather->request_connected ? "new" : "reused",
+             (unsigned long)weather->stats.connections, (unsigned long)weather->stats.reused);
+
+    if (status == 304) {
+        weather->stats.not_modified++;
+        *not_modified = true;
+        return true;
+    }
+    if (status != 200) {
+        weather->stats.failures++;
         return false;
     }
+    return true;
+}
+
+/**
+ * @brief Convert the fields captured by the streaming extractor
+ * @param weather Instance pointer (replacement for this)
+ * @param temp_c Temperature output pointer
+ * @param weather_text Weather description output buffer
+ * @param timestamp Timestamp output pointer
+ * @return bool
+ */
+static bool weather_analyse_weather_json(weather_t *weather, double *temp_c, char* const weather_text, int *timestamp)
+{
+    const weather_provider_t *provider = weather->provider;
+    const json_stream_field_t *fields = weather->fields;
+    double temp = 0.0;
+    int ts = 0;
 
     // Extract temp_c
-    cJSON *temp_c_node = cJSON_GetObjectItemCaseSensitive(data_node, "temp");
-    if (!cJSON_IsNumber(temp_c_node)) {
-        ESP_LOGE(TAG, "Valid temp node not found");
-        cJSON_Delete(root);
+    if (!fields[WEATHER_FIELD_TEMP].found || !weather_provider_parse_temp(provider, weather->temp_value, &temp)) {
+        ESP_LOGE(TAG, "Valid %s node not found", provider->temp_path);
         return false;
     }
-    *temp_c = temp_c_node->valuedouble;
 
     // Extract weather
-    cJSON *weather_node = cJSON_GetObjectItemCaseSensitive(data_node, "weather");
-    if (!cJSON_IsString(weather_node) || weather_node->valuestring == NULL) {
-        ESP_LOGE(TAG, "Valid condition.text node not found");
-        cJSON_Delete(root);
+    if (!fields[WEATHER_FIELD_TEXT].found ||
+        !weather_provider_parse_text(provider, weather->text_value, weather_text, WEATHER_TEXT_SIZE)) {
+        ESP_LOGE(TAG, "Valid %s node not found", provider->text_path);
         return false;
-    } 
-    // Use strncpy instead of strcpy to safely copy string
-    strncpy(weather_text, weather_node->valuestring, strlen(weather_node->valuestring) + 1);
+    }
 
     // Extract timestamp
-    cJSON *timestamp_node = cJSON_GetObjectItemCaseSensitive(data_node, "timestamp");
-    if (!cJSON_IsNumber(timestamp_node)) {
-        ESP_LOGE(TAG, "Valid timestamp node not found");
-        cJSON_Delete(root);
+    if (!fields[WEATHER_FIELD_TIMESTAMP].found || !weather_provider_parse_time(provider, weather->timestamp_value, &ts)) {
+        ESP_LOGE(TAG, "Valid %s node not found", provider->time_path);
         return false;
     }
-    *timestamp = timestamp_node->valueint;
 
-    // Output result (omitted)
+    *temp_c = temp;
+    *timestamp = ts;
+    return true;
+}
 
-    // Free memory (critical)
-    cJSON_Delete(root);
+/**
+ * @brief Decode a fetched response, or return the previous result on 304, and keep it with its validators
+ * @param weather Instance pointer (replacement for this)
+ * @param not_modified The server answered 304
+ * @param temp_c Temperature output pointer
+ * @param weather_text Weather description output buffer
+ * @param timestamp Timestamp output pointer
+ * @return bool
+ */
+static bool weather_accept_weather(weather_t *weather, bool not_modified, double *temp_c, char *weather_text,
+                                   int *timestamp)
+{
+    if (not_modified && weather->has_result) {
+        // 304: nothing changed, skip parsing and return the previous result
+        *temp_c = weather->temp_c;
+        strcpy(weather_text, weather->weather_text);
+        *timestamp = weather->timestamp;
+        return true;
+    }
+    // Convert temperature, weather condition and timestamp
+    TRACE_BEGIN("weather", "parse");
+    bool parsed = weather_analyse_weather_json(weather, temp_c, weather_text, timestamp);
+    TRACE_END("weather", "parse");
+    if (false == parsed) {
+        return false;
+    }
+
+    // Remember the result and its validators for the next conditional request
+    weather->has_result = true;
+    weather->temp_c = *temp_c;
+    strcpy(weather->weather_text, weather_text);
+    weather->timestamp = *timestamp;
+    strcpy(weather->etag, weather->pending_etag);
+    strcpy(weather->last_modified, weather->pending_last_modified);
     return true;
 }
 
+static void forecast_start(void *arg)
+{
+    weather_forecast_ctx_t *ctx = (weather_forecast_ctx_t*)arg;
+    weather_forecast_begin(ctx->forecast);
+}
+
+static void forecast_time_value(const char *value, size_t len, void *arg)
+{
+    (void)len;
+    weather_forecast_ctx_t *ctx = (weather_forecast_ctx_t*)arg;
+    int ts = 0;
+    if (weather_provider_parse_time(ctx->provider, value, &ts)) {
+        weather_forecast_push_time(ctx->forecast, ts);
+    }
+}
+
+static void forecast_temp_value(const char *value, size_t len, void *arg)
+{
+    (void)len;
+    weather_forecast_ctx_t *ctx = (weather_forecast_ctx_t*)arg;
+    double temp_c = 0.0;
+    if (weather_provider_parse_temp(ctx->provider, value, &temp_c)) {
+        weather_forecast_push_temp(ctx->forecast, temp_c);
+    }
+}
+
+/**
+ * @brief Set up the forecast extractor (ctx must not move while it is used, no tree is built)
+ */
+static void forecast_ctx_init(weather_forecast_ctx_t *ctx, const weather_provider_t *provider,
+                              weather_forecast_t *forecast)
+{
+    ctx->provider = provider;
+    ctx->forecast = forecast;
+    ctx->fields[0] = (json_stream_field_t){
+        .path = provider->forecast_time_path, .value = ctx->time_value, .value_size = sizeof(ctx->time_value),
+        .on_value = forecast_time_value, .arg = ctx,
+    };
+    ctx->fields[1] = (json_stream_field_t){
+        .path = provider->forecast_temp_path, .value = ctx->temp_value, .value_size = sizeof(ctx->temp_value),
+        .on_value = forecast_temp_value, .arg = ctx,
+    };
+    json_stream_init(&ctx->parser, ctx->fields, sizeof(ctx->fields) / sizeof(ctx->fields[0]));
+}
+
+static void async_on_header(const char *key, const char *value, void *arg)
+{
+    weather_t *weather = ((weather_async_ctx_t*)arg)->weather;
+    if (strcasecmp(key, "ETag") == 0) {
+        weather_copy_header(weather->pending_etag, WEATHER_ETAG_SIZE, value);
+    } else if (strcasecmp(key, "Last-Modified") == 0) {
+        weather_copy_header(weather->pending_last_modified, WEATHER_DATE_SIZE, value);
+    }
+}
+
+static void async_on_data(const char *data, int len, void *arg)
+{
+    weather_async_ctx_t *ctx = (weather_async_ctx_t*)arg;
+    if (!json_stream_feed(ctx->parser, data, len)) {
+        ESP_LOGD(TAG, "Malformed JSON chunk (%d bytes)", len);
+    }
+}
+
+static void async_on_done(esp_err_t err, int status, void *arg)
+{
+    weather_async_ctx_t *ctx = (weather_async_ctx_t*)arg;
+    ctx->err = err;
+    ctx->status = status;
+}
+
 
 // ---------------------- External API function ----------------------
 
@@ -180,14 +441,149 @@ bool weather_get_weather(weather_t* weather, double *temp_c, char *weather_text,
         ESP_LOGE(TAG, "Weather instance is NULL");
         return false;
     }
-    
-    // Send HTTP request to get JSON
-    if (false == weather_http_get_json(weather)) {
+
+    // Send HTTP request, the fields are extracted while the body streams in
+    weather_http_request_t request = {
+        .url = weather->provider->url,
+        .parser = &weather->parser,
+        .conditional = true,
+    };
+    bool not_modified = false;
+    if (false == weather_http_get_json(weather, &request, &not_modified)) {
         return false;
     }
-    // Parse JSON to get temperature and weather condition
-    if (false == weather_analyse_weather_json(weather, weather->json_response, temp_c, weather_text, timestamp)) {
+    return weather_accept_weather(weather, not_modified, temp_c, weather_text, timestamp);
+}
+
+bool weather_get_forecast(weather_t* weather, weather_forecast_t *forecast)
+{
+    if (weather == NULL || forecast == NULL) {
+        ESP_LOGE(TAG, "Invalid arguments");
         return false;
     }
-    return true;
-}
\ No newline at end of file
+    const weather_provider_t *provider = weather->provider;
+    if (provider->forecast_url == NULL) {
+        ESP_LOGW(TAG, "Provider %s has no forecast", provider->name);
+        return false;
+    }
+
+    weather_forecast_ctx_t ctx;
+    forecast_ctx_init(&ctx, provider, forecast);
+
+    weather_http_request_t request = {
+        .url = provider->forecast_url,
+        .parser = &ctx.parser,
+        .conditional = false,
+        .on_start = forecast_start,
+        .arg = &ctx,
+    };
+    bool not_modified = false;
+    bool success = weather_http_get_json(weather, &request, &not_modified);
+    weather->active_parser = NULL;  // The parser lives on this stack frame
+
+    weather_forecast_state_t state;
+    weather_forecast_get_state(forecast, &state);
+    ESP_LOGI(TAG, "Forecast: %u points in %lld ms", state.count, (long long)(weather->stats.last_latency_us / 1000));
+    return success && state.count > 0;
+}
+
+bool weather_get_weather_and_forecast(weather_t* weather, weather_forecast_t *forecast,
+                                      double *temp_c, char *weather_text, int *timestamp, bool *forecast_ok)
+{
+    if (weather == NULL || forecast == NULL || forecast_ok == NULL) {
+        ESP_LOGE(TAG, "Invalid arguments");
+        return false;
+    }
+    const weather_provider_t *provider = weather->provider;
+    *forecast_ok = false;
+
+    // Plain HTTP cannot use the async engine: one request after the other over the session
+    if (provider->forecast_url == NULL ||
+        !weather_async_supported(provider->url) || !weather_async_supported(provider->forecast_url)) {
+        if (false == weather_get_weather(weather, temp_c, weather_text, timestamp)) {
+            return false;
+        }
+        *forecast_ok = provider->forecast_url != NULL && weather_get_forecast(weather, forecast);
+        return true;
+    }
+    if (weather->async == NULL) {
+        weather->async = weather_async_create();
+        if (weather->async == NULL) {
+            return false;
+        }
+    }
+
+    // Start both documents
+    bool conditional = weather->has_result;
+    json_stream_reset(&weather->parser);
+    weather->pending_etag[0] = '\0';
+    weather->pending_last_modified[0] = '\0';
+    weather_forecast_ctx_t timeline;
+    forecast_ctx_init(&timeline, provider, forecast);
+    weather_forecast_begin(forecast);
+
+    weather_async_ctx_t ctx[2] = {
+        { .weather = weather, .parser = &weather->parser, .err = ESP_FAIL },
+        { .weather = weather, .parser = &timeline.parser, .err = ESP_FAIL },
+    };
+    const weather_async_request_t requests[2] = {
+        {
+            .url = provider->url,
+            .cert_pem = provider->cert_pem,
+            .if_none_match = conditional && weather->etag[0] != '\0' ? weather->etag : NULL,
+            .if_modified_since = conditional && weather->last_modified[0] != '\0' ? weather->last_modified : NULL,
+            .timeout_ms = WEATHER_HTTP_TIMEOUT_MS,
+            .on_header = async_on_header,
+            .on_data = async_on_data,
+            .on_done = async_on_done,
+            .arg = &ctx[0],
+        },
+        {
+            .url = provider->forecast_url,
+            .cert_pem = provider->cert_pem,
+            .timeout_ms = WEATHER_HTTP_TIMEOUT_MS,
+            .on_data = async_on_data,
+            .on_done = async_on_done,
+            .arg = &ctx[1],
+        },
+    };
+
+    int64_t start_us = esp_timer_get_time();
+    for (int i = 0; i < 2; i++) {
+        if (weather_async_submit(weather->async, &requests[i]) == ESP_OK) {
+            // Every async request opens its own connection
+            weather->stats.requests++;
+            weather->stats.connections++;
+        }
+    }
+    TRACE_BEGIN("weather", "request");
+    weather_async_run(weather->async);
+    TRACE_END("weather", "request");
+    weather->stats.last_latency_us = esp_timer_get_time() - start_us;
+
+    weather_forecast_state_t state;
+    weather_forecast_get_state(forecast, &state);
+    *forecast_ok = ctx[1].err == ESP_OK && ctx[1].status == 200 && state.count > 0;
+    ESP_LOGI(TAG, "HTTP status codes: %d (weather), %d (forecast, %u points) in %lld ms, concurrent",
+             ctx[0].status, ctx[1].status, state.count, (long long)(weather->stats.last_latency_us / 1000));
+
+    if (!*forecast_ok) {
+        weather->stats.failures++;
+    }
+    if (ctx[0].err != ESP_OK || (ctx[0].status != 200 && ctx[0].status != 304)) {
+        weather->stats.failures++;
+        return false;
+    }
+    if (ctx[0].status == 304) {
+        weather->stats.not_modified++;
+    }
+    return weather_accept_weather(weather, ctx[0].status == 304, temp_c, weather_text, timestamp);
+}
+
+void weather_get_stats(const weather_t* weather, weather_stats_t *stats)
+{
+    if (weather == NULL || stats == NULL) {
+        return;
+    }
+    *stats = weather->stats;
+}
@@ -0,0 +1,164 @@
+#include "weather_async.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <esp_log.h>
+#include <esp_http_client.h>
+#include <esp_timer.h>
+#include <esp_crt_bundle.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#define TAG "WeatherAsync"
+
+// ---------------------- Internal implementation functions ----------------------
+
+static esp_err_t async_event_handler(esp_http_client_event_t *evt)
+{
+    weather_async_slot_t *slot = (weather_async_slot_t*)evt->user_data;
+    if (slot == NULL) {
+        return ESP_FAIL;
+    }
+    if (evt->event_id == HTTP_EVENT_ON_HEADER && slot->request.on_header != NULL) {
+        slot->request.on_header(evt->header_key, evt->header_value, slot->request.arg);
+    } else if (evt->event_id == HTTP_EVENT_ON_DATA && slot->request.on_data != NULL) {
+        slot->request.on_data((const char*)evt->data, evt->data_len, slot->request.arg);
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Finish a request: release its client and report the result
+ */
+static void async_complete(weather_async_t *engine, weather_async_slot_t *slot, esp_err_t err)
+{
+    int status = 0;
+    if (err == ESP_OK) {
+        status = esp_http_client_get_status_code(slot->client);
+    }
+    esp_http_client_cleanup(slot->client);
+    slot->client = NULL;
+    slot->active = false;
+    engine->active_count--;
+
+    // The slot is free before the callback runs, so it may submit a follow-up request
+    weather_async_request_t request = slot->request;
+    if (request.on_done != NULL) {
+        request.on_done(err, status, request.arg);
+    }
+}
+
+// ---------------------- External API functions ----------------------
+
+weather_async_t* weather_async_create(void)
+{
+    weather_async_t *engine = (weather_async_t*)calloc(1, sizeof(weather_async_t));
+    if (engine == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate weather_async_t");
+    }
+    return engine;
+}
+
+void weather_async_destroy(weather_async_t *engine)
+{
+    if (engine == NULL) {
+        return;
+    }
+    for (int i = 0; i < WEATHER_ASYNC_MAX_REQUESTS; i++) {
+        if (engine->slots[i].client != NULL) {
+            esp_http_client_cleanup(engine->slots[i].client);
+        }
+    }
+    free(engine);
+}
+
+bool weather_async_supported(const char *url)
+{
+    // esp_http_client supports is_async over TLS only: a plain HTTP request
+    // could block inside perform() and stall every other slot
+    return url != NULL && strncmp(url, "https://", 8) == 0;
+}
+
+esp_err_t weather_async_submit(weather_async_t *engine, const weather_async_request_t *request)
+{
+    if (engine == NULL || request == NULL || request->url == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!weather_async_supported(request->url)) {
+        ESP_LOGE(TAG, "Async mode needs HTTPS: %s", request->url);
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    weather_async_slot_t *slot = NULL;
+    for (int i = 0; i < WEATHER_ASYNC_MAX_REQUESTS; i++) {
+        if (!engine->slots[i].active) {
+            slot = &engine->slots[i];
+            break;
+        }
+    }
+    if (slot == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    slot->request = *request;
+    esp_http_client_config_t config = {
+        .url = request->url,
+        .is_async = true,                           // perform() returns ESP_ERR_HTTP_EAGAIN instead of blocking
+        .timeout_ms = WEATHER_ASYNC_IO_TIMEOUT_MS,
+        .cert_pem = request->cert_pem,
+        .crt_bundle_attach = request->cert_pem ? NULL : esp_crt_bundle_attach,
+        .event_handler = async_event_handler,
+        .user_data = slot,
+    };
+    slot->client = esp_http_client_init(&config);
+    if (slot->client == NULL) {
+        ESP_LOGE(TAG, "Failed to init HTTP client for %s", request->url);
+        return ESP_FAIL;
+    }
+    if (request->if_none_match != NULL) {
+        esp_http_client_set_header(slot->client, "If-None-Match", request->if_none_match);
+    }
+    if (request->if_modified_since != NULL) {
+        esp_http_client_set_header(slot->client, "If-Modified-Since", request->if_modified_since);
+    }
+    slot->deadline_us = esp_timer_get_time() + (int64_t)request->timeout_ms * 1000;
+    slot->active = true;
+    engine->active_count++;
+    return ESP_OK;
+}
+
+uint32_t weather_async_poll(weather_async_t *engine)
+{
+    if (engine == NULL) {
+        return 0;
+    }
+
+    for (int i = 0; i < WEATHER_ASYNC_MAX_REQUESTS; i++) {
+        weather_async_slot_t *slot = &engine->slots[i];
+        if (!slot->active) {
+            continue;
+        }
+
+        // Each call resumes the request where it stopped (connect, send, headers, body)
+        esp_err_t err = esp_http_client_perform(slot->client);
+        if (err == ESP_ERR_HTTP_EAGAIN) {
+            if (esp_timer_get_time() >= slot->deadline_us) {
+                ESP_LOGW(TAG, "Request timed out: %s", slot->request.url);
+                async_complete(engine, slot, ESP_ERR_TIMEOUT);
+            }
+            continue;
+        }
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Request failed: %s (%s)", slot->request.url, esp_err_to_name(err));
+        }
+        async_complete(engine, slot, err);
+    }
+    return engine->active_count;
+}
+
+void weather_async_run(weather_async_t *engine)
+{
+    while (weather_async_poll(engine) > 0) {
+        vTaskDelay(1);  // Let lower priority tasks run while sockets are idle
+    }
+}
@@ -0,0 +1,59 @@
+#include "weather_cache.h"
+
+#include <nvs.h>
+
+#define TAG "WeatherCache"
+
+esp_err_t weather_cache_load(weather_cache_record_t *record)
+{
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open(WEATHER_CACHE_NAMESPACE, NVS_READONLY, &handle);
+    if (err != ESP_OK) {
+        // The namespace does not exist until the first store
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    size_t size = sizeof(*record);
+    err = nvs_get_blob(handle, WEATHER_CACHE_KEY, record, &size);
+    nvs_close(handle);
+
+    if (err != ESP_OK || size != sizeof(*record) || record->version != WEATHER_CACHE_VERSION) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    // Never trust the stored string to be terminated
+    record->weather_text[WEATHER_TEXT_SIZE - 1] = '\0';
+    return ESP_OK;
+}
+
+esp_err_t weather_cache_store(const weather_cache_record_t *record)
+{
+    weather_cache_record_t stored = *record;
+    stored.version = WEATHER_CACHE_VERSION;
+
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open(WEATHER_CACHE_NAMESPACE, NVS_READWRITE, &handle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "nvs_open failed: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    err = nvs_set_blob(handle, WEATHER_CACHE_KEY, &stored, sizeof(stored));
+    if (err == ESP_OK) {
+        err = nvs_commit(handle);
+    }
+    nvs_close(handle);
+
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to store record: %s", esp_err_to_name(err));
+    }
+    return err;
+}
+
+bool weather_cache_is_fresh(const weather_cache_record_t *record, int64_t now)
+{
+    // A clock behind the fetch time has not been set since boot: age unknown
+    if (now < record->fetched_at) {
+        return false;
+    }
+    return (now - record->fetched_at) < (int64_t)record->ttl_s;
+}
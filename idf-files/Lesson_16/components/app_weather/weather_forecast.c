@@ -0,0 +1,124 @@
+#include "weather_forecast.h"
+
+#include <math.h>
+#include <string.h>
+#include <esp_log.h>
+#include <esp_heap_caps.h>
+
+#define TAG "WeatherForecast"
+
+// ---------------------- Internal helper functions ----------------------
+
+static void *forecast_alloc(size_t size)
+{
+    // Large buffers go to PSRAM, internal RAM is kept for stacks and DMA
+    void *ptr = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (ptr == NULL) {
+        ptr = heap_caps_malloc(size, MALLOC_CAP_8BIT);
+    }
+    return ptr;
+}
+
+static void forecast_publish(weather_forecast_t *forecast)
+{
+    uint16_t count = forecast->time_count < forecast->temp_count ? forecast->time_count : forecast->temp_count;
+    atomic_store_explicit(&forecast->count, count, memory_order_release);
+}
+
+// ---------------------- External API functions ----------------------
+
+weather_forecast_t* weather_forecast_create(uint16_t capacity)
+{
+    weather_forecast_t *forecast = (weather_forecast_t*)calloc(1, sizeof(weather_forecast_t));
+    if (forecast == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate weather_forecast_t");
+        return NULL;
+    }
+    forecast->capacity = capacity;
+    forecast->time = (int32_t*)forecast_alloc(capacity * sizeof(int32_t));
+    forecast->temp_dc = (int16_t*)forecast_alloc(capacity * sizeof(int16_t));
+    if (forecast->time == NULL || forecast->temp_dc == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate %u forecast points", capacity);
+        weather_forecast_destroy(forecast);
+        return NULL;
+    }
+    atomic_init(&forecast->generation, 0);
+    atomic_init(&forecast->count, 0);
+    ESP_LOGI(TAG, "Forecast timeline: %u points, %u bytes", capacity,
+             (unsigned)(capacity * (sizeof(int32_t) + sizeof(int16_t))));
+    return forecast;
+}
+
+void weather_forecast_destroy(weather_forecast_t *forecast)
+{
+    if (forecast) {
+        heap_caps_free(forecast->time);
+        heap_caps_free(forecast->temp_dc);
+        free(forecast);
+    }
+}
+
+void weather_forecast_begin(weather_forecast_t *forecast)
+{
+    // Bump the generation before the arrays are overwritten: a release operation alone lets the later
+    // stores move above it, the fence keeps them after it (the same sequence as trace_evt_record())
+    atomic_store_explicit(&forecast->count, 0, memory_order_relaxed);
+    atomic_fetch_add_explicit(&forecast->generation, 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    forecast->time_count = 0;
+    forecast->temp_count = 0;
+}
+
+void weather_forecast_push_time(weather_forecast_t *forecast, int32_t time)
+{
+    if (forecast->time_count < forecast->capacity) {
+        forecast->time[forecast->time_count++] = time;
+        forecast_publish(forecast);
+    }
+}
+
+void weather_forecast_push_temp(weather_forecast_t *forecast, double temp_c)
+{
+    if (forecast->temp_count < forecast->capacity) {
+        forecast->temp_dc[forecast->temp_count++] = (int16_t)lround(temp_c * 10.0);
+        forecast_publish(forecast);
+    }
+}
+
+void weather_forecast_get_state(const weather_forecast_t *forecast, weather_forecast_state_t *state)
+{
+    while (1) {
+        uint32_t generation = atomic_load_explicit(&forecast->generation, memory_order_acquire);
+        uint16_t count = atomic_load_explicit(&forecast->count, memory_order_acquire);
+        if (atomic_load_explicit(&forecast->generation, memory_order_acquire) == generation) {
+            state->generation = generation;
+            state->count = count;
+            return;
+        }
+    }
+}
+
+size_t weather_forecast_copy(const weather_forecast_t *forecast, const weather_forecast_state_t *state,
+                             size_t start, size_t max, int32_t *time, int16_t *temp_dc)
+{
+    if (start >= state->count) {
+        return 0;
+    }
+    size_t n = state->count - start;
+    if (n > max) {
+        n = max;
+    }
+    if (time) {
+        memcpy(time, &forecast->time[start], n * sizeof(int32_t));
+    }
+    if (temp_dc) {
+        memcpy(temp_dc, &forecast->temp_dc[start], n * sizeof(int16_t));
+    }
+
+    // Points may have been overwritten by a new timeline during the copy
+    atomic_thread_fence(memory_order_acquire);
+    if (atomic_load_explicit(&forecast->generation, memory_order_relaxed) != state->generation) {
+        return 0;
+    }
+    return n;
+}
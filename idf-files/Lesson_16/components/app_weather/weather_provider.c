@@ -0,0 +1,170 @@
+#include "weather_provider.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ---------------------- Provider descriptors ----------------------
+
+// Elecrow demo API: {"data":{"temp":25.4,"weather":"Cloudy","timestamp":1734430000}}
+const weather_provider_t weather_provider_thinknode = {
+    .name = "thinknode",
+    .url = "http://service.thinknode.cc/api/users/weather",
+    .temp_path = "data.temp",
+    .text_path = "data.weather",
+    .time_path = "data.timestamp",
+    .temp_scale = 1.0,
+    .temp_offset = 0.0,
+    .text_format = WEATHER_TEXT_STRING,
+    .time_format = WEATHER_TIME_UNIX_S,
+};
+
+// Open-Meteo: {"current":{"time":"2025-12-17T14:00","temperature_2m":27.3,"weather_code":3}}
+const weather_provider_t weather_provider_open_meteo = {
+    .name = "open-meteo",
+    .url = "https://api.open-meteo.com/v1/forecast?latitude=" CONFIG_WEATHER_LATITUDE
+           "&longitude=" CONFIG_WEATHER_LONGITUDE "&current=temperature_2m,weather_code",
+    .temp_path = "current.temperature_2m",
+    .text_path = "current.weather_code",
+    .time_path = "current.time",
+    .temp_scale = 1.0,
+    .temp_offset = 0.0,
+    .text_format = WEATHER_TEXT_WMO_CODE,
+    .time_format = WEATHER_TIME_ISO8601,
+    // {"hourly":{"time":["2025-12-17T00:00",...],"temperature_2m":[21.5,...]}}
+    .forecast_url = "https://api.open-meteo.com/v1/forecast?latitude=" CONFIG_WEATHER_LATITUDE
+                    "&longitude=" CONFIG_WEATHER_LONGITUDE "&hourly=temperature_2m&forecast_days=7",
+    .forecast_time_path = "hourly.time",
+    .forecast_temp_path = "hourly.temperature_2m",
+};
+
+// OpenWeatherMap: {"weather":[{"description":"clear sky"}],"main":{"temp":27.3},"dt":1734430000}
+// Requested in Kelvin (the API default) to show the unit conversion.
+const weather_provider_t weather_provider_openweathermap = {
+    .name = "openweathermap",
+    .url = "https://api.openweathermap.org/data/2.5/weather?q=" CONFIG_WEATHER_CITY
+           "&appid=" CONFIG_WEATHER_API_KEY,
+    .temp_path = "main.temp",
+    .text_path = "weather.description",   // First element of the "weather" array
+    .time_path = "dt",
+    .temp_scale = 1.0,
+    .temp_offset = -273.15,
+    .text_format = WEATHER_TEXT_STRING,
+    .time_format = WEATHER_TIME_UNIX_S,
+    // 5 days in 3 hour steps: {"list":[{"dt":1734430000,"main":{"temp":300.4}},...]}
+    .forecast_url = "https://api.openweathermap.org/data/2.5/forecast?q=" CONFIG_WEATHER_CITY
+                    "&appid=" CONFIG_WEATHER_API_KEY,
+    .forecast_time_path = "list.dt",
+    .forecast_temp_path = "list.main.temp",
+};
+
+// ---------------------- Internal helper functions ----------------------
+
+// WMO weather interpretation codes used by Open-Meteo
+typedef struct {
+    int code;
+    const char *text;
+} wmo_text_t;
+
+static const wmo_text_t s_wmo_texts[] = {
+    { 0, "Clear sky" },        { 1, "Mainly clear" },      { 2, "Partly cloudy" },
+    { 3, "Overcast" },         { 45, "Fog" },              { 48, "Rime fog" },
+    { 51, "Light drizzle" },   { 53, "Drizzle" },          { 55, "Dense drizzle" },
+    { 56, "Freezing drizzle" }, { 57, "Freezing drizzle" },
+    { 61, "Light rain" },      { 63, "Rain" },             { 65, "Heavy rain" },
+    { 66, "Freezing rain" },   { 67, "Freezing rain" },
+    { 71, "Light snow" },      { 73, "Snow" },             { 75, "Heavy snow" },
+    { 77, "Snow grains" },
+    { 80, "Rain showers" },    { 81, "Rain showers" },     { 82, "Violent showers" },
+    { 85, "Snow showers" },    { 86, "Snow showers" },
+    { 95, "Thunderstorm" },    { 96, "Thunderstorm, hail" }, { 99, "Thunderstorm, hail" },
+};
+
+/**
+ * @brief Days since 1970-01-01 for a proleptic Gregorian date
+ */
+static long days_from_civil(int y, int m, int d)
+{
+    y -= m <= 2;
+    long era = (y >= 0 ? y : y - 399) / 400;
+    long yoe = y - era * 400;
+    long doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+static bool parse_iso8601(const char *text, int *timestamp)
+{
+    int y, mo, d, h, mi, s = 0;
+    if (sscanf(text, "%4d-%2d-%2dT%2d:%2d:%2d", &y, &mo, &d, &h, &mi, &s) < 5) {
+        return false;
+    }
+    if (mo < 1 || mo > 12 || d < 1 || d > 31) {
+        return false;
+    }
+    long long t = (long long)days_from_civil(y, mo, d) * 86400 + h * 3600 + mi * 60 + s;
+    *timestamp = (int)t;
+    return true;
+}
+
+// ---------------------- External API functions ----------------------
+
+bool weather_provider_parse_temp(const weather_provider_t *provider, const char *text, double *temp_c)
+{
+    char *end = NULL;
+    double value = strtod(text, &end);
+    if (end == text) {
+        return false;
+    }
+    *temp_c = value * provider->temp_scale + provider->temp_offset;
+    return true;
+}
+
+bool weather_provider_parse_text(const weather_provider_t *provider, const char *text, char *out, size_t size)
+{
+    if (provider->text_format == WEATHER_TEXT_STRING) {
+        snprintf(out, size, "%s", text);
+        return true;
+    }
+
+    char *end = NULL;
+    long code = strtol(text, &end, 10);
+    if (end == text) {
+        return false;
+    }
+    for (size_t i = 0; i < sizeof(s_wmo_texts) / sizeof(s_wmo_texts[0]); i++) {
+        if (s_wmo_texts[i].code == code) {
+            snprintf(out, size, "%s", s_wmo_texts[i].text);
+            return true;
+        }
+    }
+    snprintf(out, size, "Code %ld", code);
+    return true;
+}
+
+bool weather_provider_parse_time(const weather_provider_t *provider, const char *text, int *timestamp)
+{
+    char *end = NULL;
+
+    switch (provider->time_format) {
+        case WEATHER_TIME_ISO8601:
+            return parse_iso8601(text, timestamp);
+        case WEATHER_TIME_UNIX_MS: {
+            long long ms = strtoll(text, &end, 10);
+            if (end == text) {
+                return false;
+            }
+            *timestamp = (int)(ms / 1000);
+            return true;
+        }
+        case WEATHER_TIME_UNIX_S:
+        default: {
+            long long s = strtoll(text, &end, 10);
+            if (end == text) {
+                return false;
+            }
+            *timestamp = (int)s;
+            return true;
+        }
+    }
+}
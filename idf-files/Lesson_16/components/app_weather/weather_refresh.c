@@ -0,0 +1,229 @@
+#include "weather_refresh.h"
+
+#include <stdio.h>
+#include <time.h>
+#include <sys/time.h>
+#include <esp_timer.h>
+#include "trace_evt.h"
+
+#define TAG "WeatherRefresh"
+
+// ---------------------- Internal implementation functions ----------------------
+
+/**
+ * @brief Publish a snapshot: fill the back buffer, then swap the index
+ * @param refresh Instance pointer
+ * @param snapshot Snapshot to publish (seq is assigned here)
+ */
+static void weather_refresh_publish(weather_refresh_t *refresh, const weather_snapshot_t *snapshot)
+{
+    // Only the refresh task writes, so a relaxed load of our own counter is enough
+    uint_fast32_t gen = atomic_load_explicit(&refresh->published, memory_order_relaxed);
+    weather_snapshot_t *back = &refresh->snapshots[(gen + 1) & 1];
+
+    *back = *snapshot;
+    back->seq = (uint32_t)(gen + 1);
+    atomic_store_explicit(&refresh->published, gen + 1, memory_order_release);
+}
+
+/**
+ * @brief Fill the date and weekday strings of a snapshot
+ */
+static void weather_refresh_format_time(weather_snapshot_t *snapshot, time_t t)
+{
+    struct tm local_time;
+    localtime_r(&t, &local_time);  // Convert to local time
+    strftime(snapshot->date_str, sizeof(snapshot->date_str), "%Y/%m/%d", &local_time);
+    strftime(snapshot->week_str, sizeof(snapshot->week_str), "%A", &local_time);
+}
+
+/**
+ * @brief Publish the persisted record, if any, before the first fetch
+ */
+static void weather_refresh_load_cache(weather_refresh_t *refresh)
+{
+    if (weather_cache_load(&refresh->cached) != ESP_OK) {
+        ESP_LOGI(TAG, "No cached weather");
+        return;
+    }
+    refresh->has_cached = true;
+
+    weather_snapshot_t snapshot = {
+        .from_cache = true,
+        .temp_c = refresh->cached.temp_c,
+        .timestamp = refresh->cached.timestamp,
+    };
+    snprintf(snapshot.temp_text, sizeof(snapshot.temp_text), "%.1lf°C", snapshot.temp_c);
+    strcpy(snapshot.weather_text, refresh->cached.weather_text);
+    // The clock may not be set yet, so show the date the data was produced
+    weather_refresh_format_time(&snapshot, (time_t)refresh->cached.timestamp);
+    weather_refresh_publish(refresh, &snapshot);
+
+    // Stale-while-revalidate: a record still within its TTL postpones the first fetch
+    int64_t now = (int64_t)time(NULL);
+    if (weather_cache_is_fresh(&refresh->cached, now)) {
+        refresh->first_wait_ms = (uint32_t)(refresh->cached.fetched_at + refresh->cached.ttl_s - now) * 1000;
+    }
+    ESP_LOGI(TAG, "Published cached weather from %ld (%s)", (long)refresh->cached.timestamp,
+             refresh->first_wait_ms ? "fresh" : "stale, revalidating");
+}
+
+/**
+ * @brief Persist a fetched snapshot when its data changed or the stored record expired
+ */
+static void weather_refresh_store_cache(weather_refresh_t *refresh, const weather_snapshot_t *snapshot)
+{
+    int64_t now = (int64_t)time(NULL);
+
+    if (refresh->has_cached && refresh->cached.timestamp == snapshot->timestamp &&
+        weather_cache_is_fresh(&refresh->cached, now)) {
+        return;  // Limit flash writes to real changes
+    }
+
+    weather_cache_record_t record = {
+        .temp_c = snapshot->temp_c,
+        .timestamp = snapshot->timestamp,
+        .fetched_at = now,
+        .ttl_s = refresh->config.cache_ttl_s,
+    };
+    strcpy(record.weather_text, snapshot->weather_text);
+    if (weather_cache_store(&record) == ESP_OK) {
+        refresh->cached = record;
+        refresh->has_cached = true;
+    }
+}
+
+/**
+ * @brief Fetch the weather once and publish it
+ * @param refresh Instance pointer
+ * @return bool
+ */
+static bool weather_refresh_fetch(weather_refresh_t *refresh)
+{
+    weather_snapshot_t snapshot = {0};
+    weather_forecast_t *forecast = refresh->config.forecast;
+    bool forecast_ok = false;
+    bool fetched;
+
+    TRACE_BEGIN("weather", "get_weather");
+    if (forecast != NULL && esp_timer_get_time() >= refresh->forecast_due_us) {
+        // Forecast due: both requests in flight at once (HTTPS providers)
+        fetched = weather_get_weather_and_forecast(refresh->weather, forecast, &snapshot.temp_c,
+                                                   snapshot.weather_text, &snapshot.timestamp, &forecast_ok);
+    } else {
+        fetched = weather_get_weather(refresh->weather, &snapshot.temp_c, snapshot.weather_text, &snapshot.timestamp);
+    }
+    TRACE_END("weather", "get_weather");
+    if (forecast_ok) {
+        refresh->forecast_due_us = esp_timer_get_time() + (int64_t)refresh->config.forecast_period_ms * 1000;
+    }
+    if (!fetched) {
+        return false;
+    }
+    snprintf(snapshot.temp_text, sizeof(snapshot.temp_text), "%.1lf°C", snapshot.temp_c);
+
+    // Set the clock from the server only when it sent a new timestamp (a 304
+    // returns the previous one, which would rewind the clock)
+    if (snapshot.timestamp != refresh->last_timestamp) {
+        struct timeval tv = {
+            .tv_sec = snapshot.timestamp,  // second
+            .tv_usec = 0,   // Microsecond (0-999999）
+        };
+        settimeofday(&tv, NULL);
+        refresh->last_timestamp = snapshot.timestamp;
+    }
+
+    weather_refresh_format_time(&snapshot, time(NULL));
+
+    weather_refresh_publish(refresh, &snapshot);
+    ESP_LOGI(TAG, "Published %s %s %s", snapshot.temp_text, snapshot.weather_text, snapshot.date_str);
+
+    if (refresh->config.use_cache) {
+        weather_refresh_store_cache(refresh, &snapshot);
+    }
+    return true;
+}
+
+static void weather_refresh_task(void *param)
+{
+    weather_refresh_t *refresh = (weather_refresh_t*)param;
+
+    if (refresh->first_wait_ms > 0) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(refresh->first_wait_ms));
+    }
+
+    while (1) {
+        uint32_t wait_ms = refresh->config.retry_ms;
+
+        if (refresh->config.network_ready == NULL || refresh->config.network_ready()) {
+            if (weather_refresh_fetch(refresh)) {
+                wait_ms = refresh->config.period_ms;
+            }
+        } else {
+            ESP_LOGI(TAG, "Network not ready, waiting");
+        }
+
+        // Sleep until the next poll or an explicit trigger
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait_ms));
+    }
+}
+
+// ---------------------- External API functions ----------------------
+
+weather_refresh_t* weather_refresh_create(weather_t *weather, const weather_refresh_config_t *config)
+{
+    if (weather == NULL || config == NULL) {
+        ESP_LOGE(TAG, "Invalid arguments");
+        return NULL;
+    }
+
+    weather_refresh_t *refresh = (weather_refresh_t*)calloc(1, sizeof(weather_refresh_t));
+    if (refresh == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate weather_refresh_t");
+        return NULL;
+    }
+    refresh->weather = weather;
+    refresh->config = *config;
+    atomic_init(&refresh->published, 0);
+
+    if (config->use_cache) {
+        weather_refresh_load_cache(refresh);
+    }
+
+    if (xTaskCreate(weather_refresh_task, "weather_refresh", config->stack_size,
+                    refresh, config->priority, &refresh->task) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create refresh task");
+        free(refresh);
+        return NULL;
+    }
+    return refresh;
+}
+
+void weather_refresh_trigger(weather_refresh_t *refresh)
+{
+    if (refresh && refresh->task) {
+        xTaskNotifyGive(refresh->task);
+    }
+}
+
+bool weather_refresh_read(weather_refresh_t *refresh, weather_snapshot_t *snapshot)
+{
+    if (refresh == NULL || snapshot == NULL) {
+        return false;
+    }
+
+    while (1) {
+        uint_fast32_t gen = atomic_load_explicit(&refresh->published, memory_order_acquire);
+        if (gen == 0) {
+            return false;
+        }
+        *snapshot = refresh->snapshots[gen & 1];
+
+        // The writer only reuses this buffer after publishing the next snapshot;
+        // if that happened during the copy, read the newer one instead
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&refresh->published, memory_order_relaxed) == gen) {
+            return true;
+        }
+    }
+}
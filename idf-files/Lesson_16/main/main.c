@@ -13,6 +13,15 @@
 #include "bsp_display.h"
 #include "bsp_wifi.h"
 #include "weather.h"
+#include "weather_refresh.h"
+#include "ui_bind.h"
+#include "weather_screen.h"
+#include "lv_perf.h"
+#include "lv_parallel.h"
+#include "lv_glyph_cache.h"
+#include "img_pack.h"
+#include "trace_evt.h"
+#include "sys_profiler.h"
 
 #define TAG "MAIN"
 #define MAIN_INFO(fmt, ...) ESP_LOGI(TAG, fmt, ##__VA_ARGS__)
@@ -21,10 +30,208 @@
 
 #define init_fail(fmt, ...) ESP_LOGE(TAG, fmt":%d", ##__VA_ARGS__)
 
+#define WEATHER_UI_POLL_MS  500     // How often the UI looks for a new weather snapshot
+#define FORECAST_UI_BATCH   32      // Forecast points appended to the chart per poll
+
+static weather_refresh_t *s_weather_refresh = NULL;
+static uint32_t s_shown_seq = 0;    // Snapshot currently on screen
+static bool s_backlight_on = false;
+static bool s_first_frame_reported = false;
+
+/* Background: compressed in flash (ui/image_both_pack.c), decoded into PSRAM at boot */
+static lv_img_dsc_t s_background;
+
+static lv_obj_t *temperature_label_ = NULL;
+static lv_obj_t *weather_label_ = NULL;
+static lv_obj_t *date_label_ = NULL;
+static lv_obj_t *week_label_ = NULL;
+
+/* Label bindings: redrawn once per frame, only when the shown text changes */
+static ui_bind_group_t *s_ui_bind = NULL;
+static ui_bind_t *temperature_bind_ = NULL;
+static ui_bind_t *weather_bind_ = NULL;
+static ui_bind_t *date_bind_ = NULL;
+static ui_bind_t *week_bind_ = NULL;
+
+/* Forecast chart, appended point by point while the timeline streams in */
+static weather_forecast_t *s_forecast = NULL;
+static lv_obj_t *forecast_chart_ = NULL;
+static lv_chart_series_t *forecast_series_ = NULL;
+static uint32_t s_chart_generation = 0;
+static uint16_t s_chart_count = 0;
+static int16_t s_chart_min = INT16_MAX;
+static int16_t s_chart_max = INT16_MIN;
+
+/* Frame instrumentation (PERF_ENABLE 0 leaves the display driver untouched; set it to 1 to log frame times) */
+#define PERF_ENABLE     0
+#define PERF_OVERLAY    0       // Corner overlay, its own redraws show up in the numbers
+#define PERF_PERIOD_MS  5000
+static lv_perf_t *s_perf = NULL;
+
+/* Banded rendering: the second core blends half of every large area (PARALLEL_ENABLE 0 keeps one core).
+ * Off until Render_Bench shows a speedup on the device and its band-by-band image compare passes. */
+#define PARALLEL_ENABLE 0
+static lv_parallel_t *s_parallel = NULL;
+
+/* Glyph cache: the 48 and 30 px labels draw from ready-to-blend A8 glyphs (GLYPH_CACHE_ENABLE 0 decodes every redraw) */
+#define GLYPH_CACHE_ENABLE  1
+static lv_glyph_cache_t *s_glyph_cache = NULL;
+
+/* Event tracing: frames and the weather fetch stages, printed once as Chrome trace JSON (TRACE_ENABLE 0: no rings).
+ * Off by default: the rings take 256 KB of PSRAM per core; set it to 1 to capture a trace. */
+#define TRACE_ENABLE        0
+#define TRACE_DUMP_AFTER_MS 30000   // Leaves time for Wi-Fi and the first fetch
+static trace_evt_t *s_trace = NULL;
+
+/* Task CPU shares, stack high-water marks and heaps, logged as key=value lines (PROFILER_ENABLE 0: nothing sampled).
+ * Off by default: its timer wakes every period and the log lines crowd the weather output; set it to 1 when tuning. */
+#define PROFILER_ENABLE     0
+#define PROFILER_DASHBOARD  0   // Task table on the top layer
+#define PROFILER_PERIOD_MS  10000
+static sys_profiler_t *s_profiler = NULL;
+
+static volatile bool s_wifi_started = false;
+
+static bool wifi_ready(void)
+{
+    return s_wifi_started && WIFI_CONNECTED == bsp_wifi_get_state();
+}
+
+/**
+ * @brief Log the boot time at which weather data was first visible (once)
+ * Must be called with the LVGL lock held, after the backlight is on.
+ */
+static void report_first_useful_frame(const char *source)
+{
+    if (s_first_frame_reported || s_shown_seq == 0) {
+        return;
+    }
+    s_first_frame_reported = true;
+    ui_bind_flush(s_ui_bind);   // Apply the bound texts without waiting for the next frame
+    lv_refr_now(NULL);  // Flush the frame now so the measurement includes rendering
+    MAIN_INFO("Time to first useful frame: %lld ms (%s)", esp_timer_get_time() / 1000, source);
+}
+
+/**
+ * @brief Append newly published forecast points to the chart
+ */
+static void forecast_chart_update(void)
+{
+    if (s_forecast == NULL || forecast_chart_ == NULL) {
+        return;
+    }
+
+    weather_forecast_state_t state;
+    weather_forecast_get_state(s_forecast, &state);
+    if (state.generation != s_chart_generation) {
+        // A new timeline started: clear the chart and follow it from the beginning
+        lv_chart_set_all_value(forecast_chart_, forecast_series_, LV_CHART_POINT_NONE);
+        s_chart_generation = state.generation;
+        s_chart_count = 0;
+        s_chart_min = INT16_MAX;
+        s_chart_max = INT16_MIN;
+    }
+    if (state.count <= s_chart_count) {
+        return;
+    }
+
+    int16_t temps[FORECAST_UI_BATCH];
+    size_t n = weather_forecast_copy(s_forecast, &state, s_chart_count, FORECAST_UI_BATCH, NULL, temps);
+    for (size_t i = 0; i < n; i++) {
+        lv_chart_set_value_by_id(forecast_chart_, forecast_series_, s_chart_count + i, temps[i]);
+        if (temps[i] < s_chart_min) s_chart_min = temps[i];
+        if (temps[i] > s_chart_max) s_chart_max = temps[i];
+    }
+    if (n == 0) {
+        return;  // Overwritten by a newer timeline, picked up on the next poll
+    }
+    s_chart_count += n;
+
+    // Values are tenths of a degree; keep the axis on whole 5 degree steps
+    int16_t low = (int16_t)((s_chart_min - 50 * (s_chart_min < 0)) / 50 * 50);
+    int16_t high = (int16_t)((s_chart_max + 50 * (s_chart_max >= 0)) / 50 * 50);
+    lv_chart_set_range(forecast_chart_, LV_CHART_AXIS_PRIMARY_Y, low, high);
+    lv_chart_refresh(forecast_chart_);
+}
+
+/**
+ * @brief LVGL timer: show the latest weather snapshot (runs in the LVGL task)
+ */
+static void weather_ui_timer_cb(lv_timer_t *timer)
+{
+    (void)timer;
+    weather_snapshot_t snapshot;
+
+    forecast_chart_update();
+
+    // Never blocks: the refresh task publishes by swapping a buffer index
+    if (!weather_refresh_read(s_weather_refresh, &snapshot) || snapshot.seq == s_shown_seq) {
+        return;
+    }
+    s_shown_seq = snapshot.seq;
+
+    ui_bind_set_float(temperature_bind_, (float)snapshot.temp_c);
+    ui_bind_set_string(weather_bind_, snapshot.weather_text);
+    ui_bind_set_string(date_bind_, snapshot.date_str);
+    ui_bind_set_string(week_bind_, snapshot.week_str);
+
+    ui_bind_stats_t stats;
+    ui_bind_get_stats(s_ui_bind, &stats);
+    MAIN_DEBUG("UI bindings: %lu sets, %lu redraws, %lu avoided", (unsigned long)stats.sets,
+               (unsigned long)stats.redraws, (unsigned long)(stats.unchanged + stats.coalesced + stats.same_text));
+
+    if (s_backlight_on) {
+        report_first_useful_frame(snapshot.from_cache ? "cache" : "network");
+    }
+}
+
+/**
+ * @brief Build the weather screen (weather_screen.c) and bind its labels
+ */
+static void weather_ui_create(void)
+{
+    IMG_PACK_DECLARE(image_both_pack);
+
+    // A plain background is better than no screen if the decode fails
+    const void *background = NULL;
+    if (img_pack_load(&image_both_pack, &s_background) == ESP_OK) {
+        background = &s_background;
+    }
+
+    weather_screen_t screen;
+    if (weather_screen_create(lv_scr_act(), background, WEATHER_FORECAST_CAPACITY, &screen) != ESP_OK) {
+        MAIN_ERROR("Weather layout failed");
+        return;
+    }
+    temperature_label_ = screen.temperature_label;
+    weather_label_ = screen.weather_label;
+    date_label_ = screen.date_label;
+    week_label_ = screen.week_label;
+    forecast_chart_ = screen.forecast_chart;
+    forecast_series_ = screen.forecast_series;
+
+    // Bindings (temperature shown like "25.4°C")
+    s_ui_bind = ui_bind_group_create();
+    temperature_bind_ = ui_bind_float(s_ui_bind, temperature_label_, "%.1f°C", 1, 1, NULL);
+    weather_bind_ = ui_bind_string(s_ui_bind, weather_label_, NULL);
+    date_bind_ = ui_bind_string(s_ui_bind, date_label_, NULL);
+    week_bind_ = ui_bind_string(s_ui_bind, week_label_, NULL);
+
+    // Labels are refreshed from the LVGL task, never from the network task
+    lv_timer_create(weather_ui_timer_cb, WEATHER_UI_POLL_MS, NULL);
+    // Show the cached snapshot, if one was published, in the very first frame
+    weather_ui_timer_cb(NULL);
+}
+
 void app_main(void)
 {
     static esp_ldo_channel_handle_t ldo3 = NULL;
     esp_err_t err = ESP_OK;
+    if (TRACE_ENABLE) {
+        trace_evt_config_t trace_config = TRACE_EVT_DEFAULT_CONFIG();
+        trace_config.events_per_core = 8192;    // 30 s of banded frames, 256 KB per core in PSRAM
+        s_trace = trace_evt_create(&trace_config);
+    }
     esp_ldo_channel_config_t ldo3_cof = {
         .chan_id = 3,
         .voltage_mv = 2500,
@@ -53,108 +260,64 @@ void app_main(void)
     if (err != ESP_OK)
         init_fail("display", err);
 
-    bsp_wifi_init();
-    bsp_wifi_sta_init();
-    bsp_wifi_connect("yanfa_software", "yanfa-123456");
-
+    // Fetching runs in its own task; the UI only reads published snapshots.
+    // The last record persisted in NVS is published right away.
     weather_t* weather_handle = weather_create();
-    char temp_text[32];
-    double temp_c = 0.0;
-    char weather_text[64];
-    int timestamp = 0;
-    char date_str[64];
-    char week_str[64];
-        
-    while (1) {
-        if (WIFI_CONNECTED == bsp_wifi_get_state()) {
-            if (weather_get_weather(weather_handle, &temp_c, weather_text, &timestamp)) {
-                snprintf(temp_text, sizeof(temp_text), "%.1lf°C", temp_c);
-                struct timeval tv = {
-                    .tv_sec = 0,  // second
-                    .tv_usec = 0,   // Microsecond (0-999999）
-                };
-                tv.tv_sec = timestamp;
-                settimeofday(&tv, NULL);
-
-                // %D  Month/Day/Year
-                // %e In a two-digit format, the day of the month (in decimal representation) for the current month
-                // %F Year-Month-Day
-                time_t now = time(NULL);
-                struct tm *local_time;
-                local_time = localtime(&now);  // Convert to local time
-                strftime(date_str, sizeof(date_str), "%Y/%m/%d", local_time);
-                strftime(week_str, sizeof(week_str), "%A", local_time);
-                ESP_LOGI(TAG, "time(NULL): %d", (int)time(NULL));
-                break;
-            }
-        } else {
-            MAIN_INFO("WIFI connecting......");
+    weather_refresh_config_t refresh_config = WEATHER_REFRESH_DEFAULT_CONFIG();
+    refresh_config.network_ready = wifi_ready;
+    s_forecast = weather_forecast_create(WEATHER_FORECAST_CAPACITY);
+    refresh_config.forecast = s_forecast;   // NULL (no chart data) if the allocation failed
+    s_weather_refresh = weather_refresh_create(weather_handle, &refresh_config);
+    if (s_weather_refresh == NULL)
+        init_fail("weather refresh", ESP_FAIL);
+
+    if (lvgl_port_lock(0)) {
+        weather_ui_create();
+        if (GLYPH_CACHE_ENABLE) {
+            lv_glyph_cache_config_t glyph_config = LV_GLYPH_CACHE_DEFAULT_CONFIG();
+            s_glyph_cache = lv_glyph_cache_create(&glyph_config);
+            if (s_glyph_cache == NULL)
+                MAIN_ERROR("Glyph cache unavailable, decoding glyphs on every redraw");
+            lv_glyph_cache_apply(s_glyph_cache, lv_scr_act());  // Warms up the digits of the temperature and date
+        }
+        lv_perf_config_t perf_config = LV_PERF_DEFAULT_CONFIG();
+        perf_config.period_ms = PERF_PERIOD_MS;
+        perf_config.overlay = PERF_OVERLAY;
+        s_perf = lv_perf_create(&perf_config);
+        lv_perf_enable(s_perf, PERF_ENABLE);
+        if (PROFILER_ENABLE) {
+            sys_profiler_config_t profiler_config = SYS_PROFILER_DEFAULT_CONFIG();
+            profiler_config.period_ms = PROFILER_PERIOD_MS;
+            profiler_config.dashboard = PROFILER_DASHBOARD;
+            s_profiler = sys_profiler_create(&profiler_config);
         }
-        vTaskDelay(pdMS_TO_TICKS(1000));
+        if (PARALLEL_ENABLE) {
+            lv_parallel_config_t parallel_config = LV_PARALLEL_DEFAULT_CONFIG();
+            s_parallel = lv_parallel_create(NULL, &parallel_config);
+            if (s_parallel == NULL)
+                MAIN_ERROR("Banded rendering unavailable, drawing on one core");
+        }
+        lvgl_port_unlock();
     }
 
-    LV_IMG_DECLARE(image_both);
-
-    lv_obj_t *ui_home = NULL;
-    lv_obj_t *temperature_label_ = NULL;
-    lv_obj_t *weather_label_ = NULL;
-    lv_obj_t *date_label_ = NULL;
-    lv_obj_t *week_label_ = NULL;
+    set_lcd_blight(100);    // At this point, turn on the screen backlight
 
     if (lvgl_port_lock(0)) {
-        
-        ui_home = lv_img_create(lv_scr_act());
-        lv_img_set_src(ui_home, &image_both);
-        lv_obj_align(ui_home, LV_ALIGN_TOP_LEFT, 0, 0);  // Full-screen alignment
-        lv_obj_set_size(ui_home, LV_HOR_RES, LV_VER_RES); // Full-screen size
-
-        lv_obj_clear_flag(ui_home, (lv_obj_flag_t)(LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_SCROLL_ELASTIC | LV_OBJ_FLAG_SCROLL_MOMENTUM));
-        lv_obj_set_style_bg_opa(ui_home, LV_OPA_COVER, LV_PART_MAIN | LV_STATE_DEFAULT);
-        lv_obj_set_style_radius(ui_home, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-        lv_obj_set_style_text_align(ui_home, LV_TEXT_ALIGN_RIGHT, 0); 
-
-
-        // ========== 1. Temperature label ==========
-        temperature_label_ = lv_label_create(ui_home);
-        lv_obj_set_width(temperature_label_, LV_HOR_RES);
-        lv_obj_set_height(temperature_label_, LV_SIZE_CONTENT);
-        lv_obj_align(temperature_label_, LV_ALIGN_TOP_RIGHT, -50, 80); // Offset to the upper right corner
-        lv_label_set_text(temperature_label_, temp_text); // for example "25.4℃"
-        // Font size maximum
-        lv_obj_set_style_text_font(temperature_label_, &lv_font_montserrat_48, 0); // Increase the font size
-        lv_obj_set_style_text_color(temperature_label_, lv_color_hex(0xFFFFFF), 0); // White is more eye-catching.
-
-
-        // ========== 2. Weather label (below the temperature, with a slightly smaller font size) ==========
-        weather_label_ = lv_label_create(ui_home);
-        lv_obj_set_width(weather_label_, LV_HOR_RES);
-        lv_obj_set_height(weather_label_, LV_SIZE_CONTENT);
-        lv_obj_align(weather_label_, LV_ALIGN_TOP_RIGHT, -50, 140); 
-        lv_label_set_text(weather_label_, weather_text); // for example "Partly Cloudy"
-        lv_obj_set_style_text_font(weather_label_, &lv_font_montserrat_30, 0); // Font size is smaller than temperature.
-        lv_obj_set_style_text_color(weather_label_, lv_color_hex(0xFFFFFF), 0);
-
-        // ========== 3. Date label (below the weather section) ==========
-        date_label_ = lv_label_create(ui_home);
-        lv_obj_set_width(date_label_, LV_HOR_RES);
-        lv_obj_set_height(date_label_, LV_SIZE_CONTENT);
-        lv_obj_align(date_label_, LV_ALIGN_TOP_RIGHT, -50, 180); 
-        lv_label_set_text(date_label_, date_str); // for example "2025/12/17"
-        lv_obj_set_style_text_font(date_label_, &lv_font_montserrat_30, 0);
-        lv_obj_set_style_text_color(date_label_, lv_color_hex(0xFFFFFF), 0);
-
-        // ========== 4. Week label (below the date) ==========
-        week_label_ = lv_label_create(ui_home); 
-        lv_obj_set_width(week_label_, LV_HOR_RES);
-        lv_obj_set_height(week_label_, LV_SIZE_CONTENT);
-        lv_obj_align(week_label_, LV_ALIGN_TOP_RIGHT, -50, 220); 
-        lv_label_set_text(week_label_, week_str); // for example "Wednesday"
-        lv_obj_set_style_text_font(week_label_, &lv_font_montserrat_30, 0);
-        lv_obj_set_style_text_color(week_label_, lv_color_hex(0xFFFFFF), 0);
-
+        s_backlight_on = true;
+        report_first_useful_frame("cache");
         lvgl_port_unlock();
     }
 
-    set_lcd_blight(100);    // At this point, turn on the screen backlight
+    // Wi-Fi comes up after the first frame; the refresh task waits for it
+    bsp_wifi_init();
+    bsp_wifi_sta_init();
+    bsp_wifi_connect("yanfa_software", "yanfa-123456");
+    s_wifi_started = true;
+
+    if (s_trace) {
+        // Copy the lines between the markers into a .json file
+        vTaskDelay(pdMS_TO_TICKS(TRACE_DUMP_AFTER_MS));
+        trace_evt_dump(s_trace);
+    }
 
 }
\ No newline at end of file
@@ -0,0 +1,48 @@
+// Generated by idf-files/tools/ui_layout.py from weather_layout.json, do not edit
+#include "weather_layout.h"
+
+static const lv_style_const_prop_t weather_layout_home_props[] = {
+    LV_STYLE_CONST_BG_OPA(LV_OPA_COVER),
+    LV_STYLE_CONST_RADIUS(0),
+    LV_STYLE_CONST_TEXT_ALIGN(LV_TEXT_ALIGN_RIGHT),
+    LV_STYLE_PROP_INV,
+};
+static LV_STYLE_CONST_INIT(weather_layout_home, weather_layout_home_props);
+
+static const lv_style_const_prop_t weather_layout_temperature_props[] = {
+    LV_STYLE_CONST_TEXT_FONT(&lv_font_montserrat_48),
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0xFF, 0xFF, 0xFF)),
+    LV_STYLE_PROP_INV,
+};
+static LV_STYLE_CONST_INIT(weather_layout_temperature, weather_layout_temperature_props);
+
+static const lv_style_const_prop_t weather_layout_info_props[] = {
+    LV_STYLE_CONST_TEXT_FONT(&lv_font_montserrat_30),
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0xFF, 0xFF, 0xFF)),
+    LV_STYLE_PROP_INV,
+};
+static LV_STYLE_CONST_INIT(weather_layout_info, weather_layout_info_props);
+
+static const lv_style_const_prop_t weather_layout_chart_props[] = {
+    LV_STYLE_CONST_BG_OPA(LV_OPA_TRANSP),
+    LV_STYLE_CONST_BORDER_WIDTH(0),
+    LV_STYLE_PROP_INV,
+};
+static LV_STYLE_CONST_INIT(weather_layout_chart, weather_layout_chart_props);
+
+// type, parent, align_to, align, x, y, w, h, style, text
+static const ui_layout_obj_t weather_layout_objs[] = {
+    {UI_LAYOUT_IMG, UI_LAYOUT_ROOT, UI_LAYOUT_ROOT, LV_ALIGN_TOP_LEFT, 0, 0, LV_PCT(100), LV_PCT(100), &weather_layout_home, NULL},  // home
+    {UI_LAYOUT_LABEL, 0, UI_LAYOUT_ROOT, LV_ALIGN_TOP_RIGHT, -50, 80, LV_PCT(100), LV_SIZE_CONTENT, &weather_layout_temperature, "--.-°C"},  // temperature
+    {UI_LAYOUT_LABEL, 0, UI_LAYOUT_ROOT, LV_ALIGN_TOP_RIGHT, -50, 140, LV_PCT(100), LV_SIZE_CONTENT, &weather_layout_info, "Connecting..."},  // weather
+    {UI_LAYOUT_LABEL, 0, UI_LAYOUT_ROOT, LV_ALIGN_TOP_RIGHT, -50, 180, LV_PCT(100), LV_SIZE_CONTENT, &weather_layout_info, ""},  // date
+    {UI_LAYOUT_LABEL, 0, UI_LAYOUT_ROOT, LV_ALIGN_TOP_RIGHT, -50, 220, LV_PCT(100), LV_SIZE_CONTENT, &weather_layout_info, ""},  // week
+    {UI_LAYOUT_CHART, 0, UI_LAYOUT_ROOT, LV_ALIGN_BOTTOM_MID, 0, -30, 0, 0, &weather_layout_chart, NULL},  // forecast_chart
+};
+
+const ui_layout_t weather_layout = {
+    .name = "weather_layout",
+    .root_style = NULL,
+    .objs = weather_layout_objs,
+    .count = sizeof(weather_layout_objs) / sizeof(weather_layout_objs[0]),
+};
@@ -0,0 +1,17 @@
+// Generated by idf-files/tools/ui_layout.py from weather_layout.json, do not edit
+#ifndef _WEATHER_LAYOUT_H
+#define _WEATHER_LAYOUT_H
+
+#include "ui_layout.h"
+
+#define WEATHER_LAYOUT_HOME 0
+#define WEATHER_LAYOUT_TEMPERATURE 1
+#define WEATHER_LAYOUT_WEATHER 2
+#define WEATHER_LAYOUT_DATE 3
+#define WEATHER_LAYOUT_WEEK 4
+#define WEATHER_LAYOUT_FORECAST_CHART 5
+#define WEATHER_LAYOUT_COUNT 6
+
+UI_LAYOUT_DECLARE(weather_layout);
+
+#endif // _WEATHER_LAYOUT_H
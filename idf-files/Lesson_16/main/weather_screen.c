@@ -0,0 +1,36 @@
+#include "weather_screen.h"
+#include "ui/weather_layout.h"
+
+esp_err_t weather_screen_create(lv_obj_t *scr, const void *background, uint16_t chart_points, weather_screen_t *screen)
+{
+    // Labels and placement live in ui/weather_layout.json, compiled to const tables by tools/ui_layout.py
+    lv_obj_t *objs[WEATHER_LAYOUT_COUNT];
+    esp_err_t err = ui_layout_build(&weather_layout, scr, objs);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    lv_obj_t *ui_home = objs[WEATHER_LAYOUT_HOME];
+    if (background) {
+        lv_img_set_src(ui_home, background);
+    } else {
+        lv_obj_set_style_bg_color(ui_home, lv_color_hex(0x203040), LV_PART_MAIN | LV_STATE_DEFAULT);
+    }
+    lv_obj_clear_flag(ui_home, (lv_obj_flag_t)(LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_SCROLL_ELASTIC | LV_OBJ_FLAG_SCROLL_MOMENTUM));
+
+    screen->temperature_label = objs[WEATHER_LAYOUT_TEMPERATURE];
+    screen->weather_label = objs[WEATHER_LAYOUT_WEATHER];
+    screen->date_label = objs[WEATHER_LAYOUT_DATE];
+    screen->week_label = objs[WEATHER_LAYOUT_WEEK];
+
+    // Forecast chart: its width follows the display, its points the forecast capacity
+    screen->forecast_chart = objs[WEATHER_LAYOUT_FORECAST_CHART];
+    lv_obj_set_size(screen->forecast_chart, LV_HOR_RES - 100, 180);
+    lv_chart_set_type(screen->forecast_chart, LV_CHART_TYPE_LINE);
+    lv_chart_set_point_count(screen->forecast_chart, chart_points);
+    lv_chart_set_div_line_count(screen->forecast_chart, 0, 0);
+    lv_obj_set_style_size(screen->forecast_chart, 0, LV_PART_INDICATOR);   // No point markers
+    screen->forecast_series = lv_chart_add_series(screen->forecast_chart, lv_color_hex(0xFFFFFF), LV_CHART_AXIS_PRIMARY_Y);
+    lv_chart_set_all_value(screen->forecast_chart, screen->forecast_series, LV_CHART_POINT_NONE);
+    return ESP_OK;
+}
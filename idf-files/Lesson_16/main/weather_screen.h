@@ -0,0 +1,32 @@
+
+#ifndef _WEATHER_SCREEN_H
+#define _WEATHER_SCREEN_H
+
+#include <stdint.h>
+#include <esp_err.h>
+#include "lvgl.h"
+
+
+// Objects updated at run time
+typedef struct {
+    lv_obj_t *temperature_label;
+    lv_obj_t *weather_label;
+    lv_obj_t *date_label;
+    lv_obj_t *week_label;
+    lv_obj_t *forecast_chart;
+    lv_chart_series_t *forecast_series;
+} weather_screen_t;
+
+
+/**
+ * @brief Build the weather screen from ui/weather_layout.json with placeholder texts (LVGL and ui_layout only,
+ * also used by the Render_Bench host build)
+ * @param scr Screen to draw on, called with the LVGL lock held
+ * @param background Full-screen image source, NULL for a plain dark background
+ * @param chart_points Number of forecast points on the chart
+ * @param screen Output of the objects updated at run time
+ * @return esp_err_t ESP_OK on success, otherwise the error of ui_layout_build()
+ */
+esp_err_t weather_screen_create(lv_obj_t *scr, const void *background, uint16_t chart_points, weather_screen_t *screen);
+
+#endif // _WEATHER_SCREEN_H
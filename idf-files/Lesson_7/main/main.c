@@ -1,6 +1,9 @@
 /*————————————————————————————————————————Header file declaration————————————————————————————————————————*/
 #include "bsp_illuminate.h"  // Include LCD initialization and backlight control interface
 #include "lvgl.h"         // Include LVGL graphics library API
+#include "ui_layout.h"     // Include the table-driven screen builder
+#include "ui/hello_layout.h"  // Include the screen layout (generated from ui/hello_layout.json)
+#include "lv_glyph_cache.h"  // Include the glyph cache for the large font
 #include "freertos/FreeRTOS.h"  // Include FreeRTOS core header
 #include "freertos/task.h"      // Include FreeRTOS task API
 #include "esp_ldo_regulator.h"  // Include LDO (Low Dropout Regulator) API
@@ -28,50 +31,14 @@ static void lvgl_show_hello_elecrow(void)
         return;
     }
 
-    lv_obj_t *screen = lv_scr_act();
-    lv_obj_set_style_bg_color(screen, LV_COLOR_WHITE, LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(screen, LV_OPA_COVER, LV_PART_MAIN);
-
-    static lv_style_t label_style;
-    static bool style_inited = false;
-    if (!style_inited) {
-        lv_style_init(&label_style);
-        lv_style_set_text_font(&label_style, &lv_font_montserrat_42);
-        lv_style_set_text_color(&label_style, LV_COLOR_BLACK);
-        lv_style_set_bg_opa(&label_style, LV_OPA_TRANSP);
-        style_inited = true;
+    if (ui_layout_build(&hello_layout, lv_scr_act(), NULL) != ESP_OK) {  // Styles and texts stay in flash
+        MAIN_ERROR("Hello layout failed");
     }
 
-    static lv_style_t rect_style;
-    static bool rect_style_inited = false;
-    if (!rect_style_inited) {
-        lv_style_init(&rect_style);
-        lv_style_set_border_width(&rect_style, 4);
-        lv_style_set_border_color(&rect_style, LV_COLOR_BLACK);
-        lv_style_set_border_opa(&rect_style, LV_OPA_COVER);
-        lv_style_set_radius(&rect_style, 10);
-        lv_style_set_pad_all(&rect_style, 20);
-        lv_style_set_bg_opa(&rect_style, LV_OPA_TRANSP);
-        rect_style_inited = true;
-    }
-
-    // Container for both lines
-    lv_obj_t *rect = lv_obj_create(screen);
-    lv_obj_add_style(rect, &rect_style, LV_PART_MAIN);
-    lv_obj_set_size(rect, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
-    lv_obj_center(rect);
-
-    // First line INSIDE rectangle
-    lv_obj_t *label1 = lv_label_create(rect);
-    lv_obj_add_style(label1, &label_style, LV_PART_MAIN);
-    lv_label_set_text(label1, "Hello Elecrow");
-    lv_obj_align(label1, LV_ALIGN_TOP_MID, 0, 0);
-
-    // Second line INSIDE rectangle
-    lv_obj_t *label2 = lv_label_create(rect);
-    lv_obj_add_style(label2, &label_style, LV_PART_MAIN);
-    lv_label_set_text(label2, "Greetings from the south of the world.");
-    lv_obj_align_to(label2, label1, LV_ALIGN_OUT_BOTTOM_MID, 0, 10);
+    // Decode the 42 px glyphs once instead of on every redraw (left undecoded if the cache can't be created)
+    lv_glyph_cache_config_t glyph_config = LV_GLYPH_CACHE_DEFAULT_CONFIG();
+    glyph_config.prewarm = "Hello Elecrow";  // The text this screen shows
+    lv_glyph_cache_apply(lv_glyph_cache_create(&glyph_config), lv_scr_act());
 
     lvgl_port_unlock();
 }
@@ -0,0 +1,45 @@
+// Generated by idf-files/tools/ui_layout.py from hello_layout.json, do not edit
+#include "hello_layout.h"
+
+static const lv_style_const_prop_t hello_layout_screen_props[] = {
+    LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(0xFF, 0xFF, 0xFF)),
+    LV_STYLE_CONST_BG_OPA(LV_OPA_COVER),
+    LV_STYLE_PROP_INV,
+};
+static LV_STYLE_CONST_INIT(hello_layout_screen, hello_layout_screen_props);
+
+static const lv_style_const_prop_t hello_layout_label_props[] = {
+    LV_STYLE_CONST_TEXT_FONT(&lv_font_montserrat_42),
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+    LV_STYLE_CONST_BG_OPA(LV_OPA_TRANSP),
+    LV_STYLE_PROP_INV,
+};
+static LV_STYLE_CONST_INIT(hello_layout_label, hello_layout_label_props);
+
+static const lv_style_const_prop_t hello_layout_frame_props[] = {
+    LV_STYLE_CONST_BORDER_WIDTH(4),
+    LV_STYLE_CONST_BORDER_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+    LV_STYLE_CONST_BORDER_OPA(LV_OPA_COVER),
+    LV_STYLE_CONST_RADIUS(10),
+    LV_STYLE_CONST_PAD_TOP(20),
+    LV_STYLE_CONST_PAD_BOTTOM(20),
+    LV_STYLE_CONST_PAD_LEFT(20),
+    LV_STYLE_CONST_PAD_RIGHT(20),
+    LV_STYLE_CONST_BG_OPA(LV_OPA_TRANSP),
+    LV_STYLE_PROP_INV,
+};
+static LV_STYLE_CONST_INIT(hello_layout_frame, hello_layout_frame_props);
+
+// type, parent, align_to, align, x, y, w, h, style, text
+static const ui_layout_obj_t hello_layout_objs[] = {
+    {UI_LAYOUT_OBJ, UI_LAYOUT_ROOT, UI_LAYOUT_ROOT, LV_ALIGN_CENTER, 0, 0, LV_SIZE_CONTENT, LV_SIZE_CONTENT, &hello_layout_frame, NULL},  // frame
+    {UI_LAYOUT_LABEL, 0, UI_LAYOUT_ROOT, LV_ALIGN_TOP_MID, 0, 0, 0, 0, &hello_layout_label, "Hello Elecrow"},  // title
+    {UI_LAYOUT_LABEL, 0, 1, LV_ALIGN_OUT_BOTTOM_MID, 0, 10, 0, 0, &hello_layout_label, "Greetings from the south of the world."},  // subtitle
+};
+
+const ui_layout_t hello_layout = {
+    .name = "hello_layout",
+    .root_style = &hello_layout_screen,
+    .objs = hello_layout_objs,
+    .count = sizeof(hello_layout_objs) / sizeof(hello_layout_objs[0]),
+};
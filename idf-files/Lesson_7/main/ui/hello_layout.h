@@ -0,0 +1,14 @@
+// Generated by idf-files/tools/ui_layout.py from hello_layout.json, do not edit
+#ifndef _HELLO_LAYOUT_H
+#define _HELLO_LAYOUT_H
+
+#include "ui_layout.h"
+
+#define HELLO_LAYOUT_FRAME 0
+#define HELLO_LAYOUT_TITLE 1
+#define HELLO_LAYOUT_SUBTITLE 2
+#define HELLO_LAYOUT_COUNT 3
+
+UI_LAYOUT_DECLARE(hello_layout);
+
+#endif // _HELLO_LAYOUT_H
@@ -1,10 +1,18 @@
 // main.c
 #include "main.h"
+#include "ui_bind.h"
+#include "ui_layout.h"
+#include "boot_graph.h"
+#include "ui/led_control_layout.h"
 
 /* Status Window */
 static bool s_led_on = false;                // current LED state
 static lv_obj_t *s_led_status_label = NULL;  // status label handle
 
+/* Label bindings: redrawn once per frame, only when the shown text changes */
+static ui_bind_group_t *s_ui_bind = NULL;
+static ui_bind_t *s_led_status_bind = NULL;
+
 // Forward declarations
 static void update_led_status_label(void);
 
@@ -35,71 +43,34 @@ static void btn_off_click_event(lv_event_t *e)
 /* Create LED control UI */
 static void create_led_control_ui(void)
 {
-    // Create main screen
-    lv_obj_t *scr = lv_scr_act();
-    lv_obj_set_style_bg_color(scr, lv_color_hex(0xFFFFFF), LV_PART_MAIN);  // Set white background
-
-    // Create title label
-    lv_obj_t *label = lv_label_create(scr);
-    lv_label_set_text(label, "LED Controller");
-    lv_obj_align(label, LV_ALIGN_TOP_MID, 0, 50);
-    // Font size
-    lv_obj_set_style_text_font(label, &lv_font_montserrat_24, 0);
-
-    // Create LED ON button
-    lv_obj_t *btn_on = lv_btn_create(scr);
-    lv_obj_set_size(btn_on, 120, 50);
-    lv_obj_align(btn_on, LV_ALIGN_CENTER, 0, -40);
-    lv_obj_add_event_cb(btn_on, btn_on_click_event, LV_EVENT_CLICKED, NULL);
-
-    // ON button label
-    lv_obj_t *label_on = lv_label_create(btn_on);
-    lv_label_set_text(label_on, "LED ON");
-
-    // Create LED OFF button
-    lv_obj_t *btn_off = lv_btn_create(scr);
-    lv_obj_set_size(btn_off, 120, 50);
-    lv_obj_align(btn_off, LV_ALIGN_CENTER, 0, 40);
-    lv_obj_add_event_cb(btn_off, btn_off_click_event, LV_EVENT_CLICKED, NULL);
-
-    // OFF button label
-    lv_obj_t *label_off = lv_label_create(btn_off);
-    lv_label_set_text(label_off, "LED OFF");
-
-    // --- Status window ---
-    static lv_style_t status_style;
-    static bool status_style_inited = false;
-    if (!status_style_inited) {
-        lv_style_init(&status_style);
-        lv_style_set_border_width(&status_style, 2);
-        lv_style_set_border_color(&status_style, LV_COLOR_BLACK);
-        lv_style_set_border_opa(&status_style, LV_OPA_COVER);
-        lv_style_set_pad_all(&status_style, 8);
-        lv_style_set_bg_opa(&status_style, LV_OPA_TRANSP);
-        status_style_inited = true;
+    // Runs in a boot stage task while the LVGL task is already up
+    if (!lvgl_port_lock(0)) {
+        MAIN_ERROR("LVGL lock failed in create_led_control_ui");
+        return;
     }
 
-    lv_obj_t *status_cont = lv_obj_create(scr);
-    lv_obj_add_style(status_cont, &status_style, LV_PART_MAIN);
-    lv_obj_set_size(status_cont, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
-    lv_obj_align(status_cont, LV_ALIGN_BOTTOM_MID, 0, -20);
+    // Screen layout lives in ui/led_control_layout.json, compiled to const tables by tools/ui_layout.py
+    lv_obj_t *objs[LED_CONTROL_LAYOUT_COUNT];
+    if (ui_layout_build(&led_control_layout, lv_scr_act(), objs) != ESP_OK) {
+        MAIN_ERROR("LED control layout failed");
+        lvgl_port_unlock();
+        return;
+    }
+    lv_obj_add_event_cb(objs[LED_CONTROL_LAYOUT_BTN_ON], btn_on_click_event, LV_EVENT_CLICKED, NULL);
+    lv_obj_add_event_cb(objs[LED_CONTROL_LAYOUT_BTN_OFF], btn_off_click_event, LV_EVENT_CLICKED, NULL);
+    s_led_status_label = objs[LED_CONTROL_LAYOUT_STATUS];
 
-    s_led_status_label = lv_label_create(status_cont);
-    lv_label_set_text(s_led_status_label, "LED Status: OFF");
-    lv_obj_center(s_led_status_label);
+    // Status text follows s_led_on through a binding
+    s_ui_bind = ui_bind_group_create();
+    s_led_status_bind = ui_bind_bool(s_ui_bind, s_led_status_label, "LED Status: ON", "LED Status: OFF");
+
+    lvgl_port_unlock();
 }
 
-/* Helper to refresh status text */
+/* Helper to refresh status text (safe from any task, redrawn on the next frame if changed) */
 static void update_led_status_label(void)
 {
-    if (!s_led_status_label) {
-        return;
-    }
-    if (s_led_on) {
-        lv_label_set_text(s_led_status_label, "LED Status: ON");
-    } else {
-        lv_label_set_text(s_led_status_label, "LED Status: OFF");
-    }
+    ui_bind_set_bool(s_led_status_bind, s_led_on);
 }
 
 /**
@@ -117,60 +88,111 @@ static void init_fail_handler(const char *module_name, esp_err_t err) {
  • @brief System initialization (LDO + LCD + backlight + other hardware)
 
  */
-static void system_init(void) {
+// ---------------------- Boot stages ----------------------
+
+static esp_err_t boot_ldo(void *ctx) {
+    (void)ctx;
     esp_err_t err = ESP_OK;
 
-    // 1. Initialize LDO (required for screen)
+    // LDO3 and LDO4 power the screen
     esp_ldo_channel_config_t ldo3_cof = {
         .chan_id = 3,
         .voltage_mv = 2500,
     };
-    err = esp_ldo_acquire_channel(&ldo3_cof, &ldo3);
-    if (err != ESP_OK) init_fail_handler("ldo3", err);
+    if (!ldo3 && (err = esp_ldo_acquire_channel(&ldo3_cof, &ldo3)) != ESP_OK) return err;
 
     esp_ldo_channel_config_t ldo4_cof = {
         .chan_id = 4,
         .voltage_mv = 3300,
     };
-    err = esp_ldo_acquire_channel(&ldo4_cof, &ldo4);
-    if (err != ESP_OK) init_fail_handler("ldo4", err);
+    if (!ldo4 && (err = esp_ldo_acquire_channel(&ldo4_cof, &ldo4)) != ESP_OK) return err;
     MAIN_INFO("LDO3 and LDO4 init success");
+    return ESP_OK;
+}
+
+static esp_err_t boot_i2c(void *ctx) {
+    (void)ctx;
+    esp_err_t err = i2c_init();
+    if (err == ESP_OK) MAIN_INFO("I2C init success");
+    return err;
+}
+
+static esp_err_t boot_touch(void *ctx) {
+    (void)ctx;
+    esp_err_t err = touch_init();
+    if (err == ESP_OK) MAIN_INFO("Touch panel init success");
+    return err;
+}
+
+static esp_err_t boot_display(void *ctx) {
+    (void)ctx;
+    esp_err_t err = display_init();
+    if (err == ESP_OK) MAIN_INFO("LCD init success");
+    return err;
+}
 
-    // 2. Initialize I2C (required for touch chip)
-    MAIN_INFO("Initializing I2C...");
-    err = i2c_init();
-    if (err != ESP_OK) init_fail_handler("I2C", err);
-    MAIN_INFO("I2C init success");
-
-    // 3. Initialize touch panel (low-level driver)
-    MAIN_INFO("Initializing touch panel...");
-    err = touch_init();
-    if (err != ESP_OK) init_fail_handler("Touch", err);
-    MAIN_INFO("Touch panel init success");
-
-    // 4. Initialize LCD hardware and LVGL (must initialize before turning on backlight)
-    err = display_init();
-    if (err != ESP_OK) init_fail_handler("LCD", err);
-    MAIN_INFO("LCD init success");
-
-    // 5. Turn on LCD backlight (brightness set to 100 = max)
-    err = set_lcd_blight(100);
-    if (err != ESP_OK) init_fail_handler("LCD Backlight", err);
-    MAIN_INFO("LCD backlight opened (brightness: 100)");
-
-    // 6. Initialize LED control GPIO (GPIO48)
-    MAIN_INFO("Initializing GPIO48 for LED...");
-    err = gpio_extra_init();
-    if (err != ESP_OK) init_fail_handler("GPIO48", err);
+static esp_err_t boot_backlight(void *ctx) {
+    (void)ctx;
+    esp_err_t err = set_lcd_blight(100);
+    if (err == ESP_OK) MAIN_INFO("LCD backlight opened (brightness: 100)");
+    return err;
+}
+
+static esp_err_t boot_led(void *ctx) {
+    (void)ctx;
+    esp_err_t err = gpio_extra_init();
+    if (err != ESP_OK) return err;
     gpio_extra_set_level(false);  // Initially turn off LED
     MAIN_INFO("LED initialized to OFF state");
+    return ESP_OK;
+}
 
-    // 7. Create UI
+static esp_err_t boot_ui(void *ctx) {
+    (void)ctx;
     create_led_control_ui();
     MAIN_INFO("UI created successfully");
-
-    // 8. Update status label
     update_led_status_label();
+    return ESP_OK;
+}
+
+// Each stage starts once the stages it depends on have succeeded,
+// so the LED GPIO comes up while the display is still initializing
+enum {
+    STAGE_LDO = 0,
+    STAGE_I2C,
+    STAGE_TOUCH,
+    STAGE_DISPLAY,
+    STAGE_BACKLIGHT,
+    STAGE_LED,
+    STAGE_UI,
+};
+
+static const boot_stage_t s_boot_stages[] = {
+    [STAGE_LDO]       = {.name = "ldo", .init = boot_ldo},
+    [STAGE_I2C]       = {.name = "i2c", .init = boot_i2c},
+    [STAGE_TOUCH]     = {.name = "touch", .init = boot_touch, .deps = BOOT_DEP(STAGE_LDO) | BOOT_DEP(STAGE_I2C)},
+    // LCD hardware and LVGL must be up before the backlight turns on
+    [STAGE_DISPLAY]   = {.name = "display", .init = boot_display, .deps = BOOT_DEP(STAGE_LDO) | BOOT_DEP(STAGE_TOUCH),
+                         .stack_size = 6144},
+    [STAGE_BACKLIGHT] = {.name = "backlight", .init = boot_backlight, .deps = BOOT_DEP(STAGE_DISPLAY)},
+    [STAGE_LED]       = {.name = "led", .init = boot_led, .deps = BOOT_DEP(STAGE_LDO)},
+    [STAGE_UI]        = {.name = "ui", .init = boot_ui, .deps = BOOT_DEP(STAGE_DISPLAY) | BOOT_DEP(STAGE_LED)},
+};
+
+static void system_init(void) {
+    boot_graph_config_t boot_config = BOOT_GRAPH_DEFAULT_CONFIG();
+    boot_graph_t *boot = boot_graph_create(&boot_config);
+    if (!boot) init_fail_handler("Boot graph", ESP_ERR_NO_MEM);
+    for (size_t i = 0; i < sizeof(s_boot_stages) / sizeof(s_boot_stages[0]); i++) {
+        if (boot_graph_add(boot, &s_boot_stages[i]) != (int)i) init_fail_handler(s_boot_stages[i].name, ESP_ERR_INVALID_ARG);
+    }
+
+    esp_err_t err = boot_graph_run(boot);
+    boot_graph_log_report(boot);
+    if (err != ESP_OK) {
+        const boot_graph_report_t *report = boot_graph_get_report(boot);
+        init_fail_handler(report->failed >= 0 ? s_boot_stages[report->failed].name : "boot", err);
+    }
 }
 
 
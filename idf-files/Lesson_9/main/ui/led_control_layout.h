@@ -0,0 +1,16 @@
+// Generated by idf-files/tools/ui_layout.py from led_control_layout.json, do not edit
+#ifndef _LED_CONTROL_LAYOUT_H
+#define _LED_CONTROL_LAYOUT_H
+
+#include "ui_layout.h"
+
+#define LED_CONTROL_LAYOUT_TITLE 0
+#define LED_CONTROL_LAYOUT_BTN_ON 1
+#define LED_CONTROL_LAYOUT_BTN_OFF 3
+#define LED_CONTROL_LAYOUT_STATUS_FRAME 5
+#define LED_CONTROL_LAYOUT_STATUS 6
+#define LED_CONTROL_LAYOUT_COUNT 7
+
+UI_LAYOUT_DECLARE(led_control_layout);
+
+#endif // _LED_CONTROL_LAYOUT_H
@@ -0,0 +1,204 @@
+// blend_bench.c - lv_fast_blend kernels against LVGL's software blend
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <esp_log.h>
+
+#include "lvgl.h"
+#include "lv_fast_blend.h"
+#include "blend_bench.h"
+
+#define TAG "BlendBench"
+#define BENCH_INFO(fmt, ...) ESP_LOGI(TAG, fmt, ##__VA_ARGS__)
+#define BENCH_ERROR(fmt, ...) ESP_LOGE(TAG, fmt, ##__VA_ARGS__)
+
+#define BLEND_BENCH_W       1024
+#define BLEND_BENCH_H       60      // One draw buffer of the lessons (a tenth of the screen)
+#define BLEND_BENCH_REPEAT  50
+
+typedef struct {
+    const char *name;
+    bool image;         // Image source instead of a color
+    bool masked;        // Through an A8 coverage mask
+    lv_opa_t opa;
+    bool aliased;       // Display anti-aliasing off: LVGL rounds the mask first
+} blend_case_t;
+
+// What the lesson screens blend: backgrounds, panels, anti-aliased text and borders, images.
+// Then the edges of LVGL's own thresholds: opa LV_OPA_MAX and 254, and masks without anti-aliasing.
+static const blend_case_t s_cases[] = {
+    {"fill", false, false, LV_OPA_COVER},
+    {"fill_opa", false, false, LV_OPA_50},
+    {"fill_mask", false, true, LV_OPA_COVER},
+    {"fill_mask_opa", false, true, LV_OPA_70},
+    {"copy", true, false, LV_OPA_COVER},
+    {"copy_opa", true, false, LV_OPA_50},
+    {"copy_mask", true, true, LV_OPA_COVER},
+    {"copy_mask_opa", true, true, LV_OPA_70},
+    {"fill_opa_max", false, false, LV_OPA_MAX},
+    {"fill_mask_opa_max", false, true, LV_OPA_MAX},
+    {"fill_mask_opa_254", false, true, 254},
+    {"copy_opa_max", true, false, LV_OPA_MAX},
+    {"copy_mask_opa_max", true, true, LV_OPA_MAX},
+    {"copy_mask_opa_254", true, true, 254},
+    {"fill_mask_aliased", false, true, LV_OPA_COVER, true},
+    {"copy_mask_opa_aliased", true, true, LV_OPA_70, true},
+};
+
+typedef struct {
+    const char *name;
+    const lv_fast_blend_kernels_t *kernels;     // NULL for LVGL's own blend
+} blend_impl_t;
+
+static const blend_impl_t s_impls[] = {
+    {"lvgl", NULL},
+    {"scalar", &lv_fast_blend_scalar},
+#if LV_FAST_BLEND_HAS_SIMD
+    {"simd", &lv_fast_blend_simd},
+#endif
+};
+
+typedef struct {
+    lv_color_t *dest;
+    lv_color_t *base;       // Destination content before each blend
+    lv_color_t *expect;     // LVGL's result
+    lv_color_t *src;
+    lv_opa_t *mask;
+    lv_opa_t *mask_base;    // Mask content before each blend: without anti-aliasing LVGL rounds it in place
+} blend_buffers_t;
+
+/* -------------------------------------------------------------------------- */
+/* Measurement                                                                */
+/* -------------------------------------------------------------------------- */
+
+static uint64_t blend_bench_now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void blend_bench_fill(blend_buffers_t *buf)
+{
+    uint32_t seed = 12345;  // Fixed: the same pixels every run
+    for (int i = 0; i < BLEND_BENCH_W * BLEND_BENCH_H; i++) {
+        seed = seed * 1103515245 + 12345;
+        int x = i % BLEND_BENCH_W;
+        int y = i / BLEND_BENCH_W;
+        // A black first row, as a cleared buffer: LVGL's unmasked opa fill mixes leading black differently
+        buf->base[i] = y == 0 ? lv_color_black() : lv_color_make(x / 4, y * 4, 255 - x / 4);
+        buf->src[i] = lv_color_make((seed >> 8) & 255, (seed >> 16) & 255, (seed >> 24) & 255);
+        // Glyph-like coverage: mostly empty or solid, anti-aliased edges in between
+        uint8_t r = (seed >> 12) & 255;
+        buf->mask_base[i] = r < 128 ? LV_OPA_TRANSP : (r < 208 ? LV_OPA_COVER : (lv_opa_t)((seed >> 4) & 255));
+    }
+}
+
+static bool blend_bench_once(const blend_impl_t *impl, lv_draw_ctx_t *ctx, const lv_draw_sw_blend_dsc_t *dsc)
+{
+    if (impl->kernels == NULL) {
+        lv_draw_sw_blend_basic(ctx, dsc);
+        return true;
+    }
+    return lv_fast_blend_dispatch(impl->kernels, ctx, dsc);
+}
+
+static bool blend_bench_case(const blend_case_t *c, blend_buffers_t *buf)
+{
+    lv_area_t area = {0, 0, BLEND_BENCH_W - 1, BLEND_BENCH_H - 1};
+    lv_draw_sw_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.base_draw.buf = buf->dest;
+    ctx.base_draw.buf_area = &area;
+    ctx.base_draw.clip_area = &area;
+
+    lv_draw_sw_blend_dsc_t dsc;
+    memset(&dsc, 0, sizeof(dsc));
+    dsc.blend_area = &area;
+    dsc.src_buf = c->image ? buf->src : NULL;
+    dsc.color = lv_color_make(40, 200, 90);
+    dsc.mask_buf = c->masked ? buf->mask : NULL;
+    dsc.mask_res = c->masked ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER;
+    dsc.mask_area = &area;
+    dsc.opa = c->opa;
+    dsc.blend_mode = LV_BLEND_MODE_NORMAL;
+
+    lv_disp_drv_t *driver = lv_disp_get_default()->driver;
+    uint32_t antialiasing = driver->antialiasing;
+    driver->antialiasing = c->aliased ? 0 : 1;
+
+    const uint32_t px = BLEND_BENCH_W * BLEND_BENCH_H;
+    bool passed = true;
+    uint64_t lvgl_us = 0;
+    for (size_t i = 0; i < sizeof(s_impls) / sizeof(s_impls[0]); i++) {
+        const blend_impl_t *impl = &s_impls[i];
+
+        // Pixels: one blend over the same destination and mask
+        memcpy(buf->dest, buf->base, px * sizeof(lv_color_t));
+        memcpy(buf->mask, buf->mask_base, px);
+        if (!blend_bench_once(impl, (lv_draw_ctx_t*)&ctx, &dsc)) {
+            BENCH_ERROR("blend=%s impl=%s not handled", c->name, impl->name);
+            passed = false;
+            continue;
+        }
+        uint32_t diff_px = 0;
+        if (impl->kernels == NULL) {
+            memcpy(buf->expect, buf->dest, px * sizeof(lv_color_t));
+        } else {
+            for (uint32_t p = 0; p < px; p++) {
+                diff_px += buf->dest[p].full != buf->expect[p].full;
+            }
+        }
+
+        uint64_t start = blend_bench_now_us();
+        for (int r = 0; r < BLEND_BENCH_REPEAT; r++) {
+            blend_bench_once(impl, (lv_draw_ctx_t*)&ctx, &dsc);
+        }
+        uint64_t us = blend_bench_now_us() - start;
+        if (us == 0) us = 1;
+        if (impl->kernels == NULL) lvgl_us = us;
+
+        BENCH_INFO("blend=%s impl=%s mpx_per_s=%.1f speedup=%.2f diff_px=%lu", c->name, impl->name,
+                   (double)px * BLEND_BENCH_REPEAT / us, (double)lvgl_us / us, (unsigned long)diff_px);
+        if (diff_px) {
+            passed = false;
+        }
+    }
+    driver->antialiasing = antialiasing;
+    return passed;
+}
+
+bool blend_bench_run(void)
+{
+    const uint32_t px = BLEND_BENCH_W * BLEND_BENCH_H;
+    blend_buffers_t buf = {
+        .dest = (lv_color_t*)malloc(px * sizeof(lv_color_t)),
+        .base = (lv_color_t*)malloc(px * sizeof(lv_color_t)),
+        .expect = (lv_color_t*)malloc(px * sizeof(lv_color_t)),
+        .src = (lv_color_t*)malloc(px * sizeof(lv_color_t)),
+        .mask = (lv_opa_t*)malloc(px),
+        .mask_base = (lv_opa_t*)malloc(px),
+    };
+    bool passed = false;
+    if (buf.dest && buf.base && buf.expect && buf.src && buf.mask && buf.mask_base) {
+        blend_bench_fill(&buf);
+
+        // Both blends read the driver of the display being refreshed
+        _lv_refr_set_disp_refreshing(lv_disp_get_default());
+        passed = true;
+        for (size_t i = 0; i < sizeof(s_cases) / sizeof(s_cases[0]); i++) {
+            passed &= blend_bench_case(&s_cases[i], &buf);
+        }
+        _lv_refr_set_disp_refreshing(NULL);
+    } else {
+        BENCH_ERROR("Failed to allocate the benchmark buffers");
+    }
+
+    free(buf.dest);
+    free(buf.base);
+    free(buf.expect);
+    free(buf.src);
+    free(buf.mask);
+    free(buf.mask_base);
+    return passed;
+}
@@ -0,0 +1,14 @@
+#ifndef _BLEND_BENCH_H
+#define _BLEND_BENCH_H
+
+#include <stdbool.h>
+
+
+/**
+ * @brief Time LVGL's software blend and the lv_fast_blend kernels on one draw buffer, and compare their pixels
+ * Call after lv_init() and with a display registered.
+ * @return bool Returns false when a kernel set gives different pixels than LVGL
+ */
+bool blend_bench_run(void);
+
+#endif // _BLEND_BENCH_H
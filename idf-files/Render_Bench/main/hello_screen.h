@@ -0,0 +1,15 @@
+
+#ifndef _HELLO_SCREEN_H
+#define _HELLO_SCREEN_H
+
+#include "lvgl.h"
+
+
+/**
+ * @brief Build the "Hello Elecrow" screen of Lesson 07 by hand
+ * Hand-written form of Lesson_7/main/ui/hello_layout.json, the reference of the construction benchmark.
+ * @param screen Screen to draw on, called with the LVGL lock held
+ */
+void hello_screen_create(lv_obj_t *screen);
+
+#endif // _HELLO_SCREEN_H
@@ -0,0 +1,159 @@
+// img_bench.c - img_pack size and decode throughput on the host
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <esp_log.h>
+
+#include "img_pack.h"
+#include "img_bench.h"
+
+#define TAG "ImgBench"
+#define BENCH_INFO(fmt, ...) ESP_LOGI(TAG, fmt, ##__VA_ARGS__)
+#define BENCH_ERROR(fmt, ...) ESP_LOGE(TAG, fmt, ##__VA_ARGS__)
+
+#define IMG_BENCH_W         1024
+#define IMG_BENCH_H         600
+#define IMG_BENCH_DECODES   20
+
+typedef enum {
+    IMG_BENCH_UI = 0,       // Flat panels and cards, like a dashboard background
+    IMG_BENCH_GRADIENT,     // Smooth two-axis gradient
+    IMG_BENCH_PHOTO,        // Gradients with sensor-like noise, close to the worst case
+} img_bench_kind_t;
+
+static const char *s_kind_names[] = {"ui", "gradient", "photo"};
+
+/* -------------------------------------------------------------------------- */
+/* Synthetic images                                                           */
+/* -------------------------------------------------------------------------- */
+
+static uint16_t img_bench_rgb565(int r, int g, int b)
+{
+    r = r < 0 ? 0 : (r > 255 ? 255 : r);
+    g = g < 0 ? 0 : (g > 255 ? 255 : g);
+    b = b < 0 ? 0 : (b > 255 ? 255 : b);
+    return (uint16_t)(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+}
+
+static void img_bench_fill(img_bench_kind_t kind, uint16_t *px)
+{
+    uint32_t seed = 12345;  // Fixed: the same image every run
+
+    for (int y = 0; y < IMG_BENCH_H; y++) {
+        for (int x = 0; x < IMG_BENCH_W; x++) {
+            int r, g, b;
+            switch (kind) {
+                case IMG_BENCH_UI: {
+                    bool card = (x % 256) > 24 && (y % 200) > 24;
+                    r = card ? 245 : 32;
+                    g = card ? 245 : 96;
+                    b = card ? 250 : 200;
+                    break;
+                }
+                case IMG_BENCH_GRADIENT:
+                    r = x * 255 / IMG_BENCH_W;
+                    g = y * 255 / IMG_BENCH_H;
+                    b = 255 - (x + y) * 255 / (IMG_BENCH_W + IMG_BENCH_H);
+                    break;
+                default:
+                    seed = seed * 1103515245 + 12345;
+                    int noise = (int)((seed >> 16) & 15) - 8;
+                    r = x * 200 / IMG_BENCH_W + 30 + noise;
+                    g = y * 180 / IMG_BENCH_H + 40 + noise;
+                    b = 160 - y * 100 / IMG_BENCH_H + noise;
+                    break;
+            }
+            px[y * IMG_BENCH_W + x] = img_bench_rgb565(r, g, b);
+        }
+    }
+}
+
+static uint64_t img_bench_now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/* -------------------------------------------------------------------------- */
+/* Measurement                                                                */
+/* -------------------------------------------------------------------------- */
+
+static bool img_bench_kind(img_bench_kind_t kind, uint16_t *px, uint8_t *stream, size_t stream_size)
+{
+    const char *name = s_kind_names[kind];
+    img_bench_fill(kind, px);
+    size_t size = img_pack_encode(px, IMG_BENCH_W, IMG_BENCH_H, stream, stream_size);
+    img_pack_asset_t asset = {.name = name, .data = stream, .size = (uint32_t)size};
+
+    uint32_t raw = IMG_BENCH_W * IMG_BENCH_H * 2;
+    uint32_t raw_alpha = IMG_BENCH_W * IMG_BENCH_H * 3;
+    BENCH_INFO("image=%s raw_565a8=%lu raw_565=%lu packed=%lu ratio=%.1f%%", name,
+               (unsigned long)raw_alpha, (unsigned long)raw, (unsigned long)size, 100.0 * size / raw);
+
+    lv_img_dsc_t dsc;
+    uint64_t best_us = UINT64_MAX, total_us = 0;
+    for (int i = 0; i < IMG_BENCH_DECODES; i++) {
+        uint64_t start = img_bench_now_us();
+        if (img_pack_load(&asset, &dsc) != ESP_OK) {
+            BENCH_ERROR("image=%s decode failed", name);
+            return false;
+        }
+        uint64_t us = img_bench_now_us() - start;
+        total_us += us;
+        if (us < best_us) best_us = us;
+
+        bool same = memcmp(dsc.data, px, raw) == 0;
+        img_pack_unload(&dsc);
+        if (!same) {
+            BENCH_ERROR("image=%s decoded pixels differ", name);
+            return false;
+        }
+    }
+    uint64_t avg_us = total_us / IMG_BENCH_DECODES;
+    BENCH_INFO("image=%s decode_us=%lu/%lu (best/avg) mpx_per_s=%.1f mb_per_s=%.1f", name,
+               (unsigned long)best_us, (unsigned long)avg_us,
+               (double)IMG_BENCH_W * IMG_BENCH_H / (avg_us ? avg_us : 1),
+               (double)raw / (avg_us ? avg_us : 1));
+    return true;
+}
+
+bool img_bench_run(void)
+{
+    size_t stream_size = img_pack_encode_bound(IMG_BENCH_W, IMG_BENCH_H);
+    uint16_t *px = (uint16_t*)malloc(IMG_BENCH_W * IMG_BENCH_H * sizeof(uint16_t));
+    uint8_t *stream = (uint8_t*)malloc(stream_size);
+    if (px == NULL || stream == NULL) {
+        BENCH_ERROR("Failed to allocate the benchmark buffers");
+        free(px);
+        free(stream);
+        return false;
+    }
+
+    bool passed = true;
+    for (int kind = IMG_BENCH_UI; kind <= IMG_BENCH_PHOTO; kind++) {
+        passed &= img_bench_kind((img_bench_kind_t)kind, px, stream, stream_size);
+    }
+
+    free(px);
+    free(stream);
+    return passed;
+}
+
+bool img_bench_background(lv_img_dsc_t *dsc)
+{
+    size_t stream_size = img_pack_encode_bound(IMG_BENCH_W, IMG_BENCH_H);
+    uint16_t *px = (uint16_t*)malloc(IMG_BENCH_W * IMG_BENCH_H * sizeof(uint16_t));
+    uint8_t *stream = (uint8_t*)malloc(stream_size);
+    bool loaded = false;
+    if (px && stream) {
+        // Through img_pack, as the lesson loads its background
+        img_bench_fill(IMG_BENCH_GRADIENT, px);
+        size_t size = img_pack_encode(px, IMG_BENCH_W, IMG_BENCH_H, stream, stream_size);
+        img_pack_asset_t asset = {.name = "background", .data = stream, .size = (uint32_t)size};
+        loaded = img_pack_load(&asset, dsc) == ESP_OK;
+    }
+    free(px);
+    free(stream);
+    return loaded;
+}
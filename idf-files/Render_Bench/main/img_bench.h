@@ -0,0 +1,22 @@
+
+#ifndef _IMG_BENCH_H
+#define _IMG_BENCH_H
+
+#include <stdbool.h>
+#include "lvgl.h"
+
+
+/**
+ * @brief Measure img_pack on synthetic 1024x600 images: flash size against the raw arrays and decode throughput
+ * @return bool Returns false when a decoded image differs from its source
+ */
+bool img_bench_run(void);
+
+/**
+ * @brief Decode a synthetic 1024x600 gradient, standing in for the full-screen background of Lesson 16
+ * @param dsc Image descriptor output pointer, released with img_pack_unload()
+ * @return bool Returns false on allocation failure
+ */
+bool img_bench_background(lv_img_dsc_t *dsc);
+
+#endif // _IMG_BENCH_H
@@ -0,0 +1,127 @@
+// layout_bench.c - screen construction: hand-written builders against ui_layout tables
+#include <stdio.h>
+#include <time.h>
+#include <esp_log.h>
+
+#include "ui_layout.h"
+#include "hello_screen.h"
+#include "led_control_screen.h"
+#include "ui/hello_layout.h"
+#include "ui/led_control_layout.h"
+#include "layout_bench.h"
+
+#define TAG "LayoutBench"
+#define BENCH_INFO(fmt, ...) ESP_LOGI(TAG, fmt, ##__VA_ARGS__)
+#define BENCH_ERROR(fmt, ...) ESP_LOGE(TAG, fmt, ##__VA_ARGS__)
+
+#define LAYOUT_BENCH_BUILDS     200
+
+typedef struct {
+    const char *screen;         // Name of the image written by the screen benchmark
+    void (*build)(lv_obj_t *scr);
+    const ui_layout_t *layout;
+} layout_bench_case_t;
+
+typedef struct {
+    uint64_t total_us;
+    uint64_t total_heap;        // LVGL heap in use after each build, less before it
+} layout_bench_result_t;
+
+static void layout_bench_led_control(lv_obj_t *scr)
+{
+    led_control_screen_create(scr, NULL, NULL);
+}
+
+static void layout_bench_build_layout(const ui_layout_t *layout, lv_obj_t *scr)
+{
+    ui_layout_build(layout, scr, NULL);
+}
+
+static const layout_bench_case_t s_cases[] = {
+    {"lesson07_hello", hello_screen_create, &hello_layout},
+    {"lesson09_led_control", layout_bench_led_control, &led_control_layout},
+};
+
+/* -------------------------------------------------------------------------- */
+/* Measurement                                                                */
+/* -------------------------------------------------------------------------- */
+
+static uint64_t layout_bench_now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static uint32_t layout_bench_heap_used(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+}
+
+/**
+ * @brief Build a screen LAYOUT_BENCH_BUILDS times on detached screens (never rendered)
+ */
+static void layout_bench_measure(const layout_bench_case_t *c, bool from_layout, layout_bench_result_t *result)
+{
+    *result = (layout_bench_result_t){0};
+    for (uint32_t i = 0; i < LAYOUT_BENCH_BUILDS; i++) {
+        lv_obj_t *scr = lv_obj_create(NULL);
+        uint32_t heap = layout_bench_heap_used();
+        uint64_t start = layout_bench_now_us();
+        if (from_layout) {
+            layout_bench_build_layout(c->layout, scr);
+        } else {
+            c->build(scr);
+        }
+        result->total_us += layout_bench_now_us() - start;
+        result->total_heap += layout_bench_heap_used() - heap;
+        lv_obj_del(scr);
+    }
+}
+
+/**
+ * @brief Render the layout-built screen and compare it with the hand-built image
+ */
+static bool layout_bench_check(lv_headless_t *headless, const layout_bench_case_t *c, const char *out_dir)
+{
+    lv_obj_t *old = lv_scr_act();
+    lv_obj_t *scr = lv_obj_create(NULL);
+    lv_scr_load(scr);
+    lv_obj_del(old);
+    ui_layout_build(c->layout, scr, NULL);
+
+    lv_headless_frame_t frame;
+    lv_headless_render(headless, true, &frame);
+    char path[256];
+    uint32_t diff_px = 0;
+    snprintf(path, sizeof(path), "%s/%s.ppm", out_dir, c->screen);
+    if (lv_headless_compare_ppm(headless, path, 0, &diff_px) != ESP_OK) {
+        BENCH_ERROR("layout=%s differs from the hand-built screen, diff_px=%lu", c->layout->name, (unsigned long)diff_px);
+        return false;
+    }
+    return true;
+}
+
+bool layout_bench_run(lv_headless_t *headless, const char *out_dir)
+{
+    bool passed = true;
+    for (size_t i = 0; i < sizeof(s_cases) / sizeof(s_cases[0]); i++) {
+        const layout_bench_case_t *c = &s_cases[i];
+        layout_bench_result_t hand, table;
+        layout_bench_measure(c, false, &hand);
+        layout_bench_measure(c, true, &table);
+
+        BENCH_INFO("layout=%s impl=hand build_us=%.1f heap_bytes=%lu", c->layout->name,
+                   (double)hand.total_us / LAYOUT_BENCH_BUILDS, (unsigned long)(hand.total_heap / LAYOUT_BENCH_BUILDS));
+        BENCH_INFO("layout=%s impl=table build_us=%.1f heap_bytes=%lu speedup=%.2f objects=%u",
+                   c->layout->name, (double)table.total_us / LAYOUT_BENCH_BUILDS,
+                   (unsigned long)(table.total_heap / LAYOUT_BENCH_BUILDS),
+                   (double)hand.total_us / (table.total_us ? table.total_us : 1), c->layout->count);
+        if (!layout_bench_check(headless, c, out_dir)) {
+            passed = false;
+        }
+    }
+    return passed;
+}
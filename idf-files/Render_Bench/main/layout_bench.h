@@ -0,0 +1,17 @@
+#ifndef _LAYOUT_BENCH_H
+#define _LAYOUT_BENCH_H
+
+#include <stdbool.h>
+#include "lv_headless.h"
+
+
+/**
+ * @brief Time and LVGL heap of building the Lesson 07 and 09 screens by hand and from their ui_layout tables
+ * Call after the screens' own benchmark, whose images in out_dir the layout-built screens must match.
+ * @param headless Display the screens are rendered on
+ * @param out_dir Directory of the screen images
+ * @return bool Returns false when a layout-built screen differs from the hand-built one
+ */
+bool layout_bench_run(lv_headless_t *headless, const char *out_dir);
+
+#endif // _LAYOUT_BENCH_H
@@ -0,0 +1,61 @@
+// led_control_screen.c
+#include "led_control_screen.h"
+
+lv_obj_t* led_control_screen_create(lv_obj_t *scr, lv_event_cb_t on_cb, lv_event_cb_t off_cb)
+{
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0xFFFFFF), LV_PART_MAIN);  // Set white background
+
+    // Create title label
+    lv_obj_t *label = lv_label_create(scr);
+    lv_label_set_text(label, "LED Controller");
+    lv_obj_align(label, LV_ALIGN_TOP_MID, 0, 50);
+    // Font size
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_24, 0);
+
+    // Create LED ON button
+    lv_obj_t *btn_on = lv_btn_create(scr);
+    lv_obj_set_size(btn_on, 120, 50);
+    lv_obj_align(btn_on, LV_ALIGN_CENTER, 0, -40);
+    if (on_cb) {
+        lv_obj_add_event_cb(btn_on, on_cb, LV_EVENT_CLICKED, NULL);
+    }
+
+    // ON button label
+    lv_obj_t *label_on = lv_label_create(btn_on);
+    lv_label_set_text(label_on, "LED ON");
+
+    // Create LED OFF button
+    lv_obj_t *btn_off = lv_btn_create(scr);
+    lv_obj_set_size(btn_off, 120, 50);
+    lv_obj_align(btn_off, LV_ALIGN_CENTER, 0, 40);
+    if (off_cb) {
+        lv_obj_add_event_cb(btn_off, off_cb, LV_EVENT_CLICKED, NULL);
+    }
+
+    // OFF button label
+    lv_obj_t *label_off = lv_label_create(btn_off);
+    lv_label_set_text(label_off, "LED OFF");
+
+    // --- Status window ---
+    static lv_style_t status_style;
+    static bool status_style_inited = false;
+    if (!status_style_inited) {
+        lv_style_init(&status_style);
+        lv_style_set_border_width(&status_style, 2);
+        lv_style_set_border_color(&status_style, LV_COLOR_BLACK);
+        lv_style_set_border_opa(&status_style, LV_OPA_COVER);
+        lv_style_set_pad_all(&status_style, 8);
+        lv_style_set_bg_opa(&status_style, LV_OPA_TRANSP);
+        status_style_inited = true;
+    }
+
+    lv_obj_t *status_cont = lv_obj_create(scr);
+    lv_obj_add_style(status_cont, &status_style, LV_PART_MAIN);
+    lv_obj_set_size(status_cont, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+    lv_obj_align(status_cont, LV_ALIGN_BOTTOM_MID, 0, -20);
+
+    lv_obj_t *status_label = lv_label_create(status_cont);
+    lv_label_set_text(status_label, "LED Status: OFF");
+    lv_obj_center(status_label);
+    return status_label;
+}
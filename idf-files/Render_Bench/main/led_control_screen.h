@@ -0,0 +1,18 @@
+
+#ifndef _LED_CONTROL_SCREEN_H
+#define _LED_CONTROL_SCREEN_H
+
+#include "lvgl.h"
+
+
+/**
+ * @brief Build the LED controller screen of Lesson 09 by hand
+ * Hand-written form of Lesson_9/main/ui/led_control_layout.json, the reference of the construction benchmark.
+ * @param scr Screen to draw on, called with the LVGL lock held
+ * @param on_cb Clicked callback of the "LED ON" button (optional)
+ * @param off_cb Clicked callback of the "LED OFF" button (optional)
+ * @return lv_obj_t* Returns the status label
+ */
+lv_obj_t* led_control_screen_create(lv_obj_t *scr, lv_event_cb_t on_cb, lv_event_cb_t off_cb);
+
+#endif // _LED_CONTROL_SCREEN_H
@@ -0,0 +1,496 @@
+// main.c - headless render benchmark of the lesson screens (linux target)
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <esp_log.h>
+
+#include "lvgl.h"
+#include "lv_headless.h"
+#include "lv_parallel.h"
+#include "lv_fast_blend.h"
+#include "lv_glyph_cache.h"
+#include "ui_bind.h"
+#include "hello_screen.h"
+#include "led_control_screen.h"
+#include "home_panel_screen.h"
+#include "weather_screen.h"
+#include "img_bench.h"
+#include "blend_bench.h"
+#include "layout_bench.h"
+#include "ui_cmd_bench.h"
+
+#define TAG "RenderBench"
+#define BENCH_INFO(fmt, ...) ESP_LOGI(TAG, fmt, ##__VA_ARGS__)
+#define BENCH_ERROR(fmt, ...) ESP_LOGE(TAG, fmt, ##__VA_ARGS__)
+
+#define BENCH_FRAMES            50                      // Full and partial frames timed per screen
+#define BENCH_OUT_DIR           "render_bench_out"      // Overridden by $RENDER_BENCH_OUT
+#define BENCH_GOLDEN_DIR        "render_bench_golden"   // Overridden by $RENDER_BENCH_GOLDEN
+#define BENCH_TOLERANCE         0                       // Per-channel difference accepted against a golden image
+#define BENCH_CHART_POINTS      48
+#define BENCH_PARALLEL_SCREEN   3                       // lesson16_weather: the most pixels to blend per frame
+
+typedef struct {
+    const char *name;
+    void (*build)(lv_obj_t *scr);
+    void (*update)(uint32_t frame);     // What the live screen changes between frames (optional)
+} bench_screen_t;
+
+typedef struct {
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t total_us;
+    uint64_t flushed_px;
+    uint32_t frames;
+} bench_stats_t;
+
+static lv_headless_t *s_headless = NULL;
+static ui_bind_group_t *s_ui_bind = NULL;   // Bindings of every screen, flushed before each frame
+
+static ui_bind_t *s_led_status_bind = NULL;
+static ui_bind_t *s_home_status_bind = NULL;
+static ui_bind_t *s_dht20_bind = NULL;
+static ui_bind_t *s_temperature_bind = NULL;
+static weather_screen_t s_weather;
+static lv_img_dsc_t s_background;           // Full-screen image of the weather screen
+
+/* -------------------------------------------------------------------------- */
+/* Screens                                                                    */
+/* -------------------------------------------------------------------------- */
+
+static void lesson7_build(lv_obj_t *scr)
+{
+    hello_screen_create(scr);
+}
+
+static void lesson9_build(lv_obj_t *scr)
+{
+    lv_obj_t *status = led_control_screen_create(scr, NULL, NULL);
+    s_led_status_bind = ui_bind_bool(s_ui_bind, status, "LED Status: ON", "LED Status: OFF");
+}
+
+static void lesson9_update(uint32_t frame)
+{
+    ui_bind_set_bool(s_led_status_bind, frame & 1);
+}
+
+static void lesson10_build(lv_obj_t *scr)
+{
+    home_panel_screen_t screen;
+    home_panel_screen_create(scr, NULL, NULL, &screen);
+    s_home_status_bind = ui_bind_bool(s_ui_bind, screen.led_status_label, "LED Status: ON", "LED Status: OFF");
+    s_dht20_bind = ui_bind_float(s_ui_bind, screen.dht20_label,
+                                 "Temperature = %.1f C  Humidity = %.1f %%", 1, 2,
+                                 "dht20 read data error");
+}
+
+static void lesson10_update(uint32_t frame)
+{
+    // A sensor reading per frame, the LED toggled every tenth frame
+    ui_bind_set_float2(s_dht20_bind, 21.0f + (frame % 30) * 0.1f, 45.0f + (frame % 7) * 0.5f);
+    ui_bind_set_bool(s_home_status_bind, (frame / 10) & 1);
+}
+
+static void lesson16_build(lv_obj_t *scr)
+{
+    weather_screen_create(scr, s_background.data ? &s_background : NULL, BENCH_CHART_POINTS, &s_weather);
+    lv_label_set_text(s_weather.weather_label, "Partly Cloudy");
+    lv_label_set_text(s_weather.date_label, "2025/12/17");
+    lv_label_set_text(s_weather.week_label, "Wednesday");
+    s_temperature_bind = ui_bind_float(s_ui_bind, s_weather.temperature_label, "%.1f°C", 1, 1, NULL);
+    ui_bind_set_float(s_temperature_bind, 25.4f);
+
+    // A full forecast so the chart cost is part of every full frame
+    lv_chart_set_range(s_weather.forecast_chart, LV_CHART_AXIS_PRIMARY_Y, 100, 300);
+    for (uint16_t i = 0; i < BENCH_CHART_POINTS; i++) {
+        lv_chart_set_value_by_id(s_weather.forecast_chart, s_weather.forecast_series, i, 150 + (i * 37) % 100);
+    }
+    lv_chart_refresh(s_weather.forecast_chart);
+}
+
+static void lesson16_update(uint32_t frame)
+{
+    ui_bind_set_float(s_temperature_bind, 25.0f + (frame % 10) * 0.1f);
+    lv_chart_set_value_by_id(s_weather.forecast_chart, s_weather.forecast_series,
+                             frame % BENCH_CHART_POINTS, 150 + (frame * 53) % 100);
+    lv_chart_refresh(s_weather.forecast_chart);
+}
+
+static const bench_screen_t s_screens[] = {
+    {"lesson07_hello", lesson7_build, NULL},
+    {"lesson09_led_control", lesson9_build, lesson9_update},
+    {"lesson10_home_panel", lesson10_build, lesson10_update},
+    {"lesson16_weather", lesson16_build, lesson16_update},
+};
+
+/* -------------------------------------------------------------------------- */
+/* Measurement                                                                */
+/* -------------------------------------------------------------------------- */
+
+static void bench_stats_add(bench_stats_t *stats, const lv_headless_frame_t *frame)
+{
+    if (stats->frames == 0 || frame->render_us < stats->min_us) stats->min_us = frame->render_us;
+    if (frame->render_us > stats->max_us) stats->max_us = frame->render_us;
+    stats->total_us += frame->render_us;
+    stats->flushed_px += frame->flushed_px;
+    stats->frames++;
+}
+
+static void bench_stats_log(const char *screen, const char *kind, const bench_stats_t *stats)
+{
+    if (stats->frames == 0) {
+        return;
+    }
+    // One key=value line per measurement, easy to diff between runs
+    BENCH_INFO("screen=%s kind=%s frames=%lu min_us=%lu avg_us=%lu max_us=%lu px_per_frame=%lu",
+               screen, kind, (unsigned long)stats->frames, (unsigned long)stats->min_us,
+               (unsigned long)(stats->total_us / stats->frames), (unsigned long)stats->max_us,
+               (unsigned long)(stats->flushed_px / stats->frames));
+}
+
+static void bench_frame(bool full, lv_headless_frame_t *frame)
+{
+    ui_bind_flush(s_ui_bind);   // What the binding timer does at the start of a live frame
+    lv_headless_render(s_headless, full, frame);
+}
+
+static void bench_load_screen(const bench_screen_t *screen)
+{
+    // Each screen starts from a fresh LVGL screen
+    lv_obj_t *old = lv_scr_act();
+    lv_obj_t *scr = lv_obj_create(NULL);
+    lv_scr_load(scr);
+    lv_obj_del(old);
+
+    screen->build(scr);
+}
+
+/**
+ * @brief Render one screen: first frame, full frames, partial frames, then check its golden image
+ * @return bool Returns false when the first frame differs from the golden image
+ */
+static bool bench_screen(const bench_screen_t *screen, const char *out_dir, const char *golden_dir)
+{
+    bench_load_screen(screen);
+
+    lv_headless_frame_t frame;
+    bench_frame(true, &frame);     // Includes the first layout of every object
+    BENCH_INFO("screen=%s kind=first render_us=%lu flush_us=%lu px=%lu", screen->name,
+               (unsigned long)frame.render_us, (unsigned long)frame.flush_us, (unsigned long)frame.flushed_px);
+
+    char path[256];
+    bool passed = true;
+    snprintf(path, sizeof(path), "%s/%s.ppm", out_dir, screen->name);
+    if (lv_headless_dump_ppm(s_headless, path) != ESP_OK) {
+        BENCH_ERROR("Failed to write %s", path);
+    }
+
+    uint32_t diff_px = 0;
+    snprintf(path, sizeof(path), "%s/%s.ppm", golden_dir, screen->name);
+    esp_err_t err = lv_headless_compare_ppm(s_headless, path, BENCH_TOLERANCE, &diff_px);
+    if (err == ESP_OK) {
+        BENCH_INFO("screen=%s golden=match", screen->name);
+    } else if (err == ESP_ERR_NOT_FOUND) {
+        BENCH_INFO("screen=%s golden=missing (copy %s/%s.ppm to %s to add it)", screen->name, out_dir, screen->name, golden_dir);
+    } else {
+        BENCH_ERROR("screen=%s golden=mismatch diff_px=%lu (%s)", screen->name, (unsigned long)diff_px, esp_err_to_name(err));
+        passed = false;
+    }
+
+    bench_stats_t full = {0};
+    for (uint32_t i = 0; i < BENCH_FRAMES; i++) {
+        bench_frame(true, &frame);
+        bench_stats_add(&full, &frame);
+    }
+    bench_stats_log(screen->name, "full", &full);
+
+    if (screen->update) {
+        bench_stats_t partial = {0};
+        for (uint32_t i = 0; i < BENCH_FRAMES; i++) {
+            screen->update(i);
+            bench_frame(false, &frame);
+            bench_stats_add(&partial, &frame);
+        }
+        bench_stats_log(screen->name, "partial", &partial);
+    }
+    return passed;
+}
+
+static uint64_t bench_full_avg_us(void)
+{
+    bench_stats_t full = {0};
+    lv_headless_frame_t frame;
+    for (uint32_t i = 0; i < BENCH_FRAMES; i++) {
+        bench_frame(true, &frame);
+        bench_stats_add(&full, &frame);
+    }
+    return full.total_us / full.frames;
+}
+
+/**
+ * @brief Full frames of one screen with 0 to LV_PARALLEL_MAX_WORKERS band workers
+ * The single-threaded frame is the reference: every banded run must produce the same pixels.
+ * @return bool Returns false when banded rendering changes the image
+ */
+static bool bench_parallel(const bench_screen_t *screen, const char *out_dir)
+{
+    lv_parallel_config_t config = LV_PARALLEL_DEFAULT_CONFIG();
+    config.workers = LV_PARALLEL_MAX_WORKERS;
+    lv_parallel_t *parallel = lv_parallel_create(NULL, &config);
+    if (parallel == NULL) {
+        BENCH_ERROR("screen=%s banded rendering unavailable", screen->name);
+        return false;
+    }
+    bench_load_screen(screen);
+
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s_serial.ppm", out_dir, screen->name);
+    bool passed = true;
+    uint64_t serial_avg_us = 0;
+
+    for (uint8_t workers = 0; workers <= config.workers; workers++) {
+        lv_parallel_set_workers(parallel, workers);
+        lv_parallel_stats_t before, after;
+        lv_parallel_get_stats(parallel, &before);
+        uint64_t avg_us = bench_full_avg_us();
+        lv_parallel_get_stats(parallel, &after);
+
+        if (workers == 0) {
+            serial_avg_us = avg_us;
+            if (lv_headless_dump_ppm(s_headless, path) != ESP_OK) {
+                BENCH_ERROR("Failed to write %s", path);
+                passed = false;
+            }
+        } else {
+            uint32_t diff_px = 0;
+            if (lv_headless_compare_ppm(s_headless, path, 0, &diff_px) != ESP_OK) {
+                BENCH_ERROR("screen=%s bands=%u differs from one band, diff_px=%lu", screen->name,
+                            workers + 1, (unsigned long)diff_px);
+                passed = false;
+            }
+        }
+        BENCH_INFO("screen=%s kind=full bands=%u avg_us=%lu speedup=%.2f split_blends=%lu split_px=%llu",
+                   screen->name, workers + 1, (unsigned long)avg_us,
+                   (double)serial_avg_us / (avg_us ? avg_us : 1),
+                   (unsigned long)(after.parallel_blends - before.parallel_blends),
+                   (unsigned long long)(after.parallel_px - before.parallel_px));
+    }
+    lv_parallel_enable(parallel, false);
+    return passed;
+}
+
+/**
+ * @brief Full frames of one screen drawn by the lv_fast_blend kernels, against the image of bench_parallel()
+ * and against LVGL's own frame with anti-aliasing off
+ * @return bool Returns false when the kernels change the image
+ */
+static bool bench_fast_blend(const bench_screen_t *screen, const char *out_dir)
+{
+    char path[256];
+    char aliased_path[256];
+    lv_headless_frame_t frame;
+    lv_disp_drv_t *driver = lv_disp_get_default()->driver;
+    uint32_t antialiasing = driver->antialiasing;
+
+    bench_load_screen(screen);
+    uint64_t lvgl_avg_us = bench_full_avg_us();
+
+    // LVGL rounds the masks itself without anti-aliasing: keep its frame to compare the kernels' against
+    snprintf(aliased_path, sizeof(aliased_path), "%s/%s_aliased.ppm", out_dir, screen->name);
+    driver->antialiasing = 0;
+    bench_frame(true, &frame);
+    esp_err_t err = lv_headless_dump_ppm(s_headless, aliased_path);
+    driver->antialiasing = antialiasing;
+    if (err != ESP_OK) {
+        BENCH_ERROR("Failed to write %s", aliased_path);
+        return false;
+    }
+
+    err = lv_fast_blend_install(NULL, NULL);
+    if (err == ESP_ERR_NOT_SUPPORTED) {
+        BENCH_INFO("screen=%s kind=full blend=kernels skipped=no_vector_kernels", screen->name);
+        return true;
+    }
+    if (err != ESP_OK) {
+        return false;
+    }
+    uint64_t avg_us = bench_full_avg_us();
+
+    uint32_t diff_px = 0;
+    bool passed = true;
+    snprintf(path, sizeof(path), "%s/%s_serial.ppm", out_dir, screen->name);
+    if (lv_headless_compare_ppm(s_headless, path, 0, &diff_px) != ESP_OK) {
+        BENCH_ERROR("screen=%s blend kernels differ from LVGL, diff_px=%lu", screen->name, (unsigned long)diff_px);
+        passed = false;
+    }
+
+    driver->antialiasing = 0;
+    bench_frame(true, &frame);
+    driver->antialiasing = antialiasing;
+    if (lv_headless_compare_ppm(s_headless, aliased_path, 0, &diff_px) != ESP_OK) {
+        BENCH_ERROR("screen=%s blend kernels differ from LVGL without anti-aliasing, diff_px=%lu",
+                    screen->name, (unsigned long)diff_px);
+        passed = false;
+    }
+    BENCH_INFO("screen=%s kind=full blend=kernels avg_us=%lu lvgl_avg_us=%lu speedup=%.2f", screen->name,
+               (unsigned long)avg_us, (unsigned long)lvgl_avg_us,
+               (double)lvgl_avg_us / (avg_us ? avg_us : 1));
+    return passed;
+}
+
+static uint64_t bench_partial_avg_us(const bench_screen_t *screen)
+{
+    bench_stats_t partial = {0};
+    lv_headless_frame_t frame;
+    for (uint32_t i = 0; i < BENCH_FRAMES; i++) {
+        screen->update(i);
+        bench_frame(false, &frame);
+        bench_stats_add(&partial, &frame);
+    }
+    return partial.total_us / partial.frames;
+}
+
+static void bench_hide_labels(lv_obj_t *obj, bool hidden)
+{
+    if (lv_obj_check_type(obj, &lv_label_class)) {
+        if (hidden) {
+            lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+        } else {
+            lv_obj_clear_flag(obj, LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+    uint32_t count = lv_obj_get_child_cnt(obj);
+    for (uint32_t i = 0; i < count; i++) {
+        bench_hide_labels(lv_obj_get_child(obj, i), hidden);
+    }
+}
+
+/**
+ * @brief Time spent on text in a full frame: full frames with the labels, less full frames without them
+ */
+static uint64_t bench_text_us(void)
+{
+    uint64_t with_text = bench_full_avg_us();
+    bench_hide_labels(lv_scr_act(), true);
+    uint64_t without_text = bench_full_avg_us();
+    bench_hide_labels(lv_scr_act(), false);
+    return with_text > without_text ? with_text - without_text : 0;
+}
+
+/**
+ * @brief Text render time of one screen with its labels decoding glyphs on every redraw, then drawing from lv_glyph_cache
+ * @return bool Returns false when the cached glyphs change the image of bench_parallel()
+ */
+static bool bench_glyph_cache(const bench_screen_t *screen, const char *out_dir)
+{
+    bench_load_screen(screen);
+    uint64_t plain_text_us = bench_text_us();
+    uint64_t plain_partial_us = bench_partial_avg_us(screen);
+    BENCH_INFO("screen=%s glyph_cache=off text_us=%lu partial_avg_us=%lu", screen->name,
+               (unsigned long)plain_text_us, (unsigned long)plain_partial_us);
+
+    lv_glyph_cache_config_t config = LV_GLYPH_CACHE_DEFAULT_CONFIG();
+    lv_glyph_cache_t *cache = lv_glyph_cache_create(&config);
+    if (cache == NULL) {
+        return false;
+    }
+    bench_load_screen(screen);
+    lv_glyph_cache_apply(cache, lv_scr_act());
+
+    char path[256];
+    uint32_t diff_px = 0;
+    bool passed = true;
+    lv_headless_frame_t frame;
+    bench_frame(true, &frame);
+    snprintf(path, sizeof(path), "%s/%s_serial.ppm", out_dir, screen->name);
+    if (lv_headless_compare_ppm(s_headless, path, 0, &diff_px) != ESP_OK) {
+        BENCH_ERROR("screen=%s cached glyphs differ from LVGL, diff_px=%lu", screen->name, (unsigned long)diff_px);
+        passed = false;
+    }
+
+    uint64_t text_us = bench_text_us();
+    uint64_t partial_us = bench_partial_avg_us(screen);
+    lv_glyph_cache_stats_t stats;
+    lv_glyph_cache_get_stats(cache, &stats);
+    uint32_t lookups = stats.hits + stats.misses;
+    BENCH_INFO("screen=%s glyph_cache=on text_us=%lu partial_avg_us=%lu text_speedup=%.2f hits=%lu misses=%lu "
+               "hit_rate=%.3f glyphs=%lu bytes=%lu", screen->name, (unsigned long)text_us, (unsigned long)partial_us,
+               (double)plain_text_us / (text_us ? text_us : 1), (unsigned long)stats.hits,
+               (unsigned long)stats.misses, lookups ? (double)stats.hits / lookups : 0.0,
+               (unsigned long)stats.glyphs, (unsigned long)stats.used);
+    return passed;
+}
+
+void app_main(void)
+{
+    const char *out_dir = getenv("RENDER_BENCH_OUT");
+    const char *golden_dir = getenv("RENDER_BENCH_GOLDEN");
+    if (out_dir == NULL) out_dir = BENCH_OUT_DIR;
+    if (golden_dir == NULL) golden_dir = BENCH_GOLDEN_DIR;
+    if (mkdir(out_dir, 0755) != 0 && errno != EEXIST) {
+        BENCH_ERROR("Cannot create %s", out_dir);
+        exit(2);
+    }
+
+    lv_init();
+    const lv_headless_config_t config = LV_HEADLESS_DEFAULT_CONFIG();
+    s_headless = lv_headless_create(&config);
+    s_ui_bind = ui_bind_group_create();
+    if (s_headless == NULL || s_ui_bind == NULL) {
+        BENCH_ERROR("Init failed");
+        exit(2);
+    }
+    BENCH_INFO("Display %ux%u, draw buffer %u lines, %d frames per measurement",
+               config.hor_res, config.ver_res, config.buf_lines, BENCH_FRAMES);
+
+    if (!img_bench_background(&s_background)) {
+        BENCH_ERROR("No background image, the weather screen is drawn on a plain color");
+    }
+
+    uint32_t failures = 0;
+    for (size_t i = 0; i < sizeof(s_screens) / sizeof(s_screens[0]); i++) {
+        if (!bench_screen(&s_screens[i], out_dir, golden_dir)) {
+            failures++;
+        }
+    }
+
+    // Frame time against band workers
+    if (!bench_parallel(&s_screens[BENCH_PARALLEL_SCREEN], out_dir)) {
+        failures++;
+    }
+
+    // Pixel kernels: each blend alone, then a whole screen
+    if (!blend_bench_run()) {
+        failures++;
+    }
+    if (!bench_fast_blend(&s_screens[BENCH_PARALLEL_SCREEN], out_dir)) {
+        failures++;
+    }
+
+    // Text: glyphs decoded on every redraw against the glyph cache
+    if (!bench_glyph_cache(&s_screens[BENCH_PARALLEL_SCREEN], out_dir)) {
+        failures++;
+    }
+
+    // Screen construction: hand-written builders against the generated layout tables
+    if (!layout_bench_run(s_headless, out_dir)) {
+        failures++;
+    }
+
+    // Compressed image assets: size against the raw arrays, decode throughput
+    if (!img_bench_run()) {
+        failures++;
+    }
+
+    // Label updates from other threads: the LVGL lock against ui_bind's command queue
+    if (!ui_cmd_bench_run(s_headless)) {
+        failures++;
+    }
+
+    ui_bind_stats_t stats;
+    ui_bind_get_stats(s_ui_bind, &stats);
+    BENCH_INFO("Bindings: %lu sets, %lu redraws", (unsigned long)stats.sets, (unsigned long)stats.redraws);
+    BENCH_INFO("%lu failure(s)", (unsigned long)failures);
+    exit(failures ? 1 : 0);    // Non-zero exit status fails a CI job
+}
@@ -0,0 +1,305 @@
+// ui_cmd_bench.c - label updates from other threads: the LVGL lock against ui_bind over the ui_cmd queue
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <esp_log.h>
+
+#include "lvgl.h"
+#include "ui_bind.h"
+#include "ui_cmd_bench.h"
+
+#define TAG "UICmdBench"
+#define BENCH_INFO(fmt, ...) ESP_LOGI(TAG, fmt, ##__VA_ARGS__)
+#define BENCH_ERROR(fmt, ...) ESP_LOGE(TAG, fmt, ##__VA_ARGS__)
+
+#define UI_CMD_BENCH_PRODUCERS      4
+#define UI_CMD_BENCH_FRAMES         100
+#define UI_CMD_BENCH_FRAME_US       (LV_DISP_DEF_REFR_PERIOD * 1000)
+#define UI_CMD_BENCH_STEADY_US      5000    // 4 producers at 200 Hz: 24 sets per frame fit the 32-slot queue
+#define UI_CMD_BENCH_FLUSH_BUDGET_US 2000   // LVGL lock time spent on queued sets per frame
+
+typedef enum {
+    UI_CMD_BENCH_LVGL_LOCK = 0,     // Each producer takes the LVGL lock and sets its label
+    UI_CMD_BENCH_QUEUED,            // Producers call ui_bind setters, the frame loop drains the queue
+} ui_cmd_bench_mode_t;
+
+typedef struct {
+    const char *name;
+    uint32_t interval_us;           // Between two sets of one producer (0: back to back)
+} ui_cmd_bench_load_t;
+
+typedef struct {
+    pthread_t thread;
+    uint8_t index;
+    lv_obj_t *label;                // Set under the LVGL lock
+    ui_bind_t *bind;                // Bound to a second label, set through the queue
+    uint32_t sets;
+    uint32_t set_us_max;            // Longest setter call, lock wait included
+    uint32_t hold_us_max;           // Longest LVGL lock hold (lock mode)
+    float last;                     // Value of the last set
+} ui_cmd_bench_producer_t;
+
+typedef struct {
+    uint32_t sets;
+    uint32_t set_us_max;
+    uint32_t hold_us_max;           // Longest LVGL lock hold by a producer, or by a drain per frame
+    uint32_t lvgl_wait_us_max;      // Longest wait of the frame loop for the LVGL lock
+    uint32_t stale;                 // Labels not showing their producer's last value
+} ui_cmd_bench_result_t;
+
+static const ui_cmd_bench_load_t s_loads[] = {
+    {"steady", UI_CMD_BENCH_STEADY_US},
+    {"burst", 0},
+};
+
+static pthread_mutex_t s_lvgl_lock = PTHREAD_MUTEX_INITIALIZER;    // Stands in for lvgl_port_lock()
+static ui_bind_group_t *s_group = NULL;
+static ui_cmd_bench_producer_t s_producers[UI_CMD_BENCH_PRODUCERS];
+static ui_cmd_bench_mode_t s_mode;
+static const ui_cmd_bench_load_t *s_load;
+static atomic_bool s_running;
+static atomic_uint s_finished;
+
+static uint64_t ui_cmd_bench_now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void ui_cmd_bench_sleep_until(uint64_t deadline_us)
+{
+    uint64_t now = ui_cmd_bench_now_us();
+    if (deadline_us > now) {
+        struct timespec ts = {
+            .tv_sec = (time_t)((deadline_us - now) / 1000000),
+            .tv_nsec = (long)((deadline_us - now) % 1000000) * 1000,
+        };
+        nanosleep(&ts, NULL);
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/* Producers                                                                  */
+/* -------------------------------------------------------------------------- */
+
+static float ui_cmd_bench_value(const ui_cmd_bench_producer_t *producer, uint32_t seq)
+{
+    return (float)(producer->index * 1000 + seq % 1000) * 0.1f;
+}
+
+/**
+ * @brief One label update
+ */
+static void ui_cmd_bench_set(ui_cmd_bench_producer_t *producer, float value)
+{
+    if (s_mode == UI_CMD_BENCH_QUEUED) {
+        // A set that finds the queue full is kept by the binding and posted by a later drain
+        ui_bind_set_float(producer->bind, value);
+        return;
+    }
+
+    pthread_mutex_lock(&s_lvgl_lock);
+    uint64_t start = ui_cmd_bench_now_us();
+    lv_label_set_text_fmt(producer->label, "%.1f", (double)value);
+    uint32_t hold = (uint32_t)(ui_cmd_bench_now_us() - start);
+    pthread_mutex_unlock(&s_lvgl_lock);
+    if (hold > producer->hold_us_max) {
+        producer->hold_us_max = hold;
+    }
+}
+
+static void* ui_cmd_bench_producer(void *arg)
+{
+    ui_cmd_bench_producer_t *producer = (ui_cmd_bench_producer_t*)arg;
+    uint64_t next = ui_cmd_bench_now_us();
+    uint32_t seq = 0;
+
+    while (atomic_load(&s_running)) {
+        float value = ui_cmd_bench_value(producer, seq++);
+        uint64_t start = ui_cmd_bench_now_us();
+        ui_cmd_bench_set(producer, value);
+        producer->last = value;
+        uint32_t elapsed = (uint32_t)(ui_cmd_bench_now_us() - start);
+        producer->sets++;
+        if (elapsed > producer->set_us_max) {
+            producer->set_us_max = elapsed;
+        }
+        if (s_load->interval_us) {
+            next += s_load->interval_us;
+            ui_cmd_bench_sleep_until(next);
+        } else {
+            sched_yield();
+        }
+    }
+
+    atomic_fetch_add(&s_finished, 1);
+    return NULL;
+}
+
+/* -------------------------------------------------------------------------- */
+/* Frame loop                                                                 */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief One frame in the LVGL task: apply the queued sets, then render, all under the LVGL lock
+ */
+static void ui_cmd_bench_frame(lv_headless_t *headless, ui_cmd_bench_result_t *result)
+{
+    uint64_t start = ui_cmd_bench_now_us();
+    pthread_mutex_lock(&s_lvgl_lock);
+    uint32_t wait = (uint32_t)(ui_cmd_bench_now_us() - start);
+    if (wait > result->lvgl_wait_us_max) {
+        result->lvgl_wait_us_max = wait;
+    }
+
+    if (s_mode == UI_CMD_BENCH_QUEUED) {
+        start = ui_cmd_bench_now_us();
+        ui_bind_flush(s_group);
+        uint32_t hold = (uint32_t)(ui_cmd_bench_now_us() - start);
+        if (hold > result->hold_us_max) {
+            result->hold_us_max = hold;
+        }
+    }
+    lv_headless_frame_t frame;
+    lv_headless_render(headless, false, &frame);
+    pthread_mutex_unlock(&s_lvgl_lock);
+}
+
+static void ui_cmd_bench_scenario(lv_headless_t *headless, ui_cmd_bench_mode_t mode,
+                                  const ui_cmd_bench_load_t *load, ui_cmd_bench_result_t *result)
+{
+    memset(result, 0, sizeof(*result));
+    s_mode = mode;
+    s_load = load;
+    atomic_store(&s_running, true);
+    atomic_store(&s_finished, 0);
+
+    uint32_t started = 0;
+    for (uint8_t i = 0; i < UI_CMD_BENCH_PRODUCERS; i++) {
+        ui_cmd_bench_producer_t *producer = &s_producers[i];
+        producer->sets = 0;
+        producer->set_us_max = 0;
+        producer->hold_us_max = 0;
+        if (pthread_create(&producer->thread, NULL, ui_cmd_bench_producer, producer) == 0) {
+            started++;
+        } else {
+            BENCH_ERROR("Cannot start producer %u", i);
+            result->stale++;
+        }
+    }
+
+    uint64_t next = ui_cmd_bench_now_us();
+    for (uint32_t frames = 0; frames < UI_CMD_BENCH_FRAMES || atomic_load(&s_finished) < started; frames++) {
+        if (frames == UI_CMD_BENCH_FRAMES) {
+            atomic_store(&s_running, false);
+        }
+        ui_cmd_bench_frame(headless, result);
+        next += UI_CMD_BENCH_FRAME_US;
+        ui_cmd_bench_sleep_until(next);
+    }
+    for (uint8_t i = 0; i < UI_CMD_BENCH_PRODUCERS; i++) {
+        pthread_join(s_producers[i].thread, NULL);
+    }
+    pthread_mutex_lock(&s_lvgl_lock);
+    ui_bind_flush(s_group);
+
+    for (uint8_t i = 0; i < UI_CMD_BENCH_PRODUCERS; i++) {
+        const ui_cmd_bench_producer_t *producer = &s_producers[i];
+        lv_obj_t *label = mode == UI_CMD_BENCH_QUEUED ? producer->bind->label : producer->label;
+        char expected[16];
+        snprintf(expected, sizeof(expected), "%.1f", (double)producer->last);
+        if (strcmp(lv_label_get_text(label), expected) != 0) {
+            BENCH_ERROR("scenario=%s label %u shows %s, last set %s", load->name, i,
+                        lv_label_get_text(label), expected);
+            result->stale++;
+        }
+        result->sets += producer->sets;
+        if (producer->set_us_max > result->set_us_max) {
+            result->set_us_max = producer->set_us_max;
+        }
+        if (producer->hold_us_max > result->hold_us_max) {
+            result->hold_us_max = producer->hold_us_max;
+        }
+    }
+    pthread_mutex_unlock(&s_lvgl_lock);
+}
+
+/* -------------------------------------------------------------------------- */
+/* Entry                                                                      */
+/* -------------------------------------------------------------------------- */
+
+static bool ui_cmd_bench_setup(void)
+{
+    lv_obj_t *old = lv_scr_act();
+    lv_obj_t *scr = lv_obj_create(NULL);
+    lv_scr_load(scr);
+    lv_obj_del(old);
+
+    s_group = ui_bind_group_create();
+    if (s_group == NULL) {
+        return false;
+    }
+    for (uint8_t i = 0; i < UI_CMD_BENCH_PRODUCERS; i++) {
+        ui_cmd_bench_producer_t *producer = &s_producers[i];
+        producer->index = i;
+        producer->label = lv_label_create(scr);
+        lv_obj_align(producer->label, LV_ALIGN_TOP_LEFT, 20, 20 + i * 40);
+        lv_obj_t *bound = lv_label_create(scr);
+        lv_obj_align(bound, LV_ALIGN_TOP_LEFT, 220, 20 + i * 40);
+        producer->bind = ui_bind_float(s_group, bound, "%.1f", 1, 1, NULL);
+        if (producer->bind == NULL) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ui_cmd_bench_run(lv_headless_t *headless)
+{
+    if (!ui_cmd_bench_setup()) {
+        BENCH_ERROR("Cannot create the bench screen");
+        return false;
+    }
+
+    bool passed = true;
+    for (size_t i = 0; i < sizeof(s_loads) / sizeof(s_loads[0]); i++) {
+        const ui_cmd_bench_load_t *load = &s_loads[i];
+
+        ui_cmd_bench_result_t locked;
+        ui_cmd_bench_scenario(headless, UI_CMD_BENCH_LVGL_LOCK, load, &locked);
+        bool ok = locked.stale == 0;
+        BENCH_INFO("scenario=%s mode=lvgl_lock producers=%d sets=%lu set_us_max=%lu lock_hold_us_max=%lu "
+                   "lvgl_wait_us_max=%lu stale=%lu result=%s", load->name, UI_CMD_BENCH_PRODUCERS,
+                   (unsigned long)locked.sets, (unsigned long)locked.set_us_max,
+                   (unsigned long)locked.hold_us_max, (unsigned long)locked.lvgl_wait_us_max,
+                   (unsigned long)locked.stale, ok ? "pass" : "FAIL");
+        passed = passed && ok;
+
+        ui_bind_stats_t before, after;
+        ui_bind_get_stats(s_group, &before);
+        ui_cmd_bench_result_t queued;
+        ui_cmd_bench_scenario(headless, UI_CMD_BENCH_QUEUED, load, &queued);
+        ui_bind_get_stats(s_group, &after);
+
+        // Every set is counted; at the steady rate none may find the queue full. In a burst the last
+        // set of a producer often does, and its label must still end on it
+        uint32_t sets = after.sets - before.sets;
+        uint32_t dropped = after.dropped - before.dropped;
+        ok = queued.stale == 0 && sets == queued.sets && queued.hold_us_max <= UI_CMD_BENCH_FLUSH_BUDGET_US &&
+             (load->interval_us == 0 || dropped == 0);
+        BENCH_INFO("scenario=%s mode=ui_cmd producers=%d sets=%lu dropped=%lu reposted=%lu coalesced=%lu redraws=%lu "
+                   "set_us_max=%lu lock_hold_us_max=%lu lvgl_wait_us_max=%lu stale=%lu result=%s",
+                   load->name, UI_CMD_BENCH_PRODUCERS, (unsigned long)sets, (unsigned long)dropped,
+                   (unsigned long)(after.reposted - before.reposted),
+                   (unsigned long)(after.coalesced - before.coalesced),
+                   (unsigned long)(after.redraws - before.redraws), (unsigned long)queued.set_us_max,
+                   (unsigned long)queued.hold_us_max, (unsigned long)queued.lvgl_wait_us_max,
+                   (unsigned long)queued.stale, ok ? "pass" : "FAIL");
+        passed = passed && ok;
+    }
+    return passed;
+}
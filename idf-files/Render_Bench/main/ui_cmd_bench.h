@@ -0,0 +1,16 @@
+#ifndef _UI_CMD_BENCH_H
+#define _UI_CMD_BENCH_H
+
+#include <stdbool.h>
+#include "lv_headless.h"
+
+
+/**
+ * @brief Label updates from producer threads while frames render: each producer taking the LVGL lock,
+ * then the same updates posted through ui_bind and its ui_cmd queue, at a steady rate and in a burst
+ * @param headless Display the frames are rendered on
+ * @return bool Returns false when a set is lost, a label ends on a stale value or a drain overruns its budget
+ */
+bool ui_cmd_bench_run(lv_headless_t *headless);
+
+#endif // _UI_CMD_BENCH_H
@@ -0,0 +1,372 @@
+// dht20_bench.c - bus-hold time of a blocking DHT20 read against dht20_async, on a simulated sensor
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <esp_log.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+
+#include "i2c_sched.h"
+#include "i2c_sched_mock.h"
+#include "dht20_async.h"
+#include "dht20_bench.h"
+
+#define TAG "DHT20Bench"
+#define BENCH_INFO(fmt, ...) ESP_LOGI(TAG, fmt, ##__VA_ARGS__)
+#define BENCH_ERROR(fmt, ...) ESP_LOGE(TAG, fmt, ##__VA_ARGS__)
+
+#define DHT20_BENCH_SAMPLES         12
+#define DHT20_BENCH_PERIOD_MS       150
+#define DHT20_BENCH_SLOW_EVERY      4       // Every 4th conversion overruns the datasheet time
+#define DHT20_BENCH_SLOW_MS         (DHT20_ASYNC_CONVERSION_MS + 5)
+#define DHT20_BENCH_TOUCH_MS        10
+#define DHT20_BENCH_TASK_STACK      4096
+#define DHT20_BENCH_TASK_PRIO       5
+#define DHT20_BENCH_SLACK_US        5000    // Host scheduling noise
+#define DHT20_BENCH_STUCK_MS        1000    // Conversion time of a sensor that stays busy
+#define DHT20_BENCH_SLOW_READ_MS    20      // Frame read time in the destroy scenario, so that it lands inside one
+
+#define DHT20_SIM_CMD_TRIGGER       0xAC
+#define DHT20_SIM_STATUS_BUSY       0x80
+
+// Simulated DHT20: converts for a set time after each trigger, then returns a frame with its CRC
+typedef struct {
+    int64_t trigger_us;
+    uint32_t conversion_ms;
+    uint32_t triggers;
+    uint32_t reads;
+    uint32_t stuck_ms;              // Non-zero: every conversion takes this long
+    uint32_t read_delay_ms;         // Time each frame read keeps the bus
+    float temperature;
+    float humidity;
+} dht20_sim_t;
+
+// The touch controller polled next to the sensor
+typedef struct {
+    i2c_sched_device_t *device;
+    volatile bool run;
+    SemaphoreHandle_t done;
+} dht20_touch_t;
+
+// What one mode measured
+typedef struct {
+    uint32_t samples;
+    uint32_t wrong;                 // Failed samples or values that differ from the simulation
+    uint32_t hold_us_avg;           // Bus time of the sensor per sample
+    uint32_t touch_wait_us_max;
+    uint32_t busy_retries;
+} dht20_mode_result_t;
+
+static int64_t dht20_bench_now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+// ---------------------- Simulated sensor ----------------------
+
+static uint8_t dht20_sim_crc8(const uint8_t *data, size_t len)
+{
+    uint8_t crc = 0xFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief Start a conversion: the values change with every trigger, some conversions run late
+ */
+static void dht20_sim_trigger(dht20_sim_t *sim)
+{
+    sim->triggers++;
+    sim->trigger_us = dht20_bench_now_us();
+    if (sim->stuck_ms) {
+        sim->conversion_ms = sim->stuck_ms;
+    } else {
+        sim->conversion_ms = (sim->triggers % DHT20_BENCH_SLOW_EVERY == 0) ? DHT20_BENCH_SLOW_MS
+                                                                            : DHT20_ASYNC_CONVERSION_MS - 5;
+    }
+    sim->temperature = 20.0f + (float)(sim->triggers % 10) * 0.5f;
+    sim->humidity = 40.0f + (float)(sim->triggers % 7);
+}
+
+static void dht20_sim_frame(const dht20_sim_t *sim, uint8_t *frame)
+{
+    uint32_t raw_humi = (uint32_t)(sim->humidity / 100.0f * 1048576.0f);
+    uint32_t raw_temp = (uint32_t)((sim->temperature + 50.0f) / 200.0f * 1048576.0f);
+    bool busy = dht20_bench_now_us() - sim->trigger_us < (int64_t)sim->conversion_ms * 1000;
+
+    frame[0] = DHT20_ASYNC_STATUS_CALIBRATED | (busy ? DHT20_SIM_STATUS_BUSY : 0);
+    frame[1] = (uint8_t)(raw_humi >> 12);
+    frame[2] = (uint8_t)(raw_humi >> 4);
+    frame[3] = (uint8_t)((raw_humi << 4) | (raw_temp >> 16));
+    frame[4] = (uint8_t)(raw_temp >> 8);
+    frame[5] = (uint8_t)raw_temp;
+    frame[6] = dht20_sim_crc8(frame, 6);
+}
+
+/**
+ * @brief Device model on the mock bus. A trigger followed by a read in the same transfer is the
+ * blocking driver: it keeps the bus through the whole conversion, as dht20_read_data() does.
+ */
+static esp_err_t dht20_sim_handler(void *arg, const uint8_t *tx, size_t tx_len, uint8_t *rx, size_t rx_len)
+{
+    dht20_sim_t *sim = (dht20_sim_t*)arg;
+
+    if (tx_len == 3 && tx[0] == DHT20_SIM_CMD_TRIGGER) {
+        dht20_sim_trigger(sim);
+        if (rx_len > 0) {
+            vTaskDelay(pdMS_TO_TICKS(sim->conversion_ms));
+        }
+    }
+    if (rx_len > 0) {
+        sim->reads++;
+        if (sim->read_delay_ms) {
+            vTaskDelay(pdMS_TO_TICKS(sim->read_delay_ms));
+        }
+    }
+    if (rx_len >= 7) {
+        dht20_sim_frame(sim, rx);
+    } else if (rx_len > 0) {
+        uint8_t frame[7];
+        dht20_sim_frame(sim, frame);
+        memcpy(rx, frame, rx_len);      // Status byte
+    }
+    return ESP_OK;
+}
+
+static bool dht20_sim_matches(const dht20_sim_t *sim, float temperature, float humidity)
+{
+    return fabsf(temperature - sim->temperature) < 0.01f && fabsf(humidity - sim->humidity) < 0.01f;
+}
+
+// ---------------------- Touch controller ----------------------
+
+static void dht20_touch_task(void *param)
+{
+    dht20_touch_t *touch = (dht20_touch_t*)param;
+    const uint8_t reg[2] = {0x81, 0x4E};
+    uint8_t points[8];
+
+    while (touch->run) {
+        i2c_sched_transfer(touch->device, reg, sizeof(reg), points, sizeof(points), I2C_SCHED_WAIT_FOREVER);
+        vTaskDelay(pdMS_TO_TICKS(DHT20_BENCH_TOUCH_MS));
+    }
+    xSemaphoreGive(touch->done);
+    vTaskDelete(NULL);
+}
+
+// ---------------------- Modes ----------------------
+
+/**
+ * @brief Trigger, wait and read in one bus transaction, as the BSP driver does
+ */
+static void dht20_bench_blocking(i2c_sched_device_t *device, dht20_sim_t *sim, dht20_mode_result_t *result)
+{
+    const uint8_t trigger[3] = {DHT20_SIM_CMD_TRIGGER, 0x33, 0x00};
+
+    for (int i = 0; i < DHT20_BENCH_SAMPLES; i++) {
+        uint8_t frame[7];
+        esp_err_t err = i2c_sched_transfer(device, trigger, sizeof(trigger), frame, sizeof(frame),
+                                           I2C_SCHED_WAIT_FOREVER);
+        uint32_t raw_humi = ((uint32_t)frame[1] << 12) | ((uint32_t)frame[2] << 4) | (frame[3] >> 4);
+        uint32_t raw_temp = ((uint32_t)(frame[3] & 0x0F) << 16) | ((uint32_t)frame[4] << 8) | frame[5];
+        float humidity = (float)raw_humi * 100.0f / 1048576.0f;
+        float temperature = (float)raw_temp * 200.0f / 1048576.0f - 50.0f;
+        if (err != ESP_OK || (frame[0] & DHT20_SIM_STATUS_BUSY) || dht20_sim_crc8(frame, 6) != frame[6] ||
+            !dht20_sim_matches(sim, temperature, humidity)) {
+            result->wrong++;
+        }
+        result->samples++;
+        vTaskDelay(pdMS_TO_TICKS(DHT20_BENCH_PERIOD_MS - sim->conversion_ms));
+    }
+}
+
+/**
+ * @brief Trigger, release the bus, collect from the timer; results arrive on a queue
+ */
+static void dht20_bench_async(i2c_sched_device_t *device, dht20_sim_t *sim, dht20_mode_result_t *result)
+{
+    QueueHandle_t queue = xQueueCreate(2, sizeof(dht20_async_result_t));
+    const dht20_async_config_t config = {
+        .transport = { .write = i2c_sched_write, .read = i2c_sched_read, .ctx = device },
+        .queue = queue,
+    };
+    dht20_async_t *dht = queue ? dht20_async_create(&config) : NULL;
+    if (dht == NULL || dht20_async_init(dht) != ESP_OK) {
+        BENCH_ERROR("Cannot start dht20_async");
+        result->wrong = DHT20_BENCH_SAMPLES;
+        dht20_async_destroy(dht);
+        if (queue) {
+            vQueueDelete(queue);
+        }
+        return;
+    }
+
+    for (int i = 0; i < DHT20_BENCH_SAMPLES; i++) {
+        dht20_async_result_t sample = {0};
+        int64_t start_us = dht20_bench_now_us();
+        if (dht20_async_trigger(dht) != ESP_OK ||
+            xQueueReceive(queue, &sample, pdMS_TO_TICKS(DHT20_BENCH_PERIOD_MS)) != pdTRUE ||
+            sample.err != ESP_OK || !dht20_sim_matches(sim, sample.temperature, sample.humidity)) {
+            result->wrong++;
+        }
+        result->samples++;
+        uint32_t elapsed_ms = (uint32_t)((dht20_bench_now_us() - start_us) / 1000);
+        if (elapsed_ms < DHT20_BENCH_PERIOD_MS) {
+            vTaskDelay(pdMS_TO_TICKS(DHT20_BENCH_PERIOD_MS - elapsed_ms));
+        }
+    }
+    dht20_async_stats_t stats;
+    dht20_async_get_stats(dht, &stats);
+    result->busy_retries = stats.busy_retries;
+    dht20_async_destroy(dht);
+    vQueueDelete(queue);
+}
+
+/**
+ * @brief Run one mode on a fresh scheduler with the touch controller polling beside it
+ */
+static bool dht20_bench_mode(bool async, dht20_mode_result_t *result)
+{
+    memset(result, 0, sizeof(*result));
+    i2c_sched_mock_bus_t bus;
+    i2c_sched_mock_bus_init(&bus, 0, 0);
+    dht20_sim_t sim = {0};
+    i2c_sched_mock_device_t sensor_dev = { .bus = &bus, .handler = dht20_sim_handler, .arg = &sim };
+    i2c_sched_mock_device_t touch_dev = { .bus = &bus };
+
+    i2c_sched_config_t config = I2C_SCHED_DEFAULT_CONFIG();
+    config.backend = i2c_sched_backend_mock();
+    i2c_sched_t *sched = i2c_sched_create(&config);
+    dht20_touch_t touch = { .run = true, .done = xSemaphoreCreateBinary() };
+    if (sched == NULL || touch.done == NULL) {
+        i2c_sched_destroy(sched);
+        if (touch.done) {
+            vSemaphoreDelete(touch.done);
+        }
+        return false;
+    }
+    i2c_sched_device_t *sensor = i2c_sched_add_device(sched, "dht20", &sensor_dev, I2C_SCHED_PRIO_NORMAL);
+    touch.device = i2c_sched_add_device(sched, "touch", &touch_dev, I2C_SCHED_PRIO_HIGH);
+    bool touching = xTaskCreate(dht20_touch_task, "touch", DHT20_BENCH_TASK_STACK, &touch,
+                                DHT20_BENCH_TASK_PRIO, NULL) == pdPASS;
+
+    if (async) {
+        dht20_bench_async(sensor, &sim, result);
+    } else {
+        dht20_bench_blocking(sensor, &sim, result);
+    }
+
+    touch.run = false;
+    if (touching) {
+        xSemaphoreTake(touch.done, portMAX_DELAY);
+    }
+    i2c_sched_device_stats_t sensor_stats;
+    i2c_sched_device_stats_t touch_stats;
+    i2c_sched_get_device_stats(sensor, &sensor_stats);
+    i2c_sched_get_device_stats(touch.device, &touch_stats);
+    result->hold_us_avg = (uint32_t)(sensor_stats.busy_us_total / (result->samples ? result->samples : 1));
+    result->touch_wait_us_max = touch_stats.wait_us_max;
+    i2c_sched_destroy(sched);
+    vSemaphoreDelete(touch.done);
+
+    bool ok = touching && result->wrong == 0 && bus.overlaps == 0;
+    BENCH_INFO("scenario=bus_hold mode=%s samples=%lu wrong=%lu hold_us_avg=%lu touch_wait_us_max=%lu "
+               "busy_retries=%lu result=%s",
+               async ? "async" : "blocking", (unsigned long)result->samples, (unsigned long)result->wrong,
+               (unsigned long)result->hold_us_avg, (unsigned long)result->touch_wait_us_max,
+               (unsigned long)result->busy_retries, ok ? "pass" : "FAIL");
+    return ok;
+}
+
+static void dht20_bench_count_result(const dht20_async_result_t *result, void *arg)
+{
+    (void)result;
+    (*(volatile uint32_t*)arg)++;
+}
+
+/**
+ * @brief Destroy dht20_async while the sensor reports busy and a collect step is reading it.
+ * The step re-arms the retry timer; destroy must wait for it before deleting the timer, and
+ * nothing may run after destroy returns.
+ */
+static bool dht20_bench_destroy_busy(void)
+{
+    i2c_sched_mock_bus_t bus;
+    i2c_sched_mock_bus_init(&bus, 0, 0);
+    dht20_sim_t sim = { .stuck_ms = DHT20_BENCH_STUCK_MS };
+    i2c_sched_mock_device_t sensor_dev = { .bus = &bus, .handler = dht20_sim_handler, .arg = &sim };
+
+    i2c_sched_config_t sched_config = I2C_SCHED_DEFAULT_CONFIG();
+    sched_config.backend = i2c_sched_backend_mock();
+    i2c_sched_t *sched = i2c_sched_create(&sched_config);
+    if (sched == NULL) {
+        BENCH_ERROR("Cannot start the scheduler");
+        return false;
+    }
+    i2c_sched_device_t *sensor = i2c_sched_add_device(sched, "dht20", &sensor_dev, I2C_SCHED_PRIO_NORMAL);
+    volatile uint32_t results = 0;
+    const dht20_async_config_t config = {
+        .transport = { .write = i2c_sched_write, .read = i2c_sched_read, .ctx = sensor },
+        .on_result = dht20_bench_count_result,
+        .arg = (void*)&results,
+    };
+    dht20_async_t *dht = dht20_async_create(&config);
+    bool ok = dht != NULL && dht20_async_init(dht) == ESP_OK && dht20_async_trigger(dht) == ESP_OK;
+
+    // Land in the middle of the second collect step: the first one found the sensor busy
+    sim.read_delay_ms = DHT20_BENCH_SLOW_READ_MS;
+    vTaskDelay(pdMS_TO_TICKS(DHT20_ASYNC_CONVERSION_MS + DHT20_BENCH_SLOW_READ_MS + DHT20_ASYNC_BUSY_RETRY_MS +
+                             DHT20_BENCH_SLOW_READ_MS / 2));
+    uint32_t reads_before = sim.reads;
+    dht20_async_stats_t stats = {0};
+    if (dht) {
+        dht20_async_get_stats(dht, &stats);
+    }
+    dht20_async_destroy(dht);
+    uint32_t reads_at_destroy = sim.reads;
+    uint32_t results_at_destroy = results;
+
+    // A timer left armed would fire here and wake a collect task that no longer exists
+    vTaskDelay(pdMS_TO_TICKS(DHT20_ASYNC_BUSY_RETRY_MS * 3));
+    ok = ok && stats.busy_retries > 0 && reads_before > 0 &&
+         sim.reads == reads_at_destroy && results == results_at_destroy && results == 0;
+    i2c_sched_destroy(sched);
+
+    BENCH_INFO("scenario=destroy_busy busy_retries=%lu reads=%lu late_reads=%lu results=%lu result=%s",
+               (unsigned long)stats.busy_retries, (unsigned long)reads_at_destroy,
+               (unsigned long)(sim.reads - reads_at_destroy), (unsigned long)results, ok ? "pass" : "FAIL");
+    return ok;
+}
+
+bool dht20_bench_run(void)
+{
+    dht20_mode_result_t blocking;
+    dht20_mode_result_t async;
+    bool ok = dht20_bench_mode(false, &blocking);
+    ok = dht20_bench_mode(true, &async) && ok;
+
+    // The async driver only holds the bus for the trigger and the frame read (plus one more frame
+    // read per late conversion); touch then never waits for more than one of those short transfers
+    uint32_t late = DHT20_BENCH_SAMPLES / DHT20_BENCH_SLOW_EVERY;
+    bool shorter = async.hold_us_avg * 10 < blocking.hold_us_avg &&
+                   async.touch_wait_us_max < DHT20_ASYNC_CONVERSION_MS * 1000 / 4 &&
+                   async.busy_retries == late;
+    BENCH_INFO("scenario=bus_hold hold_reduction=%.1fx touch_wait_blocking_us=%lu touch_wait_async_us=%lu result=%s",
+               (double)blocking.hold_us_avg / (async.hold_us_avg ? async.hold_us_avg : 1),
+               (unsigned long)blocking.touch_wait_us_max, (unsigned long)async.touch_wait_us_max,
+               ok && shorter ? "pass" : "FAIL");
+
+    bool destroyed = dht20_bench_destroy_busy();
+    return ok && shorter && destroyed;
+}
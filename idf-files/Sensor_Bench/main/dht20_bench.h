@@ -0,0 +1,16 @@
+#ifndef _DHT20_BENCH_H
+#define _DHT20_BENCH_H
+
+#include <stdbool.h>
+
+
+/**
+ * @brief Sample a simulated DHT20 on the i2c_sched mock bus, next to a touch controller read every 10 ms:
+ * first holding the bus through the conversion like the BSP driver, then with dht20_async; last, destroy
+ * dht20_async while the sensor reports busy
+ * @return bool Returns false when a sample is wrong, dht20_async does not cut the bus-hold time, or its
+ * collect step runs after destroy
+ */
+bool dht20_bench_run(void);
+
+#endif // _DHT20_BENCH_H
@@ -0,0 +1,264 @@
+// history_bench.c - weeks of simulated DHT20 samples through the sensor_history tiers
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <esp_log.h>
+
+#include "sensor_history.h"
+#include "history_bench.h"
+
+#define TAG "HistoryBench"
+#define BENCH_INFO(fmt, ...) ESP_LOGI(TAG, fmt, ##__VA_ARGS__)
+#define BENCH_ERROR(fmt, ...) ESP_LOGE(TAG, fmt, ##__VA_ARGS__)
+
+#define HISTORY_DAY_S           86400
+#define HISTORY_BENCH_WEEKS     5                       // Past the 30 days of the coarsest tier
+#define HISTORY_BENCH_T0        1765929600u             // 2025-12-17 00:00 UTC
+#define HISTORY_BENCH_END       (HISTORY_BENCH_T0 + HISTORY_BENCH_WEEKS * 7 * HISTORY_DAY_S)
+
+// The sensor is offline for six hours of day 31: no samples, no buckets
+#define HISTORY_OUTAGE_START    (HISTORY_BENCH_T0 + 31 * HISTORY_DAY_S + 6 * 3600)
+#define HISTORY_OUTAGE_END      (HISTORY_OUTAGE_START + 6 * 3600)
+
+// One range query and the tier it must be answered from
+typedef struct {
+    const char *name;
+    uint32_t from;
+    size_t max_points;
+    uint32_t resolution_s;
+    bool truncated;             // Starts before anything retained: the oldest points are returned
+} history_query_t;
+
+static const history_query_t s_queries[] = {
+    {"hour",  HISTORY_BENCH_END - 3600,               3600, 0,    false},
+    {"day",   HISTORY_BENCH_END - HISTORY_DAY_S,      1440, 60,   false},
+    {"week",  HISTORY_BENCH_END - 7 * HISTORY_DAY_S,  672,  900,  false},
+    {"month", HISTORY_BENCH_END - 30 * HISTORY_DAY_S, 720,  3600, false},
+    {"all",   HISTORY_BENCH_T0,                       720,  3600, true},
+};
+
+// Aggregates over a range, compared with what the tiers hold
+typedef struct {
+    const char *name;
+    uint32_t from;
+    uint32_t to;
+} history_range_t;
+
+static const history_range_t s_summaries[] = {
+    {"day",    HISTORY_BENCH_END - HISTORY_DAY_S,     HISTORY_BENCH_END - 1},
+    {"week",   HISTORY_BENCH_END - 7 * HISTORY_DAY_S, HISTORY_BENCH_END - 1},
+    {"outage", HISTORY_OUTAGE_START,                  HISTORY_OUTAGE_END - 1},
+};
+
+static int64_t history_now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+// ---------------------- Simulated sensor ----------------------
+
+static bool history_present(uint32_t time)
+{
+    return time < HISTORY_OUTAGE_START || time >= HISTORY_OUTAGE_END;
+}
+
+/**
+ * @brief Temperature at a time: a daily cycle, a slower weekly one and +-0.1 C of noise
+ */
+static float history_value(uint32_t time)
+{
+    uint32_t t = time - HISTORY_BENCH_T0;
+    double daily = sin(2.0 * M_PI * (t % HISTORY_DAY_S) / HISTORY_DAY_S);
+    double weekly = sin(2.0 * M_PI * t / (7.0 * HISTORY_DAY_S));
+    double noise = (double)((t * 2654435761u) >> 24) / 255.0 - 0.5;
+    return (float)(22.0 + 4.0 * daily + 1.5 * weekly + 0.2 * noise);
+}
+
+/**
+ * @brief What one point must hold: the samples of [start, start + resolution_s), aggregated like the tiers do
+ * @return bool Returns false if the bucket holds no sample
+ */
+static bool history_expected(uint32_t start, uint32_t resolution_s, sensor_history_point_t *point)
+{
+    uint32_t end = start + (resolution_s ? resolution_s : 1);
+    double sum = 0;
+    uint32_t n = 0;
+    for (uint32_t t = start; t < end && t < HISTORY_BENCH_END; t++) {
+        if (!history_present(t)) {
+            continue;
+        }
+        float value = history_value(t);
+        if (n == 0 || value < point->min) point->min = value;
+        if (n == 0 || value > point->max) point->max = value;
+        sum += value;
+        n++;
+    }
+    point->time = start;
+    point->avg = n ? (float)(sum / n) : 0.0f;
+    return n > 0;
+}
+
+/**
+ * @brief Start of the oldest bucket a full ring still holds (the newest bucket is still open)
+ */
+static uint32_t history_oldest_retained(uint32_t resolution_s, uint32_t capacity)
+{
+    uint32_t last = HISTORY_BENCH_END - 1;
+    uint32_t start = last - last % resolution_s;
+    sensor_history_point_t point;
+    for (uint32_t kept = 0; kept < capacity;) {
+        start -= resolution_s;
+        if (history_expected(start, resolution_s, &point)) {
+            kept++;
+        }
+    }
+    return start;
+}
+
+// ---------------------- Scenarios ----------------------
+
+/**
+ * @brief Add every sample once, timing the adds week by week
+ */
+static bool history_bench_fill(sensor_history_t *history)
+{
+    uint32_t samples = 0;
+    double week_ns[HISTORY_BENCH_WEEKS];
+    for (int week = 0; week < HISTORY_BENCH_WEEKS; week++) {
+        uint32_t from = HISTORY_BENCH_T0 + week * 7 * HISTORY_DAY_S;
+        uint32_t added = 0;
+        int64_t start_us = history_now_us();
+        for (uint32_t t = from; t < from + 7 * HISTORY_DAY_S; t++) {
+            if (history_present(t)) {
+                sensor_history_add(history, t, history_value(t));
+                added++;
+            }
+        }
+        week_ns[week] = (history_now_us() - start_us) * 1000.0 / added;
+        samples += added;
+    }
+
+    // Fixed rings: the store is the same size after one week and after five
+    size_t bytes = 0;
+    for (uint8_t i = 0; i < history->tier_count; i++) {
+        bytes += history->tiers[i].capacity * sizeof(sensor_history_point_t);
+    }
+    BENCH_INFO("scenario=fill weeks=%d samples=%lu add_ns_first_week=%.1f add_ns_last_week=%.1f "
+               "store_bytes=%u raw_bytes=%lu result=pass",
+               HISTORY_BENCH_WEEKS, (unsigned long)samples, week_ns[0], week_ns[HISTORY_BENCH_WEEKS - 1],
+               (unsigned)bytes, (unsigned long)(samples * sizeof(sensor_history_point_t)));
+    return true;
+}
+
+/**
+ * @brief Query a range and compare each returned point with the samples of its bucket
+ */
+static bool history_bench_query(sensor_history_t *history, const history_query_t *query)
+{
+    sensor_history_point_t *points = (sensor_history_point_t*)calloc(query->max_points,
+                                                                     sizeof(sensor_history_point_t));
+    if (points == NULL) {
+        return false;
+    }
+    uint32_t resolution_s = UINT32_MAX;
+    int64_t start_us = history_now_us();
+    size_t n = sensor_history_query(history, query->from, HISTORY_BENCH_END - 1, points, query->max_points,
+                                    &resolution_s);
+    int64_t query_us = history_now_us() - start_us;
+
+    bool ok = n > 0 && resolution_s == query->resolution_s;
+    uint32_t step = resolution_s ? resolution_s : 1;
+    uint32_t start = query->from - query->from % step;
+    if (ok && query->truncated) {
+        // Nothing covers the range: the coarsest tier gives what it still has, oldest first
+        start = history_oldest_retained(resolution_s, history->tiers[history->tier_count - 1].capacity);
+        ok = n == query->max_points && points[0].time == start;
+    }
+
+    // Walk the buckets of the range: every one with samples is the next point, empty ones are skipped
+    uint32_t mismatched = 0;
+    size_t k = 0;
+    for (uint32_t b = start; ok && k < n && b < HISTORY_BENCH_END; b += step) {
+        sensor_history_point_t expected;
+        if (!history_expected(b, resolution_s, &expected)) {
+            continue;
+        }
+        const sensor_history_point_t *p = &points[k++];
+        if (p->time != expected.time || p->min != expected.min || p->max != expected.max ||
+            p->avg != expected.avg) {
+            if (mismatched++ == 0) {
+                BENCH_ERROR("%s: point %u at %lu is %.3f/%.3f/%.3f, expected %lu %.3f/%.3f/%.3f", query->name,
+                            (unsigned)(k - 1), (unsigned long)p->time, p->min, p->max, p->avg,
+                            (unsigned long)expected.time, expected.min, expected.max, expected.avg);
+            }
+        }
+    }
+    ok = ok && k == n && mismatched == 0;
+
+    BENCH_INFO("scenario=query range=%s points=%u resolution_s=%lu query_us=%lld mismatched=%lu result=%s",
+               query->name, (unsigned)n, (unsigned long)resolution_s, (long long)query_us,
+               (unsigned long)mismatched, ok ? "pass" : "FAIL");
+    free(points);
+    return ok;
+}
+
+/**
+ * @brief Summarize a range: min/max are exact, the bucket-weighted average matches the samples
+ */
+static bool history_bench_summary(sensor_history_t *history, const history_range_t *range)
+{
+    sensor_history_point_t expected = {0};
+    double sum = 0;
+    uint32_t n = 0;
+    for (uint32_t t = range->from; t <= range->to; t++) {
+        if (!history_present(t)) {
+            continue;
+        }
+        float value = history_value(t);
+        if (n == 0 || value < expected.min) expected.min = value;
+        if (n == 0 || value > expected.max) expected.max = value;
+        sum += value;
+        n++;
+    }
+    bool has_data = n > 0;
+    expected.avg = n ? (float)(sum / n) : 0.0f;
+
+    sensor_history_point_t summary = {0};
+    bool found = sensor_history_summary(history, range->from, range->to, &summary);
+    if (!found) {
+        summary = (sensor_history_point_t){0};
+    }
+    bool ok = found == has_data;
+    if (ok && found) {
+        ok = summary.min == expected.min && summary.max == expected.max && fabsf(summary.avg - expected.avg) < 1e-3f;
+    }
+    BENCH_INFO("scenario=summary range=%s samples=%lu min=%.2f max=%.2f avg=%.3f expected_avg=%.3f result=%s",
+               range->name, (unsigned long)n, summary.min, summary.max, summary.avg, expected.avg,
+               ok ? "pass" : "FAIL");
+    return ok;
+}
+
+bool history_bench_run(void)
+{
+    const sensor_history_tier_config_t tiers[] = SENSOR_HISTORY_DEFAULT_TIERS();
+    sensor_history_t *history = sensor_history_create(tiers, sizeof(tiers) / sizeof(tiers[0]));
+    if (history == NULL) {
+        BENCH_ERROR("Cannot create the history");
+        return false;
+    }
+
+    bool ok = history_bench_fill(history);
+    for (size_t i = 0; i < sizeof(s_queries) / sizeof(s_queries[0]); i++) {
+        ok = history_bench_query(history, &s_queries[i]) && ok;
+    }
+    for (size_t i = 0; i < sizeof(s_summaries) / sizeof(s_summaries[0]); i++) {
+        ok = history_bench_summary(history, &s_summaries[i]) && ok;
+    }
+
+    sensor_history_destroy(history);
+    return ok;
+}
@@ -0,0 +1,14 @@
+#ifndef _HISTORY_BENCH_H
+#define _HISTORY_BENCH_H
+
+#include <stdbool.h>
+
+
+/**
+ * @brief Feed weeks of simulated 1 Hz DHT20 samples into sensor_history with the default tiers,
+ * and check every query and summary against the generated signal
+ * @return bool Returns false when a returned point differs from the samples it covers
+ */
+bool history_bench_run(void);
+
+#endif // _HISTORY_BENCH_H
@@ -0,0 +1,363 @@
+// i2c_bench.c - i2c_sched priorities, aging and batching on the mock bus
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <esp_log.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+
+#include "i2c_sched.h"
+#include "i2c_sched_mock.h"
+#include "i2c_bench.h"
+
+#define TAG "I2CBench"
+#define BENCH_INFO(fmt, ...) ESP_LOGI(TAG, fmt, ##__VA_ARGS__)
+#define BENCH_ERROR(fmt, ...) ESP_LOGE(TAG, fmt, ##__VA_ARGS__)
+
+#define I2C_BENCH_RUN_MS        1000
+#define I2C_BENCH_MAX_TASKS     6
+#define I2C_BENCH_TASK_STACK    4096
+#define I2C_BENCH_TASK_PRIO     5
+#define I2C_BENCH_SLACK_US      5000    // Host scheduling noise on top of the bounds checked below
+#define I2C_BENCH_BATCH_READS   4
+#define I2C_BENCH_STRETCH_US    20000   // Transfer that holds the bus while the batch is queued
+
+// A task repeating one transfer until the run ends
+typedef struct {
+    i2c_sched_device_t *device;
+    uint8_t tx[33];
+    size_t tx_len;
+    size_t rx_len;
+    uint32_t period_ms;             // 0: back to back
+    volatile bool *run;
+    SemaphoreHandle_t done;
+    uint32_t errors;
+} i2c_producer_t;
+
+// One run: a scheduler on a fresh mock bus and its producers
+typedef struct {
+    i2c_sched_t *sched;
+    i2c_sched_mock_bus_t bus;
+    i2c_sched_mock_device_t devices[I2C_BENCH_MAX_TASKS];
+    i2c_producer_t producers[I2C_BENCH_MAX_TASKS];
+    size_t count;
+    volatile bool run;
+    SemaphoreHandle_t done;
+} i2c_run_t;
+
+// A register read of the batch scenario
+typedef struct {
+    i2c_sched_device_t *device;
+    uint8_t reg;
+    uint8_t rx[4];
+    esp_err_t err;
+    SemaphoreHandle_t done;
+} i2c_reader_t;
+
+static int64_t i2c_bench_now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+// ---------------------- Producers ----------------------
+
+static void i2c_producer_task(void *param)
+{
+    i2c_producer_t *producer = (i2c_producer_t*)param;
+    uint8_t rx[32];
+
+    while (*producer->run) {
+        if (i2c_sched_transfer(producer->device, producer->tx, producer->tx_len, producer->rx_len ? rx : NULL,
+                               producer->rx_len, I2C_SCHED_WAIT_FOREVER) != ESP_OK) {
+            producer->errors++;
+        }
+        if (producer->period_ms) {
+            vTaskDelay(pdMS_TO_TICKS(producer->period_ms));
+        }
+    }
+    xSemaphoreGive(producer->done);
+    vTaskDelete(NULL);
+}
+
+static bool i2c_run_init(i2c_run_t *run)
+{
+    memset(run, 0, sizeof(*run));
+    i2c_sched_mock_bus_init(&run->bus, 0, 0);
+    i2c_sched_config_t config = I2C_SCHED_DEFAULT_CONFIG();
+    config.backend = i2c_sched_backend_mock();
+    run->sched = i2c_sched_create(&config);
+    run->done = xSemaphoreCreateCounting(I2C_BENCH_MAX_TASKS, 0);
+    return run->sched && run->done;
+}
+
+/**
+ * @brief Register a device with its own producer
+ * @param tx_len Bytes written: the register address, then page data for a write
+ * @param rx_len Bytes read after the address (0 for a write)
+ */
+static i2c_sched_device_t* i2c_run_add(i2c_run_t *run, const char *name, i2c_sched_prio_t prio,
+                                       size_t tx_len, size_t rx_len, uint32_t period_ms)
+{
+    i2c_sched_mock_device_t *dev = &run->devices[run->count];
+    dev->bus = &run->bus;
+    i2c_sched_device_t *device = i2c_sched_add_device(run->sched, name, dev, prio);
+
+    i2c_producer_t *producer = &run->producers[run->count++];
+    producer->device = device;
+    producer->tx_len = tx_len;
+    producer->rx_len = rx_len;
+    producer->period_ms = period_ms;
+    producer->run = &run->run;
+    producer->done = run->done;
+    return device;
+}
+
+/**
+ * @brief Start every producer, let them run, then stop them and the scheduler
+ */
+static bool i2c_run_execute(i2c_run_t *run, uint32_t run_ms)
+{
+    run->run = true;
+    size_t started = 0;
+    for (size_t i = 0; i < run->count; i++) {
+        if (xTaskCreate(i2c_producer_task, "i2c_producer", I2C_BENCH_TASK_STACK, &run->producers[i],
+                        I2C_BENCH_TASK_PRIO, NULL) == pdPASS) {
+            started++;
+        }
+    }
+    vTaskDelay(pdMS_TO_TICKS(run_ms));
+    run->run = false;
+    for (size_t i = 0; i < started; i++) {
+        xSemaphoreTake(run->done, portMAX_DELAY);
+    }
+    uint32_t errors = 0;
+    for (size_t i = 0; i < run->count; i++) {
+        errors += run->producers[i].errors;
+    }
+    return started == run->count && errors == 0;
+}
+
+static void i2c_run_deinit(i2c_run_t *run)
+{
+    i2c_sched_destroy(run->sched);
+    if (run->done) {
+        vSemaphoreDelete(run->done);
+    }
+}
+
+static uint32_t i2c_wait_avg_us(const i2c_sched_device_stats_t *stats)
+{
+    return stats->transfers ? (uint32_t)(stats->wait_us_total / stats->transfers) : 0;
+}
+
+// ---------------------- Scenarios ----------------------
+
+/**
+ * @brief Touch reads every 10 ms and a sensor every 20 ms, while three log writers keep the bus full
+ * @param prioritized Touch HIGH, sensor NORMAL, writers LOW; otherwise everything in one FIFO
+ * @param touch Touch stats output pointer
+ */
+static bool i2c_bench_latency(bool prioritized, i2c_sched_device_stats_t *touch)
+{
+    i2c_run_t *run = (i2c_run_t*)calloc(1, sizeof(i2c_run_t));
+    if (run == NULL || !i2c_run_init(run)) {
+        if (run) {
+            i2c_run_deinit(run);
+        }
+        free(run);
+        return false;
+    }
+    i2c_sched_prio_t high = prioritized ? I2C_SCHED_PRIO_HIGH : I2C_SCHED_PRIO_NORMAL;
+    i2c_sched_prio_t low = prioritized ? I2C_SCHED_PRIO_LOW : I2C_SCHED_PRIO_NORMAL;
+
+    // GT911: 16-bit register address, status and first point; DHT20: one 7-byte frame
+    i2c_sched_device_t *touch_dev = i2c_run_add(run, "touch", high, 2, 8, 10);
+    i2c_sched_device_t *sensor_dev = i2c_run_add(run, "sensor", I2C_SCHED_PRIO_NORMAL, 0, 7, 20);
+    for (int i = 0; i < 3; i++) {
+        i2c_run_add(run, "log", low, 33, 0, 0);     // 32-byte page writes, back to back
+    }
+    bool ok = i2c_run_execute(run, I2C_BENCH_RUN_MS);
+
+    i2c_sched_device_stats_t sensor;
+    i2c_sched_get_device_stats(touch_dev, touch);
+    i2c_sched_get_device_stats(sensor_dev, &sensor);
+    float utilization = i2c_sched_get_utilization(run->sched);
+
+    // Transfers do not preempt each other: touch waits for at most the one on the bus
+    uint32_t longest_us = i2c_sched_mock_transfer_us(&run->bus, 33, 0);
+    ok = ok && run->bus.overlaps == 0 && touch->transfers > 0;
+    if (prioritized) {
+        ok = ok && touch->wait_us_max <= longest_us + I2C_BENCH_SLACK_US;
+    }
+    BENCH_INFO("scenario=latency mode=%s touch_transfers=%lu touch_wait_us_avg=%lu touch_wait_us_max=%lu "
+               "sensor_wait_us_avg=%lu longest_transfer_us=%lu utilization_pct=%.1f overlaps=%lu result=%s",
+               prioritized ? "priority" : "fifo", (unsigned long)touch->transfers,
+               (unsigned long)i2c_wait_avg_us(touch), (unsigned long)touch->wait_us_max,
+               (unsigned long)i2c_wait_avg_us(&sensor), (unsigned long)longest_us, utilization,
+               (unsigned long)run->bus.overlaps, ok ? "pass" : "FAIL");
+
+    i2c_run_deinit(run);
+    free(run);
+    return ok;
+}
+
+/**
+ * @brief Three HIGH devices saturate the bus: the LOW device still gets through after the aging limit,
+ * and the HIGH devices share the bus evenly
+ */
+static bool i2c_bench_aging(void)
+{
+    i2c_run_t *run = (i2c_run_t*)calloc(1, sizeof(i2c_run_t));
+    if (run == NULL || !i2c_run_init(run)) {
+        if (run) {
+            i2c_run_deinit(run);
+        }
+        free(run);
+        return false;
+    }
+    i2c_sched_device_t *busy[3];
+    for (int i = 0; i < 3; i++) {
+        busy[i] = i2c_run_add(run, "busy", I2C_SCHED_PRIO_HIGH, 2, 8, 0);
+    }
+    i2c_sched_device_t *starved_dev = i2c_run_add(run, "starved", I2C_SCHED_PRIO_LOW, 1, 1, 5);
+    bool ok = i2c_run_execute(run, I2C_BENCH_RUN_MS);
+
+    i2c_sched_device_stats_t starved;
+    i2c_sched_get_device_stats(starved_dev, &starved);
+    uint32_t min_transfers = UINT32_MAX;
+    uint32_t max_transfers = 0;
+    for (int i = 0; i < 3; i++) {
+        i2c_sched_device_stats_t stats;
+        i2c_sched_get_device_stats(busy[i], &stats);
+        if (stats.transfers < min_transfers) min_transfers = stats.transfers;
+        if (stats.transfers > max_transfers) max_transfers = stats.transfers;
+    }
+
+    // Served once its head is older than the aging limit, after the transfer already on the bus
+    uint32_t bound_us = I2C_SCHED_AGING_MS * 1000 + i2c_sched_mock_transfer_us(&run->bus, 2, 8) +
+                        I2C_BENCH_SLACK_US;
+    ok = ok && run->bus.overlaps == 0 && starved.transfers > 0 && starved.wait_us_max <= bound_us &&
+         min_transfers * 2 >= max_transfers;
+    BENCH_INFO("scenario=aging starved_transfers=%lu starved_wait_us_avg=%lu starved_wait_us_max=%lu bound_us=%lu "
+               "high_transfers_min=%lu high_transfers_max=%lu overlaps=%lu result=%s",
+               (unsigned long)starved.transfers, (unsigned long)i2c_wait_avg_us(&starved),
+               (unsigned long)starved.wait_us_max, (unsigned long)bound_us, (unsigned long)min_transfers,
+               (unsigned long)max_transfers, (unsigned long)run->bus.overlaps, ok ? "pass" : "FAIL");
+
+    i2c_run_deinit(run);
+    free(run);
+    return ok;
+}
+
+static void i2c_reader_task(void *param)
+{
+    i2c_reader_t *reader = (i2c_reader_t*)param;
+    reader->err = i2c_sched_transfer(reader->device, &reader->reg, 1, reader->rx, sizeof(reader->rx),
+                                     I2C_SCHED_WAIT_FOREVER);
+    xSemaphoreGive(reader->done);
+    vTaskDelete(NULL);
+}
+
+static esp_err_t i2c_stretch_handler(void *arg, const uint8_t *tx, size_t tx_len, uint8_t *rx, size_t rx_len)
+{
+    int64_t end = i2c_bench_now_us() + I2C_BENCH_STRETCH_US;
+    while (i2c_bench_now_us() < end) {
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Reads of four consecutive register blocks, queued while the bus is held, go out as one burst
+ */
+static bool i2c_bench_batch(void)
+{
+    i2c_run_t *run = (i2c_run_t*)calloc(1, sizeof(i2c_run_t));
+    i2c_reader_t *readers = (i2c_reader_t*)calloc(I2C_BENCH_BATCH_READS, sizeof(i2c_reader_t));
+    if (run == NULL || readers == NULL || !i2c_run_init(run)) {
+        if (run && readers) {
+            i2c_run_deinit(run);
+        }
+        free(run);
+        free(readers);
+        return false;
+    }
+    i2c_sched_mock_device_t *regs = &run->devices[0];
+    regs->bus = &run->bus;
+    for (int i = 0; i < I2C_SCHED_MOCK_REGS; i++) {
+        regs->regs[i] = (uint8_t)(i * 7 + 3);
+    }
+    i2c_sched_device_t *regs_dev = i2c_sched_add_device(run->sched, "regs", regs, I2C_SCHED_PRIO_HIGH);
+
+    // A device that holds the bus long enough for the readers to queue behind it
+    i2c_sched_mock_device_t *stretch = &run->devices[1];
+    stretch->bus = &run->bus;
+    stretch->handler = i2c_stretch_handler;
+    i2c_reader_t blocker = {
+        .device = i2c_sched_add_device(run->sched, "stretch", stretch, I2C_SCHED_PRIO_LOW),
+        .done = run->done,
+    };
+    int started = 0;
+    if (xTaskCreate(i2c_reader_task, "i2c_blocker", I2C_BENCH_TASK_STACK, &blocker,
+                    I2C_BENCH_TASK_PRIO, NULL) == pdPASS) {
+        started++;
+    }
+    vTaskDelay(pdMS_TO_TICKS(2));
+    for (int i = 0; i < I2C_BENCH_BATCH_READS; i++) {
+        readers[i] = (i2c_reader_t){.device = regs_dev, .reg = (uint8_t)(0x10 + i * 4), .done = run->done};
+        if (xTaskCreate(i2c_reader_task, "i2c_reader", I2C_BENCH_TASK_STACK, &readers[i],
+                        I2C_BENCH_TASK_PRIO, NULL) == pdPASS) {
+            started++;
+        }
+        vTaskDelay(pdMS_TO_TICKS(1));   // Keep the submission order
+    }
+    for (int i = 0; i < started; i++) {
+        xSemaphoreTake(run->done, portMAX_DELAY);
+    }
+    bool ok = started == I2C_BENCH_BATCH_READS + 1;
+
+    uint32_t wrong = 0;
+    for (int i = 0; ok && i < I2C_BENCH_BATCH_READS; i++) {
+        if (readers[i].err != ESP_OK || memcmp(readers[i].rx, &regs->regs[readers[i].reg], 4) != 0) {
+            wrong++;
+        }
+    }
+    i2c_sched_device_stats_t stats;
+    i2c_sched_get_device_stats(regs_dev, &stats);
+
+    // The stretched transfer, then one burst for the four reads
+    ok = ok && blocker.err == ESP_OK && wrong == 0 && stats.transfers == I2C_BENCH_BATCH_READS &&
+         stats.batched == I2C_BENCH_BATCH_READS && run->bus.transfers == 2;
+    BENCH_INFO("scenario=batch reads=%d batched=%lu bus_transfers=%lu wrong=%lu saved_us=%lu result=%s",
+               I2C_BENCH_BATCH_READS, (unsigned long)stats.batched, (unsigned long)run->bus.transfers,
+               (unsigned long)wrong,
+               (unsigned long)(I2C_BENCH_BATCH_READS * i2c_sched_mock_transfer_us(&run->bus, 1, 4) -
+                               i2c_sched_mock_transfer_us(&run->bus, 1, 4 * I2C_BENCH_BATCH_READS)),
+               ok ? "pass" : "FAIL");
+
+    i2c_run_deinit(run);
+    free(run);
+    free(readers);
+    return ok;
+}
+
+bool i2c_bench_run(void)
+{
+    i2c_sched_device_stats_t fifo;
+    i2c_sched_device_stats_t priority;
+    bool ok = i2c_bench_latency(false, &fifo);
+    ok = i2c_bench_latency(true, &priority) && ok;
+
+    // Behind three writers in one queue, touch waits for several pages; with priorities for one at most
+    bool faster = i2c_wait_avg_us(&priority) < i2c_wait_avg_us(&fifo);
+    BENCH_INFO("scenario=latency touch_wait_speedup=%.2f result=%s",
+               (double)i2c_wait_avg_us(&fifo) / (i2c_wait_avg_us(&priority) ? i2c_wait_avg_us(&priority) : 1),
+               ok && faster ? "pass" : "FAIL");
+    ok = ok && faster;
+
+    ok = i2c_bench_aging() && ok;
+    return i2c_bench_batch() && ok;
+}
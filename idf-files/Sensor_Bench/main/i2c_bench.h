@@ -0,0 +1,14 @@
+#ifndef _I2C_BENCH_H
+#define _I2C_BENCH_H
+
+#include <stdbool.h>
+
+
+/**
+ * @brief Drive i2c_sched with producer tasks on the mock bus: touch latency under bulk traffic
+ * with and without priorities, aging of a starved low-priority device, and merged register reads
+ * @return bool Returns false when transfers overlap, a priority is not honored or a batch is wrong
+ */
+bool i2c_bench_run(void);
+
+#endif // _I2C_BENCH_H
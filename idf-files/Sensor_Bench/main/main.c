@@ -0,0 +1,227 @@
+// main.c - sensor scheduler, history, I2C bus and DHT20 benchmarks with simulated sensors (linux target)
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <esp_log.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "sensor_sched.h"
+#include "sensor_sim.h"
+#include "history_bench.h"
+#include "i2c_bench.h"
+#include "dht20_bench.h"
+
+#define TAG "SensorBench"
+#define BENCH_INFO(fmt, ...) ESP_LOGI(TAG, fmt, ##__VA_ARGS__)
+#define BENCH_ERROR(fmt, ...) ESP_LOGE(TAG, fmt, ##__VA_ARGS__)
+
+#define BENCH_RUN_MS        3000
+#define BENCH_MAX_OVERRUN   1       // Percent of the samples: slack for host scheduling noise
+
+// Readings seen by the callback, per sensor
+typedef struct {
+    uint32_t readings;
+    uint32_t errors;
+} bench_count_t;
+
+static bench_count_t s_counts[SENSOR_SCHED_MAX_SENSORS];
+
+/* -------------------------------------------------------------------------- */
+/* Simulated sensor sets                                                      */
+/* -------------------------------------------------------------------------- */
+
+// A board full of sensors: 10 ms to 1 s periods, some with a conversion between start and read
+static const sensor_sim_config_t s_board[] = {
+    {.name = "imu",     .period_ms = 10,   .exec_us = 300},
+    {.name = "accel",   .period_ms = 20,   .exec_us = 200},
+    {.name = "baro",    .period_ms = 25,   .exec_us = 150, .convert_ms = 8},
+    {.name = "light",   .period_ms = 50,   .exec_us = 200},
+    {.name = "mag",     .period_ms = 50,   .exec_us = 300, .deadline_ms = 20},
+    {.name = "adc",     .period_ms = 100,  .exec_us = 500},
+    {.name = "co2",     .period_ms = 100,  .exec_us = 300, .convert_ms = 20},
+    {.name = "soil",    .period_ms = 200,  .exec_us = 250},
+    {.name = "gas",     .period_ms = 250,  .exec_us = 400, .fail_every = 5},
+    {.name = "voltage", .period_ms = 500,  .exec_us = 100},
+    {.name = "dht20",   .period_ms = 1000, .exec_us = 400, .convert_ms = 80},
+    {.name = "temp",    .period_ms = 1000, .exec_us = 150},
+};
+#define BOARD_COUNT (sizeof(s_board) / sizeof(s_board[0]))
+
+static void bench_on_reading(const sensor_driver_t *driver, const sensor_reading_t *reading, void *arg)
+{
+    bench_count_t *count = (bench_count_t*)arg;
+    count->readings++;
+    if (reading->err != ESP_OK) {
+        count->errors++;
+    }
+}
+
+static int64_t bench_now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/**
+ * @brief Create a scheduler with the given sensors, run it for run_ms and stop it
+ */
+static sensor_sched_t* bench_run(const sensor_sim_config_t *sims, size_t count, uint32_t run_ms)
+{
+    sensor_sched_config_t config = SENSOR_SCHED_DEFAULT_CONFIG();
+    sensor_sched_t *sched = sensor_sched_create(&config);
+    if (sched == NULL) {
+        return NULL;
+    }
+    for (size_t i = 0; i < count; i++) {
+        s_counts[i] = (bench_count_t){0};
+        if (sensor_sim_add(sched, &sims[i], bench_on_reading, &s_counts[i]) != (int)i) {
+            BENCH_ERROR("Cannot add %s", sims[i].name);
+            return NULL;
+        }
+    }
+    if (sensor_sched_start(sched) != ESP_OK) {
+        return NULL;
+    }
+    vTaskDelay(pdMS_TO_TICKS(run_ms));
+    sensor_sched_stop(sched);
+    sensor_sched_log_stats(sched);
+    return sched;
+}
+
+/* -------------------------------------------------------------------------- */
+/* Scenarios                                                                  */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief Twelve sensors on one task: every release served, on time, without drift
+ */
+static bool bench_many_sensors(void)
+{
+    sensor_sched_t *sched = bench_run(s_board, BOARD_COUNT, BENCH_RUN_MS);
+    if (sched == NULL) {
+        BENCH_ERROR("Scheduler failed");
+        return false;
+    }
+    bool ok = true;
+    uint32_t jitter_us_max = 0;
+    for (int i = 0; i < (int)BOARD_COUNT; i++) {
+        sensor_sched_stats_t stats;
+        sensor_sched_get_stats(sched, i, &stats);
+        // Releases at 0, T, 2T...: the last one may still be converting when the run stops
+        uint32_t expected = BENCH_RUN_MS / s_board[i].period_ms + 1;
+        if (stats.samples + 1 < expected || stats.samples > expected) {
+            BENCH_ERROR("%s: %lu samples, expected %lu", s_board[i].name, (unsigned long)stats.samples,
+                        (unsigned long)expected);
+            ok = false;
+        }
+        if (stats.skipped || stats.overruns * 100 > stats.samples * BENCH_MAX_OVERRUN) {
+            BENCH_ERROR("%s: %lu overruns, %lu skipped", s_board[i].name, (unsigned long)stats.overruns,
+                        (unsigned long)stats.skipped);
+            ok = false;
+        }
+        uint32_t errors = s_board[i].fail_every ? stats.samples / s_board[i].fail_every : 0;
+        if (s_counts[i].readings != stats.samples || s_counts[i].errors != errors || stats.errors != errors) {
+            BENCH_ERROR("%s: %lu readings, %lu errors", s_board[i].name, (unsigned long)s_counts[i].readings,
+                        (unsigned long)s_counts[i].errors);
+            ok = false;
+        }
+        if (stats.jitter_us_max > jitter_us_max) {
+            jitter_us_max = stats.jitter_us_max;
+        }
+    }
+    BENCH_INFO("scenario=many_sensors sensors=%u run_ms=%u jitter_us_max=%lu result=%s", (unsigned)BOARD_COUNT,
+               BENCH_RUN_MS, (unsigned long)jitter_us_max, ok ? "pass" : "FAIL");
+    return ok;
+}
+
+/**
+ * @brief Absolute releases against a vTaskDelay() loop doing the same work
+ */
+static bool bench_drift(void)
+{
+    const sensor_sim_config_t sim = {.name = "drift", .period_ms = 20, .exec_us = 2000};
+    sensor_sched_t *sched = bench_run(&sim, 1, BENCH_RUN_MS);
+    if (sched == NULL) {
+        BENCH_ERROR("Scheduler failed");
+        return false;
+    }
+    sensor_sched_stats_t stats;
+    sensor_sched_get_stats(sched, 0, &stats);
+
+    // The loop Lesson 10 used: work, then a relative delay, so each period is work + delay
+    uint32_t loops = 0;
+    int64_t end_us = bench_now_us() + BENCH_RUN_MS * 1000;
+    while (bench_now_us() < end_us) {
+        int64_t busy_us = bench_now_us() + sim.exec_us;
+        while (bench_now_us() < busy_us) {
+        }
+        loops++;
+        vTaskDelay(pdMS_TO_TICKS(sim.period_ms));
+    }
+
+    uint32_t expected = BENCH_RUN_MS / sim.period_ms + 1;
+    bool ok = stats.samples + 1 >= expected && stats.samples <= expected && loops < stats.samples;
+    BENCH_INFO("scenario=drift expected=%lu sched_samples=%lu delay_loop_samples=%lu delay_loop_drift_ms=%ld result=%s",
+               (unsigned long)expected, (unsigned long)stats.samples, (unsigned long)loops,
+               (long)(BENCH_RUN_MS - (int64_t)(loops - 1) * sim.period_ms), ok ? "pass" : "FAIL");
+    return ok;
+}
+
+/**
+ * @brief A 25 ms step blocks a 10 ms sensor: overruns and skipped releases are counted, the grid is kept
+ */
+static bool bench_overload(void)
+{
+    const sensor_sim_config_t sims[] = {
+        {.name = "fast", .period_ms = 10, .exec_us = 500},
+        {.name = "hog",  .period_ms = 50, .exec_us = 25000},
+    };
+    sensor_sched_t *sched = bench_run(sims, 2, BENCH_RUN_MS);
+    if (sched == NULL) {
+        BENCH_ERROR("Scheduler failed");
+        return false;
+    }
+    sensor_sched_stats_t fast;
+    sensor_sched_stats_t hog;
+    sensor_sched_get_stats(sched, sensor_sched_find(sched, "fast"), &fast);
+    sensor_sched_get_stats(sched, sensor_sched_find(sched, "hog"), &hog);
+
+    uint32_t releases = BENCH_RUN_MS / sims[0].period_ms + 1;
+    uint32_t served = fast.samples + fast.skipped;
+    bool ok = fast.overruns > 0 && fast.skipped > 0 && hog.overruns == 0 &&
+              served + 1 >= releases && served <= releases;
+    BENCH_INFO("scenario=overload fast_overruns=%lu fast_skipped=%lu fast_jitter_us_max=%lu releases=%lu served=%lu result=%s",
+               (unsigned long)fast.overruns, (unsigned long)fast.skipped, (unsigned long)fast.jitter_us_max,
+               (unsigned long)releases, (unsigned long)served, ok ? "pass" : "FAIL");
+    return ok;
+}
+
+void app_main(void)
+{
+    uint32_t failures = 0;
+    if (!bench_many_sensors()) {
+        failures++;
+    }
+    if (!bench_drift()) {
+        failures++;
+    }
+    if (!bench_overload()) {
+        failures++;
+    }
+    // Weeks of DHT20 samples through the history tiers
+    if (!history_bench_run()) {
+        failures++;
+    }
+    // Bus scheduler priorities, aging and batching on the mock bus
+    if (!i2c_bench_run()) {
+        failures++;
+    }
+    // Bus-hold time of a blocking DHT20 read against dht20_async
+    if (!dht20_bench_run()) {
+        failures++;
+    }
+    BENCH_INFO("%lu failure(s)", (unsigned long)failures);
+    exit(failures ? 1 : 0);    // Non-zero exit status fails a CI job
+}
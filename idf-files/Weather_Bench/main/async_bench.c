@@ -0,0 +1,189 @@
+// async_bench.c - weather_get_weather_and_forecast() against a server that takes its time
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <esp_log.h>
+#include <esp_timer.h>
+
+#include "weather.h"
+#include "mock_server.h"
+#include "bench_fixture.h"
+#include "async_bench.h"
+
+#define TAG "AsyncBench"
+#define BENCH_INFO(fmt, ...) ESP_LOGI(TAG, fmt, ##__VA_ARGS__)
+#define BENCH_ERROR(fmt, ...) ESP_LOGE(TAG, fmt, ##__VA_ARGS__)
+
+#define ASYNC_BENCH_DELAY_MS    300     // Think time of each response, like a busy public API
+#define ASYNC_BENCH_ROUNDS      5
+
+// What the fixtures hold
+#define ASYNC_BENCH_TEMP_C      27.3
+#define ASYNC_BENCH_TEXT        "Overcast"
+#define ASYNC_BENCH_POINTS      (7 * 24)
+
+typedef struct {
+    char *current;
+    size_t current_len;
+    char *hourly;
+    size_t hourly_len;
+    char *cert;
+    char *key;
+    mock_route_t routes[2];
+} async_fixtures_t;
+
+static bool async_check(const weather_forecast_t *forecast, double temp_c, const char *text)
+{
+    weather_forecast_state_t state;
+    weather_forecast_get_state(forecast, &state);
+    if (fabs(temp_c - ASYNC_BENCH_TEMP_C) > 0.05 || strcmp(text, ASYNC_BENCH_TEXT) != 0 ||
+        state.count != ASYNC_BENCH_POINTS) {
+        BENCH_ERROR("Got %.1f C \"%s\" and %u points", temp_c, text, state.count);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Average wall time of one current weather + forecast round
+ * @param concurrent Use weather_get_weather_and_forecast() instead of the two blocking calls
+ */
+static int64_t async_rounds(const weather_provider_t *provider, weather_forecast_t *forecast, bool concurrent,
+                            bool *ok)
+{
+    weather_t *weather = weather_create_with_provider(provider);
+    if (weather == NULL) {
+        *ok = false;
+        return 0;
+    }
+    int64_t total_us = 0;
+    for (int i = 0; i < ASYNC_BENCH_ROUNDS; i++) {
+        double temp_c = 0.0;
+        char text[WEATHER_TEXT_SIZE] = "";
+        int timestamp = 0;
+        bool fetched;
+        bool forecast_ok = false;
+
+        int64_t start_us = esp_timer_get_time();
+        if (concurrent) {
+            fetched = weather_get_weather_and_forecast(weather, forecast, &temp_c, text, &timestamp, &forecast_ok);
+        } else {
+            fetched = weather_get_weather(weather, &temp_c, text, &timestamp);
+            forecast_ok = fetched && weather_get_forecast(weather, forecast);
+        }
+        total_us += esp_timer_get_time() - start_us;
+        if (!fetched || !forecast_ok || !async_check(forecast, temp_c, text)) {
+            *ok = false;
+        }
+    }
+    weather_destroy(weather);
+    return total_us / ASYNC_BENCH_ROUNDS;
+}
+
+static mock_server_t* async_server(const async_fixtures_t *fx, bool tls, weather_provider_t *provider,
+                                   char *url, char *forecast_url, size_t url_size)
+{
+    const mock_server_config_t config = {
+        .routes = fx->routes,
+        .route_count = sizeof(fx->routes) / sizeof(fx->routes[0]),
+        .cert_pem = tls ? fx->cert : NULL,
+        .key_pem = tls ? fx->key : NULL,
+        .keep_alive = true,
+    };
+    mock_server_t *server = mock_server_start(&config);
+    if (server == NULL) {
+        return NULL;
+    }
+
+    // Open-Meteo's descriptor with its host replaced: same key paths and conversions
+    const char *scheme = tls ? "https" : "http";
+    snprintf(url, url_size, "%s://localhost:%u/v1/current", scheme, server->port);
+    snprintf(forecast_url, url_size, "%s://localhost:%u/v1/forecast", scheme, server->port);
+    *provider = weather_provider_open_meteo;
+    provider->url = url;
+    provider->forecast_url = forecast_url;
+    provider->cert_pem = tls ? fx->cert : NULL;
+    return server;
+}
+
+/**
+ * @brief Both requests in flight at once against one after the other over the keep-alive session
+ */
+static bool async_bench_concurrent(const async_fixtures_t *fx, weather_forecast_t *forecast)
+{
+    char url[64];
+    char forecast_url[64];
+    weather_provider_t provider;
+    mock_server_t *server = async_server(fx, true, &provider, url, forecast_url, sizeof(url));
+    if (server == NULL) {
+        return false;
+    }
+
+    bool ok = true;
+    int64_t sequential_us = async_rounds(&provider, forecast, false, &ok);
+    int64_t concurrent_us = async_rounds(&provider, forecast, true, &ok);
+    mock_server_stop(server);
+
+    // Two responses of ASYNC_BENCH_DELAY_MS each: about one delay saved per round
+    bool faster = concurrent_us * 4 < sequential_us * 3;
+    BENCH_INFO("scenario=concurrent delay_ms=%u rounds=%u sequential_ms=%.1f concurrent_ms=%.1f speedup=%.2f result=%s",
+               ASYNC_BENCH_DELAY_MS, ASYNC_BENCH_ROUNDS, sequential_us / 1000.0, concurrent_us / 1000.0,
+               (double)sequential_us / (concurrent_us ? concurrent_us : 1), ok && faster ? "pass" : "FAIL");
+    return ok && faster;
+}
+
+/**
+ * @brief Plain HTTP (the thinknode default) cannot use the async engine: both requests go over one connection
+ */
+static bool async_bench_plain_http(const async_fixtures_t *fx, weather_forecast_t *forecast)
+{
+    char url[64];
+    char forecast_url[64];
+    weather_provider_t provider;
+    mock_server_t *server = async_server(fx, false, &provider, url, forecast_url, sizeof(url));
+    if (server == NULL) {
+        return false;
+    }
+
+    bool ok = true;
+    int64_t round_us = async_rounds(&provider, forecast, true, &ok);
+    mock_server_stats_t stats;
+    mock_server_get_stats(server, &stats);
+    mock_server_stop(server);
+
+    // Sequential fallback: two delays per round, every request on the first connection
+    ok = ok && stats.connections == 1 && stats.requests == 2 * ASYNC_BENCH_ROUNDS &&
+         round_us >= 2 * ASYNC_BENCH_DELAY_MS * 1000;
+    BENCH_INFO("scenario=plain_http fallback=sequential round_ms=%.1f connections=%lu requests=%lu result=%s",
+               round_us / 1000.0, (unsigned long)stats.connections, (unsigned long)stats.requests,
+               ok ? "pass" : "FAIL");
+    return ok;
+}
+
+bool async_bench_run(void)
+{
+    async_fixtures_t fx = {0};
+    fx.current = bench_fixture_load("open_meteo_current.json", &fx.current_len);
+    fx.hourly = bench_fixture_load("open_meteo_hourly.json", &fx.hourly_len);
+    fx.cert = bench_fixture_load("server_cert.pem", NULL);
+    fx.key = bench_fixture_load("server_key.pem", NULL);
+    fx.routes[0] = (mock_route_t){.path = "/v1/current", .body = fx.current, .body_len = fx.current_len,
+                                  .delay_ms = ASYNC_BENCH_DELAY_MS};
+    fx.routes[1] = (mock_route_t){.path = "/v1/forecast", .body = fx.hourly, .body_len = fx.hourly_len,
+                                  .delay_ms = ASYNC_BENCH_DELAY_MS};
+    weather_forecast_t *forecast = weather_forecast_create(WEATHER_FORECAST_CAPACITY);
+
+    bool ok = false;
+    if (fx.current && fx.hourly && fx.cert && fx.key && forecast) {
+        ok = async_bench_concurrent(&fx, forecast);
+        ok = async_bench_plain_http(&fx, forecast) && ok;
+    }
+
+    weather_forecast_destroy(forecast);
+    free(fx.current);
+    free(fx.hourly);
+    free(fx.cert);
+    free(fx.key);
+    return ok;
+}
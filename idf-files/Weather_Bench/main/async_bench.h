@@ -0,0 +1,15 @@
+
+#ifndef _ASYNC_BENCH_H
+#define _ASYNC_BENCH_H
+
+#include <stdbool.h>
+
+
+/**
+ * @brief Fetch the current weather and the forecast from a slow local server, one after the other
+ * and with both requests in flight, then check the plain HTTP fallback
+ * @return bool Returns false when the concurrent fetch is not faster or a result is wrong
+ */
+bool async_bench_run(void);
+
+#endif // _ASYNC_BENCH_H
@@ -0,0 +1,39 @@
+// bench_fixture.c - checked-in response bodies, certificates and JSON corpus files
+#include <stdio.h>
+#include <stdlib.h>
+#include <esp_log.h>
+
+#include "bench_fixture.h"
+
+#define TAG "BenchFixture"
+
+char* bench_fixture_load(const char *name, size_t *len)
+{
+    const char *dir = getenv("WEATHER_BENCH_FIXTURES");
+    if (dir == NULL) dir = BENCH_FIXTURE_DIR;
+
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        ESP_LOGE(TAG, "Cannot open %s (run from the project folder or set WEATHER_BENCH_FIXTURES)", path);
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    char *data = (size >= 0) ? (char*)malloc(size + 1) : NULL;
+    if (data == NULL || fread(data, 1, size, f) != (size_t)size) {
+        ESP_LOGE(TAG, "Cannot read %s", path);
+        free(data);
+        fclose(f);
+        return NULL;
+    }
+    fclose(f);
+    data[size] = '\0';
+    if (len) {
+        *len = (size_t)size;
+    }
+    return data;
+}
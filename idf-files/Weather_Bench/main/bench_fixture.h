@@ -0,0 +1,19 @@
+
+#ifndef _BENCH_FIXTURE_H
+#define _BENCH_FIXTURE_H
+
+#include <stddef.h>
+
+
+#define BENCH_FIXTURE_DIR   "fixtures"      // Overridden by $WEATHER_BENCH_FIXTURES
+
+
+/**
+ * @brief Read a checked-in fixture file
+ * @param name File name inside the fixtures folder
+ * @param len Optional size output pointer (terminator excluded)
+ * @return char* Returns a NUL terminated heap buffer (free() it), NULL if the file cannot be read
+ */
+char* bench_fixture_load(const char *name, size_t *len);
+
+#endif // _BENCH_FIXTURE_H
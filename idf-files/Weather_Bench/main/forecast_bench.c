@@ -0,0 +1,311 @@
+// forecast_bench.c - the struct-of-arrays forecast timeline against a cJSON tree and an array of structs
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <math.h>
+#include <pthread.h>
+#include <esp_log.h>
+#include <esp_timer.h>
+#include "cJSON.h"
+
+#include "weather.h"
+#include "bench_fixture.h"
+#include "forecast_bench.h"
+
+#define TAG "ForecastBench"
+#define BENCH_INFO(fmt, ...) ESP_LOGI(TAG, fmt, ##__VA_ARGS__)
+#define BENCH_ERROR(fmt, ...) ESP_LOGE(TAG, fmt, ##__VA_ARGS__)
+
+#define FORECAST_BENCH_ITERATIONS   100
+#define FORECAST_BENCH_CHUNK        512     // esp_http_client's default receive buffer
+#define FORECAST_BENCH_FOLLOW_RUNS  200     // Timelines written while the reader follows
+
+// The layout the timeline replaces: one struct per point, built from a parsed tree
+typedef struct {
+    int32_t time;
+    double temp_c;
+} forecast_point_t;
+
+// Streaming ingestion, as weather_get_forecast() does it
+typedef struct {
+    const weather_provider_t *provider;
+    weather_forecast_t *forecast;
+    char time_value[32];
+    char temp_value[16];
+    json_stream_field_t fields[2];
+    json_stream_t parser;
+} forecast_ingest_t;
+
+// Reader thread of the follow scenario
+typedef struct {
+    const weather_forecast_t *forecast;
+    const forecast_point_t *expected;
+    size_t count;
+    volatile bool done;
+    uint32_t copies;
+    uint32_t restarts;          // Copies refused because a new timeline started
+    uint32_t torn;              // Copied points that differ from the document
+} forecast_reader_t;
+
+typedef union {
+    size_t size;
+    max_align_t align;
+} forecast_heap_header_t;
+
+static size_t s_heap_used;
+static size_t s_heap_peak;
+
+// ---------------------- Streaming into the timeline ----------------------
+
+static void forecast_ingest_time(const char *value, size_t len, void *arg)
+{
+    forecast_ingest_t *ingest = (forecast_ingest_t*)arg;
+    int ts = 0;
+    if (weather_provider_parse_time(ingest->provider, value, &ts)) {
+        weather_forecast_push_time(ingest->forecast, ts);
+    }
+}
+
+static void forecast_ingest_temp(const char *value, size_t len, void *arg)
+{
+    forecast_ingest_t *ingest = (forecast_ingest_t*)arg;
+    double temp_c = 0.0;
+    if (weather_provider_parse_temp(ingest->provider, value, &temp_c)) {
+        weather_forecast_push_temp(ingest->forecast, temp_c);
+    }
+}
+
+static void forecast_ingest_init(forecast_ingest_t *ingest, const weather_provider_t *provider,
+                                 weather_forecast_t *forecast)
+{
+    ingest->provider = provider;
+    ingest->forecast = forecast;
+    ingest->fields[0] = (json_stream_field_t){
+        .path = provider->forecast_time_path, .value = ingest->time_value, .value_size = sizeof(ingest->time_value),
+        .on_value = forecast_ingest_time, .arg = ingest,
+    };
+    ingest->fields[1] = (json_stream_field_t){
+        .path = provider->forecast_temp_path, .value = ingest->temp_value, .value_size = sizeof(ingest->temp_value),
+        .on_value = forecast_ingest_temp, .arg = ingest,
+    };
+    json_stream_init(&ingest->parser, ingest->fields, 2);
+}
+
+static bool forecast_ingest_run(forecast_ingest_t *ingest, const char *json, size_t len)
+{
+    json_stream_reset(&ingest->parser);
+    weather_forecast_begin(ingest->forecast);
+    for (size_t pos = 0; pos < len; pos += FORECAST_BENCH_CHUNK) {
+        size_t n = (len - pos < FORECAST_BENCH_CHUNK) ? len - pos : FORECAST_BENCH_CHUNK;
+        if (!json_stream_feed(&ingest->parser, json + pos, n)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ---------------------- cJSON into an array of structs ----------------------
+
+static void* forecast_heap_malloc(size_t size)
+{
+    forecast_heap_header_t *header = (forecast_heap_header_t*)malloc(sizeof(forecast_heap_header_t) + size);
+    if (header == NULL) {
+        return NULL;
+    }
+    header->size = size;
+    s_heap_used += size;
+    if (s_heap_used > s_heap_peak) {
+        s_heap_peak = s_heap_used;
+    }
+    return header + 1;
+}
+
+static void forecast_heap_free(void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+    forecast_heap_header_t *header = (forecast_heap_header_t*)ptr - 1;
+    s_heap_used -= header->size;
+    free(header);
+}
+
+/**
+ * @brief Parse the whole body, then copy hourly.time / hourly.temperature_2m into an array of structs
+ * @return forecast_point_t* Points (free with forecast_heap_free()), NULL on failure
+ */
+static forecast_point_t* forecast_tree_run(const weather_provider_t *provider, const char *json, size_t *count)
+{
+    cJSON *root = cJSON_Parse(json);
+    const cJSON *hourly = cJSON_GetObjectItemCaseSensitive(root, "hourly");
+    const cJSON *times = cJSON_GetObjectItemCaseSensitive(hourly, "time");
+    const cJSON *temps = cJSON_GetObjectItemCaseSensitive(hourly, "temperature_2m");
+    int n = cJSON_GetArraySize(times);
+    forecast_point_t *points = NULL;
+    if (n > 0 && n == cJSON_GetArraySize(temps)) {
+        points = (forecast_point_t*)forecast_heap_malloc(n * sizeof(forecast_point_t));
+    }
+    if (points) {
+        const cJSON *time = times->child;
+        const cJSON *temp = temps->child;
+        for (int i = 0; i < n; i++, time = time->next, temp = temp->next) {
+            int ts = 0;
+            weather_provider_parse_time(provider, cJSON_IsString(time) ? time->valuestring : "", &ts);
+            points[i].time = ts;
+            points[i].temp_c = temp->valuedouble * provider->temp_scale + provider->temp_offset;
+        }
+        *count = n;
+    }
+    cJSON_Delete(root);
+    return points;
+}
+
+// ---------------------- Scenarios ----------------------
+
+/**
+ * @brief One hourly document: both layouts must hold the same points, then time both and measure their heap
+ */
+static bool forecast_bench_document(const char *file, uint16_t capacity)
+{
+    size_t len = 0;
+    char *json = bench_fixture_load(file, &len);
+    weather_forecast_t *forecast = weather_forecast_create(capacity);
+    forecast_ingest_t *ingest = (forecast_ingest_t*)calloc(1, sizeof(forecast_ingest_t));
+    bool ok = json && forecast && ingest;
+
+    size_t count = 0;
+    forecast_point_t *points = NULL;
+    cJSON_Hooks hooks = { .malloc_fn = forecast_heap_malloc, .free_fn = forecast_heap_free };
+    cJSON_InitHooks(&hooks);
+    s_heap_used = 0;
+    s_heap_peak = 0;
+    if (ok) {
+        forecast_ingest_init(ingest, &weather_provider_open_meteo, forecast);
+        ok = forecast_ingest_run(ingest, json, len);
+        points = forecast_tree_run(&weather_provider_open_meteo, json, &count);
+        ok = ok && points != NULL;
+    }
+    size_t tree_peak = s_heap_peak;
+
+    weather_forecast_state_t state = {0};
+    if (ok) {
+        weather_forecast_get_state(forecast, &state);
+        ok = state.count == count && count == capacity;
+        for (size_t i = 0; ok && i < count; i++) {
+            ok = forecast->time[i] == points[i].time &&
+                 forecast->temp_dc[i] == (int16_t)lround(points[i].temp_c * 10.0);
+        }
+        if (!ok) {
+            BENCH_ERROR("%s: timeline has %u points, the tree %u", file, state.count, (unsigned)count);
+        }
+    }
+    forecast_heap_free(points);
+
+    int64_t stream_us = 0;
+    int64_t tree_us = 0;
+    if (ok) {
+        int64_t start_us = esp_timer_get_time();
+        for (int i = 0; i < FORECAST_BENCH_ITERATIONS; i++) {
+            forecast_ingest_run(ingest, json, len);
+        }
+        stream_us = esp_timer_get_time() - start_us;
+
+        start_us = esp_timer_get_time();
+        for (int i = 0; i < FORECAST_BENCH_ITERATIONS; i++) {
+            forecast_heap_free(forecast_tree_run(&weather_provider_open_meteo, json, &count));
+        }
+        tree_us = esp_timer_get_time() - start_us;
+    }
+    cJSON_InitHooks(NULL);
+
+    // Streaming allocates nothing while parsing: its heap is the timeline itself.
+    // The tree needs the whole body in one buffer next to it.
+    size_t timeline_bytes = capacity * (sizeof(int32_t) + sizeof(int16_t));
+    BENCH_INFO("file=%s points=%u stream_us=%.1f tree_us=%.1f speedup=%.2f timeline_bytes=%u "
+               "tree_heap_peak=%u result=%s",
+               file, (unsigned)count, (double)stream_us / FORECAST_BENCH_ITERATIONS,
+               (double)tree_us / FORECAST_BENCH_ITERATIONS, (double)tree_us / (stream_us ? stream_us : 1),
+               (unsigned)timeline_bytes, (unsigned)(tree_peak + len + 1), ok ? "pass" : "FAIL");
+
+    free(ingest);
+    weather_forecast_destroy(forecast);
+    free(json);
+    return ok;
+}
+
+static void* forecast_reader_thread(void *arg)
+{
+    forecast_reader_t *reader = (forecast_reader_t*)arg;
+    int32_t time[WEATHER_FORECAST_CAPACITY];
+    int16_t temp_dc[WEATHER_FORECAST_CAPACITY];
+
+    while (!reader->done) {
+        weather_forecast_state_t state;
+        weather_forecast_get_state(reader->forecast, &state);
+        if (state.count == 0) {
+            continue;
+        }
+        size_t n = weather_forecast_copy(reader->forecast, &state, 0, WEATHER_FORECAST_CAPACITY, time, temp_dc);
+        if (n == 0) {
+            reader->restarts++;
+            continue;
+        }
+        reader->copies++;
+        for (size_t i = 0; i < n && i < reader->count; i++) {
+            if (time[i] != reader->expected[i].time ||
+                temp_dc[i] != (int16_t)lround(reader->expected[i].temp_c * 10.0)) {
+                reader->torn++;
+                break;
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief A reader copies the published points while the writer restarts and refills the timeline
+ * (a real thread, so both run at the same time like the HTTP and LVGL tasks on two cores)
+ */
+static bool forecast_bench_follow(void)
+{
+    size_t len = 0;
+    size_t count = 0;
+    char *json = bench_fixture_load("open_meteo_hourly.json", &len);
+    forecast_point_t *expected = json ? forecast_tree_run(&weather_provider_open_meteo, json, &count) : NULL;
+    weather_forecast_t *forecast = weather_forecast_create(WEATHER_FORECAST_CAPACITY);
+    forecast_ingest_t *ingest = (forecast_ingest_t*)calloc(1, sizeof(forecast_ingest_t));
+    bool ok = expected && forecast && ingest;
+
+    forecast_reader_t reader = { .forecast = forecast, .expected = expected, .count = count };
+    pthread_t thread;
+    if (ok && pthread_create(&thread, NULL, forecast_reader_thread, &reader) == 0) {
+        forecast_ingest_init(ingest, &weather_provider_open_meteo, forecast);
+        for (int i = 0; i < FORECAST_BENCH_FOLLOW_RUNS; i++) {
+            ok = forecast_ingest_run(ingest, json, len) && ok;
+        }
+        reader.done = true;
+        pthread_join(thread, NULL);
+    } else {
+        ok = false;
+    }
+
+    ok = ok && reader.torn == 0 && reader.copies > 0;
+    BENCH_INFO("scenario=follow timelines=%u copies=%lu restarts=%lu torn=%lu result=%s",
+               FORECAST_BENCH_FOLLOW_RUNS, (unsigned long)reader.copies, (unsigned long)reader.restarts,
+               (unsigned long)reader.torn, ok ? "pass" : "FAIL");
+
+    free(ingest);
+    weather_forecast_destroy(forecast);
+    forecast_heap_free(expected);
+    free(json);
+    return ok;
+}
+
+bool forecast_bench_run(void)
+{
+    // A week of hourly points (the lesson's timeline), then 16 days
+    bool ok = forecast_bench_document("open_meteo_hourly.json", WEATHER_FORECAST_CAPACITY);
+    ok = forecast_bench_document("open_meteo_hourly_16d.json", 16 * 24) && ok;
+    return forecast_bench_follow() && ok;
+}
@@ -0,0 +1,15 @@
+
+#ifndef _FORECAST_BENCH_H
+#define _FORECAST_BENCH_H
+
+#include <stdbool.h>
+
+
+/**
+ * @brief Stream the hourly fixtures into the struct-of-arrays timeline and compare parse time and peak heap
+ * with a cJSON tree copied into an array of structs, then follow the timeline from a reader while it is written
+ * @return bool Returns false when the two layouts disagree or the reader sees a torn point
+ */
+bool forecast_bench_run(void);
+
+#endif // _FORECAST_BENCH_H
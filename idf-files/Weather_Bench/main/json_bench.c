@@ -0,0 +1,415 @@
+// json_bench.c - json_stream against cJSON on the checked-in response corpus
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <esp_log.h>
+#include <esp_timer.h>
+#include "cJSON.h"
+
+#include "json_stream.h"
+#include "bench_fixture.h"
+#include "json_bench.h"
+
+#define TAG "JsonBench"
+#define BENCH_INFO(fmt, ...) ESP_LOGI(TAG, fmt, ##__VA_ARGS__)
+#define BENCH_ERROR(fmt, ...) ESP_LOGE(TAG, fmt, ##__VA_ARGS__)
+
+#define JSON_BENCH_ITERATIONS   200
+#define JSON_BENCH_CHUNK        512     // esp_http_client's default receive buffer
+#define JSON_BENCH_MAX_FIELDS   16
+#define JSON_BENCH_MAX_STREAMS  2
+#define JSON_BENCH_VALUE_SIZE   64
+
+// One corpus document and the key paths to extract from it
+typedef struct {
+    const char *file;
+    const char *fields[JSON_BENCH_MAX_FIELDS];      // First match only, like the current weather
+    const char *streams[JSON_BENCH_MAX_STREAMS];    // Every match, like the forecast arrays
+} json_corpus_t;
+
+static const json_corpus_t s_corpus[] = {
+    { "thinknode_current.json", { "data.temp", "data.weather", "data.timestamp" }, { NULL } },
+    { "open_meteo_current.json", { "current.temperature_2m", "current.weather_code", "current.time" }, { NULL } },
+    { "openweathermap_current.json", { "main.temp", "weather.description", "dt" }, { NULL } },
+    { "open_meteo_hourly.json", { NULL }, { "hourly.time", "hourly.temperature_2m" } },
+    { "open_meteo_hourly_16d.json", { "hourly_units.precipitation" }, { "hourly.time", "hourly.temperature_2m" } },
+    { "openweathermap_forecast.json", { "city.name" }, { "list.dt", "list.main.temp" } },
+    { "json_edge_cases.json",
+      { "meta.note", "meta.unicode", "meta.raw_utf8", "meta.empty", "numbers.neg", "numbers.exp",
+        "numbers.exp_neg", "numbers.zero", "numbers.int", "flags.yes", "flags.no", "flags.none",
+        "deep.l2.l3.l4.l5.l6.l7.value", "after_long", "escaped_key", "rows.name" },
+      { "matrix" } },
+};
+
+// Documents json_stream_feed() must refuse
+static const char *const s_malformed[] = {
+    "{\"a\":}",                     // Missing value
+    "{\"a\" 1}",                    // Missing colon
+    "[1,2}",                        // Mismatched bracket
+    "{\"a\":1}}",                   // Extra closing bracket
+    "{\"a\":1} {\"b\":2}",          // Two root values
+    "{\"a\":\"\\u12G4\"}",          // Bad \u escape
+    "{a:1}",                        // Unquoted key
+    "[[[[[[[[[1]]]]]]]]]",          // Deeper than JSON_STREAM_MAX_DEPTH
+};
+
+// Every match of a streaming path, folded so both parsers can be compared
+typedef struct {
+    uint32_t count;
+    double sum;                     // Numbers
+    uint32_t hash;                  // Strings (FNV-1a over the unescaped text)
+} json_fold_t;
+
+typedef struct {
+    json_stream_field_t fields[JSON_BENCH_MAX_FIELDS + JSON_BENCH_MAX_STREAMS];
+    char values[JSON_BENCH_MAX_FIELDS + JSON_BENCH_MAX_STREAMS][JSON_BENCH_VALUE_SIZE];
+    json_fold_t folds[JSON_BENCH_MAX_STREAMS];
+    size_t field_count;
+    size_t stream_count;
+    json_stream_t parser;
+} json_extract_t;
+
+// cJSON allocations, counted through cJSON_InitHooks()
+typedef union {
+    size_t size;
+    max_align_t align;
+} json_heap_header_t;
+
+static size_t s_heap_used;
+static size_t s_heap_peak;
+
+// ---------------------- Folding ----------------------
+
+static uint32_t json_fnv1a(uint32_t hash, const char *text)
+{
+    for (; *text; text++) {
+        hash = (hash ^ (uint8_t)*text) * 16777619u;
+    }
+    return hash;
+}
+
+static void json_fold_number(json_fold_t *fold, double value)
+{
+    fold->count++;
+    fold->sum += value;
+}
+
+static void json_fold_string(json_fold_t *fold, const char *text)
+{
+    fold->count++;
+    fold->hash = json_fnv1a(fold->hash, text);
+}
+
+/**
+ * @brief json_stream hands out raw scalar text: whatever parses as a whole number is a number
+ */
+static void json_fold_stream_cb(const char *value, size_t len, void *arg)
+{
+    char *end = NULL;
+    double number = strtod(value, &end);
+    if (len > 0 && end == value + len) {
+        json_fold_number((json_fold_t*)arg, number);
+    } else {
+        json_fold_string((json_fold_t*)arg, value);
+    }
+}
+
+static bool json_fold_equal(const json_fold_t *a, const json_fold_t *b)
+{
+    return a->count == b->count && a->sum == b->sum && a->hash == b->hash;
+}
+
+// ---------------------- json_stream ----------------------
+
+static void json_extract_init(json_extract_t *ex, const json_corpus_t *doc)
+{
+    memset(ex, 0, sizeof(*ex));
+    for (size_t i = 0; i < JSON_BENCH_MAX_FIELDS && doc->fields[i]; i++) {
+        ex->fields[ex->field_count] = (json_stream_field_t){
+            .path = doc->fields[i], .value = ex->values[ex->field_count], .value_size = JSON_BENCH_VALUE_SIZE,
+        };
+        ex->field_count++;
+    }
+    for (size_t i = 0; i < JSON_BENCH_MAX_STREAMS && doc->streams[i]; i++) {
+        size_t n = ex->field_count + ex->stream_count;
+        ex->fields[n] = (json_stream_field_t){
+            .path = doc->streams[i], .value = ex->values[n], .value_size = JSON_BENCH_VALUE_SIZE,
+            .on_value = json_fold_stream_cb, .arg = &ex->folds[i],
+        };
+        ex->stream_count++;
+    }
+    json_stream_init(&ex->parser, ex->fields, ex->field_count + ex->stream_count);
+}
+
+/**
+ * @brief Parse a document fed in chunks, the way the HTTP event handler does
+ */
+static bool json_extract_run(json_extract_t *ex, const char *json, size_t len, size_t chunk)
+{
+    json_stream_reset(&ex->parser);
+    memset(ex->folds, 0, sizeof(ex->folds));
+    for (size_t pos = 0; pos < len; pos += chunk) {
+        size_t n = (len - pos < chunk) ? len - pos : chunk;
+        if (!json_stream_feed(&ex->parser, json + pos, n)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool json_extract_equal(const json_extract_t *a, const json_extract_t *b)
+{
+    for (size_t i = 0; i < a->field_count; i++) {
+        if (a->fields[i].found != b->fields[i].found || strcmp(a->values[i], b->values[i]) != 0) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < a->stream_count; i++) {
+        if (!json_fold_equal(&a->folds[i], &b->folds[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ---------------------- cJSON ----------------------
+
+static void* json_heap_malloc(size_t size)
+{
+    json_heap_header_t *header = (json_heap_header_t*)malloc(sizeof(json_heap_header_t) + size);
+    if (header == NULL) {
+        return NULL;
+    }
+    header->size = size;
+    s_heap_used += size;
+    if (s_heap_used > s_heap_peak) {
+        s_heap_peak = s_heap_used;
+    }
+    return header + 1;
+}
+
+static void json_heap_free(void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+    json_heap_header_t *header = (json_heap_header_t*)ptr - 1;
+    s_heap_used -= header->size;
+    free(header);
+}
+
+typedef bool (*json_match_cb_t)(const cJSON *node, void *arg);
+
+/**
+ * @brief Visit the scalars at a key path in document order, with arrays transparent as in json_stream.h
+ * @return bool Returns false once the callback asked to stop
+ */
+static bool json_walk(const cJSON *node, const char *path, json_match_cb_t cb, void *arg)
+{
+    if (cJSON_IsArray(node)) {
+        const cJSON *item;
+        cJSON_ArrayForEach(item, node) {
+            if (!json_walk(item, path, cb, arg)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (*path == '\0') {
+        return cJSON_IsObject(node) ? true : cb(node, arg);
+    }
+    if (!cJSON_IsObject(node)) {
+        return true;
+    }
+    const char *dot = strchr(path, '.');
+    size_t key_len = dot ? (size_t)(dot - path) : strlen(path);
+    const char *rest = dot ? dot + 1 : path + key_len;
+    const cJSON *item;
+    cJSON_ArrayForEach(item, node) {
+        if (strlen(item->string) == key_len && strncmp(item->string, path, key_len) == 0) {
+            if (!json_walk(item, rest, cb, arg)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool json_first_cb(const cJSON *node, void *arg)
+{
+    *(const cJSON**)arg = node;
+    return false;
+}
+
+static bool json_fold_cb(const cJSON *node, void *arg)
+{
+    if (cJSON_IsString(node)) {
+        json_fold_string((json_fold_t*)arg, node->valuestring);
+    } else if (cJSON_IsNumber(node)) {
+        json_fold_number((json_fold_t*)arg, node->valuedouble);
+    } else {
+        json_fold_string((json_fold_t*)arg, cJSON_IsTrue(node) ? "true" : cJSON_IsFalse(node) ? "false" : "null");
+    }
+    return true;
+}
+
+/**
+ * @brief The old code path: buffer the whole body, build the tree, look the fields up
+ */
+static bool json_cjson_run(const json_corpus_t *doc, const char *json, const cJSON **first, json_fold_t *folds,
+                           cJSON **root)
+{
+    *root = cJSON_Parse(json);
+    if (*root == NULL) {
+        return false;
+    }
+    for (size_t i = 0; i < JSON_BENCH_MAX_FIELDS && doc->fields[i]; i++) {
+        first[i] = NULL;
+        json_walk(*root, doc->fields[i], json_first_cb, (void*)&first[i]);
+    }
+    for (size_t i = 0; i < JSON_BENCH_MAX_STREAMS && doc->streams[i]; i++) {
+        memset(&folds[i], 0, sizeof(folds[i]));
+        json_walk(*root, doc->streams[i], json_fold_cb, &folds[i]);
+    }
+    return true;
+}
+
+/**
+ * @brief Compare one json_stream capture with the cJSON node at the same path
+ */
+static bool json_scalar_equal(const json_stream_field_t *field, const cJSON *node)
+{
+    if (node == NULL || !field->found) {
+        return node == NULL && !field->found;
+    }
+    if (cJSON_IsString(node)) {
+        return strcmp(field->value, node->valuestring) == 0;
+    }
+    if (cJSON_IsNumber(node)) {
+        return strtod(field->value, NULL) == node->valuedouble;
+    }
+    const char *literal = cJSON_IsTrue(node) ? "true" : cJSON_IsFalse(node) ? "false" : "null";
+    return strcmp(field->value, literal) == 0;
+}
+
+// ---------------------- Scenarios ----------------------
+
+/**
+ * @brief One corpus document: chunking must not change the result, cJSON must agree, then time both
+ */
+static bool json_bench_document(const json_corpus_t *doc)
+{
+    size_t len = 0;
+    char *json = bench_fixture_load(doc->file, &len);
+    json_extract_t *ex = (json_extract_t*)calloc(2, sizeof(json_extract_t));
+    if (json == NULL || ex == NULL) {
+        free(json);
+        free(ex);
+        return false;
+    }
+    json_extract_t *whole = &ex[0];
+    json_extract_t *chunked = &ex[1];
+    bool ok = true;
+
+    json_extract_init(whole, doc);
+    json_extract_init(chunked, doc);
+    if (!json_extract_run(whole, json, len, len)) {
+        BENCH_ERROR("%s: json_stream rejected the document", doc->file);
+        ok = false;
+    }
+    static const size_t chunks[] = {1, 7, 64, JSON_BENCH_CHUNK};
+    for (size_t i = 0; ok && i < sizeof(chunks) / sizeof(chunks[0]); i++) {
+        if (!json_extract_run(chunked, json, len, chunks[i]) || !json_extract_equal(whole, chunked)) {
+            BENCH_ERROR("%s: %u byte chunks give a different result", doc->file, (unsigned)chunks[i]);
+            ok = false;
+        }
+    }
+
+    // cJSON is the reference for every path
+    const cJSON *first[JSON_BENCH_MAX_FIELDS];
+    json_fold_t folds[JSON_BENCH_MAX_STREAMS];
+    cJSON *root = NULL;
+    cJSON_Hooks hooks = { .malloc_fn = json_heap_malloc, .free_fn = json_heap_free };
+    cJSON_InitHooks(&hooks);
+    s_heap_used = 0;
+    s_heap_peak = 0;
+    if (!json_cjson_run(doc, json, first, folds, &root)) {
+        BENCH_ERROR("%s: cJSON rejected the document", doc->file);
+        ok = false;
+    }
+    for (size_t i = 0; ok && i < whole->field_count; i++) {
+        if (!json_scalar_equal(&whole->fields[i], first[i])) {
+            BENCH_ERROR("%s: %s is \"%s\", cJSON disagrees", doc->file, doc->fields[i], whole->values[i]);
+            ok = false;
+        }
+    }
+    for (size_t i = 0; ok && i < whole->stream_count; i++) {
+        if (!json_fold_equal(&whole->folds[i], &folds[i]) || folds[i].count == 0) {
+            BENCH_ERROR("%s: %s gives %lu values, cJSON %lu", doc->file, doc->streams[i],
+                        (unsigned long)whole->folds[i].count, (unsigned long)folds[i].count);
+            ok = false;
+        }
+    }
+    cJSON_Delete(root);
+    size_t tree_peak = s_heap_peak;
+
+    int64_t stream_us = 0;
+    int64_t cjson_us = 0;
+    if (ok) {
+        int64_t start_us = esp_timer_get_time();
+        for (int i = 0; i < JSON_BENCH_ITERATIONS; i++) {
+            json_extract_run(chunked, json, len, JSON_BENCH_CHUNK);
+        }
+        stream_us = esp_timer_get_time() - start_us;
+
+        start_us = esp_timer_get_time();
+        for (int i = 0; i < JSON_BENCH_ITERATIONS; i++) {
+            json_cjson_run(doc, json, first, folds, &root);
+            cJSON_Delete(root);
+        }
+        cjson_us = esp_timer_get_time() - start_us;
+    }
+    cJSON_InitHooks(NULL);
+
+    // cJSON also needs the whole body in one buffer; json_stream keeps its state in the caller's struct
+    BENCH_INFO("file=%s bytes=%u fields=%u streams=%u stream_us=%.1f cjson_us=%.1f speedup=%.2f "
+               "stream_state_bytes=%u cjson_heap_peak=%u result=%s",
+               doc->file, (unsigned)len, (unsigned)whole->field_count, (unsigned)whole->stream_count,
+               (double)stream_us / JSON_BENCH_ITERATIONS, (double)cjson_us / JSON_BENCH_ITERATIONS,
+               (double)cjson_us / (stream_us ? stream_us : 1), (unsigned)sizeof(json_stream_t),
+               (unsigned)(tree_peak + len + 1), ok ? "pass" : "FAIL");
+    free(ex);
+    free(json);
+    return ok;
+}
+
+static bool json_bench_malformed(void)
+{
+    json_stream_field_t field = { .path = "a", .value = (char[8]){0}, .value_size = 8 };
+    json_stream_t parser;
+    json_stream_init(&parser, &field, 1);
+
+    size_t count = sizeof(s_malformed) / sizeof(s_malformed[0]);
+    size_t rejected = 0;
+    for (size_t i = 0; i < count; i++) {
+        json_stream_reset(&parser);
+        if (!json_stream_feed(&parser, s_malformed[i], strlen(s_malformed[i]))) {
+            rejected++;
+        } else {
+            BENCH_ERROR("Accepted %s", s_malformed[i]);
+        }
+    }
+    BENCH_INFO("scenario=malformed cases=%u rejected=%u result=%s", (unsigned)count, (unsigned)rejected,
+               rejected == count ? "pass" : "FAIL");
+    return rejected == count;
+}
+
+bool json_bench_run(void)
+{
+    bool ok = true;
+    for (size_t i = 0; i < sizeof(s_corpus) / sizeof(s_corpus[0]); i++) {
+        ok = json_bench_document(&s_corpus[i]) && ok;
+    }
+    return json_bench_malformed() && ok;
+}
@@ -0,0 +1,15 @@
+
+#ifndef _JSON_BENCH_H
+#define _JSON_BENCH_H
+
+#include <stdbool.h>
+
+
+/**
+ * @brief Extract the provider key paths from the JSON corpus with json_stream and with cJSON,
+ * compare the results and the cost of both, and check that malformed documents are rejected
+ * @return bool Returns false when json_stream disagrees with cJSON or accepts a malformed document
+ */
+bool json_bench_run(void);
+
+#endif // _JSON_BENCH_H
@@ -0,0 +1,54 @@
+// main.c - weather client benchmarks against a local mock server (linux target)
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <esp_log.h>
+
+#include "json_bench.h"
+#include "session_bench.h"
+#include "tls_bench.h"
+#include "provider_bench.h"
+#include "forecast_bench.h"
+#include "async_bench.h"
+
+#define TAG "WeatherBench"
+#define BENCH_INFO(fmt, ...) ESP_LOGI(TAG, fmt, ##__VA_ARGS__)
+#define BENCH_ERROR(fmt, ...) ESP_LOGE(TAG, fmt, ##__VA_ARGS__)
+
+void app_main(void)
+{
+    uint32_t failures = 0;
+
+    // Field extraction: json_stream against cJSON on the response corpus
+    if (!json_bench_run()) {
+        failures++;
+    }
+
+    // Every provider descriptor against its own responses
+    if (!provider_bench_run()) {
+        failures++;
+    }
+
+    // Forecast timeline layout: parse time, heap and a concurrent reader
+    if (!forecast_bench_run()) {
+        failures++;
+    }
+
+    // Keep-alive session and conditional GETs
+    if (!session_bench_run()) {
+        failures++;
+    }
+
+    // Reconnections: full TLS handshakes against resumed ones
+    if (!tls_bench_run()) {
+        failures++;
+    }
+
+    // Current weather and forecast: one after the other against both requests in flight
+    if (!async_bench_run()) {
+        failures++;
+    }
+
+    BENCH_INFO("%lu failure(s)", (unsigned long)failures);
+    exit(failures ? 1 : 0);    // Non-zero exit status fails a CI job
+}
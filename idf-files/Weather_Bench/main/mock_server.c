@@ -0,0 +1,544 @@
+// mock_server.c - canned HTTP/1.1 responses over TCP or TLS on 127.0.0.1
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <esp_log.h>
+#include "sdkconfig.h"
+#include <mbedtls/ssl.h>
+#include <mbedtls/entropy.h>
+#include <mbedtls/ctr_drbg.h>
+#include <mbedtls/x509_crt.h>
+#include <mbedtls/pk.h>
+#include <mbedtls/net_sockets.h>
+#if CONFIG_MBEDTLS_SERVER_SSL_SESSION_TICKETS
+#include <mbedtls/ssl_ticket.h>
+#endif
+
+#include "mock_server.h"
+
+#define TAG "MockServer"
+
+#define MOCK_POLL_MS        100     // Socket timeout: how often a blocked thread looks at the stop flag
+#define MOCK_REQUEST_SIZE   2048    // Request line and headers
+#define MOCK_HEADER_SIZE    256     // Response headers
+#define MOCK_AGAIN          (-2)    // Read timed out, nothing received
+#define MOCK_TICKET_LIFETIME_S  86400
+
+// Shared TLS state: the configuration is read-only once set up, the random generator is guarded
+typedef struct {
+    mbedtls_entropy_context entropy;
+    mbedtls_ctr_drbg_context drbg;
+    mbedtls_x509_crt cert;
+    mbedtls_pk_context key;
+    mbedtls_ssl_config conf;
+#if CONFIG_MBEDTLS_SERVER_SSL_SESSION_TICKETS
+    mbedtls_ssl_ticket_context ticket;
+    pthread_mutex_t ticket_lock;        // Ticket keys are shared by the connection threads
+    mock_server_t *server;
+#endif
+} mock_tls_t;
+
+// One accepted connection
+typedef struct {
+    mock_server_t *server;
+    int fd;
+    mbedtls_ssl_context ssl;
+    bool tls;
+} mock_conn_t;
+
+// ---------------------- Internal implementation functions ----------------------
+
+/**
+ * @brief Start a thread with every signal blocked: the FreeRTOS POSIX port drives its tick with signals
+ */
+static bool mock_thread_start(pthread_t *thread, void *(*entry)(void*), void *arg)
+{
+    sigset_t all, old;
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &old);
+    int err = pthread_create(thread, NULL, entry, arg);
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+    return err == 0;
+}
+
+static int mock_rng(void *arg, unsigned char *out, size_t len)
+{
+    mock_server_t *server = (mock_server_t*)arg;
+    mock_tls_t *tls = (mock_tls_t*)server->tls;
+    pthread_mutex_lock(&server->lock);
+    int ret = mbedtls_ctr_drbg_random(&tls->drbg, out, len);
+    pthread_mutex_unlock(&server->lock);
+    return ret;
+}
+
+static int mock_bio_send(void *arg, const unsigned char *buf, size_t len)
+{
+    int fd = ((mock_conn_t*)arg)->fd;
+    ssize_t n = send(fd, buf, len, MSG_NOSIGNAL);
+    if (n < 0) {
+        return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ?
+               MBEDTLS_ERR_SSL_WANT_WRITE : MBEDTLS_ERR_NET_SEND_FAILED;
+    }
+    return (int)n;
+}
+
+static int mock_bio_recv(void *arg, unsigned char *buf, size_t len)
+{
+    int fd = ((mock_conn_t*)arg)->fd;
+    ssize_t n = recv(fd, buf, len, 0);
+    if (n < 0) {
+        return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ?
+               MBEDTLS_ERR_SSL_WANT_READ : MBEDTLS_ERR_NET_RECV_FAILED;
+    }
+    return (int)n;
+}
+
+#if CONFIG_MBEDTLS_SERVER_SSL_SESSION_TICKETS
+static int mock_ticket_write(void *arg, const mbedtls_ssl_session *session, unsigned char *start,
+                             const unsigned char *end, size_t *tlen, uint32_t *lifetime)
+{
+    mock_tls_t *tls = (mock_tls_t*)arg;
+    pthread_mutex_lock(&tls->ticket_lock);
+    int ret = mbedtls_ssl_ticket_write(&tls->ticket, session, start, end, tlen, lifetime);
+    pthread_mutex_unlock(&tls->ticket_lock);
+    return ret;
+}
+
+/**
+ * @brief Accepting a ticket means the handshake is resumed: count it
+ */
+static int mock_ticket_parse(void *arg, mbedtls_ssl_session *session, unsigned char *buf, size_t len)
+{
+    mock_tls_t *tls = (mock_tls_t*)arg;
+    pthread_mutex_lock(&tls->ticket_lock);
+    int ret = mbedtls_ssl_ticket_parse(&tls->ticket, session, buf, len);
+    pthread_mutex_unlock(&tls->ticket_lock);
+    if (ret == 0) {
+        pthread_mutex_lock(&tls->server->lock);
+        tls->server->stats.resumed++;
+        pthread_mutex_unlock(&tls->server->lock);
+    }
+    return ret;
+}
+#endif
+
+static void mock_tls_free(mock_tls_t *tls)
+{
+    if (tls) {
+#if CONFIG_MBEDTLS_SERVER_SSL_SESSION_TICKETS
+        mbedtls_ssl_ticket_free(&tls->ticket);
+        pthread_mutex_destroy(&tls->ticket_lock);
+#endif
+        mbedtls_ssl_config_free(&tls->conf);
+        mbedtls_pk_free(&tls->key);
+        mbedtls_x509_crt_free(&tls->cert);
+        mbedtls_ctr_drbg_free(&tls->drbg);
+        mbedtls_entropy_free(&tls->entropy);
+        free(tls);
+    }
+}
+
+static mock_tls_t* mock_tls_create(mock_server_t *server)
+{
+    const mock_server_config_t *config = &server->config;
+    mock_tls_t *tls = (mock_tls_t*)calloc(1, sizeof(mock_tls_t));
+    if (tls == NULL) {
+        return NULL;
+    }
+    mbedtls_entropy_init(&tls->entropy);
+    mbedtls_ctr_drbg_init(&tls->drbg);
+    mbedtls_x509_crt_init(&tls->cert);
+    mbedtls_pk_init(&tls->key);
+    mbedtls_ssl_config_init(&tls->conf);
+#if CONFIG_MBEDTLS_SERVER_SSL_SESSION_TICKETS
+    mbedtls_ssl_ticket_init(&tls->ticket);
+    pthread_mutex_init(&tls->ticket_lock, NULL);
+    tls->server = server;
+#endif
+    server->tls = tls;
+
+    int ret = mbedtls_ctr_drbg_seed(&tls->drbg, mbedtls_entropy_func, &tls->entropy,
+                                    (const unsigned char*)TAG, strlen(TAG));
+    if (ret == 0) {
+        ret = mbedtls_x509_crt_parse(&tls->cert, (const unsigned char*)config->cert_pem,
+                                     strlen(config->cert_pem) + 1);
+    }
+    if (ret == 0) {
+        ret = mbedtls_pk_parse_key(&tls->key, (const unsigned char*)config->key_pem, strlen(config->key_pem) + 1,
+                                   NULL, 0, mock_rng, server);
+    }
+    if (ret == 0) {
+        ret = mbedtls_ssl_config_defaults(&tls->conf, MBEDTLS_SSL_IS_SERVER, MBEDTLS_SSL_TRANSPORT_STREAM,
+                                          MBEDTLS_SSL_PRESET_DEFAULT);
+    }
+    if (ret == 0) {
+        mbedtls_ssl_conf_rng(&tls->conf, mock_rng, server);
+        ret = mbedtls_ssl_conf_own_cert(&tls->conf, &tls->cert, &tls->key);
+    }
+    if (ret == 0 && config->session_tickets) {
+#if CONFIG_MBEDTLS_SERVER_SSL_SESSION_TICKETS
+        ret = mbedtls_ssl_ticket_setup(&tls->ticket, mock_rng, server, MBEDTLS_CIPHER_AES_256_GCM,
+                                       MOCK_TICKET_LIFETIME_S);
+        if (ret == 0) {
+            mbedtls_ssl_conf_session_tickets_cb(&tls->conf, mock_ticket_write, mock_ticket_parse, tls);
+        }
+#else
+        ESP_LOGW(TAG, "Session tickets need CONFIG_MBEDTLS_SERVER_SSL_SESSION_TICKETS, every handshake is full");
+#endif
+    }
+    if (ret != 0) {
+        ESP_LOGE(TAG, "TLS setup failed: -0x%04x", (unsigned)-ret);
+        mock_tls_free(tls);
+        server->tls = NULL;
+        return NULL;
+    }
+    return tls;
+}
+
+/**
+ * @brief Read what is available: bytes, 0 when the peer closed, MOCK_AGAIN on timeout, -1 on error
+ */
+static int mock_conn_read(mock_conn_t *conn, char *buf, size_t len)
+{
+    if (!conn->tls) {
+        ssize_t n = recv(conn->fd, buf, len, 0);
+        if (n < 0) {
+            return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? MOCK_AGAIN : -1;
+        }
+        return (int)n;
+    }
+    int ret = mbedtls_ssl_read(&conn->ssl, (unsigned char*)buf, len);
+    if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE) {
+        return MOCK_AGAIN;
+    }
+    if (ret == MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY) {
+        return 0;
+    }
+    return ret < 0 ? -1 : ret;
+}
+
+static bool mock_conn_write(mock_conn_t *conn, const char *data, size_t len)
+{
+    while (len > 0) {
+        int n;
+        if (conn->tls) {
+            n = mbedtls_ssl_write(&conn->ssl, (const unsigned char*)data, len);
+            if (n == MBEDTLS_ERR_SSL_WANT_READ || n == MBEDTLS_ERR_SSL_WANT_WRITE) {
+                continue;
+            }
+        } else {
+            n = (int)send(conn->fd, data, len, MSG_NOSIGNAL);
+            if (n < 0 && (errno == EAGAIN || errno == EINTR)) {
+                continue;
+            }
+        }
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        len -= n;
+    }
+    return true;
+}
+
+static bool mock_conn_handshake(mock_conn_t *conn)
+{
+    mock_server_t *server = conn->server;
+    mock_tls_t *tls = (mock_tls_t*)server->tls;
+
+    mbedtls_ssl_init(&conn->ssl);
+    conn->tls = true;
+    if (mbedtls_ssl_setup(&conn->ssl, &tls->conf) != 0) {
+        return false;
+    }
+    mbedtls_ssl_set_bio(&conn->ssl, conn, mock_bio_send, mock_bio_recv, NULL);
+
+    int ret;
+    while ((ret = mbedtls_ssl_handshake(&conn->ssl)) != 0) {
+        if ((ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) || server->stopping) {
+            ESP_LOGD(TAG, "Handshake failed: -0x%04x", (unsigned)-ret);
+            return false;
+        }
+    }
+    pthread_mutex_lock(&server->lock);
+    server->stats.handshakes++;
+    pthread_mutex_unlock(&server->lock);
+    return true;
+}
+
+/**
+ * @brief Find a header value in a request head (case-insensitive name), copied into value
+ */
+static bool mock_find_header(const char *head, const char *name, char *value, size_t size)
+{
+    size_t name_len = strlen(name);
+    for (const char *line = strstr(head, "\r\n"); line != NULL; line = strstr(line, "\r\n")) {
+        line += 2;
+        if (strncasecmp(line, name, name_len) == 0 && line[name_len] == ':') {
+            const char *start = line + name_len + 1;
+            while (*start == ' ') {
+                start++;
+            }
+            const char *end = strstr(start, "\r\n");
+            size_t len = end ? (size_t)(end - start) : strlen(start);
+            if (len >= size) {
+                return false;
+            }
+            memcpy(value, start, len);
+            value[len] = '\0';
+            return true;
+        }
+    }
+    return false;
+}
+
+static const mock_route_t* mock_find_route(const mock_server_t *server, const char *path)
+{
+    for (size_t i = 0; i < server->config.route_count; i++) {
+        if (strcmp(server->config.routes[i].path, path) == 0) {
+            return &server->config.routes[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Answer one request head; returns false when the connection must be closed
+ */
+static bool mock_respond(mock_conn_t *conn, const char *head)
+{
+    mock_server_t *server = conn->server;
+    char path[256];
+    char value[128];
+    char header[MOCK_HEADER_SIZE];
+
+    if (sscanf(head, "GET %255s HTTP/1.1", path) != 1) {
+        return false;
+    }
+    bool keep_alive = server->config.keep_alive &&
+                      !(mock_find_header(head, "Connection", value, sizeof(value)) && strcasecmp(value, "close") == 0);
+    const char *connection = keep_alive ? "keep-alive" : "close";
+    const mock_route_t *route = mock_find_route(server, path);
+
+    pthread_mutex_lock(&server->lock);
+    server->stats.requests++;
+    pthread_mutex_unlock(&server->lock);
+
+    if (route == NULL) {
+        int len = snprintf(header, sizeof(header), "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n"
+                           "Connection: %s\r\n\r\n", connection);
+        return mock_conn_write(conn, header, len) && keep_alive;
+    }
+    if (route->delay_ms) {
+        usleep(route->delay_ms * 1000);
+    }
+
+    if (route->etag && mock_find_header(head, "If-None-Match", value, sizeof(value)) &&
+        strcmp(value, route->etag) == 0) {
+        pthread_mutex_lock(&server->lock);
+        server->stats.not_modified++;
+        pthread_mutex_unlock(&server->lock);
+        int len = snprintf(header, sizeof(header), "HTTP/1.1 304 Not Modified\r\nETag: %s\r\nContent-Length: 0\r\n"
+                           "Connection: %s\r\n\r\n", route->etag, connection);
+        return mock_conn_write(conn, header, len) && keep_alive;
+    }
+
+    int len = snprintf(header, sizeof(header), "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n"
+                       "Content-Length: %u\r\n%s%s%sConnection: %s\r\n\r\n", (unsigned)route->body_len,
+                       route->etag ? "ETag: " : "", route->etag ? route->etag : "", route->etag ? "\r\n" : "",
+                       connection);
+    return mock_conn_write(conn, header, len) && mock_conn_write(conn, route->body, route->body_len) && keep_alive;
+}
+
+static void* mock_conn_thread(void *arg)
+{
+    mock_conn_t *conn = (mock_conn_t*)arg;
+    mock_server_t *server = conn->server;
+    char buf[MOCK_REQUEST_SIZE];
+    size_t used = 0;
+
+    bool open = server->tls == NULL || mock_conn_handshake(conn);
+    while (open && !server->stopping) {
+        int n = mock_conn_read(conn, buf + used, sizeof(buf) - 1 - used);
+        if (n == MOCK_AGAIN) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        used += n;
+        buf[used] = '\0';
+
+        // Serve every complete head in the buffer (GET requests have no body)
+        char *end;
+        while (open && (end = strstr(buf, "\r\n\r\n")) != NULL) {
+            end[2] = '\0';
+            open = mock_respond(conn, buf);
+            size_t consumed = end + 4 - buf;
+            memmove(buf, buf + consumed, used - consumed + 1);
+            used -= consumed;
+        }
+        if (used == sizeof(buf) - 1) {
+            break;  // Head too large
+        }
+    }
+
+    if (conn->tls) {
+        mbedtls_ssl_close_notify(&conn->ssl);
+        mbedtls_ssl_free(&conn->ssl);
+    }
+    close(conn->fd);
+    free(conn);
+
+    pthread_mutex_lock(&server->lock);
+    if (--server->active == 0) {
+        pthread_cond_broadcast(&server->idle);
+    }
+    pthread_mutex_unlock(&server->lock);
+    return NULL;
+}
+
+static void* mock_accept_thread(void *arg)
+{
+    mock_server_t *server = (mock_server_t*)arg;
+
+    while (!server->stopping) {
+        int fd = accept(server->listen_fd, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;  // Listening socket shut down by mock_server_stop()
+        }
+        struct timeval tv = { .tv_sec = 0, .tv_usec = MOCK_POLL_MS * 1000 };
+        int one = 1;
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));   // Headers and body leave at once
+
+        mock_conn_t *conn = (mock_conn_t*)calloc(1, sizeof(mock_conn_t));
+        pthread_t thread;
+        if (conn == NULL) {
+            close(fd);
+            continue;
+        }
+        conn->server = server;
+        conn->fd = fd;
+
+        pthread_mutex_lock(&server->lock);
+        server->active++;
+        server->stats.connections++;
+        pthread_mutex_unlock(&server->lock);
+        if (!mock_thread_start(&thread, mock_conn_thread, conn)) {
+            pthread_mutex_lock(&server->lock);
+            server->active--;
+            pthread_mutex_unlock(&server->lock);
+            close(fd);
+            free(conn);
+            continue;
+        }
+        pthread_detach(thread);
+    }
+    return NULL;
+}
+
+// ---------------------- External API functions ----------------------
+
+mock_server_t* mock_server_start(const mock_server_config_t *config)
+{
+    if (config == NULL || config->routes == NULL) {
+        ESP_LOGE(TAG, "Invalid config");
+        return NULL;
+    }
+    mock_server_t *server = (mock_server_t*)calloc(1, sizeof(mock_server_t));
+    if (server == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate mock_server_t");
+        return NULL;
+    }
+    server->config = *config;
+    pthread_mutex_init(&server->lock, NULL);
+    pthread_cond_init(&server->idle, NULL);
+
+    if (config->cert_pem && config->key_pem && mock_tls_create(server) == NULL) {
+        free(server);
+        return NULL;
+    }
+
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = 0,
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+    };
+    socklen_t addr_len = sizeof(addr);
+    int one = 1;
+    server->listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (server->listen_fd < 0 ||
+        setsockopt(server->listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) != 0 ||
+        bind(server->listen_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        listen(server->listen_fd, 8) != 0 ||
+        getsockname(server->listen_fd, (struct sockaddr*)&addr, &addr_len) != 0) {
+        ESP_LOGE(TAG, "Cannot listen on 127.0.0.1: %s", strerror(errno));
+        if (server->listen_fd >= 0) {
+            close(server->listen_fd);
+        }
+        mock_tls_free((mock_tls_t*)server->tls);
+        free(server);
+        return NULL;
+    }
+    server->port = ntohs(addr.sin_port);
+
+    if (!mock_thread_start(&server->accept_thread, mock_accept_thread, server)) {
+        ESP_LOGE(TAG, "Failed to start the accept thread");
+        close(server->listen_fd);
+        mock_tls_free((mock_tls_t*)server->tls);
+        free(server);
+        return NULL;
+    }
+    ESP_LOGI(TAG, "Serving %s on 127.0.0.1:%u", server->tls ? "HTTPS" : "HTTP", server->port);
+    return server;
+}
+
+void mock_server_stop(mock_server_t *server)
+{
+    if (server == NULL) {
+        return;
+    }
+    server->stopping = true;
+    shutdown(server->listen_fd, SHUT_RDWR);     // Wakes accept()
+    pthread_join(server->accept_thread, NULL);
+    close(server->listen_fd);
+
+    // Connection threads see the flag within one socket timeout
+    pthread_mutex_lock(&server->lock);
+    while (server->active > 0) {
+        pthread_cond_wait(&server->idle, &server->lock);
+    }
+    pthread_mutex_unlock(&server->lock);
+
+    mock_tls_free((mock_tls_t*)server->tls);
+    pthread_cond_destroy(&server->idle);
+    pthread_mutex_destroy(&server->lock);
+    free(server);
+}
+
+void mock_server_get_stats(mock_server_t *server, mock_server_stats_t *stats)
+{
+    pthread_mutex_lock(&server->lock);
+    *stats = server->stats;
+    pthread_mutex_unlock(&server->lock);
+}
+
+void mock_server_reset_stats(mock_server_t *server)
+{
+    pthread_mutex_lock(&server->lock);
+    memset(&server->stats, 0, sizeof(server->stats));
+    pthread_mutex_unlock(&server->lock);
+}
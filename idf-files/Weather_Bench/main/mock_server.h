@@ -0,0 +1,79 @@
+
+#ifndef _MOCK_SERVER_H
+#define _MOCK_SERVER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+
+// One canned response
+typedef struct {
+    const char *path;           // Request target, query included, e.g. "/v1/forecast"
+    const char *body;
+    size_t body_len;
+    const char *etag;           // Optional: sent with the body, a matching If-None-Match gets 304
+    uint32_t delay_ms;          // Server think time before the response headers
+} mock_route_t;
+
+typedef struct {
+    const mock_route_t *routes;
+    size_t route_count;
+    const char *cert_pem;       // Certificate and key (PEM): set both to serve HTTPS
+    const char *key_pem;
+    bool keep_alive;            // Serve several requests per connection
+    bool session_tickets;       // Issue TLS session tickets, so reconnecting clients can resume
+} mock_server_config_t;
+
+// Counters since start or the last mock_server_reset_stats()
+typedef struct {
+    uint32_t connections;       // Accepted connections
+    uint32_t requests;
+    uint32_t not_modified;      // 304 answers
+    uint32_t handshakes;        // Completed TLS handshakes
+    uint32_t resumed;           // Handshakes resumed from a session ticket (included in handshakes)
+} mock_server_stats_t;
+
+// HTTP/1.1 server on 127.0.0.1 with one thread per connection (bench only, POSIX sockets)
+typedef struct {
+    mock_server_config_t config;
+    int listen_fd;
+    uint16_t port;              // Ephemeral port chosen by the system
+    void *tls;                  // mbedtls state, NULL for plain HTTP
+    pthread_t accept_thread;
+    pthread_mutex_t lock;       // Guards stats, active and the shared TLS random generator
+    pthread_cond_t idle;        // Signaled when the last connection thread exits
+    uint32_t active;            // Connection threads still running
+    volatile bool stopping;
+    mock_server_stats_t stats;
+} mock_server_t;
+
+
+/**
+ * @brief Start a server on an ephemeral port of 127.0.0.1
+ * @param config Server settings (routes and PEM strings must outlive the server)
+ * @return mock_server_t* Returns a pointer to the instance on success, NULL on failure
+ */
+mock_server_t* mock_server_start(const mock_server_config_t *config);
+
+/**
+ * @brief Close the listening socket, wait for the open connections to end and release the server
+ * @param server Instance pointer
+ */
+void mock_server_stop(mock_server_t *server);
+
+/**
+ * @brief Get the server counters
+ * @param server Instance pointer
+ * @param stats Counters output pointer
+ */
+void mock_server_get_stats(mock_server_t *server, mock_server_stats_t *stats);
+
+/**
+ * @brief Clear the server counters
+ * @param server Instance pointer
+ */
+void mock_server_reset_stats(mock_server_t *server);
+
+#endif // _MOCK_SERVER_H
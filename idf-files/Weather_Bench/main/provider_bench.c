@@ -0,0 +1,176 @@
+// provider_bench.c - the provider descriptors against their checked-in responses
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <esp_log.h>
+
+#include "weather.h"
+#include "mock_server.h"
+#include "bench_fixture.h"
+#include "provider_bench.h"
+
+#define TAG "ProviderBench"
+#define BENCH_INFO(fmt, ...) ESP_LOGI(TAG, fmt, ##__VA_ARGS__)
+#define BENCH_ERROR(fmt, ...) ESP_LOGE(TAG, fmt, ##__VA_ARGS__)
+
+// One descriptor and what its fixtures must decode to
+typedef struct {
+    const weather_provider_t *provider;
+    const char *current_file;
+    double temp_c;
+    const char *text;
+    int timestamp;
+    const char *forecast_file;          // NULL if the provider has no forecast
+    uint16_t points;
+    int32_t first_time;
+    int16_t first_temp_dc;
+    int32_t last_time;
+    int16_t last_temp_dc;
+} provider_case_t;
+
+static const provider_case_t s_cases[] = {
+    // Celsius, text and UNIX seconds as sent
+    { &weather_provider_thinknode, "thinknode_current.json", 25.4, "Cloudy", 1765980000, NULL, 0, 0, 0, 0, 0 },
+    // WMO code 3 and an ISO 8601 time; a week of hourly points
+    { &weather_provider_open_meteo, "open_meteo_current.json", 27.3, "Overcast", 1765980000,
+      "open_meteo_hourly.json", 168, 1765929600, 208, 1766530800, 210 },
+    // Kelvin (300.45 K), the description of the first "weather" element; 5 days in 3 hour steps
+    { &weather_provider_openweathermap, "openweathermap_current.json", 27.3, "overcast clouds", 1765980000,
+      "openweathermap_forecast.json", 40, 1765980000, 259, 1766401200, 240 },
+};
+
+/**
+ * @brief Serve one provider's fixtures and decode them through a copy of its descriptor pointing at the server
+ */
+static bool provider_bench_case(const provider_case_t *tc, const char *cert, const char *key,
+                                weather_forecast_t *forecast)
+{
+    size_t current_len = 0;
+    size_t forecast_len = 0;
+    char *current = bench_fixture_load(tc->current_file, &current_len);
+    char *forecast_body = tc->forecast_file ? bench_fixture_load(tc->forecast_file, &forecast_len) : NULL;
+    if (current == NULL || (tc->forecast_file && forecast_body == NULL)) {
+        free(current);
+        free(forecast_body);
+        return false;
+    }
+
+    // Same scheme as the real service: thinknode stays plain HTTP
+    bool tls = strncmp(tc->provider->url, "https://", 8) == 0;
+    const mock_route_t routes[] = {
+        { .path = "/current", .body = current, .body_len = current_len },
+        { .path = "/forecast", .body = forecast_body, .body_len = forecast_len },
+    };
+    const mock_server_config_t config = {
+        .routes = routes,
+        .route_count = tc->forecast_file ? 2 : 1,
+        .cert_pem = tls ? cert : NULL,
+        .key_pem = tls ? key : NULL,
+        .keep_alive = true,
+    };
+    mock_server_t *server = mock_server_start(&config);
+    if (server == NULL) {
+        free(current);
+        free(forecast_body);
+        return false;
+    }
+
+    char url[64];
+    char forecast_url[64];
+    const char *scheme = tls ? "https" : "http";
+    snprintf(url, sizeof(url), "%s://localhost:%u/current", scheme, server->port);
+    snprintf(forecast_url, sizeof(forecast_url), "%s://localhost:%u/forecast", scheme, server->port);
+    weather_provider_t provider = *tc->provider;
+    provider.url = url;
+    provider.forecast_url = tc->forecast_file ? forecast_url : NULL;
+    provider.cert_pem = tls ? cert : NULL;
+
+    bool ok = false;
+    double temp_c = 0.0;
+    char text[WEATHER_TEXT_SIZE] = "";
+    int timestamp = 0;
+    weather_forecast_state_t state = {0};
+    int32_t times[2] = {0};
+    int16_t temps[2] = {0};
+    weather_t *weather = weather_create_with_provider(&provider);
+    if (weather) {
+        ok = weather_get_weather(weather, &temp_c, text, &timestamp);
+        ok = ok && fabs(temp_c - tc->temp_c) < 0.005 && strcmp(text, tc->text) == 0 && timestamp == tc->timestamp;
+        if (!ok) {
+            BENCH_ERROR("%s: got %.2f C \"%s\" at %d", tc->provider->name, temp_c, text, timestamp);
+        }
+        if (ok && tc->forecast_file) {
+            ok = weather_get_forecast(weather, forecast);
+            weather_forecast_get_state(forecast, &state);
+            ok = ok && state.count == tc->points &&
+                 weather_forecast_copy(forecast, &state, 0, 1, &times[0], &temps[0]) == 1 &&
+                 weather_forecast_copy(forecast, &state, state.count - 1, 1, &times[1], &temps[1]) == 1;
+            ok = ok && times[0] == tc->first_time && temps[0] == tc->first_temp_dc &&
+                 times[1] == tc->last_time && temps[1] == tc->last_temp_dc;
+            if (!ok) {
+                BENCH_ERROR("%s: forecast has %u points, %ld/%d to %ld/%d", tc->provider->name, state.count,
+                            (long)times[0], temps[0], (long)times[1], temps[1]);
+            }
+        }
+        weather_destroy(weather);
+    }
+    mock_server_stop(server);
+    free(current);
+    free(forecast_body);
+
+    BENCH_INFO("provider=%s scheme=%s temp_c=%.2f text=\"%s\" timestamp=%d forecast_points=%u result=%s",
+               tc->provider->name, scheme, temp_c, text, timestamp, state.count, ok ? "pass" : "FAIL");
+    return ok;
+}
+
+/**
+ * @brief Field conversions the fixtures do not reach
+ */
+static bool provider_bench_conversions(void)
+{
+    weather_provider_t iso = weather_provider_open_meteo;
+    weather_provider_t unix_ms = weather_provider_thinknode;
+    unix_ms.time_format = WEATHER_TIME_UNIX_MS;
+
+    uint32_t failed = 0;
+    int ts = 0;
+    double temp_c = 0.0;
+    char text[WEATHER_TEXT_SIZE];
+
+    if (!weather_provider_parse_time(&iso, "2025-12-17T14:00:30", &ts) || ts != 1765980030) failed++;
+    if (!weather_provider_parse_time(&iso, "2024-02-29T00:00", &ts) || ts != 1709164800) failed++;
+    if (weather_provider_parse_time(&iso, "17/12/2025 14:00", &ts)) failed++;
+    if (!weather_provider_parse_time(&unix_ms, "1765980000123", &ts) || ts != 1765980000) failed++;
+    if (weather_provider_parse_time(&unix_ms, "null", &ts)) failed++;
+    if (!weather_provider_parse_text(&iso, "95", text, sizeof(text)) || strcmp(text, "Thunderstorm") != 0) failed++;
+    if (!weather_provider_parse_text(&iso, "42", text, sizeof(text)) || strcmp(text, "Code 42") != 0) failed++;
+    if (weather_provider_parse_text(&iso, "cloudy", text, sizeof(text))) failed++;
+    if (!weather_provider_parse_temp(&weather_provider_openweathermap, "0", &temp_c) ||
+        fabs(temp_c + 273.15) > 1e-9) failed++;
+    if (weather_provider_parse_temp(&weather_provider_thinknode, "warm", &temp_c)) failed++;
+
+    BENCH_INFO("scenario=conversions cases=10 failed=%lu result=%s", (unsigned long)failed, failed ? "FAIL" : "pass");
+    return failed == 0;
+}
+
+bool provider_bench_run(void)
+{
+    char *cert = bench_fixture_load("server_cert.pem", NULL);
+    char *key = bench_fixture_load("server_key.pem", NULL);
+    weather_forecast_t *forecast = weather_forecast_create(WEATHER_FORECAST_CAPACITY);
+
+    bool ok = false;
+    if (cert && key && forecast) {
+        ok = true;
+        for (size_t i = 0; i < sizeof(s_cases) / sizeof(s_cases[0]); i++) {
+            ok = provider_bench_case(&s_cases[i], cert, key, forecast) && ok;
+        }
+    }
+    ok = provider_bench_conversions() && ok;
+
+    weather_forecast_destroy(forecast);
+    free(cert);
+    free(key);
+    return ok;
+}
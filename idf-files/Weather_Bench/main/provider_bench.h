@@ -0,0 +1,15 @@
+
+#ifndef _PROVIDER_BENCH_H
+#define _PROVIDER_BENCH_H
+
+#include <stdbool.h>
+
+
+/**
+ * @brief Fetch each provider's checked-in responses through its descriptor and check the decoded
+ * weather and forecast, then the value conversions on their own
+ * @return bool Returns false when a descriptor decodes a fixture to the wrong values
+ */
+bool provider_bench_run(void);
+
+#endif // _PROVIDER_BENCH_H
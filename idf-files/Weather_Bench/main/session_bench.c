@@ -0,0 +1,218 @@
+// session_bench.c - keep-alive connection reuse and conditional GETs of weather_get_weather()
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <esp_log.h>
+#include <esp_timer.h>
+
+#include "weather.h"
+#include "mock_server.h"
+#include "bench_fixture.h"
+#include "session_bench.h"
+
+#define TAG "SessionBench"
+#define BENCH_INFO(fmt, ...) ESP_LOGI(TAG, fmt, ##__VA_ARGS__)
+#define BENCH_ERROR(fmt, ...) ESP_LOGE(TAG, fmt, ##__VA_ARGS__)
+
+#define SESSION_BENCH_REQUESTS  20
+#define SESSION_BENCH_ETAG      "\"om-current-1\""
+#define SESSION_BENCH_ETAG_NEW  "\"om-current-2\""
+
+// What the fixture holds, and what the changed copy holds
+#define SESSION_BENCH_TEMP      "27.3"
+#define SESSION_BENCH_TEMP_NEW  "28.1"
+#define SESSION_BENCH_TEXT      "Overcast"
+
+typedef struct {
+    char *current;
+    char *changed;              // Same document with another temperature
+    size_t current_len;
+    char *cert;
+    char *key;
+    mock_route_t routes[2];
+} session_fixtures_t;
+
+// Wall time of a run of requests
+typedef struct {
+    int64_t first_us;           // First request (new connection, full response)
+    int64_t rest_us;            // Sum over the following ones
+    uint32_t wrong;             // Failed requests or unexpected values
+} session_timing_t;
+
+static mock_server_t* session_server(const session_fixtures_t *fx, bool keep_alive, weather_provider_t *provider,
+                                     char *url, size_t url_size)
+{
+    const mock_server_config_t config = {
+        .routes = fx->routes,
+        .route_count = sizeof(fx->routes) / sizeof(fx->routes[0]),
+        .cert_pem = fx->cert,
+        .key_pem = fx->key,
+        .keep_alive = keep_alive,
+    };
+    mock_server_t *server = mock_server_start(&config);
+    if (server == NULL) {
+        return NULL;
+    }
+    // Open-Meteo's descriptor with its host replaced: same key paths and conversions
+    snprintf(url, url_size, "https://localhost:%u/v1/current", server->port);
+    *provider = weather_provider_open_meteo;
+    provider->url = url;
+    provider->forecast_url = NULL;
+    provider->cert_pem = fx->cert;
+    return server;
+}
+
+/**
+ * @brief Fetch the current weather a number of times and check each result
+ */
+static void session_requests(weather_t *weather, uint32_t count, double expected_c, session_timing_t *timing)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        double temp_c = 0.0;
+        char text[WEATHER_TEXT_SIZE] = "";
+        int timestamp = 0;
+
+        int64_t start_us = esp_timer_get_time();
+        bool ok = weather_get_weather(weather, &temp_c, text, &timestamp);
+        int64_t elapsed_us = esp_timer_get_time() - start_us;
+        if (i == 0) {
+            timing->first_us = elapsed_us;
+        } else {
+            timing->rest_us += elapsed_us;
+        }
+        if (!ok || fabs(temp_c - expected_c) > 0.05 || strcmp(text, SESSION_BENCH_TEXT) != 0) {
+            BENCH_ERROR("Request %lu: got %.1f C \"%s\"", (unsigned long)i, temp_c, text);
+            timing->wrong++;
+        }
+    }
+}
+
+/**
+ * @brief The same requests against a server that keeps the connection open and one that closes it
+ * @param keep_alive Server mode
+ * @param avg_us Average request time output pointer
+ */
+static bool session_bench_mode(const session_fixtures_t *fx, bool keep_alive, double *avg_us)
+{
+    char url[64];
+    weather_provider_t provider;
+    mock_server_t *server = session_server(fx, keep_alive, &provider, url, sizeof(url));
+    weather_t *weather = server ? weather_create_with_provider(&provider) : NULL;
+    if (weather == NULL) {
+        mock_server_stop(server);
+        return false;
+    }
+
+    session_timing_t timing = {0};
+    session_requests(weather, SESSION_BENCH_REQUESTS, atof(SESSION_BENCH_TEMP), &timing);
+    weather_stats_t stats;
+    weather_get_stats(weather, &stats);
+    weather_destroy(weather);
+    mock_server_stats_t server_stats;
+    mock_server_get_stats(server, &server_stats);
+    mock_server_stop(server);
+
+    // Kept alive: one connection and one handshake for everything, closed: one per request
+    uint32_t expected = keep_alive ? 1 : SESSION_BENCH_REQUESTS;
+    bool ok = timing.wrong == 0 && server_stats.connections == expected && server_stats.handshakes == expected &&
+              stats.reused == SESSION_BENCH_REQUESTS - expected;
+    *avg_us = (double)(timing.first_us + timing.rest_us) / SESSION_BENCH_REQUESTS;
+    BENCH_INFO("scenario=keep_alive server=%s requests=%u avg_ms=%.2f first_ms=%.2f last_connect_ms=%.2f "
+               "connections=%lu handshakes=%lu reused=%lu result=%s",
+               keep_alive ? "keep-alive" : "close", SESSION_BENCH_REQUESTS, *avg_us / 1000.0,
+               timing.first_us / 1000.0, stats.last_connect_us / 1000.0, (unsigned long)server_stats.connections,
+               (unsigned long)server_stats.handshakes, (unsigned long)stats.reused, ok ? "pass" : "FAIL");
+    return ok;
+}
+
+static bool session_bench_keep_alive(const session_fixtures_t *fx)
+{
+    double reuse_us = 0.0;
+    double close_us = 0.0;
+    bool ok = session_bench_mode(fx, true, &reuse_us);
+    ok = session_bench_mode(fx, false, &close_us) && ok;
+
+    // Skipping TCP connect and TLS handshake must show in the average
+    bool faster = reuse_us < close_us;
+    BENCH_INFO("scenario=keep_alive speedup=%.2f result=%s", close_us / (reuse_us > 0.0 ? reuse_us : 1.0),
+               ok && faster ? "pass" : "FAIL");
+    return ok && faster;
+}
+
+/**
+ * @brief Repeated requests for an unchanged resource get 304, a changed one is parsed again
+ */
+static bool session_bench_conditional(const session_fixtures_t *fx)
+{
+    char url[64];
+    weather_provider_t provider;
+    mock_server_t *server = session_server(fx, true, &provider, url, sizeof(url));
+    weather_t *weather = server ? weather_create_with_provider(&provider) : NULL;
+    if (weather == NULL) {
+        mock_server_stop(server);
+        return false;
+    }
+
+    session_timing_t timing = {0};
+    session_requests(weather, SESSION_BENCH_REQUESTS, atof(SESSION_BENCH_TEMP), &timing);
+    weather_stats_t stats;
+    weather_get_stats(weather, &stats);
+    mock_server_stats_t server_stats;
+    mock_server_get_stats(server, &server_stats);
+    bool ok = timing.wrong == 0 && server_stats.not_modified == SESSION_BENCH_REQUESTS - 1 &&
+              stats.not_modified == SESSION_BENCH_REQUESTS - 1;
+
+    // The resource changes (new ETag): the old validator must not hide the new value
+    snprintf(url, sizeof(url), "https://localhost:%u/v1/current_changed", server->port);
+    session_timing_t changed = {0};
+    session_requests(weather, 2, atof(SESSION_BENCH_TEMP_NEW), &changed);
+    mock_server_stats_t after;
+    mock_server_get_stats(server, &after);
+    ok = ok && changed.wrong == 0 && after.not_modified == server_stats.not_modified + 1;
+
+    weather_destroy(weather);
+    mock_server_stop(server);
+
+    BENCH_INFO("scenario=conditional requests=%u first_ms=%.2f not_modified_avg_ms=%.2f not_modified=%lu "
+               "body_bytes_saved=%lu changed_refetched=%s result=%s",
+               SESSION_BENCH_REQUESTS, timing.first_us / 1000.0,
+               timing.rest_us / 1000.0 / (SESSION_BENCH_REQUESTS - 1), (unsigned long)stats.not_modified,
+               (unsigned long)(stats.not_modified * fx->current_len), changed.wrong == 0 ? "yes" : "no",
+               ok ? "pass" : "FAIL");
+    return ok;
+}
+
+bool session_bench_run(void)
+{
+    session_fixtures_t fx = {0};
+    fx.current = bench_fixture_load("open_meteo_current.json", &fx.current_len);
+    fx.cert = bench_fixture_load("server_cert.pem", NULL);
+    fx.key = bench_fixture_load("server_key.pem", NULL);
+    fx.changed = fx.current ? strdup(fx.current) : NULL;
+
+    // Same length, so the copy keeps the fixture's Content-Length
+    char *temp = fx.changed ? strstr(fx.changed, "\"temperature_2m\":" SESSION_BENCH_TEMP) : NULL;
+    if (temp) {
+        memcpy(temp + strlen("\"temperature_2m\":"), SESSION_BENCH_TEMP_NEW, strlen(SESSION_BENCH_TEMP_NEW));
+    }
+    fx.routes[0] = (mock_route_t){.path = "/v1/current", .body = fx.current, .body_len = fx.current_len,
+                                  .etag = SESSION_BENCH_ETAG};
+    fx.routes[1] = (mock_route_t){.path = "/v1/current_changed", .body = fx.changed, .body_len = fx.current_len,
+                                  .etag = SESSION_BENCH_ETAG_NEW};
+
+    bool ok = false;
+    if (temp && fx.cert && fx.key) {
+        // No validators in keep_alive: every answer carries the body
+        fx.routes[0].etag = NULL;
+        ok = session_bench_keep_alive(&fx);
+        fx.routes[0].etag = SESSION_BENCH_ETAG;
+        ok = session_bench_conditional(&fx) && ok;
+    }
+
+    free(fx.current);
+    free(fx.changed);
+    free(fx.cert);
+    free(fx.key);
+    return ok;
+}
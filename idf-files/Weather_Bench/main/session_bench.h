@@ -0,0 +1,15 @@
+
+#ifndef _SESSION_BENCH_H
+#define _SESSION_BENCH_H
+
+#include <stdbool.h>
+
+
+/**
+ * @brief Send repeated current weather requests over HTTPS with and without a kept-alive connection,
+ * then with an ETag the server answers 304 to
+ * @return bool Returns false when connections are not reused, 304s are not served or a result is wrong
+ */
+bool session_bench_run(void);
+
+#endif // _SESSION_BENCH_H
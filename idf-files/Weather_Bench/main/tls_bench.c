@@ -0,0 +1,118 @@
+// tls_bench.c - full TLS handshakes against handshakes resumed from a session ticket
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <esp_log.h>
+#include "sdkconfig.h"
+
+#include "weather.h"
+#include "mock_server.h"
+#include "bench_fixture.h"
+#include "tls_bench.h"
+
+#define TAG "TlsBench"
+#define BENCH_INFO(fmt, ...) ESP_LOGI(TAG, fmt, ##__VA_ARGS__)
+#define BENCH_ERROR(fmt, ...) ESP_LOGE(TAG, fmt, ##__VA_ARGS__)
+
+#define TLS_BENCH_REQUESTS      10
+
+typedef struct {
+    char *current;
+    size_t current_len;
+    char *cert;
+    char *key;
+} tls_fixtures_t;
+
+/**
+ * @brief One request per connection: the server closes each one after its response
+ * @param tickets Let the server issue session tickets
+ * @param reconnect_us Average connect time (TCP + TLS) of the reconnections output pointer
+ */
+static bool tls_bench_mode(const tls_fixtures_t *fx, bool tickets, double *reconnect_us)
+{
+    const mock_route_t route = { .path = "/v1/current", .body = fx->current, .body_len = fx->current_len };
+    const mock_server_config_t config = {
+        .routes = &route,
+        .route_count = 1,
+        .cert_pem = fx->cert,
+        .key_pem = fx->key,
+        .keep_alive = false,
+        .session_tickets = tickets,
+    };
+    mock_server_t *server = mock_server_start(&config);
+    if (server == NULL) {
+        return false;
+    }
+    char url[64];
+    snprintf(url, sizeof(url), "https://localhost:%u/v1/current", server->port);
+    weather_provider_t provider = weather_provider_open_meteo;
+    provider.url = url;
+    provider.forecast_url = NULL;
+    provider.cert_pem = fx->cert;
+
+    bool ok = true;
+    int64_t first_us = 0;
+    weather_stats_t stats = {0};
+    weather_t *weather = weather_create_with_provider(&provider);
+    for (int i = 0; weather && i < TLS_BENCH_REQUESTS; i++) {
+        double temp_c;
+        char text[WEATHER_TEXT_SIZE];
+        int timestamp;
+        ok = weather_get_weather(weather, &temp_c, text, &timestamp) && ok;
+        if (i == 0) {
+            weather_get_stats(weather, &stats);
+            first_us = stats.last_connect_us;
+        }
+    }
+    if (weather) {
+        weather_get_stats(weather, &stats);
+        weather_destroy(weather);
+    }
+    mock_server_stats_t server_stats;
+    mock_server_get_stats(server, &server_stats);
+    mock_server_stop(server);
+
+    // Without tickets every handshake is full; with them, all but the first resume
+    uint32_t expected = tickets ? TLS_BENCH_REQUESTS - 1 : 0;
+    ok = ok && weather && stats.connections == TLS_BENCH_REQUESTS &&
+         server_stats.handshakes == TLS_BENCH_REQUESTS && server_stats.resumed == expected;
+    *reconnect_us = (double)(stats.connect_us_total - first_us) / (TLS_BENCH_REQUESTS - 1);
+    BENCH_INFO("scenario=tls_resumption tickets=%s connections=%lu handshakes=%lu resumed=%lu first_connect_ms=%.2f "
+               "reconnect_avg_ms=%.2f result=%s",
+               tickets ? "on" : "off", (unsigned long)stats.connections, (unsigned long)server_stats.handshakes,
+               (unsigned long)server_stats.resumed, first_us / 1000.0, *reconnect_us / 1000.0,
+               ok ? "pass" : "FAIL");
+    return ok;
+}
+
+bool tls_bench_run(void)
+{
+#if !CONFIG_WEATHER_TLS_RESUMPTION
+    BENCH_ERROR("CONFIG_WEATHER_TLS_RESUMPTION is off: the client never offers its session ticket");
+    return false;
+#else
+    tls_fixtures_t fx = {0};
+    fx.current = bench_fixture_load("open_meteo_current.json", &fx.current_len);
+    fx.cert = bench_fixture_load("server_cert.pem", NULL);
+    fx.key = bench_fixture_load("server_key.pem", NULL);
+
+    bool ok = false;
+    if (fx.current && fx.cert && fx.key) {
+        double full_us = 0.0;
+        double resumed_us = 0.0;
+        ok = tls_bench_mode(&fx, false, &full_us);
+        ok = tls_bench_mode(&fx, true, &resumed_us) && ok;
+
+        // A resumed handshake skips the certificate and the key exchange
+        bool faster = resumed_us < full_us;
+        BENCH_INFO("scenario=tls_resumption speedup=%.2f result=%s", full_us / (resumed_us > 0.0 ? resumed_us : 1.0),
+                   ok && faster ? "pass" : "FAIL");
+        ok = ok && faster;
+    }
+
+    free(fx.current);
+    free(fx.cert);
+    free(fx.key);
+    return ok;
+#endif
+}
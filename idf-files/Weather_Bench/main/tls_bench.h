@@ -0,0 +1,15 @@
+
+#ifndef _TLS_BENCH_H
+#define _TLS_BENCH_H
+
+#include <stdbool.h>
+
+
+/**
+ * @brief Reconnect for every request to a server without and with session tickets,
+ * and compare the full TLS handshake with the resumed one
+ * @return bool Returns false when the client does not resume or resuming is not faster
+ */
+bool tls_bench_run(void);
+
+#endif // _TLS_BENCH_H
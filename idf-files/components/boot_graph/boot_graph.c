@@ -0,0 +1,196 @@
+#include "boot_graph.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <sdkconfig.h>
+#include <esp_log.h>
+#include <freertos/task.h>
+#include "trace_evt.h"
+#if CONFIG_IDF_TARGET_LINUX
+#include <time.h>
+#else
+#include <esp_timer.h>
+#endif
+
+#define TAG "BootGraph"
+
+static const char *s_state_names[] = {"pending", "ok", "failed", "skipped"};
+
+// ---------------------- Internal implementation functions ----------------------
+
+static int64_t boot_graph_now_us(void)
+{
+#if CONFIG_IDF_TARGET_LINUX
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#else
+    return esp_timer_get_time();
+#endif
+}
+
+/**
+ * @brief Run one stage whose dependencies have all finished
+ */
+static void boot_graph_run_stage(boot_graph_t *graph, uint8_t index)
+{
+    const boot_stage_t *stage = &graph->stages[index];
+    boot_stage_result_t *result = &graph->report.stages[index];
+
+    for (uint8_t dep = 0; dep < index; dep++) {
+        if ((stage->deps & BOOT_DEP(dep)) && graph->report.stages[dep].state != BOOT_STAGE_OK) {
+            ESP_LOGW(TAG, "%s skipped: %s did not succeed", stage->name, graph->stages[dep].name);
+            result->err = ESP_ERR_INVALID_STATE;
+            result->state = BOOT_STAGE_SKIPPED;
+            return;
+        }
+    }
+
+    TRACE_BEGIN("boot", stage->name);
+    result->start_us = boot_graph_now_us() - graph->start_us;
+    esp_err_t err = ESP_FAIL;
+    for (uint8_t attempt = 0; attempt <= stage->retries; attempt++) {
+        if (attempt > 0) {
+            ESP_LOGW(TAG, "%s failed (%s), retry %u of %u", stage->name, esp_err_to_name(err), attempt, stage->retries);
+            TRACE_INSTANT("boot", "retry");
+            vTaskDelay(pdMS_TO_TICKS(stage->retry_delay_ms));
+        }
+        result->attempts++;
+        err = stage->init(stage->ctx);
+        if (err == ESP_OK) {
+            break;
+        }
+    }
+    result->end_us = boot_graph_now_us() - graph->start_us;
+    TRACE_END("boot", stage->name);
+    result->err = err;
+    result->state = err == ESP_OK ? BOOT_STAGE_OK : BOOT_STAGE_FAILED;
+}
+
+static void boot_graph_stage_task(void *param)
+{
+    boot_graph_slot_t *slot = (boot_graph_slot_t*)param;
+    boot_graph_t *graph = slot->graph;
+    uint32_t deps = graph->stages[slot->index].deps;
+
+    if (deps) {
+        xEventGroupWaitBits(graph->done, deps, pdFALSE, pdTRUE, portMAX_DELAY);
+    }
+    boot_graph_run_stage(graph, slot->index);
+    xEventGroupSetBits(graph->done, BOOT_DEP(slot->index));
+    vTaskDelete(NULL);
+}
+
+// ---------------------- External API functions ----------------------
+
+boot_graph_t* boot_graph_create(const boot_graph_config_t *config)
+{
+    if (config == NULL) {
+        ESP_LOGE(TAG, "Invalid config");
+        return NULL;
+    }
+    boot_graph_t *graph = (boot_graph_t*)calloc(1, sizeof(boot_graph_t));
+    if (graph == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate boot_graph_t");
+        return NULL;
+    }
+    graph->config = *config;
+    graph->done = xEventGroupCreate();
+    if (graph->done == NULL) {
+        ESP_LOGE(TAG, "Failed to create the event group");
+        free(graph);
+        return NULL;
+    }
+    return graph;
+}
+
+int boot_graph_add(boot_graph_t *graph, const boot_stage_t *stage)
+{
+    if (graph == NULL || stage == NULL || stage->name == NULL || stage->init == NULL ||
+        graph->count >= BOOT_GRAPH_MAX_STAGES) {
+        return -1;
+    }
+    if (stage->deps & ~(BOOT_DEP(graph->count) - 1)) {
+        ESP_LOGE(TAG, "%s depends on a stage added after it", stage->name);
+        return -1;
+    }
+    uint8_t index = graph->count++;
+    graph->stages[index] = *stage;
+    graph->slots[index] = (boot_graph_slot_t){.graph = graph, .index = index};
+    return index;
+}
+
+esp_err_t boot_graph_run(boot_graph_t *graph)
+{
+    if (graph == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    memset(&graph->report, 0, sizeof(graph->report));
+    graph->report.failed = -1;
+    xEventGroupClearBits(graph->done, BOOT_DEP(BOOT_GRAPH_MAX_STAGES) - 1);
+    graph->start_us = boot_graph_now_us();
+    TRACE_BEGIN("boot", "boot_graph_run");
+
+    esp_err_t err = ESP_OK;
+    if (graph->config.parallel && graph->count > 0) {
+        for (uint8_t i = 0; i < graph->count; i++) {
+            uint32_t stack = graph->stages[i].stack_size ? graph->stages[i].stack_size : graph->config.stack_size;
+            if (xTaskCreate(boot_graph_stage_task, graph->stages[i].name, stack, &graph->slots[i],
+                            graph->config.priority, NULL) != pdPASS) {
+                // Dependents still wait for the bit, and are skipped
+                ESP_LOGE(TAG, "No task for %s", graph->stages[i].name);
+                graph->report.stages[i].err = ESP_ERR_NO_MEM;
+                graph->report.stages[i].state = BOOT_STAGE_FAILED;
+                xEventGroupSetBits(graph->done, BOOT_DEP(i));
+            }
+        }
+        uint32_t all = BOOT_DEP(graph->count) - 1;
+        EventBits_t bits = xEventGroupWaitBits(graph->done, all, pdFALSE, pdTRUE, pdMS_TO_TICKS(graph->config.timeout_ms));
+        if ((bits & all) != all) {
+            err = ESP_ERR_TIMEOUT;
+        }
+    } else {
+        for (uint8_t i = 0; i < graph->count; i++) {
+            boot_graph_run_stage(graph, i);
+        }
+    }
+    graph->report.total_us = boot_graph_now_us() - graph->start_us;
+    TRACE_END("boot", "boot_graph_run");
+
+    for (uint8_t i = 0; i < graph->count; i++) {
+        const boot_stage_result_t *result = &graph->report.stages[i];
+        if (result->state == BOOT_STAGE_OK || result->state == BOOT_STAGE_FAILED) {
+            graph->report.serial_us += result->end_us - result->start_us;
+        }
+        if (graph->report.failed < 0 && !graph->stages[i].optional && result->state != BOOT_STAGE_OK) {
+            graph->report.failed = i;
+            if (err == ESP_OK) {
+                err = result->err;
+            }
+        }
+    }
+    return err;
+}
+
+const boot_graph_report_t* boot_graph_get_report(boot_graph_t *graph)
+{
+    return graph ? &graph->report : NULL;
+}
+
+void boot_graph_log_report(boot_graph_t *graph)
+{
+    if (graph == NULL) {
+        return;
+    }
+    const boot_graph_report_t *report = &graph->report;
+    for (uint8_t i = 0; i < graph->count; i++) {
+        const boot_stage_result_t *result = &report->stages[i];
+        ESP_LOGI(TAG, "stage=%s state=%s attempts=%u start_ms=%.1f ms=%.1f err=%s", graph->stages[i].name,
+                 s_state_names[result->state], result->attempts, result->start_us / 1000.0,
+                 (result->end_us - result->start_us) / 1000.0, esp_err_to_name(result->err));
+    }
+    ESP_LOGI(TAG, "boot=%s failed_stage=%s total_ms=%.1f serial_ms=%.1f stages=%u mode=%s",
+             report->failed < 0 ? "ok" : "failed", report->failed < 0 ? "-" : graph->stages[report->failed].name,
+             report->total_us / 1000.0, report->serial_us / 1000.0, graph->count,
+             graph->config.parallel ? "parallel" : "serial");
+}
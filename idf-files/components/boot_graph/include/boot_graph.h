@@ -0,0 +1,130 @@
+
+#ifndef _BOOT_GRAPH_H
+#define _BOOT_GRAPH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <esp_err.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+
+
+#define BOOT_GRAPH_MAX_STAGES   24      // Usable bits of a FreeRTOS event group
+#define BOOT_DEP(stage)         (1UL << (stage))
+
+#define BOOT_GRAPH_DEFAULT_CONFIG() {   \
+    .parallel = true,                   \
+    .stack_size = 4096,                 \
+    .priority = 5,                      \
+    .timeout_ms = 30000,                \
+}
+
+#define BOOT_STAGE_DEFAULT() {          \
+    .name = NULL,                       \
+    .init = NULL,                       \
+    .ctx = NULL,                        \
+    .deps = 0,                          \
+    .retries = 0,                       \
+    .retry_delay_ms = 100,              \
+    .optional = false,                  \
+    .stack_size = 0,                    \
+}
+
+
+typedef esp_err_t (*boot_stage_fn_t)(void *ctx);
+
+typedef struct {
+    bool parallel;              // One task per stage; false runs the stages one by one in the caller
+    uint32_t stack_size;        // Stage task stack, unless the stage sets its own
+    UBaseType_t priority;       // Stage task priority
+    uint32_t timeout_ms;        // Whole boot
+} boot_graph_config_t;
+
+typedef struct {
+    const char *name;
+    boot_stage_fn_t init;
+    void *ctx;
+    uint32_t deps;              // BOOT_DEP() of stages that must have succeeded first
+    uint8_t retries;            // Attempts after the first failure
+    uint16_t retry_delay_ms;
+    bool optional;              // A failure skips the dependent stages but does not fail the boot
+    uint32_t stack_size;        // 0: the graph's default
+} boot_stage_t;
+
+typedef enum {
+    BOOT_STAGE_PENDING = 0,     // Not finished when the boot timed out
+    BOOT_STAGE_OK,
+    BOOT_STAGE_FAILED,
+    BOOT_STAGE_SKIPPED,         // A dependency failed or was skipped
+} boot_stage_state_t;
+
+typedef struct {
+    boot_stage_state_t state;
+    esp_err_t err;              // Last attempt
+    uint8_t attempts;
+    int64_t start_us;           // From the start of boot_graph_run()
+    int64_t end_us;
+} boot_stage_result_t;
+
+typedef struct {
+    boot_stage_result_t stages[BOOT_GRAPH_MAX_STAGES];
+    int64_t total_us;
+    int64_t serial_us;          // Sum of the stage times: a one-by-one boot
+    int8_t failed;              // First required stage that did not succeed, -1 for none
+} boot_graph_report_t;
+
+typedef struct boot_graph boot_graph_t;
+
+// One stage task's arguments
+typedef struct {
+    boot_graph_t *graph;
+    uint8_t index;
+} boot_graph_slot_t;
+
+struct boot_graph {
+    boot_graph_config_t config;
+    boot_stage_t stages[BOOT_GRAPH_MAX_STAGES];
+    boot_graph_slot_t slots[BOOT_GRAPH_MAX_STAGES];
+    uint8_t count;
+    EventGroupHandle_t done;    // Bit n: stage n finished, whatever its result
+    int64_t start_us;
+    boot_graph_report_t report;
+};
+
+
+/**
+ * @brief Create an empty boot graph
+ * @param config Configuration pointer
+ * @return boot_graph_t* Returns a pointer to the instance on success, NULL on failure
+ */
+boot_graph_t* boot_graph_create(const boot_graph_config_t *config);
+
+/**
+ * @brief Add a stage; it may only depend on stages added before it, so the graph has no cycles
+ * @param graph Instance pointer
+ * @param stage Stage description, copied
+ * @return int Returns the stage index (for BOOT_DEP()), -1 on failure
+ */
+int boot_graph_add(boot_graph_t *graph, const boot_stage_t *stage);
+
+/**
+ * @brief Run every stage as soon as its dependencies have succeeded, and wait for all of them
+ * @param graph Instance pointer
+ * @return esp_err_t ESP_OK when every required stage succeeded, ESP_ERR_TIMEOUT, or the error of the first failed required stage
+ */
+esp_err_t boot_graph_run(boot_graph_t *graph);
+
+/**
+ * @brief Results of the last run
+ * @param graph Instance pointer
+ * @return const boot_graph_report_t* Report pointer, NULL without an instance
+ */
+const boot_graph_report_t* boot_graph_get_report(boot_graph_t *graph);
+
+/**
+ * @brief Log one line per stage and a summary, as key=value pairs
+ * @param graph Instance pointer
+ */
+void boot_graph_log_report(boot_graph_t *graph);
+
+#endif // _BOOT_GRAPH_H
@@ -0,0 +1,273 @@
+#include "img_pack.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <sdkconfig.h>
+#include <esp_log.h>
+#if CONFIG_SPIRAM
+#include <esp_heap_caps.h>
+#endif
+
+#define TAG "ImgPack"
+
+#if LV_COLOR_DEPTH != 16
+#error "img_pack decodes to RGB565: LV_COLOR_DEPTH must be 16"
+#endif
+
+#define IMG_PACK_OP_INDEX   0x00
+#define IMG_PACK_OP_DIFF    0x40
+#define IMG_PACK_OP_LUMA    0x80
+#define IMG_PACK_OP_RUN     0xC0
+#define IMG_PACK_OP_RGB     0xFE
+#define IMG_PACK_OP_MASK    0xC0
+#define IMG_PACK_MAX_RUN    62
+
+static const uint8_t s_magic[4] = {'I', 'P', 'K', '1'};
+
+// ---------------------- Internal implementation functions ----------------------
+
+static inline uint8_t img_pack_hash(uint16_t px)
+{
+    return ((px >> 11) * 3 + ((px >> 5) & 63) * 5 + (px & 31) * 7) & 63;
+}
+
+static inline uint16_t img_pack_pack(int r, int g, int b)
+{
+    return (uint16_t)(((r & 31) << 11) | ((g & 63) << 5) | (b & 31));
+}
+
+/**
+ * @brief RGB565 as stored in lv_color_t
+ */
+static inline uint16_t img_pack_native(uint16_t px)
+{
+#if LV_COLOR_16_SWAP
+    return (uint16_t)((px >> 8) | (px << 8));
+#else
+    return px;
+#endif
+}
+
+/**
+ * @brief Signed difference modulo 2^bits
+ */
+static inline int img_pack_wrap(int value, int bits)
+{
+    int half = 1 << (bits - 1);
+    return ((value + half) & ((1 << bits) - 1)) - half;
+}
+
+static void* img_pack_alloc(size_t size)
+{
+#if CONFIG_SPIRAM
+    void *buf = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (buf) {
+        return buf;
+    }
+#endif
+    return malloc(size);
+}
+
+// ---------------------- External API functions ----------------------
+
+esp_err_t img_pack_decoder_init(img_pack_decoder_t *dec, const uint8_t *data, uint32_t size)
+{
+    if (dec == NULL || data == NULL || size < IMG_PACK_HEADER_SIZE || memcmp(data, s_magic, sizeof(s_magic)) != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    memset(dec, 0, sizeof(*dec));
+    dec->data = data;
+    dec->size = size;
+    dec->pos = IMG_PACK_HEADER_SIZE;
+    dec->width = (uint16_t)(data[4] | (data[5] << 8));
+    dec->height = (uint16_t)(data[6] | (data[7] << 8));
+    dec->px_left = (uint32_t)dec->width * dec->height;
+    return dec->px_left ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t img_pack_decoder_read(img_pack_decoder_t *dec, lv_color_t *out, uint32_t px)
+{
+    if (dec == NULL || out == NULL || px > dec->px_left) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    uint16_t *dst = (uint16_t*)out;
+    uint16_t *end = dst + px;
+    const uint8_t *data = dec->data;
+    uint32_t pos = dec->pos;
+    uint32_t size = dec->size;
+    uint16_t prev = dec->prev;
+    uint16_t native = img_pack_native(prev);
+    uint32_t run = dec->run;
+
+    // A run may continue from the previous call
+    while (run && dst < end) {
+        *dst++ = native;
+        run--;
+    }
+
+    while (dst < end) {
+        if (pos >= size) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+        uint8_t op = data[pos++];
+
+        if (op == IMG_PACK_OP_RGB) {
+            if (pos + 2 > size) {
+                return ESP_ERR_INVALID_SIZE;
+            }
+            prev = (uint16_t)(data[pos] | (data[pos + 1] << 8));
+            pos += 2;
+        } else {
+            switch (op & IMG_PACK_OP_MASK) {
+                case IMG_PACK_OP_INDEX:
+                    prev = dec->index[op];
+                    break;
+                case IMG_PACK_OP_DIFF:
+                    prev = img_pack_pack((prev >> 11) + ((op >> 4) & 3) - 2,
+                                         ((prev >> 5) & 63) + ((op >> 2) & 3) - 2,
+                                         (prev & 31) + (op & 3) - 2);
+                    break;
+                case IMG_PACK_OP_LUMA: {
+                    if (pos >= size) {
+                        return ESP_ERR_INVALID_SIZE;
+                    }
+                    uint8_t rb = data[pos++];
+                    int dg = (op & 63) - 32;
+                    int dg_half = (dg + 32) / 2 - 16;
+                    prev = img_pack_pack((prev >> 11) + dg_half + (rb >> 4) - 8,
+                                         ((prev >> 5) & 63) + dg,
+                                         (prev & 31) + dg_half + (rb & 15) - 8);
+                    break;
+                }
+                default:
+                    if (op == 0xFF) {
+                        return ESP_ERR_INVALID_SIZE;    // Reserved
+                    }
+                    // Runs repeat prev, which is already in the index
+                    run = (op & 63) + 1;
+                    while (run && dst < end) {
+                        *dst++ = native;
+                        run--;
+                    }
+                    continue;
+            }
+        }
+        dec->index[img_pack_hash(prev)] = prev;
+        native = img_pack_native(prev);
+        *dst++ = native;
+    }
+
+    dec->pos = pos;
+    dec->prev = prev;
+    dec->run = (uint8_t)run;
+    dec->px_left -= px;
+    return ESP_OK;
+}
+
+esp_err_t img_pack_load(const img_pack_asset_t *asset, lv_img_dsc_t *dsc)
+{
+    if (asset == NULL || dsc == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    img_pack_decoder_t dec;
+    esp_err_t err = img_pack_decoder_init(&dec, asset->data, asset->size);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "%s: not an img_pack stream", asset->name);
+        return err;
+    }
+
+    uint32_t px = dec.px_left;
+    lv_color_t *buf = (lv_color_t*)img_pack_alloc(px * sizeof(lv_color_t));
+    if (buf == NULL) {
+        ESP_LOGE(TAG, "%s: failed to allocate %lu bytes", asset->name, (unsigned long)(px * sizeof(lv_color_t)));
+        return ESP_ERR_NO_MEM;
+    }
+    err = img_pack_decoder_read(&dec, buf, px);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "%s: corrupt stream", asset->name);
+        free(buf);
+        return err;
+    }
+
+    memset(dsc, 0, sizeof(*dsc));
+    dsc->header.cf = LV_IMG_CF_TRUE_COLOR;
+    dsc->header.w = dec.width;
+    dsc->header.h = dec.height;
+    dsc->data_size = px * sizeof(lv_color_t);
+    dsc->data = (const uint8_t*)buf;
+    ESP_LOGD(TAG, "%s: %ux%u decoded from %lu bytes", asset->name, dec.width, dec.height, (unsigned long)asset->size);
+    return ESP_OK;
+}
+
+void img_pack_unload(lv_img_dsc_t *dsc)
+{
+    if (dsc == NULL) {
+        return;
+    }
+    free((void*)dsc->data);
+    dsc->data = NULL;
+    dsc->data_size = 0;
+}
+
+size_t img_pack_encode_bound(uint16_t width, uint16_t height)
+{
+    return IMG_PACK_HEADER_SIZE + (size_t)width * height * 3;   // Every pixel a literal
+}
+
+size_t img_pack_encode(const uint16_t *pixels, uint16_t width, uint16_t height, uint8_t *out, size_t out_size)
+{
+    if (pixels == NULL || out == NULL || out_size < img_pack_encode_bound(width, height)) {
+        return 0;
+    }
+    memcpy(out, s_magic, sizeof(s_magic));
+    out[4] = width & 0xFF;
+    out[5] = width >> 8;
+    out[6] = height & 0xFF;
+    out[7] = height >> 8;
+    memset(&out[8], 0, 4);
+
+    size_t pos = IMG_PACK_HEADER_SIZE;
+    uint16_t index[64] = {0};
+    uint16_t prev = 0;
+    uint32_t run = 0;
+    uint32_t count = (uint32_t)width * height;
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint16_t px = pixels[i];
+        if (px == prev) {
+            run++;
+            if (run == IMG_PACK_MAX_RUN || i == count - 1) {
+                out[pos++] = IMG_PACK_OP_RUN | (run - 1);
+                run = 0;
+            }
+            continue;
+        }
+        if (run) {
+            out[pos++] = IMG_PACK_OP_RUN | (run - 1);
+            run = 0;
+        }
+
+        uint8_t hash = img_pack_hash(px);
+        if (index[hash] == px) {
+            out[pos++] = IMG_PACK_OP_INDEX | hash;
+        } else {
+            index[hash] = px;
+            int dr = img_pack_wrap((px >> 11) - (prev >> 11), 5);
+            int dg = img_pack_wrap(((px >> 5) & 63) - ((prev >> 5) & 63), 6);
+            int db = img_pack_wrap((px & 31) - (prev & 31), 5);
+            int dg_half = (dg + 32) / 2 - 16;
+            if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                out[pos++] = IMG_PACK_OP_DIFF | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2);
+            } else if (dr - dg_half >= -8 && dr - dg_half <= 7 && db - dg_half >= -8 && db - dg_half <= 7) {
+                out[pos++] = IMG_PACK_OP_LUMA | (dg + 32);
+                out[pos++] = ((dr - dg_half + 8) << 4) | (db - dg_half + 8);
+            } else {
+                out[pos++] = IMG_PACK_OP_RGB;
+                out[pos++] = px & 0xFF;
+                out[pos++] = px >> 8;
+            }
+        }
+        prev = px;
+    }
+    return pos;
+}
@@ -0,0 +1,124 @@
+#include "img_pack.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <esp_log.h>
+
+#define TAG "ImgPackCache"
+
+// ---------------------- Internal implementation functions ----------------------
+
+static size_t img_pack_asset_bytes(const img_pack_asset_t *asset)
+{
+    img_pack_decoder_t dec;
+    if (img_pack_decoder_init(&dec, asset->data, asset->size) != ESP_OK) {
+        return 0;
+    }
+    return (size_t)dec.px_left * sizeof(lv_color_t);
+}
+
+static void img_pack_cache_evict(img_pack_cache_t *cache, img_pack_cache_entry_t *entry)
+{
+    cache->used -= entry->dsc.data_size;
+    img_pack_unload(&entry->dsc);
+    memset(entry, 0, sizeof(*entry));
+    cache->evictions++;
+}
+
+/**
+ * @brief Least recently used entry that no object shows
+ */
+static img_pack_cache_entry_t* img_pack_cache_victim(img_pack_cache_t *cache)
+{
+    img_pack_cache_entry_t *victim = NULL;
+    for (int i = 0; i < IMG_PACK_CACHE_ENTRIES; i++) {
+        img_pack_cache_entry_t *entry = &cache->entries[i];
+        if (entry->asset && entry->refs == 0 && (victim == NULL || entry->last_use < victim->last_use)) {
+            victim = entry;
+        }
+    }
+    return victim;
+}
+
+// ---------------------- External API functions ----------------------
+
+img_pack_cache_t* img_pack_cache_create(size_t budget)
+{
+    img_pack_cache_t *cache = (img_pack_cache_t*)calloc(1, sizeof(img_pack_cache_t));
+    if (cache == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate img_pack_cache_t");
+        return NULL;
+    }
+    cache->budget = budget;
+    return cache;
+}
+
+const lv_img_dsc_t* img_pack_cache_get(img_pack_cache_t *cache, const img_pack_asset_t *asset)
+{
+    if (cache == NULL || asset == NULL) {
+        return NULL;
+    }
+
+    for (int i = 0; i < IMG_PACK_CACHE_ENTRIES; i++) {
+        img_pack_cache_entry_t *entry = &cache->entries[i];
+        if (entry->asset == asset) {
+            entry->refs++;
+            entry->last_use = ++cache->tick;
+            cache->hits++;
+            return &entry->dsc;
+        }
+    }
+    cache->misses++;
+
+    size_t bytes = img_pack_asset_bytes(asset);
+    if (bytes == 0 || bytes > cache->budget) {
+        ESP_LOGW(TAG, "%s: %u bytes do not fit a %u byte cache", asset->name, (unsigned)bytes, (unsigned)cache->budget);
+        return NULL;
+    }
+
+    // Make room: the budget and a free entry
+    img_pack_cache_entry_t *slot = NULL;
+    while (1) {
+        if (slot == NULL) {
+            for (int i = 0; i < IMG_PACK_CACHE_ENTRIES && slot == NULL; i++) {
+                if (cache->entries[i].asset == NULL) {
+                    slot = &cache->entries[i];
+                }
+            }
+        }
+        if (slot && cache->used + bytes <= cache->budget) {
+            break;
+        }
+        img_pack_cache_entry_t *victim = img_pack_cache_victim(cache);
+        if (victim == NULL) {
+            ESP_LOGW(TAG, "%s: every cached image is in use", asset->name);
+            return NULL;
+        }
+        img_pack_cache_evict(cache, victim);
+    }
+
+    if (img_pack_load(asset, &slot->dsc) != ESP_OK) {
+        return NULL;
+    }
+    slot->asset = asset;
+    slot->refs = 1;
+    slot->last_use = ++cache->tick;
+    cache->used += slot->dsc.data_size;
+    return &slot->dsc;
+}
+
+void img_pack_cache_release(img_pack_cache_t *cache, const lv_img_dsc_t *dsc)
+{
+    if (cache == NULL || dsc == NULL) {
+        return;
+    }
+    for (int i = 0; i < IMG_PACK_CACHE_ENTRIES; i++) {
+        img_pack_cache_entry_t *entry = &cache->entries[i];
+        if (entry->asset && &entry->dsc == dsc) {
+            if (entry->refs > 0) {
+                entry->refs--;
+            }
+            return;
+        }
+    }
+}
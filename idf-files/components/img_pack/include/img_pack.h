@@ -0,0 +1,128 @@
+
+#ifndef _IMG_PACK_H
+#define _IMG_PACK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <esp_err.h>
+#include "lvgl.h"
+
+
+#define IMG_PACK_HEADER_SIZE    12      // "IPK1", width, height (u16 LE), flags, 3 reserved bytes
+#define IMG_PACK_CACHE_ENTRIES  8
+
+// Declare an asset defined in a generated file, like LV_IMG_DECLARE()
+#define IMG_PACK_DECLARE(name)  extern const img_pack_asset_t name
+
+
+// Compressed RGB565 image, generated by idf-files/tools/img_pack.py
+typedef struct {
+    const char *name;
+    const uint8_t *data;
+    uint32_t size;
+} img_pack_asset_t;
+
+// Streaming decoder state: an image can be decoded a few rows at a time
+typedef struct {
+    const uint8_t *data;
+    uint32_t size;
+    uint32_t pos;               // Next stream byte
+    uint16_t width;
+    uint16_t height;
+    uint32_t px_left;           // Pixels not decoded yet
+    uint16_t prev;              // Last pixel, RGB565
+    uint8_t run;                // Repeats of prev still to output
+    uint16_t index[64];
+} img_pack_decoder_t;
+
+typedef struct {
+    const img_pack_asset_t *asset;  // NULL for a free entry
+    lv_img_dsc_t dsc;
+    uint32_t refs;              // Images currently showing it, never evicted while > 0
+    uint32_t last_use;
+} img_pack_cache_entry_t;
+
+// Decoded images kept within a byte budget, least recently used first out
+typedef struct {
+    img_pack_cache_entry_t entries[IMG_PACK_CACHE_ENTRIES];
+    size_t budget;
+    size_t used;
+    uint32_t tick;
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+} img_pack_cache_t;
+
+
+/**
+ * @brief Start decoding a stream
+ * @param dec Decoder pointer
+ * @param data Stream (header included)
+ * @param size Stream size in bytes
+ * @return esp_err_t Returns ESP_OK on success, ESP_ERR_INVALID_ARG on a bad header
+ */
+esp_err_t img_pack_decoder_init(img_pack_decoder_t *dec, const uint8_t *data, uint32_t size);
+
+/**
+ * @brief Decode the next pixels, in the byte order of lv_color_t (LV_COLOR_16_SWAP honored)
+ * @param dec Decoder pointer
+ * @param out Output pixels
+ * @param px Number of pixels to decode, at most the pixels left
+ * @return esp_err_t Returns ESP_OK on success, ESP_ERR_INVALID_SIZE on a truncated or corrupt stream
+ */
+esp_err_t img_pack_decoder_read(img_pack_decoder_t *dec, lv_color_t *out, uint32_t px);
+
+/**
+ * @brief Decode an asset into a new buffer (PSRAM when available)
+ * @param asset Asset pointer
+ * @param dsc Image descriptor filled for lv_img_set_src() (LV_IMG_CF_TRUE_COLOR)
+ * @return esp_err_t Returns ESP_OK on success, error code on failure
+ */
+esp_err_t img_pack_load(const img_pack_asset_t *asset, lv_img_dsc_t *dsc);
+
+/**
+ * @brief Free the buffer of an image loaded by img_pack_load()
+ * @param dsc Image descriptor
+ */
+void img_pack_unload(lv_img_dsc_t *dsc);
+
+/**
+ * @brief Encode RGB565 pixels into a stream, as the converter script does (host tools and benchmarks)
+ * @param pixels Pixels, RGB565 without byte swap
+ * @param width Width
+ * @param height Height
+ * @param out Output buffer, img_pack_encode_bound() bytes are always enough
+ * @param out_size Output buffer size
+ * @return size_t Returns the stream size, 0 if the buffer is too small
+ */
+size_t img_pack_encode(const uint16_t *pixels, uint16_t width, uint16_t height, uint8_t *out, size_t out_size);
+
+/**
+ * @brief Worst-case stream size of an image
+ */
+size_t img_pack_encode_bound(uint16_t width, uint16_t height);
+
+/**
+ * @brief Create an image cache (used from the LVGL task or with the LVGL lock held)
+ * @param budget Bytes of decoded pixels kept at most
+ * @return img_pack_cache_t* Returns a pointer to the instance on success, NULL on failure
+ */
+img_pack_cache_t* img_pack_cache_create(size_t budget);
+
+/**
+ * @brief Get the decoded image of an asset, decoding it on a miss
+ * @param cache Instance pointer
+ * @param asset Asset pointer
+ * @return const lv_img_dsc_t* Returns NULL when it cannot be decoded within the budget
+ */
+const lv_img_dsc_t* img_pack_cache_get(img_pack_cache_t *cache, const img_pack_asset_t *asset);
+
+/**
+ * @brief Release an image returned by img_pack_cache_get() once no object shows it
+ * @param cache Instance pointer
+ * @param dsc Image descriptor
+ */
+void img_pack_cache_release(img_pack_cache_t *cache, const lv_img_dsc_t *dsc);
+
+#endif // _IMG_PACK_H
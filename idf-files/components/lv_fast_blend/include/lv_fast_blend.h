@@ -0,0 +1,82 @@
+
+#ifndef _LV_FAST_BLEND_H
+#define _LV_FAST_BLEND_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sdkconfig.h>
+#include <esp_err.h>
+#include "lvgl.h"
+
+
+#if CONFIG_LV_FAST_BLEND_SIMD && (defined(__SSE2__) || defined(__ARM_NEON) || defined(__riscv_vector))
+#define LV_FAST_BLEND_HAS_SIMD 1
+#else
+#define LV_FAST_BLEND_HAS_SIMD 0
+#endif
+
+#if LV_COLOR_DEPTH != 16 && LV_COLOR_DEPTH != 32
+#error "lv_fast_blend supports RGB565 (LV_COLOR_DEPTH 16) and XRGB8888 (LV_COLOR_DEPTH 32)"
+#endif
+
+
+// One rectangle of work, strides in pixels
+typedef struct {
+    lv_color_t *dest;
+    int32_t dest_stride;
+    const lv_color_t *src;      // NULL for fills
+    int32_t src_stride;
+    lv_color_t color;           // Fill color
+    const lv_opa_t *mask;       // A8 coverage, NULL when fully covered
+    int32_t mask_stride;
+    int32_t w;
+    int32_t h;
+    lv_opa_t opa;
+} lv_fast_blend_job_t;
+
+// A kernel set: every kernel must give the same pixels as LVGL's software blend
+typedef struct {
+    const char *name;
+    void (*fill)(const lv_fast_blend_job_t *job);       // Color at opa >= LV_OPA_MAX, no mask
+    void (*fill_opa)(const lv_fast_blend_job_t *job);   // Color at opa < LV_OPA_MAX, no mask
+    void (*fill_mask)(const lv_fast_blend_job_t *job);  // Color through an A8 mask, any opa (opa ignored from LV_OPA_MAX)
+    void (*copy)(const lv_fast_blend_job_t *job);       // Image at opa >= LV_OPA_MAX, no mask
+    void (*copy_opa)(const lv_fast_blend_job_t *job);   // Image at opa < LV_OPA_MAX, no mask
+    void (*copy_mask)(const lv_fast_blend_job_t *job);  // Image through an A8 mask, any opa (opa ignored above LV_OPA_MAX)
+} lv_fast_blend_kernels_t;
+
+extern const lv_fast_blend_kernels_t lv_fast_blend_scalar;     // Reference for the self-test and the benches
+#if LV_FAST_BLEND_HAS_SIMD
+extern const lv_fast_blend_kernels_t lv_fast_blend_simd;
+#endif
+
+
+/**
+ * @brief The vector kernels of this build
+ * @return const lv_fast_blend_kernels_t* Kernel set pointer, NULL without LV_FAST_BLEND_HAS_SIMD
+ */
+const lv_fast_blend_kernels_t* lv_fast_blend_default(void);
+
+/**
+ * @brief Blend like lv_draw_sw_blend_basic() with the given kernels, pixel for pixel
+ * Rounds the mask in place when the display has anti-aliasing off, as LVGL does.
+ * Other blend modes, set_px_cb and transparent screens are left to LVGL.
+ * @param kernels Kernel set pointer
+ * @param draw_ctx Draw context of the buffer being rendered
+ * @param dsc Blend descriptor
+ * @return bool Returns true when the blend was done, false when LVGL must do it
+ */
+bool lv_fast_blend_dispatch(const lv_fast_blend_kernels_t *kernels, lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc);
+
+/**
+ * @brief Replace the software blend of a display with vector kernels (call with the LVGL lock held)
+ * Only a vector set is hooked in, after a short self-test against the scalar set; otherwise the display keeps
+ * LVGL's blend. Install before lv_parallel_create() so the bands run the kernels.
+ * @param disp Display, NULL for the default one
+ * @param kernels Kernel set pointer, NULL for lv_fast_blend_default()
+ * @return esp_err_t ESP_OK, ESP_ERR_NOT_SUPPORTED without vector kernels (the scalar set is not installed),
+ * ESP_FAIL if the self-test fails, ESP_ERR_INVALID_STATE if the display does not use the software renderer
+ */
+esp_err_t lv_fast_blend_install(lv_disp_t *disp, const lv_fast_blend_kernels_t *kernels);
+
+#endif // _LV_FAST_BLEND_H
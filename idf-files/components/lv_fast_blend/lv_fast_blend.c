@@ -0,0 +1,213 @@
+#include "lv_fast_blend.h"
+
+#include <string.h>
+#include <esp_log.h>
+
+#define TAG "LvFastBlend"
+
+#define SELFTEST_W  19      // Two vector blocks and a tail
+
+static const lv_fast_blend_kernels_t *s_kernels = NULL;
+static void (*s_lvgl_blend)(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc) = NULL;
+
+// ---------------------- Internal implementation functions ----------------------
+
+static void lv_fast_blend_hook(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc)
+{
+    if (!lv_fast_blend_dispatch(s_kernels, draw_ctx, dsc)) {
+        s_lvgl_blend(draw_ctx, dsc);
+    }
+}
+
+static bool lv_fast_blend_selftest_kernel(const char *name, void (*ref)(const lv_fast_blend_job_t*),
+                                          void (*test)(const lv_fast_blend_job_t*), lv_fast_blend_job_t *job,
+                                          const lv_color_t *base)
+{
+    lv_color_t expect[SELFTEST_W], got[SELFTEST_W];
+    memcpy(expect, base, sizeof(expect));
+    memcpy(got, base, sizeof(got));
+    job->dest = expect;
+    ref(job);
+    job->dest = got;
+    test(job);
+    if (memcmp(expect, got, sizeof(got)) != 0) {
+        ESP_LOGW(TAG, "%s differs from the scalar kernel at opa %u", name, job->opa);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Run every kernel of a set and of the scalar set on the same pixels
+ * @return bool Returns true when both sets give identical results
+ */
+static bool lv_fast_blend_selftest(const lv_fast_blend_kernels_t *kernels)
+{
+    static const lv_opa_t opas[] = {LV_OPA_COVER, 254, LV_OPA_MAX, LV_OPA_50, 77, 200};
+    const lv_fast_blend_kernels_t *ref = &lv_fast_blend_scalar;
+    lv_color_t src[SELFTEST_W], base[SELFTEST_W];
+    lv_opa_t mask[SELFTEST_W];
+    for (int i = 0; i < SELFTEST_W; i++) {
+        src[i] = lv_color_make((uint8_t)(i * 13), (uint8_t)(255 - i * 11), (uint8_t)(i * 29));
+        base[i] = lv_color_make((uint8_t)(255 - i * 7), (uint8_t)(i * 17), (uint8_t)(128 + i * 5));
+        mask[i] = i == 0 ? LV_OPA_TRANSP : (i == 1 ? LV_OPA_COVER : (lv_opa_t)(i * 41 + 3));
+    }
+
+    bool same = true;
+    for (size_t o = 0; o < sizeof(opas) / sizeof(opas[0]) && same; o++) {
+        lv_fast_blend_job_t job = {
+            .src = src, .color = lv_color_make(40, 200, 90), .mask = mask,
+            .w = SELFTEST_W, .h = 1, .opa = opas[o],
+        };
+        same = lv_fast_blend_selftest_kernel("fill", ref->fill, kernels->fill, &job, base) &&
+               lv_fast_blend_selftest_kernel("fill_opa", ref->fill_opa, kernels->fill_opa, &job, base) &&
+               lv_fast_blend_selftest_kernel("fill_mask", ref->fill_mask, kernels->fill_mask, &job, base) &&
+               lv_fast_blend_selftest_kernel("copy", ref->copy, kernels->copy, &job, base) &&
+               lv_fast_blend_selftest_kernel("copy_opa", ref->copy_opa, kernels->copy_opa, &job, base) &&
+               lv_fast_blend_selftest_kernel("copy_mask", ref->copy_mask, kernels->copy_mask, &job, base);
+    }
+    return same;
+}
+
+/**
+ * @brief Unmasked fill with opacity, as fill_normal() of LVGL
+ * LVGL caches the result of the previous destination color and seeds that cache with black mixed by
+ * lv_color_mix(), which rounds differently from the premultiplied mix: the black pixels before the first
+ * other color of the area take the seed. The kernel runs from that first other color on.
+ */
+static void lv_fast_blend_fill_opa(const lv_fast_blend_kernels_t *kernels, lv_fast_blend_job_t *job)
+{
+    lv_color_t black = lv_color_black();
+    lv_color_t seed = lv_color_mix(job->color, black, job->opa);
+    for (; job->h > 0; job->h--, job->dest += job->dest_stride) {
+        int32_t x = 0;
+        while (x < job->w && job->dest[x].full == black.full) {
+            job->dest[x++] = seed;
+        }
+        if (x < job->w) {
+            // The rest of this row, then the rows below
+            lv_fast_blend_job_t row = *job;
+            row.dest += x;
+            row.w -= x;
+            row.h = 1;
+            kernels->fill_opa(&row);
+            job->dest += job->dest_stride;
+            if (--job->h > 0) {
+                kernels->fill_opa(job);
+            }
+            return;
+        }
+    }
+}
+
+// ---------------------- External API functions ----------------------
+
+const lv_fast_blend_kernels_t* lv_fast_blend_default(void)
+{
+#if LV_FAST_BLEND_HAS_SIMD
+    return &lv_fast_blend_simd;
+#else
+    return NULL;
+#endif
+}
+
+bool lv_fast_blend_dispatch(const lv_fast_blend_kernels_t *kernels, lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc)
+{
+    lv_disp_t *disp = _lv_refr_get_disp_refreshing();
+    lv_opa_t opa = dsc->opa;
+    if (dsc->blend_mode != LV_BLEND_MODE_NORMAL || disp == NULL || disp->driver->set_px_cb ||
+        disp->driver->screen_transp) {
+        return false;
+    }
+
+    // Mask handling as lv_draw_sw_blend_basic()
+    lv_opa_t *mask = dsc->mask_buf;
+    if (mask && dsc->mask_res == LV_DRAW_MASK_RES_TRANSP) {
+        return true;
+    }
+    if (dsc->mask_res == LV_DRAW_MASK_RES_FULL_COVER) {
+        mask = NULL;
+    }
+
+    lv_area_t area;
+    if (!_lv_area_intersect(&area, dsc->blend_area, draw_ctx->clip_area)) {
+        return true;
+    }
+
+    lv_fast_blend_job_t job = {
+        .dest_stride = lv_area_get_width(draw_ctx->buf_area),
+        .color = dsc->color,
+        .w = lv_area_get_width(&area),
+        .h = lv_area_get_height(&area),
+        .opa = opa,
+    };
+    job.dest = (lv_color_t*)draw_ctx->buf + job.dest_stride * (area.y1 - draw_ctx->buf_area->y1) +
+               (area.x1 - draw_ctx->buf_area->x1);
+    if (dsc->src_buf) {
+        job.src_stride = lv_area_get_width(dsc->blend_area);
+        job.src = dsc->src_buf + job.src_stride * (area.y1 - dsc->blend_area->y1) + (area.x1 - dsc->blend_area->x1);
+    }
+    if (mask) {
+        // Without anti-aliasing LVGL rounds the whole mask in place, so later blends see it rounded too
+        if (disp->driver->antialiasing == 0) {
+            int32_t size = lv_area_get_width(dsc->mask_area) * lv_area_get_height(dsc->mask_area);
+            for (int32_t i = 0; i < size; i++) {
+                mask[i] = mask[i] > 128 ? LV_OPA_COVER : LV_OPA_TRANSP;
+            }
+        }
+        job.mask_stride = lv_area_get_width(dsc->mask_area);
+        job.mask = mask + job.mask_stride * (area.y1 - dsc->mask_area->y1) + (area.x1 - dsc->mask_area->x1);
+    }
+
+    // The same opa thresholds as fill_normal() and map_normal()
+    if (job.src == NULL) {
+        if (job.mask) {
+            kernels->fill_mask(&job);
+        } else if (opa >= LV_OPA_MAX) {
+            kernels->fill(&job);
+        } else {
+            lv_fast_blend_fill_opa(kernels, &job);
+        }
+    } else {
+        if (job.mask) {
+            kernels->copy_mask(&job);
+        } else if (opa >= LV_OPA_MAX) {
+            kernels->copy(&job);
+        } else {
+            kernels->copy_opa(&job);
+        }
+    }
+    return true;
+}
+
+esp_err_t lv_fast_blend_install(lv_disp_t *disp, const lv_fast_blend_kernels_t *kernels)
+{
+    if (disp == NULL) {
+        disp = lv_disp_get_default();
+    }
+    if (disp == NULL || disp->driver->draw_ctx == NULL || ((lv_draw_sw_ctx_t*)disp->driver->draw_ctx)->blend == NULL) {
+        ESP_LOGE(TAG, "The display does not use the software renderer");
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (kernels == NULL) {
+        kernels = lv_fast_blend_default();
+    }
+    // The scalar set is LVGL's own mixing: hooking it in only adds a call per blend
+    if (kernels == NULL || kernels == &lv_fast_blend_scalar) {
+        ESP_LOGI(TAG, "No vector blend kernels in this build, LVGL blends");
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    if (!lv_fast_blend_selftest(kernels)) {
+        ESP_LOGW(TAG, "%s blend kernels failed the self-test, LVGL blends", kernels->name);
+        return ESP_FAIL;
+    }
+
+    lv_draw_sw_ctx_t *sw_ctx = (lv_draw_sw_ctx_t*)disp->driver->draw_ctx;
+    if (sw_ctx->blend != lv_fast_blend_hook) {
+        s_lvgl_blend = sw_ctx->blend;
+        sw_ctx->blend = lv_fast_blend_hook;
+    }
+    s_kernels = kernels;
+    ESP_LOGI(TAG, "%s blend kernels", kernels->name);
+    return ESP_OK;
+}
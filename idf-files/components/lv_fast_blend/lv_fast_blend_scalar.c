@@ -0,0 +1,116 @@
+#include "lv_fast_blend.h"
+
+#include <string.h>
+
+// Portable kernels: LVGL's own color mixing and opa thresholds, without its per-pixel result caching
+
+// ---------------------- Internal implementation functions ----------------------
+
+static void scalar_fill(const lv_fast_blend_job_t *job)
+{
+    lv_color_t *dest = job->dest;
+    for (int32_t y = 0; y < job->h; y++) {
+        lv_color_fill(dest, job->color, job->w);
+        dest += job->dest_stride;
+    }
+}
+
+static void scalar_fill_opa(const lv_fast_blend_job_t *job)
+{
+    uint16_t premult[3];
+    lv_color_premult(job->color, job->opa, premult);
+    lv_opa_t opa_inv = 255 - job->opa;
+    lv_color_t *dest = job->dest;
+    for (int32_t y = 0; y < job->h; y++) {
+        for (int32_t x = 0; x < job->w; x++) {
+            dest[x] = lv_color_mix_premult(premult, dest[x], opa_inv);
+        }
+        dest += job->dest_stride;
+    }
+}
+
+static void scalar_fill_mask(const lv_fast_blend_job_t *job)
+{
+    lv_color_t *dest = job->dest;
+    const lv_opa_t *mask = job->mask;
+    bool cover = job->opa >= LV_OPA_MAX;     // fill_normal() ignores opa from LV_OPA_MAX up
+    for (int32_t y = 0; y < job->h; y++) {
+        for (int32_t x = 0; x < job->w; x++) {
+            lv_opa_t m = mask[x];
+            if (m == LV_OPA_TRANSP) {
+                continue;
+            }
+            if (cover) {
+                dest[x] = m == LV_OPA_COVER ? job->color : lv_color_mix(job->color, dest[x], m);
+            } else {
+                // LVGL scales by the mask with a shift, not a division by 255
+                lv_opa_t opa = m == LV_OPA_COVER ? job->opa : (lv_opa_t)((m * job->opa) >> 8);
+                dest[x] = lv_color_mix(job->color, dest[x], opa);
+            }
+        }
+        dest += job->dest_stride;
+        mask += job->mask_stride;
+    }
+}
+
+static void scalar_copy(const lv_fast_blend_job_t *job)
+{
+    lv_color_t *dest = job->dest;
+    const lv_color_t *src = job->src;
+    for (int32_t y = 0; y < job->h; y++) {
+        memcpy(dest, src, job->w * sizeof(lv_color_t));
+        dest += job->dest_stride;
+        src += job->src_stride;
+    }
+}
+
+static void scalar_copy_opa(const lv_fast_blend_job_t *job)
+{
+    lv_color_t *dest = job->dest;
+    const lv_color_t *src = job->src;
+    for (int32_t y = 0; y < job->h; y++) {
+        for (int32_t x = 0; x < job->w; x++) {
+            dest[x] = lv_color_mix(src[x], dest[x], job->opa);
+        }
+        dest += job->dest_stride;
+        src += job->src_stride;
+    }
+}
+
+static void scalar_copy_mask(const lv_fast_blend_job_t *job)
+{
+    lv_color_t *dest = job->dest;
+    const lv_color_t *src = job->src;
+    const lv_opa_t *mask = job->mask;
+    bool cover = job->opa > LV_OPA_MAX;     // map_normal() keeps opa LV_OPA_MAX itself, unlike fill_normal()
+    for (int32_t y = 0; y < job->h; y++) {
+        for (int32_t x = 0; x < job->w; x++) {
+            lv_opa_t m = mask[x];
+            if (m == LV_OPA_TRANSP) {
+                continue;
+            }
+            if (cover) {
+                dest[x] = m == LV_OPA_COVER ? src[x] : lv_color_mix(src[x], dest[x], m);
+            } else {
+                // Here a mask from LV_OPA_MAX up already counts as full
+                lv_opa_t opa = m >= LV_OPA_MAX ? job->opa : (lv_opa_t)((m * job->opa) >> 8);
+                dest[x] = lv_color_mix(src[x], dest[x], opa);
+            }
+        }
+        dest += job->dest_stride;
+        src += job->src_stride;
+        mask += job->mask_stride;
+    }
+}
+
+// ---------------------- External API functions ----------------------
+
+const lv_fast_blend_kernels_t lv_fast_blend_scalar = {
+    .name = "scalar",
+    .fill = scalar_fill,
+    .fill_opa = scalar_fill_opa,
+    .fill_mask = scalar_fill_mask,
+    .copy = scalar_copy,
+    .copy_opa = scalar_copy_opa,
+    .copy_mask = scalar_copy_mask,
+};
@@ -0,0 +1,268 @@
+#include "lv_fast_blend.h"
+
+#if LV_FAST_BLEND_HAS_SIMD
+
+#include <string.h>
+
+// GCC vector extensions: the compiler maps them to SSE2, NEON or RVV.
+// Eight pixels per block. Channel math runs on 16-bit lanes: c1 * mix + c2 * (255 - mix) + ofs
+// stays below 65280, so every mix is the exact integer result of lv_color_mix().
+
+#define LANES 8
+
+typedef uint16_t vu16_t __attribute__((vector_size(LANES * 2)));
+typedef uint32_t vu32_t __attribute__((vector_size(LANES * 4)));
+typedef uint8_t vu8_t __attribute__((vector_size(LANES)));
+#if LV_COLOR_DEPTH == 16
+typedef vu16_t vpx_t;
+#else
+typedef vu32_t vpx_t;
+#endif
+
+// lv_color_mix() takes a packed shortcut for plain RGB565 when it rounds down
+#define SIMD_MIX_PACKED (LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0 && LV_COLOR_MIX_ROUND_OFS == 0)
+
+#define ALWAYS_INLINE static inline __attribute__((always_inline))
+
+typedef void (*simd_block_t)(const lv_fast_blend_job_t *job, lv_color_t *d, const lv_color_t *s, const lv_opa_t *m);
+
+// ---------------------- Internal implementation functions ----------------------
+
+ALWAYS_INLINE vpx_t simd_splat(lv_color_t color)
+{
+    return (vpx_t){0} + color.full;
+}
+
+ALWAYS_INLINE vu16_t simd_splat16(uint16_t value)
+{
+    return (vu16_t){0} + value;
+}
+
+ALWAYS_INLINE vpx_t simd_select(vpx_t cond, vpx_t a, vpx_t b)
+{
+    return (a & cond) | (b & ~cond);
+}
+
+ALWAYS_INLINE vu16_t simd_select16(vu16_t cond, vu16_t a, vu16_t b)
+{
+    return (a & cond) | (b & ~cond);
+}
+
+ALWAYS_INLINE vpx_t simd_load(const lv_color_t *p)
+{
+    vpx_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+ALWAYS_INLINE void simd_store(lv_color_t *p, vpx_t v)
+{
+    memcpy(p, &v, sizeof(v));
+}
+
+ALWAYS_INLINE vu16_t simd_load_mask(const lv_opa_t *p)
+{
+    vu8_t v;
+    memcpy(&v, p, sizeof(v));
+    return __builtin_convertvector(v, vu16_t);
+}
+
+/**
+ * @brief LV_UDIV255 for values below 65535, without 32-bit products
+ */
+ALWAYS_INLINE vu16_t simd_udiv255(vu16_t v)
+{
+    return (v + 1 + (v >> 8)) >> 8;
+}
+
+ALWAYS_INLINE vu16_t simd_mix_channel(vu16_t c1, vu16_t c2, vu16_t mix, vu16_t inv, uint16_t ofs)
+{
+    return simd_udiv255(c1 * mix + c2 * inv + ofs);
+}
+
+/**
+ * @brief Per-channel (c1 * mix + c2 * (255 - mix) + ofs) / 255, as lv_color_mix() and lv_color_mix_premult()
+ */
+ALWAYS_INLINE vpx_t simd_mix_channels(vpx_t c1, vpx_t c2, vu16_t mix, uint16_t ofs)
+{
+    vu16_t inv = 255 - mix;
+#if LV_COLOR_DEPTH == 16
+#if LV_COLOR_16_SWAP
+    c1 = (c1 >> 8) | (c1 << 8);
+    c2 = (c2 >> 8) | (c2 << 8);
+#endif
+    vu16_t r = simd_mix_channel(c1 >> 11, c2 >> 11, mix, inv, ofs);
+    vu16_t g = simd_mix_channel((c1 >> 5) & 63, (c2 >> 5) & 63, mix, inv, ofs);
+    vu16_t b = simd_mix_channel(c1 & 31, c2 & 31, mix, inv, ofs);
+    vu16_t out = (r << 11) | (g << 5) | b;
+#if LV_COLOR_16_SWAP
+    out = (out >> 8) | (out << 8);
+#endif
+    return out;
+#else
+    vu16_t r = simd_mix_channel(__builtin_convertvector((c1 >> 16) & 255, vu16_t),
+                                __builtin_convertvector((c2 >> 16) & 255, vu16_t), mix, inv, ofs);
+    vu16_t g = simd_mix_channel(__builtin_convertvector((c1 >> 8) & 255, vu16_t),
+                                __builtin_convertvector((c2 >> 8) & 255, vu16_t), mix, inv, ofs);
+    vu16_t b = simd_mix_channel(__builtin_convertvector(c1 & 255, vu16_t),
+                                __builtin_convertvector(c2 & 255, vu16_t), mix, inv, ofs);
+    return 0xFF000000U | (__builtin_convertvector(r, vu32_t) << 16) |
+           (__builtin_convertvector(g, vu32_t) << 8) | __builtin_convertvector(b, vu32_t);
+#endif
+}
+
+ALWAYS_INLINE vpx_t simd_mix(vpx_t c1, vpx_t c2, vu16_t mix)
+{
+#if SIMD_MIX_PACKED
+    // The packed form needs 32-bit lanes
+    vu32_t m = (__builtin_convertvector(mix, vu32_t) + 4) >> 3;
+    vu32_t bg = __builtin_convertvector(c2, vu32_t);
+    vu32_t fg = __builtin_convertvector(c1, vu32_t);
+    bg = (bg | (bg << 16)) & 0x7E0F81FU;
+    fg = (fg | (fg << 16)) & 0x7E0F81FU;
+    vu32_t result = ((((fg - bg) * m) >> 5) + bg) & 0x7E0F81FU;
+    return __builtin_convertvector((result >> 16) | result, vu16_t);
+#else
+    return simd_mix_channels(c1, c2, mix, LV_COLOR_MIX_ROUND_OFS);
+#endif
+}
+
+/**
+ * @brief Widen a per-lane condition to pixel lanes
+ */
+ALWAYS_INLINE vpx_t simd_cond(vu16_t cond)
+{
+#if LV_COLOR_DEPTH == 16
+    return cond;
+#else
+    return (vu32_t){0} - __builtin_convertvector(cond & 1, vu32_t);
+#endif
+}
+
+/**
+ * @brief Run a block function over every LANES pixels of a job; row tails go through a stack copy
+ */
+ALWAYS_INLINE void simd_rows(const lv_fast_blend_job_t *job, simd_block_t block)
+{
+    lv_color_t *d = job->dest;
+    const lv_color_t *s = job->src;
+    const lv_opa_t *m = job->mask;
+    for (int32_t y = 0; y < job->h; y++) {
+        int32_t x = 0;
+        for (; x + LANES <= job->w; x += LANES) {
+            block(job, d + x, s ? s + x : NULL, m ? m + x : NULL);
+        }
+        int32_t n = job->w - x;
+        if (n > 0) {
+            lv_color_t dt[LANES] = {0};
+            lv_color_t st[LANES] = {0};
+            lv_opa_t mt[LANES] = {0};
+            memcpy(dt, d + x, n * sizeof(lv_color_t));
+            if (s) memcpy(st, s + x, n * sizeof(lv_color_t));
+            if (m) memcpy(mt, m + x, n);
+            block(job, dt, s ? st : NULL, m ? mt : NULL);
+            memcpy(d + x, dt, n * sizeof(lv_color_t));
+        }
+        d += job->dest_stride;
+        if (s) s += job->src_stride;
+        if (m) m += job->mask_stride;
+    }
+}
+
+ALWAYS_INLINE void fill_block(const lv_fast_blend_job_t *job, lv_color_t *d, const lv_color_t *s, const lv_opa_t *m)
+{
+    simd_store(d, simd_splat(job->color));
+}
+
+ALWAYS_INLINE void fill_opa_block(const lv_fast_blend_job_t *job, lv_color_t *d, const lv_color_t *s, const lv_opa_t *m)
+{
+    // lv_color_mix_premult() has no rounding offset
+    simd_store(d, simd_mix_channels(simd_splat(job->color), simd_load(d), simd_splat16(job->opa), 0));
+}
+
+ALWAYS_INLINE void fill_mask_block(const lv_fast_blend_job_t *job, lv_color_t *d, const lv_color_t *s, const lv_opa_t *m)
+{
+    vu16_t mask = simd_load_mask(m);
+    vpx_t color = simd_splat(job->color);
+    vpx_t dest = simd_load(d);
+    vu16_t full = (vu16_t)(mask == 255);
+    vpx_t out;
+    if (job->opa >= LV_OPA_MAX) {
+        out = simd_select(simd_cond(full), color, simd_mix(color, dest, mask));
+    } else {
+        vu16_t opa = simd_select16(full, simd_splat16(job->opa), (mask * job->opa) >> 8);
+        out = simd_mix(color, dest, opa);
+    }
+    simd_store(d, simd_select(simd_cond((vu16_t)(mask == 0)), dest, out));
+}
+
+ALWAYS_INLINE void copy_opa_block(const lv_fast_blend_job_t *job, lv_color_t *d, const lv_color_t *s, const lv_opa_t *m)
+{
+    simd_store(d, simd_mix(simd_load(s), simd_load(d), simd_splat16(job->opa)));
+}
+
+ALWAYS_INLINE void copy_mask_block(const lv_fast_blend_job_t *job, lv_color_t *d, const lv_color_t *s, const lv_opa_t *m)
+{
+    vu16_t mask = simd_load_mask(m);
+    vpx_t src = simd_load(s);
+    vpx_t dest = simd_load(d);
+    vpx_t out;
+    if (job->opa > LV_OPA_MAX) {
+        out = simd_select(simd_cond((vu16_t)(mask == 255)), src, simd_mix(src, dest, mask));
+    } else {
+        vu16_t opa = simd_select16((vu16_t)(mask >= LV_OPA_MAX), simd_splat16(job->opa), (mask * job->opa) >> 8);
+        out = simd_mix(src, dest, opa);
+    }
+    simd_store(d, simd_select(simd_cond((vu16_t)(mask == 0)), dest, out));
+}
+
+static void simd_fill(const lv_fast_blend_job_t *job)
+{
+    simd_rows(job, fill_block);
+}
+
+static void simd_fill_opa(const lv_fast_blend_job_t *job)
+{
+    simd_rows(job, fill_opa_block);
+}
+
+static void simd_fill_mask(const lv_fast_blend_job_t *job)
+{
+    simd_rows(job, fill_mask_block);
+}
+
+static void simd_copy(const lv_fast_blend_job_t *job)
+{
+    // libc's memcpy is already vectorized
+    lv_color_t *dest = job->dest;
+    const lv_color_t *src = job->src;
+    for (int32_t y = 0; y < job->h; y++) {
+        memcpy(dest, src, job->w * sizeof(lv_color_t));
+        dest += job->dest_stride;
+        src += job->src_stride;
+    }
+}
+
+static void simd_copy_opa(const lv_fast_blend_job_t *job)
+{
+    simd_rows(job, copy_opa_block);
+}
+
+static void simd_copy_mask(const lv_fast_blend_job_t *job)
+{
+    simd_rows(job, copy_mask_block);
+}
+
+// ---------------------- External API functions ----------------------
+
+const lv_fast_blend_kernels_t lv_fast_blend_simd = {
+    .name = "simd",
+    .fill = simd_fill,
+    .fill_opa = simd_fill_opa,
+    .fill_mask = simd_fill_mask,
+    .copy = simd_copy,
+    .copy_opa = simd_copy_opa,
+    .copy_mask = simd_copy_mask,
+};
+
+#endif // LV_FAST_BLEND_HAS_SIMD
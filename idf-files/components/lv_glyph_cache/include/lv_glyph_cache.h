@@ -0,0 +1,105 @@
+
+#ifndef _LV_GLYPH_CACHE_H
+#define _LV_GLYPH_CACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "lvgl.h"
+
+
+#define LV_GLYPH_CACHE_FONTS    8       // Fonts wrapped per cache
+
+// What temperature, date and time labels show
+#define LV_GLYPH_CACHE_DIGITS   "0123456789.,:-+/%°C"
+
+#define LV_GLYPH_CACHE_DEFAULT_CONFIG() {   \
+    .budget = 192 * 1024,                   \
+    .entries = 256,                         \
+    .prewarm = LV_GLYPH_CACHE_DIGITS,       \
+}
+
+
+typedef struct {
+    size_t budget;              // Bytes of A8 bitmaps kept, in PSRAM when present
+    uint16_t entries;           // Glyphs kept at most
+    const char *prewarm;        // UTF-8 characters decoded when a font is wrapped, NULL for none
+} lv_glyph_cache_config_t;
+
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t glyphs;            // Glyphs cached now
+    size_t used;                // Bytes cached now
+} lv_glyph_cache_stats_t;
+
+typedef struct {
+    const lv_font_t *font;      // Wrapped font, NULL for a free entry
+    uint32_t letter;
+    uint8_t *bitmap;            // A8, box_w * box_h bytes
+    uint32_t size;
+    uint32_t last_use;
+    int16_t next;               // Next entry of the same hash bucket, -1 at the end
+} lv_glyph_cache_entry_t;
+
+typedef struct lv_glyph_cache lv_glyph_cache_t;
+
+// A font that draws from the cache; labels use it in place of the wrapped font
+typedef struct {
+    lv_font_t font;             // Must stay first
+    const lv_font_t *base;
+    lv_glyph_cache_t *cache;
+} lv_glyph_cache_font_t;
+
+struct lv_glyph_cache {
+    lv_glyph_cache_config_t config;
+    lv_glyph_cache_entry_t *entries;
+    int16_t *buckets;
+    uint16_t bucket_mask;
+    lv_glyph_cache_font_t fonts[LV_GLYPH_CACHE_FONTS];
+    uint8_t font_count;
+    uint32_t tick;
+    lv_glyph_cache_stats_t stats;
+};
+
+
+/**
+ * @brief Create an empty glyph cache
+ * @param config Configuration pointer
+ * @return lv_glyph_cache_t* Returns a pointer to the instance on success, NULL on failure
+ */
+lv_glyph_cache_t* lv_glyph_cache_create(const lv_glyph_cache_config_t *config);
+
+/**
+ * @brief Font drawing the glyphs of a font from the cache, created on first use (call with the LVGL lock held)
+ * Glyphs are converted once to A8, the format the renderer blends, and the font reports 8 bpp for them.
+ * Fonts with subpixel rendering and glyphs larger than the budget are passed through unchanged.
+ * @param cache Instance pointer
+ * @param font Font to wrap; a font this cache returned is returned as is
+ * @return lv_font_t* Returns the caching font, NULL on failure
+ */
+lv_font_t* lv_glyph_cache_font(lv_glyph_cache_t *cache, const lv_font_t *font);
+
+/**
+ * @brief Decode characters into the cache ahead of the first frame that shows them
+ * @param font Font returned by lv_glyph_cache_font()
+ * @param text UTF-8 characters
+ * @return uint32_t Number of glyphs now cached from the text
+ */
+uint32_t lv_glyph_cache_prewarm(lv_font_t *font, const char *text);
+
+/**
+ * @brief Switch every label under an object to the caching version of its font (call with the LVGL lock held)
+ * @param cache Instance pointer
+ * @param obj Root object, e.g. lv_scr_act()
+ */
+void lv_glyph_cache_apply(lv_glyph_cache_t *cache, lv_obj_t *obj);
+
+/**
+ * @brief Copy the counters
+ * @param cache Instance pointer
+ * @param stats Stats output pointer
+ */
+void lv_glyph_cache_get_stats(lv_glyph_cache_t *cache, lv_glyph_cache_stats_t *stats);
+
+#endif // _LV_GLYPH_CACHE_H
@@ -0,0 +1,289 @@
+#include "lv_glyph_cache.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <sdkconfig.h>
+#include <esp_log.h>
+#if CONFIG_SPIRAM
+#include <esp_heap_caps.h>
+#endif
+
+#define TAG "LvGlyphCache"
+
+// ---------------------- Internal implementation functions ----------------------
+
+static void* glyph_cache_alloc(size_t size)
+{
+#if CONFIG_SPIRAM
+    void *buf = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (buf) {
+        return buf;
+    }
+#endif
+    return malloc(size);
+}
+
+static uint16_t glyph_cache_hash(const lv_glyph_cache_t *cache, const lv_font_t *font, uint32_t letter)
+{
+    uint32_t h = ((uint32_t)(uintptr_t)font >> 4) ^ (letter * 2654435761U);
+    return (uint16_t)((h ^ (h >> 16)) & cache->bucket_mask);
+}
+
+/**
+ * @brief Whether a glyph goes through the cache (and is reported as A8)
+ */
+static bool glyph_cache_cacheable(const lv_glyph_cache_font_t *wrap, const lv_font_glyph_dsc_t *dsc)
+{
+    uint8_t bpp = dsc->bpp;
+    size_t size = (size_t)dsc->box_w * dsc->box_h;
+    return (bpp == 1 || bpp == 2 || bpp == 4 || bpp == 8) && size > 0 &&
+           size <= wrap->cache->config.budget && wrap->base->subpx == LV_FONT_SUBPX_NONE;
+}
+
+static lv_glyph_cache_entry_t* glyph_cache_find(lv_glyph_cache_t *cache, const lv_font_t *font, uint32_t letter)
+{
+    for (int16_t i = cache->buckets[glyph_cache_hash(cache, font, letter)]; i >= 0; i = cache->entries[i].next) {
+        lv_glyph_cache_entry_t *entry = &cache->entries[i];
+        if (entry->font == font && entry->letter == letter) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void glyph_cache_evict(lv_glyph_cache_t *cache, lv_glyph_cache_entry_t *entry)
+{
+    int16_t index = (int16_t)(entry - cache->entries);
+    int16_t *link = &cache->buckets[glyph_cache_hash(cache, entry->font, entry->letter)];
+    while (*link != index) {
+        link = &cache->entries[*link].next;
+    }
+    *link = entry->next;
+
+    cache->stats.used -= entry->size;
+    cache->stats.glyphs--;
+    cache->stats.evictions++;
+    free(entry->bitmap);
+    memset(entry, 0, sizeof(*entry));
+    entry->next = -1;
+}
+
+/**
+ * @brief Free entry with room for size bytes, evicting least recently used glyphs
+ */
+static lv_glyph_cache_entry_t* glyph_cache_slot(lv_glyph_cache_t *cache, uint32_t size)
+{
+    lv_glyph_cache_entry_t *slot = NULL;
+    while (1) {
+        lv_glyph_cache_entry_t *victim = NULL;
+        for (uint16_t i = 0; i < cache->config.entries; i++) {
+            lv_glyph_cache_entry_t *entry = &cache->entries[i];
+            if (entry->font == NULL) {
+                slot = slot ? slot : entry;
+            } else if (victim == NULL || entry->last_use < victim->last_use) {
+                victim = entry;
+            }
+        }
+        if (slot && cache->stats.used + size <= cache->config.budget) {
+            return slot;
+        }
+        if (victim == NULL) {
+            return NULL;
+        }
+        glyph_cache_evict(cache, victim);
+        slot = NULL;
+    }
+}
+
+/**
+ * @brief Expand a font bitmap (rows packed back to back, MSB first) to one coverage byte per pixel
+ * Same values as LVGL's bpp to opa tables: v * 255 / (2^bpp - 1)
+ */
+static void glyph_cache_to_a8(const uint8_t *src, uint8_t bpp, uint32_t px, uint8_t *out)
+{
+    if (bpp == 8) {
+        memcpy(out, src, px);
+        return;
+    }
+    uint8_t mask = (uint8_t)((1 << bpp) - 1);
+    uint8_t scale = 255 / mask;
+    uint32_t bit = 0;
+    for (uint32_t i = 0; i < px; i++, bit += bpp) {
+        uint8_t v = (src[bit >> 3] >> (8 - bpp - (bit & 7))) & mask;
+        out[i] = v * scale;
+    }
+}
+
+static bool glyph_cache_get_dsc(const lv_font_t *font, lv_font_glyph_dsc_t *dsc, uint32_t letter, uint32_t next)
+{
+    const lv_glyph_cache_font_t *wrap = (const lv_glyph_cache_font_t*)font;
+    if (!wrap->base->get_glyph_dsc(wrap->base, dsc, letter, next)) {
+        return false;
+    }
+    if (glyph_cache_cacheable(wrap, dsc)) {
+        dsc->bpp = 8;
+    }
+    return true;
+}
+
+static const uint8_t* glyph_cache_get_bitmap(const lv_font_t *font, uint32_t letter)
+{
+    const lv_glyph_cache_font_t *wrap = (const lv_glyph_cache_font_t*)font;
+    lv_glyph_cache_t *cache = wrap->cache;
+    const lv_font_t *base = wrap->base;
+
+    lv_glyph_cache_entry_t *entry = glyph_cache_find(cache, base, letter);
+    if (entry) {
+        cache->stats.hits++;
+        entry->last_use = ++cache->tick;
+        return entry->bitmap;
+    }
+
+    lv_font_glyph_dsc_t dsc;
+    if (!base->get_glyph_dsc(base, &dsc, letter, 0)) {
+        return NULL;
+    }
+    const uint8_t *src = base->get_glyph_bitmap(base, letter);
+    if (src == NULL || !glyph_cache_cacheable(wrap, &dsc)) {
+        return src;     // Reported with the font's own bpp
+    }
+    cache->stats.misses++;
+
+    uint32_t size = (uint32_t)dsc.box_w * dsc.box_h;
+    entry = glyph_cache_slot(cache, size);
+    uint8_t *bitmap = entry ? (uint8_t*)glyph_cache_alloc(size) : NULL;
+    if (bitmap == NULL) {
+        ESP_LOGW(TAG, "No room for glyph U+%04lX", (unsigned long)letter);
+        return NULL;    // LVGL skips the glyph
+    }
+    glyph_cache_to_a8(src, dsc.bpp, size, bitmap);
+
+    uint16_t bucket = glyph_cache_hash(cache, base, letter);
+    entry->font = base;
+    entry->letter = letter;
+    entry->bitmap = bitmap;
+    entry->size = size;
+    entry->last_use = ++cache->tick;
+    entry->next = cache->buckets[bucket];
+    cache->buckets[bucket] = (int16_t)(entry - cache->entries);
+    cache->stats.used += size;
+    cache->stats.glyphs++;
+    return bitmap;
+}
+
+// ---------------------- External API functions ----------------------
+
+lv_glyph_cache_t* lv_glyph_cache_create(const lv_glyph_cache_config_t *config)
+{
+    if (config == NULL || config->entries == 0 || config->entries > INT16_MAX || config->budget == 0) {
+        ESP_LOGE(TAG, "Invalid config");
+        return NULL;
+    }
+    lv_glyph_cache_t *cache = (lv_glyph_cache_t*)calloc(1, sizeof(lv_glyph_cache_t));
+    if (cache == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate lv_glyph_cache_t");
+        return NULL;
+    }
+    cache->config = *config;
+
+    // Buckets: the next power of two at or above the entry count
+    uint32_t buckets = 1;
+    while (buckets < config->entries) {
+        buckets <<= 1;
+    }
+    cache->bucket_mask = (uint16_t)(buckets - 1);
+    cache->entries = (lv_glyph_cache_entry_t*)calloc(config->entries, sizeof(lv_glyph_cache_entry_t));
+    cache->buckets = (int16_t*)malloc(buckets * sizeof(int16_t));
+    if (cache->entries == NULL || cache->buckets == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate %u entries", config->entries);
+        free(cache->entries);
+        free(cache->buckets);
+        free(cache);
+        return NULL;
+    }
+    memset(cache->buckets, 0xFF, buckets * sizeof(int16_t));   // -1: empty
+    for (uint16_t i = 0; i < config->entries; i++) {
+        cache->entries[i].next = -1;
+    }
+    return cache;
+}
+
+lv_font_t* lv_glyph_cache_font(lv_glyph_cache_t *cache, const lv_font_t *font)
+{
+    if (cache == NULL || font == NULL) {
+        return NULL;
+    }
+    if (font->get_glyph_bitmap == glyph_cache_get_bitmap) {
+        return (lv_font_t*)font;
+    }
+    for (uint8_t i = 0; i < cache->font_count; i++) {
+        if (cache->fonts[i].base == font) {
+            return &cache->fonts[i].font;
+        }
+    }
+    if (cache->font_count >= LV_GLYPH_CACHE_FONTS) {
+        ESP_LOGW(TAG, "No room for another font");
+        return NULL;
+    }
+
+    lv_glyph_cache_font_t *wrap = &cache->fonts[cache->font_count++];
+    wrap->font = *font;     // Metrics, fallback and subpx as the original
+    wrap->font.get_glyph_dsc = glyph_cache_get_dsc;
+    wrap->font.get_glyph_bitmap = glyph_cache_get_bitmap;
+    wrap->base = font;
+    wrap->cache = cache;
+    if (cache->config.prewarm) {
+        lv_glyph_cache_prewarm(&wrap->font, cache->config.prewarm);
+    }
+    return &wrap->font;
+}
+
+uint32_t lv_glyph_cache_prewarm(lv_font_t *font, const char *text)
+{
+    if (font == NULL || text == NULL || font->get_glyph_bitmap != glyph_cache_get_bitmap) {
+        return 0;
+    }
+    lv_glyph_cache_t *cache = ((const lv_glyph_cache_font_t*)font)->cache;
+    uint32_t misses = cache->stats.misses;
+    uint32_t hits = cache->stats.hits;
+    uint32_t cached = 0;
+    uint32_t i = 0;
+    while (text[i] != '\0') {
+        uint32_t letter = _lv_txt_encoded_next(text, &i);
+        lv_font_glyph_dsc_t dsc;
+        if (glyph_cache_get_dsc(font, &dsc, letter, 0) && dsc.bpp == 8 &&
+            glyph_cache_get_bitmap(font, letter) != NULL) {
+            cached++;
+        }
+    }
+    // Warming up does not count towards the hit rate of the frames
+    cache->stats.misses = misses;
+    cache->stats.hits = hits;
+    return cached;
+}
+
+void lv_glyph_cache_apply(lv_glyph_cache_t *cache, lv_obj_t *obj)
+{
+    if (cache == NULL || obj == NULL) {
+        return;
+    }
+    if (lv_obj_check_type(obj, &lv_label_class)) {
+        const lv_font_t *font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+        lv_font_t *cached = lv_glyph_cache_font(cache, font);
+        if (cached && cached != font) {
+            lv_obj_set_style_text_font(obj, cached, LV_PART_MAIN);
+        }
+    }
+    uint32_t count = lv_obj_get_child_cnt(obj);
+    for (uint32_t i = 0; i < count; i++) {
+        lv_glyph_cache_apply(cache, lv_obj_get_child(obj, i));
+    }
+}
+
+void lv_glyph_cache_get_stats(lv_glyph_cache_t *cache, lv_glyph_cache_stats_t *stats)
+{
+    if (cache == NULL || stats == NULL) {
+        return;
+    }
+    *stats = cache->stats;
+}
@@ -0,0 +1,81 @@
+
+#ifndef _LV_HEADLESS_H
+#define _LV_HEADLESS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <esp_err.h>
+#include "lvgl.h"
+
+
+#define LV_HEADLESS_HOR_RES     1024    // CrowPanel 10.1" panel
+#define LV_HEADLESS_VER_RES     600
+
+#define LV_HEADLESS_DEFAULT_CONFIG() {          \
+    .hor_res = LV_HEADLESS_HOR_RES,             \
+    .ver_res = LV_HEADLESS_VER_RES,             \
+    .buf_lines = LV_HEADLESS_VER_RES / 10,      \
+}
+
+
+typedef struct {
+    uint16_t hor_res;
+    uint16_t ver_res;
+    uint16_t buf_lines;         // Height of the LVGL draw buffer, like the panel's partial buffer
+} lv_headless_config_t;
+
+// Cost of one rendered frame
+typedef struct {
+    uint32_t render_us;         // lv_refr_now(): layout, drawing and flushing
+    uint32_t flush_us;          // Part of render_us spent copying into the framebuffer
+    uint32_t flushes;           // flush_cb calls
+    uint32_t flushed_px;        // Pixels redrawn
+} lv_headless_frame_t;
+
+// In-memory display: LVGL renders into a draw buffer, flush_cb copies it into a full framebuffer
+typedef struct {
+    lv_headless_config_t config;
+    lv_disp_draw_buf_t draw_buf;
+    lv_disp_drv_t drv;
+    lv_disp_t *disp;
+    lv_color_t *buf;            // buf_lines rows
+    lv_color_t *fb;             // What the panel would show
+    lv_headless_frame_t frame;  // Frame being rendered
+} lv_headless_t;
+
+
+/**
+ * @brief Create an in-memory display and make it the default one (lv_init() must have been called)
+ * @param config Configuration pointer
+ * @return lv_headless_t* Returns a pointer to the instance on success, NULL on failure
+ */
+lv_headless_t* lv_headless_create(const lv_headless_config_t *config);
+
+/**
+ * @brief Render the invalidated areas now
+ * @param headless Instance pointer
+ * @param full Invalidate the whole screen first (full render) instead of only what changed (partial)
+ * @param frame Cost of the frame output pointer (optional)
+ */
+void lv_headless_render(lv_headless_t *headless, bool full, lv_headless_frame_t *frame);
+
+/**
+ * @brief Write the framebuffer as a binary PPM (P6) image
+ * @param headless Instance pointer
+ * @param path Output file path
+ * @return esp_err_t Returns ESP_OK on success, error code on failure
+ */
+esp_err_t lv_headless_dump_ppm(lv_headless_t *headless, const char *path);
+
+/**
+ * @brief Compare the framebuffer with a golden PPM image written by lv_headless_dump_ppm()
+ * @param headless Instance pointer
+ * @param path Golden image path
+ * @param tolerance Largest per-channel difference still counted as equal
+ * @param diff_px Number of differing pixels output pointer (optional)
+ * @return esp_err_t Returns ESP_OK when the images match, ESP_ERR_NOT_FOUND without a golden image,
+ *                   ESP_ERR_INVALID_SIZE on a size mismatch, ESP_FAIL when pixels differ
+ */
+esp_err_t lv_headless_compare_ppm(lv_headless_t *headless, const char *path, uint8_t tolerance, uint32_t *diff_px);
+
+#endif // _LV_HEADLESS_H
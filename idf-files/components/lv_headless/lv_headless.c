@@ -0,0 +1,210 @@
+#include "lv_headless.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include <esp_log.h>
+
+#define TAG "LvHeadless"
+
+// ---------------------- Internal implementation functions ----------------------
+
+static uint64_t lv_headless_now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/**
+ * @brief Copy a rendered area into the framebuffer, as the panel DMA would
+ */
+static void lv_headless_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    lv_headless_t *headless = (lv_headless_t*)drv->user_data;
+    uint64_t start = lv_headless_now_us();
+    int32_t w = lv_area_get_width(area);
+
+    for (int32_t y = area->y1; y <= area->y2; y++) {
+        memcpy(&headless->fb[y * headless->config.hor_res + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+
+    headless->frame.flush_us += (uint32_t)(lv_headless_now_us() - start);
+    headless->frame.flushes++;
+    headless->frame.flushed_px += (uint32_t)lv_area_get_size(area);
+    lv_disp_flush_ready(drv);
+}
+
+static void lv_headless_pixel_rgb(lv_color_t color, uint8_t *rgb)
+{
+    lv_color32_t c32;
+    c32.full = lv_color_to32(color);
+    rgb[0] = c32.ch.red;
+    rgb[1] = c32.ch.green;
+    rgb[2] = c32.ch.blue;
+}
+
+// ---------------------- External API functions ----------------------
+
+lv_headless_t* lv_headless_create(const lv_headless_config_t *config)
+{
+    if (config == NULL || config->hor_res == 0 || config->ver_res == 0 ||
+        config->buf_lines == 0 || config->buf_lines > config->ver_res) {
+        ESP_LOGE(TAG, "Invalid configuration");
+        return NULL;
+    }
+
+    lv_headless_t *headless = (lv_headless_t*)calloc(1, sizeof(lv_headless_t));
+    if (headless == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate lv_headless_t");
+        return NULL;
+    }
+    headless->config = *config;
+
+    uint32_t buf_px = (uint32_t)config->hor_res * config->buf_lines;
+    headless->buf = (lv_color_t*)malloc(buf_px * sizeof(lv_color_t));
+    headless->fb = (lv_color_t*)calloc((size_t)config->hor_res * config->ver_res, sizeof(lv_color_t));
+    if (headless->buf == NULL || headless->fb == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate %ux%u buffers", config->hor_res, config->ver_res);
+        free(headless->buf);
+        free(headless->fb);
+        free(headless);
+        return NULL;
+    }
+
+    lv_disp_draw_buf_init(&headless->draw_buf, headless->buf, NULL, buf_px);
+    lv_disp_drv_init(&headless->drv);
+    headless->drv.hor_res = config->hor_res;
+    headless->drv.ver_res = config->ver_res;
+    headless->drv.draw_buf = &headless->draw_buf;
+    headless->drv.flush_cb = lv_headless_flush_cb;
+    headless->drv.user_data = headless;
+    headless->disp = lv_disp_drv_register(&headless->drv);
+    if (headless->disp == NULL) {
+        ESP_LOGE(TAG, "Failed to register the display");
+        free(headless->buf);
+        free(headless->fb);
+        free(headless);
+        return NULL;
+    }
+    lv_disp_set_default(headless->disp);
+    return headless;
+}
+
+void lv_headless_render(lv_headless_t *headless, bool full, lv_headless_frame_t *frame)
+{
+    if (headless == NULL) {
+        return;
+    }
+    memset(&headless->frame, 0, sizeof(headless->frame));
+    if (full) {
+        lv_obj_invalidate(lv_disp_get_scr_act(headless->disp));
+    }
+
+    uint64_t start = lv_headless_now_us();
+    lv_refr_now(headless->disp);
+    headless->frame.render_us = (uint32_t)(lv_headless_now_us() - start);
+
+    if (frame) {
+        *frame = headless->frame;
+    }
+}
+
+esp_err_t lv_headless_dump_ppm(lv_headless_t *headless, const char *path)
+{
+    if (headless == NULL || path == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    uint16_t w = headless->config.hor_res;
+    uint16_t h = headless->config.ver_res;
+
+    uint8_t *row = (uint8_t*)malloc((size_t)w * 3);
+    if (row == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) {
+        ESP_LOGE(TAG, "Cannot open %s", path);
+        free(row);
+        return ESP_FAIL;
+    }
+
+    esp_err_t err = ESP_OK;
+    fprintf(f, "P6\n%u %u\n255\n", w, h);
+    for (uint32_t y = 0; y < h && err == ESP_OK; y++) {
+        const lv_color_t *src = &headless->fb[y * w];
+        for (uint32_t x = 0; x < w; x++) {
+            lv_headless_pixel_rgb(src[x], &row[x * 3]);
+        }
+        if (fwrite(row, 3, w, f) != w) {
+            err = ESP_FAIL;
+        }
+    }
+    if (fclose(f) != 0) {
+        err = ESP_FAIL;
+    }
+    free(row);
+    return err;
+}
+
+esp_err_t lv_headless_compare_ppm(lv_headless_t *headless, const char *path, uint8_t tolerance, uint32_t *diff_px)
+{
+    if (headless == NULL || path == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (diff_px) {
+        *diff_px = 0;
+    }
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    uint16_t w = headless->config.hor_res;
+    uint16_t h = headless->config.ver_res;
+    unsigned file_w = 0, file_h = 0, max_val = 0;
+    // A single whitespace byte separates the header from the pixels
+    if (fscanf(f, "P6 %u %u %u", &file_w, &file_h, &max_val) != 3 || fgetc(f) == EOF ||
+        file_w != w || file_h != h || max_val != 255) {
+        fclose(f);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    uint8_t *row = (uint8_t*)malloc((size_t)w * 3);
+    if (row == NULL) {
+        fclose(f);
+        return ESP_ERR_NO_MEM;
+    }
+
+    esp_err_t err = ESP_OK;
+    uint32_t diff = 0;
+    for (uint32_t y = 0; y < h; y++) {
+        if (fread(row, 3, w, f) != w) {
+            err = ESP_ERR_INVALID_SIZE;
+            break;
+        }
+        const lv_color_t *src = &headless->fb[y * w];
+        for (uint32_t x = 0; x < w; x++) {
+            uint8_t rgb[3];
+            lv_headless_pixel_rgb(src[x], rgb);
+            for (int c = 0; c < 3; c++) {
+                if (abs((int)rgb[c] - (int)row[x * 3 + c]) > tolerance) {
+                    diff++;
+                    break;
+                }
+            }
+        }
+    }
+    fclose(f);
+    free(row);
+
+    if (diff_px) {
+        *diff_px = diff;
+    }
+    if (err == ESP_OK && diff > 0) {
+        err = ESP_FAIL;
+    }
+    return err;
+}
@@ -0,0 +1,100 @@
+
+#ifndef _LV_PARALLEL_H
+#define _LV_PARALLEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "lvgl.h"
+
+
+#define LV_PARALLEL_MAX_WORKERS 3
+#define LV_PARALLEL_MIN_ROWS    4       // Smallest band height worth a worker
+
+#define LV_PARALLEL_DEFAULT_CONFIG() {  \
+    .workers = 1,                       \
+    .min_px = 8192,                     \
+    .first_core = 1,                    \
+    .priority = 5,                      \
+    .stack_size = 4096,                 \
+}
+
+
+typedef struct {
+    uint8_t workers;            // Threads besides the LVGL task, which renders one band itself (1 on the P4)
+    uint32_t min_px;            // Smaller blends stay on the LVGL task: waking a worker costs more
+    uint8_t first_core;         // Workers are pinned from this core on, round-robin (ESP only)
+    uint8_t priority;           // Worker priority (ESP only)
+    uint32_t stack_size;        // Worker stack size (ESP only)
+} lv_parallel_config_t;
+
+typedef struct {
+    uint32_t blends;            // Blend calls seen
+    uint32_t parallel_blends;   // Blend calls split into bands
+    uint64_t parallel_px;
+    uint64_t serial_px;
+} lv_parallel_stats_t;
+
+typedef struct lv_parallel lv_parallel_t;
+
+// One band: a copy of the draw context whose clip area is the band
+typedef struct {
+    lv_parallel_t *parallel;
+    lv_draw_sw_ctx_t ctx;
+    lv_area_t clip;
+    const lv_draw_sw_blend_dsc_t *dsc;
+    pthread_t thread;
+} lv_parallel_worker_t;
+
+struct lv_parallel {
+    lv_parallel_config_t config;
+    lv_draw_sw_ctx_t *sw_ctx;
+    void (*blend)(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc);   // Wrapped blend
+    bool enabled;
+    uint8_t active;             // Workers used, at most config.workers
+
+    pthread_mutex_t lock;
+    pthread_cond_t start_cond;
+    pthread_cond_t done_cond;
+    uint32_t generation;        // Bumped for each split blend
+    uint8_t helpers;            // Workers with a band in the current blend
+    uint8_t pending;            // Worker bands not finished yet
+
+    lv_parallel_worker_t workers[LV_PARALLEL_MAX_WORKERS];
+    lv_parallel_stats_t stats;
+};
+
+
+/**
+ * @brief Start the workers and wrap the blend of a display (one per application, call with the LVGL lock held)
+ * The wrapped blend must only write inside draw_ctx->clip_area, as LVGL's software blend does.
+ * Objects are still drawn one at a time: only the pixel blending of large areas
+ * (fills, image copies, masked blends) is split into horizontal bands.
+ * @param disp Display whose draw context is wrapped, NULL for the default one
+ * @param config Configuration pointer
+ * @return lv_parallel_t* Returns a pointer to the instance on success, NULL on failure
+ */
+lv_parallel_t* lv_parallel_create(lv_disp_t *disp, const lv_parallel_config_t *config);
+
+/**
+ * @brief Split blends into bands or render everything on the LVGL task again (call with the LVGL lock held)
+ * @param parallel Instance pointer
+ * @param enable True to split
+ */
+void lv_parallel_enable(lv_parallel_t *parallel, bool enable);
+
+/**
+ * @brief Use fewer workers than created, e.g. to measure scaling (call with the LVGL lock held)
+ * @param parallel Instance pointer
+ * @param workers Workers used, 0 renders on the LVGL task only
+ */
+void lv_parallel_set_workers(lv_parallel_t *parallel, uint8_t workers);
+
+/**
+ * @brief Copy the counters
+ * @param parallel Instance pointer
+ * @param stats Stats output pointer
+ */
+void lv_parallel_get_stats(lv_parallel_t *parallel, lv_parallel_stats_t *stats);
+
+#endif // _LV_PARALLEL_H
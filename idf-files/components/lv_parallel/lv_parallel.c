@@ -0,0 +1,222 @@
+#include "lv_parallel.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <sdkconfig.h>
+#include <esp_log.h>
+#if !CONFIG_IDF_TARGET_LINUX
+#include <esp_pthread.h>
+#endif
+
+#define TAG "LvParallel"
+
+static lv_parallel_t *s_parallel = NULL;    // The blend hook has no user data to find its instance
+
+// ---------------------- Internal implementation functions ----------------------
+
+static void lv_parallel_run_band(lv_parallel_worker_t *worker)
+{
+    lv_parallel_t *parallel = worker->parallel;
+    parallel->blend((lv_draw_ctx_t*)&worker->ctx, worker->dsc);
+}
+
+static void* lv_parallel_worker(void *arg)
+{
+    lv_parallel_worker_t *worker = (lv_parallel_worker_t*)arg;
+    lv_parallel_t *parallel = worker->parallel;
+    uint8_t index = (uint8_t)(worker - parallel->workers);
+    uint32_t seen = 0;
+
+    // Workers live as long as the display
+    pthread_mutex_lock(&parallel->lock);
+    while (1) {
+        // Skip the blends this worker has no band in
+        while (parallel->generation == seen || index >= parallel->helpers) {
+            seen = parallel->generation;
+            pthread_cond_wait(&parallel->start_cond, &parallel->lock);
+        }
+        seen = parallel->generation;
+        pthread_mutex_unlock(&parallel->lock);
+
+        lv_parallel_run_band(worker);
+
+        pthread_mutex_lock(&parallel->lock);
+        if (--parallel->pending == 0) {
+            pthread_cond_signal(&parallel->done_cond);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Replaces the software blend: large blends are cut into one band per worker plus one for the caller
+ * Each band reuses the blend descriptor unchanged, only the clip area of its draw context copy
+ * differs, so the bands write disjoint rows of the draw buffer.
+ */
+static void lv_parallel_blend(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc)
+{
+    lv_parallel_t *parallel = s_parallel;
+    parallel->stats.blends++;
+
+    lv_area_t area;
+    if (!_lv_area_intersect(&area, dsc->blend_area, draw_ctx->clip_area)) {
+        return;
+    }
+
+    uint32_t px = lv_area_get_size(&area);
+    lv_coord_t rows = lv_area_get_height(&area);
+    uint8_t bands = parallel->active + 1;
+    if (rows / bands < LV_PARALLEL_MIN_ROWS) {
+        bands = (uint8_t)LV_MAX(1, rows / LV_PARALLEL_MIN_ROWS);
+    }
+    lv_disp_t *disp = _lv_refr_get_disp_refreshing();
+    if (!parallel->enabled || bands < 2 || px < parallel->config.min_px ||
+        (disp && disp->driver->set_px_cb)) {
+        // set_px_cb draws pixel by pixel through user code that may not be reentrant
+        parallel->stats.serial_px += px;
+        parallel->blend(draw_ctx, dsc);
+        return;
+    }
+
+    // Band 0 is the caller's, band i + 1 is worker i's
+    lv_parallel_worker_t own;
+    lv_coord_t y = area.y1;
+    for (uint8_t i = 0; i < bands; i++) {
+        lv_parallel_worker_t *worker = i == 0 ? &own : &parallel->workers[i - 1];
+        lv_coord_t band_rows = rows / bands + (i < rows % bands ? 1 : 0);
+        worker->parallel = parallel;
+        worker->ctx = *(lv_draw_sw_ctx_t*)draw_ctx;
+        worker->clip = area;
+        worker->clip.y1 = y;
+        worker->clip.y2 = y + band_rows - 1;
+        worker->ctx.base_draw.clip_area = &worker->clip;
+        worker->dsc = dsc;
+        y += band_rows;
+    }
+
+    pthread_mutex_lock(&parallel->lock);
+    parallel->helpers = bands - 1;
+    parallel->pending = bands - 1;
+    parallel->generation++;
+    pthread_cond_broadcast(&parallel->start_cond);
+    pthread_mutex_unlock(&parallel->lock);
+
+    lv_parallel_run_band(&own);
+
+    pthread_mutex_lock(&parallel->lock);
+    while (parallel->pending) {
+        pthread_cond_wait(&parallel->done_cond, &parallel->lock);
+    }
+    pthread_mutex_unlock(&parallel->lock);
+
+    parallel->stats.parallel_blends++;
+    parallel->stats.parallel_px += px;
+}
+
+static bool lv_parallel_start_worker(lv_parallel_t *parallel, uint8_t index)
+{
+    lv_parallel_worker_t *worker = &parallel->workers[index];
+    worker->parallel = parallel;
+
+#if !CONFIG_IDF_TARGET_LINUX
+    // Threads created from here on take this configuration
+    esp_pthread_cfg_t cfg = esp_pthread_get_default_config();
+    cfg.stack_size = parallel->config.stack_size;
+    cfg.prio = parallel->config.priority;
+    cfg.pin_to_core = (parallel->config.first_core + index) % portNUM_PROCESSORS;
+    cfg.thread_name = "lv_band";
+    esp_pthread_set_cfg(&cfg);
+#endif
+    int ret = pthread_create(&worker->thread, NULL, lv_parallel_worker, worker);
+#if !CONFIG_IDF_TARGET_LINUX
+    cfg = esp_pthread_get_default_config();
+    esp_pthread_set_cfg(&cfg);
+#endif
+    if (ret != 0) {
+        ESP_LOGE(TAG, "Failed to start worker %u (%d)", index, ret);
+        return false;
+    }
+    return true;
+}
+
+// ---------------------- External API functions ----------------------
+
+lv_parallel_t* lv_parallel_create(lv_disp_t *disp, const lv_parallel_config_t *config)
+{
+    if (config == NULL || config->workers == 0 || config->workers > LV_PARALLEL_MAX_WORKERS) {
+        ESP_LOGE(TAG, "Invalid config");
+        return NULL;
+    }
+    if (s_parallel) {
+        ESP_LOGE(TAG, "Already created");
+        return NULL;
+    }
+    if (disp == NULL) {
+        disp = lv_disp_get_default();
+    }
+    if (disp == NULL || disp->driver->draw_ctx == NULL) {
+        ESP_LOGE(TAG, "No display to render");
+        return NULL;
+    }
+    lv_draw_sw_ctx_t *sw_ctx = (lv_draw_sw_ctx_t*)disp->driver->draw_ctx;
+    if (sw_ctx->blend == NULL) {
+        ESP_LOGE(TAG, "The display does not use the software renderer");
+        return NULL;
+    }
+
+    lv_parallel_t *parallel = (lv_parallel_t*)calloc(1, sizeof(lv_parallel_t));
+    if (parallel == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate lv_parallel_t");
+        return NULL;
+    }
+    parallel->config = *config;
+    pthread_mutex_init(&parallel->lock, NULL);
+    pthread_cond_init(&parallel->start_cond, NULL);
+    pthread_cond_init(&parallel->done_cond, NULL);
+
+    uint8_t started = 0;
+    while (started < config->workers && lv_parallel_start_worker(parallel, started)) {
+        started++;
+    }
+    if (started == 0) {
+        pthread_cond_destroy(&parallel->done_cond);
+        pthread_cond_destroy(&parallel->start_cond);
+        pthread_mutex_destroy(&parallel->lock);
+        free(parallel);
+        return NULL;
+    }
+    parallel->config.workers = started;
+    parallel->active = started;
+
+    parallel->sw_ctx = sw_ctx;
+    parallel->blend = sw_ctx->blend;
+    s_parallel = parallel;
+    lv_parallel_enable(parallel, true);
+    ESP_LOGI(TAG, "%u band(s) per large blend, at least %lu px", started + 1, (unsigned long)config->min_px);
+    return parallel;
+}
+
+void lv_parallel_enable(lv_parallel_t *parallel, bool enable)
+{
+    if (parallel == NULL) {
+        return;
+    }
+    parallel->enabled = enable;
+    parallel->sw_ctx->blend = enable ? lv_parallel_blend : parallel->blend;
+}
+
+void lv_parallel_set_workers(lv_parallel_t *parallel, uint8_t workers)
+{
+    if (parallel == NULL) {
+        return;
+    }
+    parallel->active = LV_MIN(workers, parallel->config.workers);
+}
+
+void lv_parallel_get_stats(lv_parallel_t *parallel, lv_parallel_stats_t *stats)
+{
+    if (parallel == NULL || stats == NULL) {
+        return;
+    }
+    *stats = parallel->stats;
+}
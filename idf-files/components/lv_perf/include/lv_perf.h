@@ -0,0 +1,130 @@
+
+#ifndef _LV_PERF_H
+#define _LV_PERF_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lvgl.h"
+
+
+#define LV_PERF_DEFAULT_CONFIG() {  \
+    .disp = NULL,                   \
+    .period_ms = 1000,              \
+    .log = true,                    \
+    .overlay = false,               \
+}
+
+
+typedef struct {
+    lv_disp_t *disp;            // Display to measure, NULL for the default one
+    uint32_t period_ms;         // Statistics window, also the log and overlay period
+    bool log;                   // Log one line per window
+    bool overlay;               // Show the statistics in the top-right corner
+} lv_perf_config_t;
+
+// One rendered frame
+typedef struct {
+    uint32_t frame_us;          // Whole refresh: layout, drawing and flushing
+    uint32_t render_us;         // frame_us minus flush_submit_us, including waits for a band still in transfer
+    uint32_t flush_submit_us;   // Time spent in the display driver's flush_cb: starting the transfers, not completing them
+    uint32_t area_px;           // Invalidated pixels redrawn
+    uint16_t dirty_rects;       // Invalidated areas after LVGL joined them
+    uint16_t flushes;           // flush_cb calls (areas split into draw buffer bands)
+} lv_perf_frame_t;
+
+// Statistics of the last complete window
+typedef struct {
+    uint32_t frames;
+    float fps;
+    uint32_t render_us_avg;
+    uint32_t render_us_max;
+    uint32_t flush_submit_us_avg;
+    uint32_t flush_submit_us_max;
+    uint32_t area_px_avg;
+    uint32_t area_px_max;
+    uint32_t dirty_rects_avg;
+    uint32_t dirty_rects_max;
+    uint32_t total_frames;      // Since lv_perf_reset()
+} lv_perf_stats_t;
+
+// Running window sums
+typedef struct {
+    uint32_t frames;
+    uint64_t render_us;
+    uint64_t flush_submit_us;
+    uint64_t area_px;
+    uint32_t dirty_rects;
+    uint32_t render_us_max;
+    uint32_t flush_submit_us_max;
+    uint32_t area_px_max;
+    uint32_t dirty_rects_max;
+} lv_perf_window_t;
+
+typedef struct {
+    lv_perf_config_t config;
+    lv_disp_t *disp;
+    bool enabled;
+
+    // Driver callbacks wrapped while enabled, restored when disabled
+    void (*flush_cb)(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p);
+    void (*monitor_cb)(lv_disp_drv_t *drv, uint32_t time_ms, uint32_t px);
+    lv_timer_cb_t refr_cb;
+
+    lv_perf_frame_t frame;      // Frame being rendered
+    int64_t frame_start_us;     // 0 when the refresh did not go through the display timer
+    lv_perf_frame_t last;
+    lv_perf_window_t window;
+    int64_t window_start_us;
+    lv_perf_stats_t stats;
+    uint32_t total_frames;
+
+    lv_timer_t *timer;          // Closes the window, logs, updates the overlay
+    lv_obj_t *overlay;
+} lv_perf_t;
+
+
+/**
+ * @brief Create the frame instrumentation of a display (one per application, call with the LVGL lock held)
+ * It starts disabled: the display driver is untouched until lv_perf_enable().
+ * @param config Configuration pointer
+ * @return lv_perf_t* Returns a pointer to the instance on success, NULL on failure
+ */
+lv_perf_t* lv_perf_create(const lv_perf_config_t *config);
+
+/**
+ * @brief Start or stop measuring (call with the LVGL lock held)
+ * @param perf Instance pointer
+ * @param enable True to wrap the driver callbacks, false to restore them
+ */
+void lv_perf_enable(lv_perf_t *perf, bool enable);
+
+/**
+ * @brief Show or hide the corner overlay (call with the LVGL lock held)
+ * Its own redraws are part of the measurement: a few hundred pixels once per window.
+ * @param perf Instance pointer
+ * @param show True to show it
+ */
+void lv_perf_show_overlay(lv_perf_t *perf, bool show);
+
+/**
+ * @brief Copy the statistics of the last complete window
+ * @param perf Instance pointer
+ * @param stats Stats output pointer
+ */
+void lv_perf_get_stats(lv_perf_t *perf, lv_perf_stats_t *stats);
+
+/**
+ * @brief Copy the last rendered frame
+ * @param perf Instance pointer
+ * @param frame Frame output pointer
+ * @return bool Returns false when no frame was measured yet
+ */
+bool lv_perf_get_last_frame(lv_perf_t *perf, lv_perf_frame_t *frame);
+
+/**
+ * @brief Clear the window, the last frame and the frame counter (call with the LVGL lock held)
+ * @param perf Instance pointer
+ */
+void lv_perf_reset(lv_perf_t *perf);
+
+#endif // _LV_PERF_H
@@ -0,0 +1,269 @@
+#include "lv_perf.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <esp_log.h>
+#include <esp_timer.h>
+#include "trace_evt.h"
+
+#define TAG "LvPerf"
+
+// Driver callbacks carry no context of ours (esp_lvgl_port owns drv->user_data)
+static lv_perf_t *s_perf = NULL;
+
+// ---------------------- Internal implementation functions ----------------------
+
+/**
+ * @brief flush_cb wrapper: time the driver's flush_cb and count the dirty areas once per frame
+ *
+ * The driver only starts the transfer: lv_disp_flush_ready() comes later from its
+ * completion callback, so this is the submission time, not the time to the panel.
+ */
+static void lv_perf_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    lv_perf_t *perf = s_perf;
+
+    if (perf->frame.flushes == 0) {
+        // The joined areas are still listed while the first band is flushed
+        lv_disp_t *disp = perf->disp;
+        uint16_t rects = 0;
+        for (uint16_t i = 0; i < disp->inv_p; i++) {
+            if (!disp->inv_area_joined[i]) {
+                rects++;
+            }
+        }
+        perf->frame.dirty_rects = rects;
+    }
+
+    int64_t start = esp_timer_get_time();
+    TRACE_BEGIN("lvgl", "flush");
+    perf->flush_cb(drv, area, color_p);
+    TRACE_END("lvgl", "flush");
+    perf->frame.flush_submit_us += (uint32_t)(esp_timer_get_time() - start);
+    perf->frame.flushes++;
+}
+
+/**
+ * @brief monitor_cb wrapper: LVGL calls it at the end of every frame that drew something
+ */
+static void lv_perf_monitor_cb(lv_disp_drv_t *drv, uint32_t time_ms, uint32_t px)
+{
+    lv_perf_t *perf = s_perf;
+    lv_perf_frame_t *frame = &perf->frame;
+
+    // lv_refr_now() bypasses the display timer: fall back to LVGL's tick resolution
+    frame->frame_us = perf->frame_start_us ? (uint32_t)(esp_timer_get_time() - perf->frame_start_us) : time_ms * 1000;
+    frame->render_us = frame->frame_us > frame->flush_submit_us ? frame->frame_us - frame->flush_submit_us : 0;
+    frame->area_px = px;
+    TRACE_COUNTER("lvgl", "area_px", (int32_t)px);
+
+    lv_perf_window_t *window = &perf->window;
+    window->frames++;
+    window->render_us += frame->render_us;
+    window->flush_submit_us += frame->flush_submit_us;
+    window->area_px += frame->area_px;
+    window->dirty_rects += frame->dirty_rects;
+    if (frame->render_us > window->render_us_max) window->render_us_max = frame->render_us;
+    if (frame->flush_submit_us > window->flush_submit_us_max) window->flush_submit_us_max = frame->flush_submit_us;
+    if (frame->area_px > window->area_px_max) window->area_px_max = frame->area_px;
+    if (frame->dirty_rects > window->dirty_rects_max) window->dirty_rects_max = frame->dirty_rects;
+
+    perf->last = *frame;
+    perf->total_frames++;
+    memset(frame, 0, sizeof(*frame));
+
+    if (perf->monitor_cb) {
+        perf->monitor_cb(drv, time_ms, px);
+    }
+}
+
+/**
+ * @brief Display refresh timer wrapper: marks the start of a frame
+ */
+static void lv_perf_refr_cb(lv_timer_t *timer)
+{
+    lv_perf_t *perf = s_perf;
+
+    perf->frame_start_us = esp_timer_get_time();
+    TRACE_BEGIN("lvgl", "refresh");
+    perf->refr_cb(timer);
+    TRACE_END("lvgl", "refresh");
+    perf->frame_start_us = 0;
+    memset(&perf->frame, 0, sizeof(perf->frame));   // Nothing was invalidated
+}
+
+/**
+ * @brief Close the statistics window, then log and show it
+ */
+static void lv_perf_timer_cb(lv_timer_t *timer)
+{
+    lv_perf_t *perf = (lv_perf_t*)timer->user_data;
+    lv_perf_window_t *window = &perf->window;
+    lv_perf_stats_t *stats = &perf->stats;
+    int64_t now = esp_timer_get_time();
+    int64_t elapsed_us = now - perf->window_start_us;
+    uint32_t frames = window->frames;
+
+    memset(stats, 0, sizeof(*stats));
+    stats->frames = frames;
+    stats->fps = elapsed_us > 0 ? frames * 1000000.0f / elapsed_us : 0.0f;
+    if (frames) {
+        stats->render_us_avg = (uint32_t)(window->render_us / frames);
+        stats->flush_submit_us_avg = (uint32_t)(window->flush_submit_us / frames);
+        stats->area_px_avg = (uint32_t)(window->area_px / frames);
+        stats->dirty_rects_avg = window->dirty_rects / frames;
+    }
+    stats->render_us_max = window->render_us_max;
+    stats->flush_submit_us_max = window->flush_submit_us_max;
+    stats->area_px_max = window->area_px_max;
+    stats->dirty_rects_max = window->dirty_rects_max;
+    stats->total_frames = perf->total_frames;
+
+    memset(window, 0, sizeof(*window));
+    perf->window_start_us = now;
+
+    if (perf->config.log) {
+        // avg/max pairs, one line per window
+        ESP_LOGI(TAG, "fps=%.1f frames=%lu render_us=%lu/%lu flush_submit_us=%lu/%lu area_px=%lu/%lu rects=%lu/%lu",
+                 stats->fps, (unsigned long)frames,
+                 (unsigned long)stats->render_us_avg, (unsigned long)stats->render_us_max,
+                 (unsigned long)stats->flush_submit_us_avg, (unsigned long)stats->flush_submit_us_max,
+                 (unsigned long)stats->area_px_avg, (unsigned long)stats->area_px_max,
+                 (unsigned long)stats->dirty_rects_avg, (unsigned long)stats->dirty_rects_max);
+    }
+    if (perf->overlay && !lv_obj_has_flag(perf->overlay, LV_OBJ_FLAG_HIDDEN)) {
+        // snprintf: lv_snprintf() has no float support by default
+        char text[96];
+        snprintf(text, sizeof(text), "%.1f FPS\nrender %lu us\nsubmit %lu us\n%lu px / %lu rects",
+                 stats->fps, (unsigned long)stats->render_us_avg, (unsigned long)stats->flush_submit_us_avg,
+                 (unsigned long)stats->area_px_avg, (unsigned long)stats->dirty_rects_avg);
+        lv_label_set_text(perf->overlay, text);
+    }
+}
+
+// ---------------------- External API functions ----------------------
+
+lv_perf_t* lv_perf_create(const lv_perf_config_t *config)
+{
+    if (config == NULL || config->period_ms == 0) {
+        ESP_LOGE(TAG, "Invalid configuration");
+        return NULL;
+    }
+    if (s_perf != NULL) {
+        ESP_LOGE(TAG, "Already created");
+        return NULL;
+    }
+    lv_disp_t *disp = config->disp ? config->disp : lv_disp_get_default();
+    if (disp == NULL || disp->refr_timer == NULL) {
+        ESP_LOGE(TAG, "No display to measure");
+        return NULL;
+    }
+
+    lv_perf_t *perf = (lv_perf_t*)calloc(1, sizeof(lv_perf_t));
+    if (perf == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate lv_perf_t");
+        return NULL;
+    }
+    perf->config = *config;
+    perf->disp = disp;
+
+    perf->timer = lv_timer_create(lv_perf_timer_cb, config->period_ms, perf);
+    if (perf->timer == NULL) {
+        ESP_LOGE(TAG, "Failed to create the statistics timer");
+        free(perf);
+        return NULL;
+    }
+    lv_timer_pause(perf->timer);
+    s_perf = perf;
+
+    if (config->overlay) {
+        lv_perf_show_overlay(perf, true);
+    }
+    return perf;
+}
+
+void lv_perf_enable(lv_perf_t *perf, bool enable)
+{
+    if (perf == NULL || perf->enabled == enable) {
+        return;
+    }
+    lv_disp_drv_t *drv = perf->disp->driver;
+    lv_timer_t *refr_timer = perf->disp->refr_timer;
+
+    if (enable) {
+        perf->flush_cb = drv->flush_cb;
+        perf->monitor_cb = drv->monitor_cb;
+        perf->refr_cb = refr_timer->timer_cb;
+        memset(&perf->frame, 0, sizeof(perf->frame));
+        memset(&perf->window, 0, sizeof(perf->window));
+        perf->window_start_us = esp_timer_get_time();
+
+        drv->flush_cb = lv_perf_flush_cb;
+        drv->monitor_cb = lv_perf_monitor_cb;
+        lv_timer_set_cb(refr_timer, lv_perf_refr_cb);
+        lv_timer_resume(perf->timer);
+    } else {
+        // Disabled means the original driver again: no per-frame cost at all
+        drv->flush_cb = perf->flush_cb;
+        drv->monitor_cb = perf->monitor_cb;
+        lv_timer_set_cb(refr_timer, perf->refr_cb);
+        lv_timer_pause(perf->timer);
+    }
+    perf->enabled = enable;
+}
+
+void lv_perf_show_overlay(lv_perf_t *perf, bool show)
+{
+    if (perf == NULL) {
+        return;
+    }
+    if (perf->overlay == NULL) {
+        if (!show) {
+            return;
+        }
+        // On the top layer, above every screen
+        perf->overlay = lv_label_create(lv_disp_get_layer_top(perf->disp));
+        lv_obj_set_style_text_font(perf->overlay, &lv_font_montserrat_14, 0);
+        lv_obj_set_style_text_color(perf->overlay, lv_color_hex(0xFFFFFF), 0);
+        lv_obj_set_style_bg_color(perf->overlay, lv_color_hex(0x000000), 0);
+        lv_obj_set_style_bg_opa(perf->overlay, LV_OPA_60, 0);
+        lv_obj_set_style_pad_all(perf->overlay, 6, 0);
+        lv_obj_align(perf->overlay, LV_ALIGN_TOP_RIGHT, -4, 4);
+        lv_label_set_text(perf->overlay, "-- FPS");
+    }
+    if (show) {
+        lv_obj_clear_flag(perf->overlay, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_add_flag(perf->overlay, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+void lv_perf_get_stats(lv_perf_t *perf, lv_perf_stats_t *stats)
+{
+    if (perf == NULL || stats == NULL) {
+        return;
+    }
+    *stats = perf->stats;
+}
+
+bool lv_perf_get_last_frame(lv_perf_t *perf, lv_perf_frame_t *frame)
+{
+    if (perf == NULL || frame == NULL || perf->total_frames == 0) {
+        return false;
+    }
+    *frame = perf->last;
+    return true;
+}
+
+void lv_perf_reset(lv_perf_t *perf)
+{
+    if (perf == NULL) {
+        return;
+    }
+    memset(&perf->window, 0, sizeof(perf->window));
+    memset(&perf->last, 0, sizeof(perf->last));
+    memset(&perf->stats, 0, sizeof(perf->stats));
+    perf->total_frames = 0;
+    perf->window_start_us = esp_timer_get_time();
+}
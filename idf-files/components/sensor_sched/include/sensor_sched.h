@@ -0,0 +1,148 @@
+
+#ifndef _SENSOR_SCHED_H
+#define _SENSOR_SCHED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <esp_err.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+#include <freertos/semphr.h>
+
+
+#define SENSOR_SCHED_MAX_SENSORS    16
+#define SENSOR_SCHED_MAX_VALUES     4       // Values per reading (e.g. temperature and humidity)
+
+#define SENSOR_SCHED_DEFAULT_CONFIG() {         \
+    .stack_size = 4096,                         \
+    .priority = configMAX_PRIORITIES - 5,       \
+}
+
+
+// One sample of a sensor
+typedef struct {
+    esp_err_t err;                          // ESP_OK, or the error of the start or read step
+    uint8_t count;                          // Valid entries of values[]
+    float values[SENSOR_SCHED_MAX_VALUES];
+    int64_t timestamp_us;                   // When the read step finished
+} sensor_reading_t;
+
+// Sensor driver: timing requirements and the steps of one sample.
+// Every step runs in the scheduler task, one at a time: keep them short.
+typedef struct {
+    const char *name;
+    uint32_t period_ms;         // Sample period, also the rate-monotonic priority (shorter first)
+    uint32_t deadline_ms;       // From the release to the end of the read step, 0: the period
+    uint32_t convert_ms;        // Time between start() and read(), other sensors run meanwhile
+    esp_err_t (*init)(void *ctx);                               // Optional, once in the scheduler task
+    esp_err_t (*start)(void *ctx);                              // Optional, e.g. trigger a conversion
+    esp_err_t (*read)(void *ctx, sensor_reading_t *reading);    // Fill values[] and count
+} sensor_driver_t;
+
+typedef struct sensor_sched sensor_sched_t;
+
+// Called in the scheduler task after every sample, also the failed ones
+typedef void (*sensor_sched_cb_t)(const sensor_driver_t *driver, const sensor_reading_t *reading, void *arg);
+
+typedef struct {
+    uint32_t stack_size;        // Scheduler task, shared by every driver and callback
+    UBaseType_t priority;
+} sensor_sched_config_t;
+
+typedef struct {
+    uint32_t samples;           // Completed samples, any result
+    uint32_t errors;
+    uint32_t overruns;          // Samples that finished after their deadline
+    uint32_t skipped;           // Releases dropped because the previous sample was a whole period late
+    uint32_t jitter_us_max;     // Release to the start of the sample
+    uint64_t jitter_us_total;
+    uint32_t response_us_max;   // Release to the end of the read step
+    uint32_t exec_us_max;       // Time in start() and read(), the conversion excluded
+} sensor_sched_stats_t;
+
+typedef enum {
+    SENSOR_SCHED_IDLE = 0,      // Waiting for the next release
+    SENSOR_SCHED_CONVERTING,    // Started, read() is due at read_us
+    SENSOR_SCHED_DISABLED,      // init() failed
+} sensor_sched_state_t;
+
+typedef struct {
+    const sensor_driver_t *driver;
+    void *ctx;
+    sensor_sched_cb_t on_reading;
+    void *arg;
+    sensor_sched_state_t state;
+    int64_t release_us;         // Release of the sample in progress
+    int64_t next_release_us;    // Absolute: the period is added to the last release, never to "now"
+    int64_t read_us;
+    uint32_t exec_us;           // Sample in progress
+    sensor_sched_stats_t stats;
+} sensor_sched_sensor_t;
+
+struct sensor_sched {
+    sensor_sched_config_t config;
+    sensor_sched_sensor_t sensors[SENSOR_SCHED_MAX_SENSORS];    // In registration order
+    uint8_t order[SENSOR_SCHED_MAX_SENSORS];                    // Indexes, highest priority first
+    uint8_t count;
+    bool running;
+    EventGroupHandle_t events;
+    SemaphoreHandle_t lock;     // Guards the stats
+};
+
+
+/**
+ * @brief Create a scheduler without sensors
+ * @param config Configuration pointer
+ * @return sensor_sched_t* Returns a pointer to the instance on success, NULL on failure
+ */
+sensor_sched_t* sensor_sched_create(const sensor_sched_config_t *config);
+
+/**
+ * @brief Register a sensor (before sensor_sched_start())
+ * @param sched Instance pointer
+ * @param driver Driver description, not copied: it must outlive the scheduler
+ * @param ctx Driver instance, passed to its steps
+ * @param on_reading Optional callback
+ * @param arg Passed to on_reading
+ * @return int Returns the sensor index, -1 on failure
+ */
+int sensor_sched_add(sensor_sched_t *sched, const sensor_driver_t *driver, void *ctx,
+                     sensor_sched_cb_t on_reading, void *arg);
+
+/**
+ * @brief Look up a registered sensor by driver name
+ * @param sched Instance pointer
+ * @param name Driver name
+ * @return int Returns the sensor index, -1 when not found
+ */
+int sensor_sched_find(sensor_sched_t *sched, const char *name);
+
+/**
+ * @brief Start the scheduler task: every sensor is released at once, then on its period
+ * @param sched Instance pointer
+ * @return esp_err_t ESP_OK, ESP_ERR_INVALID_STATE when already running, ESP_ERR_NO_MEM
+ */
+esp_err_t sensor_sched_start(sensor_sched_t *sched);
+
+/**
+ * @brief Stop the scheduler task and wait for it to exit (not from a callback)
+ * @param sched Instance pointer
+ */
+void sensor_sched_stop(sensor_sched_t *sched);
+
+/**
+ * @brief Get the timing counters of a sensor
+ * @param sched Instance pointer
+ * @param index Sensor index from sensor_sched_add()
+ * @param stats Stats output pointer
+ * @return esp_err_t ESP_OK, ESP_ERR_INVALID_ARG for an unknown index
+ */
+esp_err_t sensor_sched_get_stats(sensor_sched_t *sched, int index, sensor_sched_stats_t *stats);
+
+/**
+ * @brief Log one line per sensor and the processor utilization, as key=value pairs
+ * @param sched Instance pointer
+ */
+void sensor_sched_log_stats(sensor_sched_t *sched);
+
+#endif // _SENSOR_SCHED_H
@@ -0,0 +1,57 @@
+
+#ifndef _SENSOR_SIM_H
+#define _SENSOR_SIM_H
+
+#include <stdint.h>
+#include "sensor_sched.h"
+
+
+#define SENSOR_SIM_DEFAULT_CONFIG() {   \
+    .name = "sim",                      \
+    .period_ms = 100,                   \
+    .deadline_ms = 0,                   \
+    .convert_ms = 0,                    \
+    .exec_us = 200,                     \
+    .fail_every = 0,                    \
+    .base = 20.0f,                      \
+    .step = 0.1f,                       \
+}
+
+
+typedef struct {
+    const char *name;           // Must outlive the sensor
+    uint32_t period_ms;
+    uint32_t deadline_ms;       // 0: the period
+    uint32_t convert_ms;        // 0: a read step only
+    uint32_t exec_us;           // CPU time burnt by each step, like a bus transaction
+    uint32_t fail_every;        // Every nth sample fails with ESP_FAIL, 0: never
+    float base;                 // First value
+    float step;                 // Added at every sample
+} sensor_sim_config_t;
+
+// Simulated sensor, to load the scheduler without hardware (e.g. on the linux target)
+typedef struct {
+    sensor_driver_t driver;     // Register &sim->driver with sim as the context
+    sensor_sim_config_t config;
+    uint32_t samples;           // Read steps so far
+} sensor_sim_t;
+
+
+/**
+ * @brief Create a simulated sensor
+ * @param config Configuration pointer
+ * @return sensor_sim_t* Returns a pointer to the instance on success, NULL on failure
+ */
+sensor_sim_t* sensor_sim_create(const sensor_sim_config_t *config);
+
+/**
+ * @brief Create a simulated sensor and register it
+ * @param sched Scheduler instance
+ * @param config Configuration pointer
+ * @param on_reading Optional callback
+ * @param arg Passed to on_reading
+ * @return int Returns the sensor index, -1 on failure
+ */
+int sensor_sim_add(sensor_sched_t *sched, const sensor_sim_config_t *config, sensor_sched_cb_t on_reading, void *arg);
+
+#endif // _SENSOR_SIM_H
@@ -0,0 +1,337 @@
+#include "sensor_sched.h"
+
+#include <math.h>
+#include <string.h>
+#include <stdlib.h>
+#include <sdkconfig.h>
+#include <esp_log.h>
+#include <freertos/task.h>
+#include "trace_evt.h"
+#if CONFIG_IDF_TARGET_LINUX
+#include <time.h>
+#else
+#include <esp_timer.h>
+#endif
+
+#define TAG "SensorSched"
+
+#define SENSOR_SCHED_STOP   (1UL << 0)
+#define SENSOR_SCHED_DONE   (1UL << 1)
+
+// ---------------------- Internal implementation functions ----------------------
+
+static int64_t sensor_sched_now_us(void)
+{
+#if CONFIG_IDF_TARGET_LINUX
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#else
+    return esp_timer_get_time();
+#endif
+}
+
+static uint32_t sensor_sched_deadline_us(const sensor_driver_t *driver)
+{
+    return (driver->deadline_ms ? driver->deadline_ms : driver->period_ms) * 1000;
+}
+
+/**
+ * @brief True when sensor a runs before sensor b: shorter period, then shorter deadline, then registration order
+ */
+static bool sensor_sched_before(const sensor_sched_t *sched, uint8_t a, uint8_t b)
+{
+    const sensor_driver_t *da = sched->sensors[a].driver;
+    const sensor_driver_t *db = sched->sensors[b].driver;
+    if (da->period_ms != db->period_ms) {
+        return da->period_ms < db->period_ms;
+    }
+    uint32_t deadline_a = sensor_sched_deadline_us(da);
+    uint32_t deadline_b = sensor_sched_deadline_us(db);
+    return deadline_a != deadline_b ? deadline_a < deadline_b : a < b;
+}
+
+static void sensor_sched_sort(sensor_sched_t *sched)
+{
+    for (uint8_t i = 0; i < sched->count; i++) {
+        uint8_t index = i;
+        int j = i - 1;
+        while (j >= 0 && sensor_sched_before(sched, index, sched->order[j])) {
+            sched->order[j + 1] = sched->order[j];
+            j--;
+        }
+        sched->order[j + 1] = index;
+    }
+}
+
+/**
+ * @brief End of a sample: account it and hand the reading to the callback
+ */
+static void sensor_sched_finish(sensor_sched_t *sched, sensor_sched_sensor_t *sensor, sensor_reading_t *reading, int64_t end_us)
+{
+    uint32_t response_us = (uint32_t)(end_us - sensor->release_us);
+    bool overrun = response_us > sensor_sched_deadline_us(sensor->driver);
+    if (overrun) {
+        TRACE_INSTANT("sensor", "overrun");
+    }
+
+    xSemaphoreTake(sched->lock, portMAX_DELAY);
+    sensor_sched_stats_t *stats = &sensor->stats;
+    stats->samples++;
+    if (reading->err != ESP_OK) stats->errors++;
+    if (overrun) stats->overruns++;
+    if (response_us > stats->response_us_max) stats->response_us_max = response_us;
+    if (sensor->exec_us > stats->exec_us_max) stats->exec_us_max = sensor->exec_us;
+    xSemaphoreGive(sched->lock);
+
+    sensor->state = SENSOR_SCHED_IDLE;
+    reading->timestamp_us = end_us;
+    if (sensor->on_reading) {
+        sensor->on_reading(sensor->driver, reading, sensor->arg);
+    }
+}
+
+/**
+ * @brief Run the step of a sample that is due: release and start, or read
+ */
+static void sensor_sched_run(sensor_sched_t *sched, sensor_sched_sensor_t *sensor, int64_t now_us)
+{
+    const sensor_driver_t *driver = sensor->driver;
+    sensor_reading_t reading = {0};
+    int64_t end_us;
+
+    if (sensor->state == SENSOR_SCHED_IDLE) {
+        // The next release stays on the grid of the first one, however late this one runs
+        int64_t period_us = (int64_t)driver->period_ms * 1000;
+        uint32_t skipped = 0;
+        sensor->release_us = sensor->next_release_us;
+        sensor->next_release_us += period_us;
+        if (sensor->next_release_us <= now_us) {
+            skipped = (uint32_t)((now_us - sensor->next_release_us) / period_us) + 1;
+            sensor->next_release_us += skipped * period_us;
+        }
+        uint32_t jitter_us = (uint32_t)(now_us - sensor->release_us);
+
+        xSemaphoreTake(sched->lock, portMAX_DELAY);
+        sensor->stats.skipped += skipped;
+        sensor->stats.jitter_us_total += jitter_us;
+        if (jitter_us > sensor->stats.jitter_us_max) sensor->stats.jitter_us_max = jitter_us;
+        xSemaphoreGive(sched->lock);
+
+        sensor->exec_us = 0;
+        if (driver->start) {
+            TRACE_BEGIN("sensor", driver->name);
+            reading.err = driver->start(sensor->ctx);
+            TRACE_END("sensor", driver->name);
+            end_us = sensor_sched_now_us();
+            sensor->exec_us += (uint32_t)(end_us - now_us);
+            if (reading.err != ESP_OK) {
+                sensor_sched_finish(sched, sensor, &reading, end_us);
+                return;
+            }
+            if (driver->convert_ms) {
+                // Free for the other sensors until the conversion is done
+                sensor->state = SENSOR_SCHED_CONVERTING;
+                sensor->read_us = end_us + driver->convert_ms * 1000;
+                return;
+            }
+            now_us = end_us;
+        }
+    }
+
+    TRACE_BEGIN("sensor", driver->name);
+    reading.err = driver->read(sensor->ctx, &reading);
+    TRACE_END("sensor", driver->name);
+    end_us = sensor_sched_now_us();
+    sensor->exec_us += (uint32_t)(end_us - now_us);
+    sensor_sched_finish(sched, sensor, &reading, end_us);
+}
+
+/**
+ * @brief Scheduler task: run the highest priority step that is due, else sleep until the next one
+ */
+static void sensor_sched_task(void *param)
+{
+    sensor_sched_t *sched = (sensor_sched_t*)param;
+    const int64_t tick_us = portTICK_PERIOD_MS * 1000;
+
+    for (uint8_t i = 0; i < sched->count; i++) {
+        sensor_sched_sensor_t *sensor = &sched->sensors[i];
+        esp_err_t err = sensor->driver->init ? sensor->driver->init(sensor->ctx) : ESP_OK;
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "%s init failed: %s, not sampled", sensor->driver->name, esp_err_to_name(err));
+        }
+        sensor->state = err == ESP_OK ? SENSOR_SCHED_IDLE : SENSOR_SCHED_DISABLED;
+    }
+    int64_t start_us = sensor_sched_now_us();
+    for (uint8_t i = 0; i < sched->count; i++) {
+        sched->sensors[i].next_release_us = start_us;
+    }
+
+    while (!(xEventGroupGetBits(sched->events) & SENSOR_SCHED_STOP)) {
+        int64_t now_us = sensor_sched_now_us();
+        int64_t wake_us = INT64_MAX;
+        sensor_sched_sensor_t *due = NULL;
+
+        for (uint8_t i = 0; i < sched->count; i++) {
+            sensor_sched_sensor_t *sensor = &sched->sensors[sched->order[i]];
+            int64_t at_us = sensor->state == SENSOR_SCHED_IDLE ? sensor->next_release_us :
+                            sensor->state == SENSOR_SCHED_CONVERTING ? sensor->read_us : INT64_MAX;
+            if (at_us <= now_us) {
+                due = sensor;
+                break;
+            }
+            if (at_us < wake_us) {
+                wake_us = at_us;
+            }
+        }
+        if (due) {
+            // Not preemptive: a step runs to its end, then the priorities are looked at again
+            sensor_sched_run(sched, due, now_us);
+            continue;
+        }
+        // Rounded up: waking a tick early would only spin until the release
+        TickType_t ticks = wake_us == INT64_MAX ? portMAX_DELAY : (TickType_t)((wake_us - now_us + tick_us - 1) / tick_us);
+        xEventGroupWaitBits(sched->events, SENSOR_SCHED_STOP, pdFALSE, pdTRUE, ticks);
+    }
+
+    xEventGroupSetBits(sched->events, SENSOR_SCHED_DONE);
+    vTaskDelete(NULL);
+}
+
+// ---------------------- External API functions ----------------------
+
+sensor_sched_t* sensor_sched_create(const sensor_sched_config_t *config)
+{
+    if (config == NULL) {
+        ESP_LOGE(TAG, "Invalid config");
+        return NULL;
+    }
+    sensor_sched_t *sched = (sensor_sched_t*)calloc(1, sizeof(sensor_sched_t));
+    if (sched == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate sensor_sched_t");
+        return NULL;
+    }
+    sched->config = *config;
+    sched->events = xEventGroupCreate();
+    sched->lock = xSemaphoreCreateMutex();
+    if (sched->events == NULL || sched->lock == NULL) {
+        ESP_LOGE(TAG, "Failed to create the event group or the lock");
+        if (sched->events) vEventGroupDelete(sched->events);
+        if (sched->lock) vSemaphoreDelete(sched->lock);
+        free(sched);
+        return NULL;
+    }
+    return sched;
+}
+
+int sensor_sched_add(sensor_sched_t *sched, const sensor_driver_t *driver, void *ctx,
+                     sensor_sched_cb_t on_reading, void *arg)
+{
+    if (sched == NULL || driver == NULL || driver->name == NULL || driver->read == NULL || driver->period_ms == 0) {
+        return -1;
+    }
+    if (sched->running || sched->count >= SENSOR_SCHED_MAX_SENSORS) {
+        ESP_LOGE(TAG, "Cannot add %s", driver->name);
+        return -1;
+    }
+    if (driver->convert_ms * 1000 >= sensor_sched_deadline_us(driver)) {
+        ESP_LOGW(TAG, "%s: the conversion alone takes the whole deadline", driver->name);
+    }
+    uint8_t index = sched->count++;
+    sched->sensors[index] = (sensor_sched_sensor_t){
+        .driver = driver,
+        .ctx = ctx,
+        .on_reading = on_reading,
+        .arg = arg,
+    };
+    return index;
+}
+
+int sensor_sched_find(sensor_sched_t *sched, const char *name)
+{
+    if (sched == NULL || name == NULL) {
+        return -1;
+    }
+    for (uint8_t i = 0; i < sched->count; i++) {
+        if (strcmp(sched->sensors[i].driver->name, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+esp_err_t sensor_sched_start(sensor_sched_t *sched)
+{
+    if (sched == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (sched->running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    sensor_sched_sort(sched);
+    for (uint8_t i = 0; i < sched->count; i++) {
+        memset(&sched->sensors[i].stats, 0, sizeof(sched->sensors[i].stats));
+    }
+    xEventGroupClearBits(sched->events, SENSOR_SCHED_STOP | SENSOR_SCHED_DONE);
+    sched->running = true;
+    if (xTaskCreate(sensor_sched_task, "sensor_sched", sched->config.stack_size, sched,
+                    sched->config.priority, NULL) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create the scheduler task");
+        sched->running = false;
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+void sensor_sched_stop(sensor_sched_t *sched)
+{
+    if (sched == NULL || !sched->running) {
+        return;
+    }
+    xEventGroupSetBits(sched->events, SENSOR_SCHED_STOP);
+    xEventGroupWaitBits(sched->events, SENSOR_SCHED_DONE, pdFALSE, pdTRUE, portMAX_DELAY);
+    sched->running = false;
+}
+
+esp_err_t sensor_sched_get_stats(sensor_sched_t *sched, int index, sensor_sched_stats_t *stats)
+{
+    if (sched == NULL || stats == NULL || index < 0 || index >= sched->count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    xSemaphoreTake(sched->lock, portMAX_DELAY);
+    *stats = sched->sensors[index].stats;
+    xSemaphoreGive(sched->lock);
+    return ESP_OK;
+}
+
+void sensor_sched_log_stats(sensor_sched_t *sched)
+{
+    if (sched == NULL) {
+        return;
+    }
+    float utilization = 0.0f;
+    int active = 0;
+    for (uint8_t i = 0; i < sched->count; i++) {
+        const sensor_sched_sensor_t *sensor = &sched->sensors[sched->order[i]];
+        const sensor_driver_t *driver = sensor->driver;
+        sensor_sched_stats_t stats;
+        sensor_sched_get_stats(sched, sched->order[i], &stats);
+        ESP_LOGI(TAG, "sensor=%s period_ms=%lu deadline_ms=%lu samples=%lu errors=%lu overruns=%lu skipped=%lu "
+                 "jitter_us=%lu/%lu response_us_max=%lu exec_us_max=%lu", driver->name,
+                 (unsigned long)driver->period_ms, (unsigned long)(sensor_sched_deadline_us(driver) / 1000),
+                 (unsigned long)stats.samples, (unsigned long)stats.errors, (unsigned long)stats.overruns,
+                 (unsigned long)stats.skipped,
+                 (unsigned long)(stats.samples ? stats.jitter_us_total / stats.samples : 0),
+                 (unsigned long)stats.jitter_us_max, (unsigned long)stats.response_us_max,
+                 (unsigned long)stats.exec_us_max);
+        if (sensor->state != SENSOR_SCHED_DISABLED) {
+            utilization += stats.exec_us_max / (driver->period_ms * 1000.0f);
+            active++;
+        }
+    }
+    // Liu and Layland: below n(2^(1/n) - 1), preemptive rate-monotonic meets every deadline.
+    // The steps here are not preemptive: the longest one also delays the shortest period.
+    float bound = active ? active * (powf(2.0f, 1.0f / active) - 1.0f) : 1.0f;
+    ESP_LOGI(TAG, "sensors=%d utilization_pct=%.2f rm_bound_pct=%.1f", active, utilization * 100.0f, bound * 100.0f);
+}
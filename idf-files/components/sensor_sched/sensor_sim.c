@@ -0,0 +1,93 @@
+#include "sensor_sim.h"
+
+#include <stdlib.h>
+#include <sdkconfig.h>
+#include <esp_log.h>
+#if CONFIG_IDF_TARGET_LINUX
+#include <time.h>
+#else
+#include <esp_timer.h>
+#endif
+
+#define TAG "SensorSim"
+
+// ---------------------- Internal implementation functions ----------------------
+
+static int64_t sensor_sim_now_us(void)
+{
+#if CONFIG_IDF_TARGET_LINUX
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#else
+    return esp_timer_get_time();
+#endif
+}
+
+/**
+ * @brief Keep the CPU busy, as a polled bus transaction would
+ */
+static void sensor_sim_busy(uint32_t us)
+{
+    int64_t end_us = sensor_sim_now_us() + us;
+    while (sensor_sim_now_us() < end_us) {
+    }
+}
+
+static esp_err_t sensor_sim_start(void *ctx)
+{
+    sensor_sim_t *sim = (sensor_sim_t*)ctx;
+    sensor_sim_busy(sim->config.exec_us);
+    return ESP_OK;
+}
+
+static esp_err_t sensor_sim_read(void *ctx, sensor_reading_t *reading)
+{
+    sensor_sim_t *sim = (sensor_sim_t*)ctx;
+    sensor_sim_busy(sim->config.exec_us);
+    uint32_t sample = sim->samples++;
+    if (sim->config.fail_every && (sample + 1) % sim->config.fail_every == 0) {
+        return ESP_FAIL;
+    }
+    reading->values[0] = sim->config.base + sim->config.step * sample;
+    reading->count = 1;
+    return ESP_OK;
+}
+
+// ---------------------- External API functions ----------------------
+
+sensor_sim_t* sensor_sim_create(const sensor_sim_config_t *config)
+{
+    if (config == NULL || config->name == NULL || config->period_ms == 0) {
+        ESP_LOGE(TAG, "Invalid config");
+        return NULL;
+    }
+    sensor_sim_t *sim = (sensor_sim_t*)calloc(1, sizeof(sensor_sim_t));
+    if (sim == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate sensor_sim_t");
+        return NULL;
+    }
+    sim->config = *config;
+    sim->driver = (sensor_driver_t){
+        .name = config->name,
+        .period_ms = config->period_ms,
+        .deadline_ms = config->deadline_ms,
+        .convert_ms = config->convert_ms,
+        .start = config->convert_ms ? sensor_sim_start : NULL,
+        .read = sensor_sim_read,
+    };
+    return sim;
+}
+
+int sensor_sim_add(sensor_sched_t *sched, const sensor_sim_config_t *config, sensor_sched_cb_t on_reading, void *arg)
+{
+    sensor_sim_t *sim = sensor_sim_create(config);
+    if (sim == NULL) {
+        return -1;
+    }
+    int index = sensor_sched_add(sched, &sim->driver, sim, on_reading, arg);
+    if (index < 0) {
+        free(sim);
+    }
+    return index;
+}
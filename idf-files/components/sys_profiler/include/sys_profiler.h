@@ -0,0 +1,112 @@
+
+#ifndef _SYS_PROFILER_H
+#define _SYS_PROFILER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <sdkconfig.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "lvgl.h"
+
+
+#define SYS_PROFILER_MAX_TASKS      32      // Tasks listed per sample, the rest are counted only
+#define SYS_PROFILER_DASHBOARD_ROWS 12      // Busiest tasks shown on the dashboard
+
+#define SYS_PROFILER_DEFAULT_CONFIG() { \
+    .period_ms = 10000,                 \
+    .log = true,                        \
+    .dashboard = false,                 \
+}
+
+
+typedef struct {
+    uint32_t period_ms;         // Sampling period, also the CPU time window
+    bool log;                   // Log each sample as key=value lines
+    bool dashboard;             // Show the table on the top layer
+} sys_profiler_config_t;
+
+typedef struct {
+    char name[configMAX_TASK_NAME_LEN];
+    TaskHandle_t handle;
+    UBaseType_t priority;
+    float cpu_pct;              // Of one core over the last period, -1 on the first sample
+    uint32_t stack_free_min;    // Bytes of stack never used since the task started
+} sys_profiler_task_t;
+
+typedef enum {
+    SYS_PROFILER_HEAP_INTERNAL = 0,
+    SYS_PROFILER_HEAP_PSRAM,
+    SYS_PROFILER_HEAP_DMA,
+    SYS_PROFILER_HEAP_COUNT,
+} sys_profiler_heap_id_t;
+
+typedef struct {
+    size_t total;               // 0: no such memory
+    size_t free;
+    size_t min_free;            // Low-water mark since boot
+    size_t largest;             // Largest allocation that would succeed now
+} sys_profiler_heap_t;
+
+typedef struct {
+    uint32_t seq;               // Sample number, starts at 1
+    uint32_t task_count;        // Tasks running, may exceed SYS_PROFILER_MAX_TASKS
+    uint32_t listed;            // Entries of tasks[], busiest first
+    sys_profiler_task_t tasks[SYS_PROFILER_MAX_TASKS];
+    float core_load_pct[portNUM_PROCESSORS];    // 100 minus the idle task's share, -1 when unknown
+    sys_profiler_heap_t heaps[SYS_PROFILER_HEAP_COUNT];
+    lv_mem_monitor_t lv_mem;    // All zero when LVGL uses the system allocator (LV_MEM_CUSTOM)
+} sys_profiler_sample_t;
+
+// Run time counters of the previous sample, to turn them into shares of the period
+typedef struct {
+    TaskHandle_t handle;
+    configRUN_TIME_COUNTER_TYPE run_time;
+} sys_profiler_prev_t;
+
+typedef struct {
+    sys_profiler_config_t config;
+    sys_profiler_sample_t sample;
+#if CONFIG_SYS_PROFILER_TASK_STATS
+    TaskStatus_t status[SYS_PROFILER_MAX_TASKS];
+    sys_profiler_prev_t prev[SYS_PROFILER_MAX_TASKS];
+    uint32_t prev_count;
+    configRUN_TIME_COUNTER_TYPE prev_total;
+#endif
+    lv_timer_t *timer;
+    lv_obj_t *dashboard;        // Panel on the top layer
+    lv_obj_t *table;
+    lv_obj_t *summary;
+} sys_profiler_t;
+
+
+/**
+ * @brief Create the profiler and take a first sample (call with the LVGL lock held)
+ * @param config Configuration pointer
+ * @return sys_profiler_t* Returns a pointer to the instance on success, NULL on failure
+ */
+sys_profiler_t* sys_profiler_create(const sys_profiler_config_t *config);
+
+/**
+ * @brief Sample now instead of waiting for the period (call with the LVGL lock held)
+ * @param profiler Instance pointer
+ */
+void sys_profiler_sample(sys_profiler_t *profiler);
+
+/**
+ * @brief Show or hide the dashboard (call with the LVGL lock held)
+ * It does not take touches: the screen below keeps working.
+ * @param profiler Instance pointer
+ * @param show True to show it
+ */
+void sys_profiler_show_dashboard(sys_profiler_t *profiler, bool show);
+
+/**
+ * @brief Copy the last sample (call with the LVGL lock held)
+ * @param profiler Instance pointer
+ * @param sample Sample output pointer
+ */
+void sys_profiler_get_sample(sys_profiler_t *profiler, sys_profiler_sample_t *sample);
+
+#endif // _SYS_PROFILER_H
@@ -0,0 +1,292 @@
+#include "sys_profiler.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <esp_log.h>
+#include <esp_heap_caps.h>
+
+#define TAG "SysProfiler"
+
+static const char *s_heap_names[SYS_PROFILER_HEAP_COUNT] = {"internal", "psram", "dma"};
+static const uint32_t s_heap_caps[SYS_PROFILER_HEAP_COUNT] = {
+    MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT,
+    MALLOC_CAP_SPIRAM,
+    MALLOC_CAP_DMA,
+};
+
+// ---------------------- Internal implementation functions ----------------------
+
+#if CONFIG_SYS_PROFILER_TASK_STATS
+
+/**
+ * @brief Run time of a task at the previous sample, 0 for a task started since
+ */
+static configRUN_TIME_COUNTER_TYPE sys_profiler_prev_run_time(sys_profiler_t *profiler, TaskHandle_t handle)
+{
+    for (uint32_t i = 0; i < profiler->prev_count; i++) {
+        if (profiler->prev[i].handle == handle) {
+            return profiler->prev[i].run_time;
+        }
+    }
+    return 0;
+}
+
+static int sys_profiler_cmp_cpu(const void *a, const void *b)
+{
+    float ca = ((const sys_profiler_task_t*)a)->cpu_pct;
+    float cb = ((const sys_profiler_task_t*)b)->cpu_pct;
+    return ca < cb ? 1 : ca > cb ? -1 : 0;
+}
+
+/**
+ * @brief Shares of CPU time over the period and stack high-water marks
+ */
+static void sys_profiler_sample_tasks(sys_profiler_t *profiler)
+{
+    sys_profiler_sample_t *sample = &profiler->sample;
+    configRUN_TIME_COUNTER_TYPE total = 0;
+    UBaseType_t count = uxTaskGetSystemState(profiler->status, SYS_PROFILER_MAX_TASKS, &total);
+
+    sample->task_count = uxTaskGetNumberOfTasks();
+    if (count == 0) {
+        // More tasks than SYS_PROFILER_MAX_TASKS: uxTaskGetSystemState() fills nothing
+        sample->listed = 0;
+        return;
+    }
+    // Unsigned differences stay right across one counter wrap
+    configRUN_TIME_COUNTER_TYPE period = total - profiler->prev_total;
+    bool first = profiler->prev_count == 0 || period == 0;
+
+    for (UBaseType_t i = 0; i < count; i++) {
+        const TaskStatus_t *status = &profiler->status[i];
+        sys_profiler_task_t *task = &sample->tasks[i];
+        strncpy(task->name, status->pcTaskName, sizeof(task->name) - 1);
+        task->handle = status->xHandle;
+        task->priority = status->uxCurrentPriority;
+        task->stack_free_min = status->usStackHighWaterMark * sizeof(StackType_t);
+        task->cpu_pct = first ? -1.0f :
+                        (status->ulRunTimeCounter - sys_profiler_prev_run_time(profiler, status->xHandle)) * 100.0f / period;
+        for (int core = 0; core < portNUM_PROCESSORS; core++) {
+            if (!first && status->xHandle == xTaskGetIdleTaskHandleForCore(core)) {
+                sample->core_load_pct[core] = task->cpu_pct < 100.0f ? 100.0f - task->cpu_pct : 0.0f;
+            }
+        }
+    }
+    sample->listed = count;
+
+    for (UBaseType_t i = 0; i < count; i++) {
+        profiler->prev[i].handle = profiler->status[i].xHandle;
+        profiler->prev[i].run_time = profiler->status[i].ulRunTimeCounter;
+    }
+    profiler->prev_count = count;
+    profiler->prev_total = total;
+
+    qsort(sample->tasks, count, sizeof(sample->tasks[0]), sys_profiler_cmp_cpu);
+}
+
+#endif
+
+static void sys_profiler_sample_memory(sys_profiler_t *profiler)
+{
+    sys_profiler_sample_t *sample = &profiler->sample;
+    for (int i = 0; i < SYS_PROFILER_HEAP_COUNT; i++) {
+        multi_heap_info_t info;
+        heap_caps_get_info(&info, s_heap_caps[i]);
+        sys_profiler_heap_t *heap = &sample->heaps[i];
+        heap->total = info.total_free_bytes + info.total_allocated_bytes;
+        heap->free = info.total_free_bytes;
+        heap->min_free = info.minimum_free_bytes;
+        heap->largest = info.largest_free_block;
+    }
+    lv_mem_monitor(&sample->lv_mem);
+}
+
+/**
+ * @brief One line per task, core, heap and the LVGL pool, all with the sample number
+ */
+static void sys_profiler_log(sys_profiler_t *profiler)
+{
+    const sys_profiler_sample_t *sample = &profiler->sample;
+    for (uint32_t i = 0; i < sample->listed; i++) {
+        const sys_profiler_task_t *task = &sample->tasks[i];
+        ESP_LOGI(TAG, "sample=%lu task=%s prio=%u cpu_pct=%.1f stack_free=%lu", (unsigned long)sample->seq,
+                 task->name, (unsigned)task->priority, task->cpu_pct, (unsigned long)task->stack_free_min);
+    }
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        if (sample->core_load_pct[core] >= 0.0f) {
+            ESP_LOGI(TAG, "sample=%lu core=%d load_pct=%.1f", (unsigned long)sample->seq, core, sample->core_load_pct[core]);
+        }
+    }
+    for (int i = 0; i < SYS_PROFILER_HEAP_COUNT; i++) {
+        const sys_profiler_heap_t *heap = &sample->heaps[i];
+        if (heap->total == 0) {
+            continue;
+        }
+        ESP_LOGI(TAG, "sample=%lu heap=%s total=%u free=%u min_free=%u largest=%u", (unsigned long)sample->seq,
+                 s_heap_names[i], (unsigned)heap->total, (unsigned)heap->free, (unsigned)heap->min_free,
+                 (unsigned)heap->largest);
+    }
+    const lv_mem_monitor_t *mem = &sample->lv_mem;
+    ESP_LOGI(TAG, "sample=%lu lvgl_mem total=%lu free=%lu max_used=%lu used_pct=%u frag_pct=%u tasks=%lu",
+             (unsigned long)sample->seq, (unsigned long)mem->total_size, (unsigned long)mem->free_size,
+             (unsigned long)mem->max_used, mem->used_pct, mem->frag_pct, (unsigned long)sample->task_count);
+}
+
+/**
+ * @brief Fill the table with the busiest tasks and the summary with the memory
+ */
+static void sys_profiler_update_dashboard(sys_profiler_t *profiler)
+{
+    const sys_profiler_sample_t *sample = &profiler->sample;
+    char text[160];
+    uint32_t rows = sample->listed < SYS_PROFILER_DASHBOARD_ROWS ? sample->listed : SYS_PROFILER_DASHBOARD_ROWS;
+
+    lv_table_set_row_cnt(profiler->table, rows + 1);
+    for (uint32_t i = 0; i < rows; i++) {
+        const sys_profiler_task_t *task = &sample->tasks[i];
+        lv_table_set_cell_value(profiler->table, i + 1, 0, task->name);
+        lv_table_set_cell_value_fmt(profiler->table, i + 1, 1, "%u", (unsigned)task->priority);
+        // snprintf: lv_snprintf() has no float support by default
+        snprintf(text, sizeof(text), task->cpu_pct < 0.0f ? "--" : "%.1f", task->cpu_pct);
+        lv_table_set_cell_value(profiler->table, i + 1, 2, text);
+        lv_table_set_cell_value_fmt(profiler->table, i + 1, 3, "%lu", (unsigned long)task->stack_free_min);
+    }
+
+    const sys_profiler_heap_t *internal = &sample->heaps[SYS_PROFILER_HEAP_INTERNAL];
+    const sys_profiler_heap_t *psram = &sample->heaps[SYS_PROFILER_HEAP_PSRAM];
+    int len = snprintf(text, sizeof(text), "Internal %u / %u KB free (min %u)\nPSRAM %u / %u KB free\nLVGL %u%% used, %u%% frag",
+                       (unsigned)(internal->free / 1024), (unsigned)(internal->total / 1024),
+                       (unsigned)(internal->min_free / 1024), (unsigned)(psram->free / 1024),
+                       (unsigned)(psram->total / 1024), sample->lv_mem.used_pct, sample->lv_mem.frag_pct);
+    for (int core = 0; core < portNUM_PROCESSORS && len < (int)sizeof(text); core++) {
+        if (sample->core_load_pct[core] >= 0.0f) {
+            len += snprintf(text + len, sizeof(text) - len, "%sCPU%d %.0f%%", core ? "  " : "\n", core,
+                            sample->core_load_pct[core]);
+        }
+    }
+    lv_label_set_text(profiler->summary, text);
+}
+
+static void sys_profiler_timer_cb(lv_timer_t *timer)
+{
+    sys_profiler_sample((sys_profiler_t*)timer->user_data);
+}
+
+// ---------------------- External API functions ----------------------
+
+sys_profiler_t* sys_profiler_create(const sys_profiler_config_t *config)
+{
+    if (config == NULL || config->period_ms == 0) {
+        ESP_LOGE(TAG, "Invalid configuration");
+        return NULL;
+    }
+    sys_profiler_t *profiler = (sys_profiler_t*)calloc(1, sizeof(sys_profiler_t));
+    if (profiler == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate sys_profiler_t");
+        return NULL;
+    }
+    profiler->config = *config;
+
+    profiler->timer = lv_timer_create(sys_profiler_timer_cb, config->period_ms, profiler);
+    if (profiler->timer == NULL) {
+        ESP_LOGE(TAG, "Failed to create the sampling timer");
+        free(profiler);
+        return NULL;
+    }
+#if !CONFIG_SYS_PROFILER_TASK_STATS
+    ESP_LOGW(TAG, "SYS_PROFILER_TASK_STATS is disabled: heap and LVGL memory only");
+#endif
+
+    // Starts the CPU time window; tasks show "--" until the next sample
+    sys_profiler_sample(profiler);
+    if (config->dashboard) {
+        sys_profiler_show_dashboard(profiler, true);
+    }
+    return profiler;
+}
+
+void sys_profiler_sample(sys_profiler_t *profiler)
+{
+    if (profiler == NULL) {
+        return;
+    }
+    profiler->sample.seq++;
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        profiler->sample.core_load_pct[core] = -1.0f;
+    }
+#if CONFIG_SYS_PROFILER_TASK_STATS
+    sys_profiler_sample_tasks(profiler);
+#endif
+    sys_profiler_sample_memory(profiler);
+
+    if (profiler->config.log) {
+        sys_profiler_log(profiler);
+    }
+    if (profiler->dashboard && !lv_obj_has_flag(profiler->dashboard, LV_OBJ_FLAG_HIDDEN)) {
+        sys_profiler_update_dashboard(profiler);
+    }
+}
+
+void sys_profiler_show_dashboard(sys_profiler_t *profiler, bool show)
+{
+    if (profiler == NULL) {
+        return;
+    }
+    if (profiler->dashboard == NULL) {
+        if (!show) {
+            return;
+        }
+        // On the top layer, above every screen, like the lv_perf overlay
+        lv_obj_t *panel = lv_obj_create(lv_layer_top());
+        lv_obj_clear_flag(panel, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_set_size(panel, 400, LV_SIZE_CONTENT);
+        lv_obj_set_flex_flow(panel, LV_FLEX_FLOW_COLUMN);
+        lv_obj_set_style_bg_color(panel, lv_color_hex(0x000000), 0);
+        lv_obj_set_style_bg_opa(panel, LV_OPA_70, 0);
+        lv_obj_set_style_border_width(panel, 0, 0);
+        lv_obj_set_style_pad_all(panel, 6, 0);
+        lv_obj_set_style_pad_row(panel, 4, 0);
+        lv_obj_set_style_text_font(panel, &lv_font_montserrat_14, 0);
+        lv_obj_set_style_text_color(panel, lv_color_hex(0xFFFFFF), 0);
+        lv_obj_align(panel, LV_ALIGN_TOP_LEFT, 4, 4);
+
+        lv_obj_t *table = lv_table_create(panel);
+        lv_obj_clear_flag(table, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+        lv_table_set_col_cnt(table, 4);
+        lv_table_set_col_width(table, 0, 160);
+        lv_table_set_col_width(table, 1, 60);
+        lv_table_set_col_width(table, 2, 80);
+        lv_table_set_col_width(table, 3, 88);
+        lv_table_set_cell_value(table, 0, 0, "Task");
+        lv_table_set_cell_value(table, 0, 1, "Prio");
+        lv_table_set_cell_value(table, 0, 2, "CPU %");
+        lv_table_set_cell_value(table, 0, 3, "Stack free");
+        lv_obj_set_style_bg_opa(table, LV_OPA_TRANSP, 0);
+        lv_obj_set_style_border_width(table, 0, 0);
+        lv_obj_set_style_pad_all(table, 0, 0);
+        lv_obj_set_style_bg_opa(table, LV_OPA_TRANSP, LV_PART_ITEMS);
+        lv_obj_set_style_border_width(table, 0, LV_PART_ITEMS);
+        lv_obj_set_style_pad_all(table, 2, LV_PART_ITEMS);
+        lv_obj_set_style_text_color(table, lv_color_hex(0xFFFFFF), LV_PART_ITEMS);
+
+        profiler->dashboard = panel;
+        profiler->table = table;
+        profiler->summary = lv_label_create(panel);
+        sys_profiler_update_dashboard(profiler);
+    }
+    if (show) {
+        lv_obj_clear_flag(profiler->dashboard, LV_OBJ_FLAG_HIDDEN);
+        sys_profiler_update_dashboard(profiler);
+    } else {
+        lv_obj_add_flag(profiler->dashboard, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+void sys_profiler_get_sample(sys_profiler_t *profiler, sys_profiler_sample_t *sample)
+{
+    if (profiler == NULL || sample == NULL) {
+        return;
+    }
+    *sample = profiler->sample;
+}
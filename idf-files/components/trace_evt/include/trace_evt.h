@@ -0,0 +1,150 @@
+
+#ifndef _TRACE_EVT_H
+#define _TRACE_EVT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <sdkconfig.h>
+#include <esp_err.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+
+#define TRACE_EVT_DEFAULT_CONFIG() {    \
+    .events_per_core = 2048,            \
+    .overwrite = false,                 \
+    .start = true,                      \
+}
+
+// Instrumentation points: cat and name must be string literals (or other static strings without quotes)
+#if CONFIG_TRACE_EVT_ENABLE
+#define TRACE_BEGIN(cat, name)              trace_evt_record(TRACE_EVT_BEGIN, cat, name, 0)
+#define TRACE_END(cat, name)                trace_evt_record(TRACE_EVT_END, cat, name, 0)
+#define TRACE_INSTANT(cat, name)            trace_evt_record(TRACE_EVT_INSTANT, cat, name, 0)
+#define TRACE_COUNTER(cat, name, value)     trace_evt_record(TRACE_EVT_COUNTER, cat, name, value)
+#define TRACE_COMPLETE(cat, name, dur_us)   trace_evt_record(TRACE_EVT_COMPLETE, cat, name, dur_us)
+#else
+#define TRACE_BEGIN(cat, name)              ((void)0)
+#define TRACE_END(cat, name)                ((void)0)
+#define TRACE_INSTANT(cat, name)            ((void)0)
+#define TRACE_COUNTER(cat, name, value)     ((void)0)
+#define TRACE_COMPLETE(cat, name, dur_us)   ((void)0)
+#endif
+
+
+typedef enum {
+    TRACE_EVT_BEGIN = 0,        // Span start, on the calling task
+    TRACE_EVT_END,              // Span end, same task and name as the begin
+    TRACE_EVT_INSTANT,
+    TRACE_EVT_COUNTER,          // Value of a counter track
+    TRACE_EVT_COMPLETE,         // Span that ends now and lasted value microseconds (when the start was on another task)
+} trace_evt_type_t;
+
+typedef struct {
+    uint32_t events_per_core;   // Ring size, must be a power of two
+    bool overwrite;             // Keep the last events; false keeps the first ones (the boot) and drops the rest
+    bool start;                 // Record from trace_evt_create() on
+} trace_evt_config_t;
+
+// One event; seq is 0 while a producer writes it, position + 1 once complete
+typedef struct {
+    atomic_uint_fast32_t seq;
+    uint8_t type;               // trace_evt_type_t
+    int32_t value;
+    uint64_t ts;                // Extended cycle count on the device, nanoseconds on the host
+    const char *cat;
+    const char *name;
+    TaskHandle_t task;
+} trace_evt_event_t;
+
+// Events of one core: only the tasks and interrupts running on that core write it
+typedef struct {
+    trace_evt_event_t *events;
+    atomic_uint_fast32_t write_pos;     // Next position to claim
+    uint32_t last_cycles;               // The 32-bit cycle counter is extended to 64 bits
+    uint32_t wraps;
+    uint64_t anchor_ts;                 // First timestamp of the core and its esp_timer time: aligns the cores
+    int64_t anchor_us;
+    bool anchored;
+} trace_evt_ring_t;
+
+typedef struct {
+    uint32_t events;            // Recorded and still in the rings
+    uint32_t dropped;           // Lost to a full ring (overwritten ones with overwrite set)
+} trace_evt_stats_t;
+
+typedef struct {
+    trace_evt_config_t config;
+    trace_evt_ring_t rings[portNUM_PROCESSORS];
+    atomic_bool enabled;
+    uint32_t ticks_per_us;      // Timestamp units per microsecond
+} trace_evt_t;
+
+// Receives the exported JSON piece by piece
+typedef void (*trace_evt_write_fn_t)(const char *data, size_t len, void *arg);
+
+
+/**
+ * @brief Create the event rings; the TRACE_* macros record into them from then on (one per application)
+ * @param config Configuration pointer
+ * @return trace_evt_t* Returns a pointer to the instance on success, NULL on failure
+ */
+trace_evt_t* trace_evt_create(const trace_evt_config_t *config);
+
+/**
+ * @brief Record one event (wait-free: a timestamp, one atomic claim and a few stores); use the TRACE_* macros
+ * @param type Event type
+ * @param cat Category, a static string
+ * @param name Name, a static string
+ * @param value Counter value or complete span duration in microseconds, 0 otherwise
+ */
+void trace_evt_record(trace_evt_type_t type, const char *cat, const char *name, int32_t value);
+
+/**
+ * @brief Start or pause recording
+ * @param trace Instance pointer
+ * @param enable True to record
+ */
+void trace_evt_enable(trace_evt_t *trace, bool enable);
+
+/**
+ * @brief Drop every recorded event (pause recording first)
+ * @param trace Instance pointer
+ */
+void trace_evt_clear(trace_evt_t *trace);
+
+/**
+ * @brief Count the recorded and dropped events
+ * @param trace Instance pointer
+ * @param stats Stats output pointer
+ */
+void trace_evt_get_stats(trace_evt_t *trace, trace_evt_stats_t *stats);
+
+/**
+ * @brief Write the events as Chrome trace JSON (chrome://tracing, ui.perfetto.dev); recording pauses meanwhile
+ * Each core is a process and each task a thread. Task names are only known for tasks still running.
+ * @param trace Instance pointer
+ * @param write Output function
+ * @param arg Output function argument
+ * @return uint32_t Number of events written
+ */
+uint32_t trace_evt_export(trace_evt_t *trace, trace_evt_write_fn_t write, void *arg);
+
+/**
+ * @brief Print the JSON to stdout between "trace_evt: begin" and "trace_evt: end" lines
+ * @param trace Instance pointer
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG without an instance
+ */
+esp_err_t trace_evt_dump(trace_evt_t *trace);
+
+/**
+ * @brief Save the JSON to a file (host build, or a mounted file system)
+ * @param trace Instance pointer
+ * @param path File path
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG, or ESP_FAIL when the file could not be written
+ */
+esp_err_t trace_evt_save(trace_evt_t *trace, const char *path);
+
+#endif // _TRACE_EVT_H
@@ -0,0 +1,395 @@
+#include "trace_evt.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <esp_log.h>
+#if CONFIG_IDF_TARGET_LINUX
+#include <time.h>
+#else
+#include <esp_cpu.h>
+#include <esp_timer.h>
+#include <esp_rom_sys.h>
+#include <esp_freertos_hooks.h>
+#endif
+#if CONFIG_SPIRAM
+#include <esp_heap_caps.h>
+#endif
+
+#define TAG "TraceEvt"
+
+#define TRACE_EVT_LINE_SIZE     192
+#define TRACE_EVT_TASK_SLACK    4       // Tasks that may be created between counting and listing them
+
+// The macros have no instance argument
+static trace_evt_t *s_trace = NULL;
+
+static const char s_phases[] = {'B', 'E', 'i', 'C', 'X'};
+
+// ---------------------- Internal implementation functions ----------------------
+
+#if CONFIG_IDF_TARGET_LINUX
+
+static uint64_t trace_evt_now(trace_evt_ring_t *ring)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+#else
+
+/**
+ * @brief Extended cycle count of the current core (call with its interrupts masked)
+ */
+static uint64_t trace_evt_now(trace_evt_ring_t *ring)
+{
+    uint32_t cycles = esp_cpu_get_cycle_count();
+    if (cycles < ring->last_cycles) {
+        ring->wraps++;
+    }
+    ring->last_cycles = cycles;
+    return ((uint64_t)ring->wraps << 32) | cycles;
+}
+
+/**
+ * @brief Tick hook of each core: sees every wrap of the cycle counter, even on a core that records nothing for a while
+ */
+static void trace_evt_tick_hook(void)
+{
+    trace_evt_t *trace = s_trace;
+    UBaseType_t state = portSET_INTERRUPT_MASK_FROM_ISR();
+    trace_evt_now(&trace->rings[xPortGetCoreID()]);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+}
+
+#endif
+
+/**
+ * @brief Pair the first timestamp of a core with the common time base
+ */
+static void trace_evt_anchor(trace_evt_ring_t *ring, uint64_t ts)
+{
+#if CONFIG_IDF_TARGET_LINUX
+    ring->anchor_us = 0;
+#else
+    ring->anchor_us = esp_timer_get_time();
+#endif
+    ring->anchor_ts = ts;
+    ring->anchored = true;
+}
+
+/**
+ * @brief Copy a complete event of a ring position (false if it is being written or was overwritten)
+ */
+static bool trace_evt_read(trace_evt_ring_t *ring, uint32_t size, uint32_t pos, trace_evt_event_t *out)
+{
+    const trace_evt_event_t *evt = &ring->events[pos & (size - 1)];
+    if (atomic_load_explicit(&evt->seq, memory_order_acquire) != pos + 1) {
+        return false;
+    }
+    out->type = evt->type;
+    out->value = evt->value;
+    out->ts = evt->ts;
+    out->cat = evt->cat;
+    out->name = evt->name;
+    out->task = evt->task;
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&evt->seq, memory_order_relaxed) == pos + 1;
+}
+
+/**
+ * @brief First position still held by a ring, and its end
+ */
+static void trace_evt_range(trace_evt_t *trace, trace_evt_ring_t *ring, uint32_t *first, uint32_t *end)
+{
+    uint32_t size = trace->config.events_per_core;
+    uint32_t write_pos = (uint32_t)atomic_load_explicit(&ring->write_pos, memory_order_acquire);
+    if (trace->config.overwrite) {
+        *first = write_pos > size ? write_pos - size : 0;
+        *end = write_pos;
+    } else {
+        *first = 0;
+        *end = write_pos < size ? write_pos : size;
+    }
+}
+
+static void trace_evt_write_task_names(trace_evt_t *trace, trace_evt_write_fn_t write, void *arg, bool *first)
+{
+#if configUSE_TRACE_FACILITY
+    // Only running tasks: the handle of a deleted one may point to freed memory.
+    // uxTaskGetSystemState() lists nothing when the array is too small, so it is sized from the count.
+    UBaseType_t size = uxTaskGetNumberOfTasks() + TRACE_EVT_TASK_SLACK;
+    TaskStatus_t *tasks = (TaskStatus_t*)malloc(size * sizeof(TaskStatus_t));
+    if (tasks == NULL) {
+        ESP_LOGW(TAG, "No memory for %u task names, threads are shown by handle", (unsigned)size);
+        return;
+    }
+    UBaseType_t count = uxTaskGetSystemState(tasks, size, NULL);
+    if (count == 0) {
+        ESP_LOGW(TAG, "More than %u tasks, threads are shown by handle", (unsigned)size);
+    }
+    char line[TRACE_EVT_LINE_SIZE];
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        for (UBaseType_t i = 0; i < count; i++) {
+            int len = snprintf(line, sizeof(line),
+                               "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%d,\"tid\":%lu,\"args\":{\"name\":\"%s\"}}",
+                               *first ? "\n" : ",\n", core, (unsigned long)(uintptr_t)tasks[i].xHandle, tasks[i].pcTaskName);
+            write(line, len, arg);
+            *first = false;
+        }
+    }
+    free(tasks);
+#endif
+}
+
+static void trace_evt_file_write(const char *data, size_t len, void *arg)
+{
+    fwrite(data, 1, len, (FILE*)arg);
+}
+
+// ---------------------- External API functions ----------------------
+
+trace_evt_t* trace_evt_create(const trace_evt_config_t *config)
+{
+    if (config == NULL || config->events_per_core == 0 ||
+        (config->events_per_core & (config->events_per_core - 1)) != 0) {
+        ESP_LOGE(TAG, "Invalid configuration");
+        return NULL;
+    }
+    if (s_trace != NULL) {
+        ESP_LOGE(TAG, "Already created");
+        return NULL;
+    }
+
+    trace_evt_t *trace = (trace_evt_t*)calloc(1, sizeof(trace_evt_t));
+    if (trace == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate trace_evt_t");
+        return NULL;
+    }
+    trace->config = *config;
+
+    size_t size = config->events_per_core * sizeof(trace_evt_event_t);
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        trace_evt_ring_t *ring = &trace->rings[core];
+#if CONFIG_SPIRAM
+        ring->events = (trace_evt_event_t*)heap_caps_calloc(1, size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+#endif
+        if (ring->events == NULL) {
+            ring->events = (trace_evt_event_t*)calloc(1, size);
+        }
+        if (ring->events == NULL) {
+            ESP_LOGE(TAG, "Failed to allocate %u bytes of events", (unsigned)size);
+            for (int i = 0; i < core; i++) {
+                free(trace->rings[i].events);
+            }
+            free(trace);
+            return NULL;
+        }
+        atomic_init(&ring->write_pos, 0);
+    }
+
+#if CONFIG_IDF_TARGET_LINUX
+    trace->ticks_per_us = 1000;
+    trace_evt_anchor(&trace->rings[0], trace_evt_now(&trace->rings[0]));
+#else
+    trace->ticks_per_us = esp_rom_get_cpu_ticks_per_us();
+#endif
+    atomic_init(&trace->enabled, config->start);
+    s_trace = trace;
+
+#if !CONFIG_IDF_TARGET_LINUX
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        if (esp_register_freertos_tick_hook_for_cpu(trace_evt_tick_hook, core) != ESP_OK) {
+            ESP_LOGW(TAG, "No tick hook on core %d: a core idle for a cycle counter period gets wrong times", core);
+        }
+    }
+#endif
+    ESP_LOGI(TAG, "%lu events per core (%u bytes each), %s", (unsigned long)config->events_per_core,
+             (unsigned)sizeof(trace_evt_event_t), config->overwrite ? "keeps the last ones" : "keeps the first ones");
+    return trace;
+}
+
+void trace_evt_record(trace_evt_type_t type, const char *cat, const char *name, int32_t value)
+{
+    trace_evt_t *trace = s_trace;
+    if (trace == NULL || !atomic_load_explicit(&trace->enabled, memory_order_relaxed)) {
+        return;
+    }
+
+#if CONFIG_IDF_TARGET_LINUX
+    trace_evt_ring_t *ring = &trace->rings[0];
+    uint64_t ts = trace_evt_now(ring);
+    uint32_t pos = (uint32_t)atomic_fetch_add_explicit(&ring->write_pos, 1, memory_order_relaxed);
+#else
+    // Masking this core's interrupts keeps the caller on the core and the counter extension
+    // consistent: no lock is shared with the other core
+    UBaseType_t state = portSET_INTERRUPT_MASK_FROM_ISR();
+    trace_evt_ring_t *ring = &trace->rings[xPortGetCoreID()];
+    uint64_t ts = trace_evt_now(ring);
+    if (!ring->anchored) {
+        trace_evt_anchor(ring, ts);
+    }
+    uint32_t pos = (uint32_t)atomic_fetch_add_explicit(&ring->write_pos, 1, memory_order_relaxed);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+#endif
+
+    uint32_t size = trace->config.events_per_core;
+    if (!trace->config.overwrite && pos >= size) {
+        return;     // Counted as dropped: write_pos keeps growing
+    }
+    trace_evt_event_t *evt = &ring->events[pos & (size - 1)];
+    atomic_store_explicit(&evt->seq, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    evt->type = (uint8_t)type;
+    evt->value = value;
+    evt->ts = ts;
+    evt->cat = cat;
+    evt->name = name;
+    evt->task = xTaskGetCurrentTaskHandle();
+    atomic_store_explicit(&evt->seq, pos + 1, memory_order_release);
+}
+
+void trace_evt_enable(trace_evt_t *trace, bool enable)
+{
+    if (trace) {
+        atomic_store_explicit(&trace->enabled, enable, memory_order_relaxed);
+    }
+}
+
+void trace_evt_clear(trace_evt_t *trace)
+{
+    if (trace == NULL) {
+        return;
+    }
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        trace_evt_ring_t *ring = &trace->rings[core];
+        memset(ring->events, 0, trace->config.events_per_core * sizeof(trace_evt_event_t));
+        atomic_store_explicit(&ring->write_pos, 0, memory_order_release);
+    }
+}
+
+void trace_evt_get_stats(trace_evt_t *trace, trace_evt_stats_t *stats)
+{
+    if (trace == NULL || stats == NULL) {
+        return;
+    }
+    memset(stats, 0, sizeof(*stats));
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        trace_evt_ring_t *ring = &trace->rings[core];
+        uint32_t first, end;
+        trace_evt_range(trace, ring, &first, &end);
+        uint32_t write_pos = (uint32_t)atomic_load_explicit(&ring->write_pos, memory_order_relaxed);
+        stats->events += end - first;
+        stats->dropped += write_pos - (end - first);
+    }
+}
+
+uint32_t trace_evt_export(trace_evt_t *trace, trace_evt_write_fn_t write, void *arg)
+{
+    if (trace == NULL || write == NULL) {
+        return 0;
+    }
+    bool enabled = atomic_exchange_explicit(&trace->enabled, false, memory_order_relaxed);
+
+    static const char head[] = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    write(head, sizeof(head) - 1, arg);
+    char line[TRACE_EVT_LINE_SIZE];
+    bool first = true;
+    uint32_t written = 0;
+
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        int len = snprintf(line, sizeof(line),
+                           "%s{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":%d,\"args\":{\"name\":\"core %d\"}}",
+                           first ? "\n" : ",\n", core, core);
+        write(line, len, arg);
+        first = false;
+    }
+    trace_evt_write_task_names(trace, write, arg, &first);
+
+    uint32_t size = trace->config.events_per_core;
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        trace_evt_ring_t *ring = &trace->rings[core];
+        uint32_t pos, end;
+        trace_evt_range(trace, ring, &pos, &end);
+        for (; pos < end; pos++) {
+            trace_evt_event_t evt;
+            if (!trace_evt_read(ring, size, pos, &evt)) {
+                continue;
+            }
+            // Microseconds on the esp_timer time base
+            double ts = ring->anchor_us + (double)(int64_t)(evt.ts - ring->anchor_ts) / trace->ticks_per_us;
+            unsigned long tid = (unsigned long)(uintptr_t)evt.task;
+            int len;
+            switch (evt.type) {
+                case TRACE_EVT_COUNTER:
+                    len = snprintf(line, sizeof(line),
+                                   ",\n{\"ph\":\"C\",\"cat\":\"%s\",\"name\":\"%s\",\"ts\":%.3f,\"pid\":%d,\"args\":{\"value\":%ld}}",
+                                   evt.cat, evt.name, ts, core, (long)evt.value);
+                    break;
+                case TRACE_EVT_COMPLETE:
+                    len = snprintf(line, sizeof(line),
+                                   ",\n{\"ph\":\"X\",\"cat\":\"%s\",\"name\":\"%s\",\"ts\":%.3f,\"dur\":%ld,\"pid\":%d,\"tid\":%lu}",
+                                   evt.cat, evt.name, ts - evt.value, (long)evt.value, core, tid);
+                    break;
+                case TRACE_EVT_INSTANT:
+                    len = snprintf(line, sizeof(line),
+                                   ",\n{\"ph\":\"i\",\"s\":\"t\",\"cat\":\"%s\",\"name\":\"%s\",\"ts\":%.3f,\"pid\":%d,\"tid\":%lu}",
+                                   evt.cat, evt.name, ts, core, tid);
+                    break;
+                default:
+                    len = snprintf(line, sizeof(line),
+                                   ",\n{\"ph\":\"%c\",\"cat\":\"%s\",\"name\":\"%s\",\"ts\":%.3f,\"pid\":%d,\"tid\":%lu}",
+                                   s_phases[evt.type], evt.cat, evt.name, ts, core, tid);
+                    break;
+            }
+            if (len >= (int)sizeof(line)) {
+                continue;   // Names too long for a line
+            }
+            write(line, len, arg);
+            written++;
+        }
+    }
+
+    static const char tail[] = "\n]}\n";
+    write(tail, sizeof(tail) - 1, arg);
+    atomic_store_explicit(&trace->enabled, enabled, memory_order_relaxed);
+    return written;
+}
+
+esp_err_t trace_evt_dump(trace_evt_t *trace)
+{
+    if (trace == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // Plain stdout: the JSON must not pick up log prefixes
+    printf("trace_evt: begin\n");
+    uint32_t written = trace_evt_export(trace, trace_evt_file_write, stdout);
+    printf("trace_evt: end\n");
+    fflush(stdout);
+    ESP_LOGI(TAG, "Dumped %lu events", (unsigned long)written);
+    return ESP_OK;
+}
+
+esp_err_t trace_evt_save(trace_evt_t *trace, const char *path)
+{
+    if (trace == NULL || path == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        ESP_LOGE(TAG, "Cannot open %s", path);
+        return ESP_FAIL;
+    }
+    uint32_t written = trace_evt_export(trace, trace_evt_file_write, file);
+    bool ok = !ferror(file);
+    if (fclose(file) != 0) {
+        ok = false;
+    }
+    if (!ok) {
+        ESP_LOGE(TAG, "Failed to write %s", path);
+        return ESP_FAIL;
+    }
+    ESP_LOGI(TAG, "Saved %lu events to %s", (unsigned long)written, path);
+    return ESP_OK;
+}
@@ -0,0 +1,163 @@
+
+#ifndef _UI_BIND_H
+#define _UI_BIND_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "lvgl.h"
+#include "ui_cmd.h"
+
+
+#define UI_BIND_MAX             16      // Bindings per group
+#define UI_BIND_MAX_VALUES      UI_CMD_MAX_VALUES   // Floats per float binding
+#define UI_BIND_TEXT_SIZE       UI_CMD_TEXT_SIZE
+
+
+typedef enum {
+    UI_BIND_FLOAT = 0,
+    UI_BIND_BOOL,
+    UI_BIND_STRING,
+} ui_bind_type_t;
+
+typedef struct ui_bind_group ui_bind_group_t;
+
+// A label bound to an observable value
+typedef struct {
+    ui_bind_group_t *group;
+    ui_bind_type_t type;
+    lv_obj_t *label;
+    const char *format;         // printf template: one "%.Nf" per value, or one "%s"
+    const char *on_text;        // Bool texts
+    const char *off_text;
+    const char *invalid_text;   // Float text after ui_bind_set_invalid() (optional)
+    uint8_t precision;          // Decimals shown; values equal at this precision are not redrawn
+    uint8_t value_count;
+
+    // Shown value, only touched in the LVGL task when a set is applied
+    bool has_value;             // False until the first set, which always redraws
+    bool valid;
+    float values[UI_BIND_MAX_VALUES];
+    int32_t keys[UI_BIND_MAX_VALUES];   // Values quantized to the shown precision
+    bool flag;
+    char text[UI_BIND_TEXT_SIZE];
+
+    // Latest set that found the queue full, posted again before the next drain (group lock)
+    atomic_bool pending;
+    ui_cmd_apply_cb_t pending_fn;
+    ui_cmd_value_t pending_value;
+} ui_bind_t;
+
+typedef struct {
+    uint32_t sets;              // Setter calls
+    uint32_t dropped;           // Sets that found the queue full: the binding keeps the latest one until it is posted
+    uint32_t reposted;          // Kept values posted again by the drain
+    uint32_t coalesced;         // Sets overwritten before the next frame
+    uint32_t unchanged;         // Applied sets that did not change the visible value
+    uint32_t same_text;         // Applied sets whose formatted text was already shown
+    uint32_t redraws;           // lv_label_set_text() calls
+    uint32_t drain_us_max;      // Longest batch of applied sets, i.e. LVGL lock time
+} ui_bind_stats_t;
+
+// Group of bindings: setters post to a ui_cmd queue, whose timer applies them once per frame
+struct ui_bind_group {
+    ui_bind_t bindings[UI_BIND_MAX];
+    uint8_t count;
+    ui_cmd_queue_t *queue;
+    pthread_mutex_t lock;       // Orders a kept value against later sets of its binding
+    atomic_uint_fast32_t sets;
+    atomic_uint_fast32_t dropped;
+    uint32_t reposted;          // Consumer-side counters (LVGL task)
+    uint32_t unchanged;
+    uint32_t same_text;
+    uint32_t redraws;
+};
+
+
+/**
+ * @brief Create a binding group and its command queue (call with the LVGL lock held)
+ * @return ui_bind_group_t* Returns a pointer to the instance on success, NULL on failure
+ */
+ui_bind_group_t* ui_bind_group_create(void);
+
+/**
+ * @brief Bind a label to one or two floats
+ * @param group Instance pointer
+ * @param label Label to update
+ * @param format Template with one "%.Nf" per value, e.g. "T = %.1f C  H = %.1f %%"
+ * @param precision Decimals used by the template (N)
+ * @param value_count Number of values (1 or 2)
+ * @param invalid_text Text shown after ui_bind_set_invalid() (optional)
+ * @return ui_bind_t* Returns NULL when the group is full
+ */
+ui_bind_t* ui_bind_float(ui_bind_group_t *group, lv_obj_t *label, const char *format,
+                         uint8_t precision, uint8_t value_count, const char *invalid_text);
+
+/**
+ * @brief Bind a label to a bool
+ * @param group Instance pointer
+ * @param label Label to update
+ * @param on_text Text shown for true
+ * @param off_text Text shown for false
+ * @return ui_bind_t* Returns NULL when the group is full
+ */
+ui_bind_t* ui_bind_bool(ui_bind_group_t *group, lv_obj_t *label, const char *on_text, const char *off_text);
+
+/**
+ * @brief Bind a label to a string
+ * @param group Instance pointer
+ * @param label Label to update
+ * @param format Template with one "%s", or NULL to show the string as is
+ * @return ui_bind_t* Returns NULL when the group is full
+ */
+ui_bind_t* ui_bind_string(ui_bind_group_t *group, lv_obj_t *label, const char *format);
+
+/**
+ * @brief Set the values of a float binding (any task)
+ *
+ * Setters never take the LVGL lock: they post the value to the group's queue and the LVGL task
+ * compares it with the shown one when the queue is drained. When the queue is full, the binding
+ * keeps the value, and the drain posts it as soon as there is room; until then, later sets of the
+ * binding take the group lock for the length of one post, so that they replace the kept value.
+ * @param bind Binding pointer
+ * @param v0 First value
+ * @param v1 Second value (ignored by single-value bindings)
+ * @return bool Returns false when the queue is full: the value is kept and shown after a later drain
+ */
+bool ui_bind_set_float2(ui_bind_t *bind, float v0, float v1);
+
+/**
+ * @brief Set the value of a single-value float binding (any task)
+ */
+bool ui_bind_set_float(ui_bind_t *bind, float value);
+
+/**
+ * @brief Show the invalid text of a float binding until the next value (any task)
+ */
+bool ui_bind_set_invalid(ui_bind_t *bind);
+
+/**
+ * @brief Set the value of a bool binding (any task)
+ */
+bool ui_bind_set_bool(ui_bind_t *bind, bool value);
+
+/**
+ * @brief Set the value of a string binding, truncated to UI_BIND_TEXT_SIZE - 1 (any task)
+ */
+bool ui_bind_set_string(ui_bind_t *bind, const char *value);
+
+/**
+ * @brief Apply pending sets now instead of on the next frame (LVGL task or lock held)
+ * @param group Instance pointer
+ */
+void ui_bind_flush(ui_bind_group_t *group);
+
+/**
+ * @brief Copy the group counters
+ * @param group Instance pointer
+ * @param stats Stats output pointer
+ */
+void ui_bind_get_stats(ui_bind_group_t *group, ui_bind_stats_t *stats);
+
+#endif // _UI_BIND_H
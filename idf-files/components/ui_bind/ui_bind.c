@@ -0,0 +1,331 @@
+#include "ui_bind.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <esp_log.h>
+
+#define TAG "UIBind"
+
+static const float s_scale[] = {1.0f, 10.0f, 100.0f, 1000.0f, 10000.0f};
+
+// ---------------------- Internal implementation functions ----------------------
+
+static ui_bind_t* ui_bind_add(ui_bind_group_t *group, ui_bind_type_t type, lv_obj_t *label)
+{
+    if (group == NULL || label == NULL) {
+        return NULL;
+    }
+    if (group->count >= UI_BIND_MAX) {
+        ESP_LOGE(TAG, "Binding group full");
+        return NULL;
+    }
+    ui_bind_t *bind = &group->bindings[group->count++];
+    bind->group = group;
+    bind->type = type;
+    bind->label = label;
+    return bind;
+}
+
+/**
+ * @brief Format the text of a binding from its shown value
+ */
+static void ui_bind_format(const ui_bind_t *bind, char *buf, size_t size)
+{
+    switch (bind->type) {
+        case UI_BIND_FLOAT:
+            if (!bind->valid) {
+                snprintf(buf, size, "%s", bind->invalid_text ? bind->invalid_text : "--");
+            } else {
+                snprintf(buf, size, bind->format, (double)bind->values[0], (double)bind->values[1]);
+            }
+            break;
+        case UI_BIND_BOOL:
+            snprintf(buf, size, "%s", bind->flag ? bind->on_text : bind->off_text);
+            break;
+        case UI_BIND_STRING:
+            snprintf(buf, size, bind->format ? bind->format : "%s", bind->text);
+            break;
+        default:
+            buf[0] = '\0';
+            break;
+    }
+}
+
+/**
+ * @brief Record an applied set (LVGL task)
+ * @param changed Whether the visible value differs from the shown one
+ * @return bool Returns true when the new value must be stored and drawn
+ */
+static bool ui_bind_note_set(ui_bind_t *bind, bool changed)
+{
+    if (bind->has_value && !changed) {
+        bind->group->unchanged++;
+        return false;
+    }
+    bind->has_value = true;
+    return true;
+}
+
+/**
+ * @brief Redraw the label from the stored value, unless it already shows that text (LVGL task)
+ */
+static void ui_bind_redraw(ui_bind_t *bind)
+{
+    char text[UI_BIND_TEXT_SIZE];
+
+    ui_bind_format(bind, text, sizeof(text));
+    if (strcmp(lv_label_get_text(bind->label), text) == 0) {
+        bind->group->same_text++;
+        return;
+    }
+    // lv_label_set_text() reallocates the text and invalidates the label area
+    lv_label_set_text(bind->label, text);
+    bind->group->redraws++;
+}
+
+/**
+ * @brief Post a set, or keep it as the binding's pending value when the queue is full (any task)
+ * @return bool Returns false when the value was kept instead of queued
+ */
+static bool ui_bind_post(ui_bind_t *bind, ui_cmd_apply_cb_t fn, const ui_cmd_value_t *value)
+{
+    ui_bind_group_t *group = bind->group;
+
+    atomic_fetch_add_explicit(&group->sets, 1, memory_order_relaxed);
+    // Nothing kept for this binding: a set that gets into the queue is the latest one
+    if (!atomic_load_explicit(&bind->pending, memory_order_acquire) &&
+        ui_cmd_post_apply(group->queue, fn, bind, value)) {
+        return true;
+    }
+
+    // Under the lock, the kept value and the drain's re-post of it stay behind this set
+    pthread_mutex_lock(&group->lock);
+    bool queued = ui_cmd_post_apply(group->queue, fn, bind, value);
+    if (queued) {
+        atomic_store_explicit(&bind->pending, false, memory_order_relaxed);
+    } else {
+        bind->pending_fn = fn;
+        bind->pending_value = *value;
+        atomic_store_explicit(&bind->pending, true, memory_order_release);
+        atomic_fetch_add_explicit(&group->dropped, 1, memory_order_relaxed);
+    }
+    pthread_mutex_unlock(&group->lock);
+    return queued;
+}
+
+/**
+ * @brief Post the kept values again, before the queue's next batch (LVGL task)
+ */
+static void ui_bind_repost(void *arg)
+{
+    ui_bind_group_t *group = (ui_bind_group_t*)arg;
+
+    bool any = false;
+    for (uint8_t i = 0; i < group->count && !any; i++) {
+        any = atomic_load_explicit(&group->bindings[i].pending, memory_order_acquire);
+    }
+    if (!any) {
+        return;
+    }
+
+    pthread_mutex_lock(&group->lock);
+    for (uint8_t i = 0; i < group->count; i++) {
+        ui_bind_t *bind = &group->bindings[i];
+        if (!atomic_load_explicit(&bind->pending, memory_order_relaxed)) {
+            continue;
+        }
+        if (!ui_cmd_post_apply(group->queue, bind->pending_fn, bind, &bind->pending_value)) {
+            break;      // Still full: the rest waits for the next drain
+        }
+        atomic_store_explicit(&bind->pending, false, memory_order_relaxed);
+        group->reposted++;
+    }
+    pthread_mutex_unlock(&group->lock);
+}
+
+// The apply callbacks run in the LVGL task when the group's queue is drained
+
+static void ui_bind_apply_float(void *target, const ui_cmd_value_t *value)
+{
+    ui_bind_t *bind = (ui_bind_t*)target;
+
+    // Compare what would be shown, not the raw values: 21.04 and 21.03 both read "21.0"
+    float scale = s_scale[bind->precision];
+    int32_t keys[UI_BIND_MAX_VALUES] = {0};
+    for (uint8_t i = 0; i < bind->value_count; i++) {
+        keys[i] = (int32_t)lroundf(value->values[i] * scale);
+    }
+    bool changed = !bind->valid || memcmp(keys, bind->keys, sizeof(keys)) != 0;
+    if (ui_bind_note_set(bind, changed)) {
+        bind->valid = true;
+        memcpy(bind->values, value->values, sizeof(bind->values));
+        memcpy(bind->keys, keys, sizeof(keys));
+        ui_bind_redraw(bind);
+    }
+}
+
+static void ui_bind_apply_invalid(void *target, const ui_cmd_value_t *value)
+{
+    ui_bind_t *bind = (ui_bind_t*)target;
+    (void)value;
+
+    if (ui_bind_note_set(bind, bind->valid)) {
+        bind->valid = false;
+        ui_bind_redraw(bind);
+    }
+}
+
+static void ui_bind_apply_bool(void *target, const ui_cmd_value_t *value)
+{
+    ui_bind_t *bind = (ui_bind_t*)target;
+
+    if (ui_bind_note_set(bind, bind->flag != value->flag)) {
+        bind->flag = value->flag;
+        ui_bind_redraw(bind);
+    }
+}
+
+static void ui_bind_apply_string(void *target, const ui_cmd_value_t *value)
+{
+    ui_bind_t *bind = (ui_bind_t*)target;
+
+    if (ui_bind_note_set(bind, strcmp(bind->text, value->text) != 0)) {
+        memcpy(bind->text, value->text, UI_BIND_TEXT_SIZE);
+        ui_bind_redraw(bind);
+    }
+}
+
+// ---------------------- External API functions ----------------------
+
+void ui_bind_flush(ui_bind_group_t *group)
+{
+    if (group == NULL) {
+        return;
+    }
+    ui_cmd_drain(group->queue);
+}
+
+ui_bind_group_t* ui_bind_group_create(void)
+{
+    ui_bind_group_t *group = (ui_bind_group_t*)calloc(1, sizeof(ui_bind_group_t));
+    if (group == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate ui_bind_group_t");
+        return NULL;
+    }
+
+    // The queue's drain timer applies the sets once per frame
+    group->queue = ui_cmd_create();
+    if (group->queue == NULL) {
+        ESP_LOGE(TAG, "Failed to create command queue");
+        free(group);
+        return NULL;
+    }
+    pthread_mutex_init(&group->lock, NULL);
+    atomic_init(&group->sets, 0);
+    atomic_init(&group->dropped, 0);
+    for (uint8_t i = 0; i < UI_BIND_MAX; i++) {
+        atomic_init(&group->bindings[i].pending, false);
+    }
+    ui_cmd_set_drain_cb(group->queue, ui_bind_repost, group);
+    return group;
+}
+
+ui_bind_t* ui_bind_float(ui_bind_group_t *group, lv_obj_t *label, const char *format,
+                         uint8_t precision, uint8_t value_count, const char *invalid_text)
+{
+    if (format == NULL || value_count == 0 || value_count > UI_BIND_MAX_VALUES ||
+        precision >= sizeof(s_scale) / sizeof(s_scale[0])) {
+        return NULL;
+    }
+    ui_bind_t *bind = ui_bind_add(group, UI_BIND_FLOAT, label);
+    if (bind) {
+        bind->format = format;
+        bind->precision = precision;
+        bind->value_count = value_count;
+        bind->invalid_text = invalid_text;
+    }
+    return bind;
+}
+
+ui_bind_t* ui_bind_bool(ui_bind_group_t *group, lv_obj_t *label, const char *on_text, const char *off_text)
+{
+    if (on_text == NULL || off_text == NULL) {
+        return NULL;
+    }
+    ui_bind_t *bind = ui_bind_add(group, UI_BIND_BOOL, label);
+    if (bind) {
+        bind->on_text = on_text;
+        bind->off_text = off_text;
+    }
+    return bind;
+}
+
+ui_bind_t* ui_bind_string(ui_bind_group_t *group, lv_obj_t *label, const char *format)
+{
+    ui_bind_t *bind = ui_bind_add(group, UI_BIND_STRING, label);
+    if (bind) {
+        bind->format = format;
+    }
+    return bind;
+}
+
+bool ui_bind_set_float2(ui_bind_t *bind, float v0, float v1)
+{
+    if (bind == NULL || bind->type != UI_BIND_FLOAT) {
+        return false;
+    }
+    ui_cmd_value_t value = { .values = {v0, v1} };
+    return ui_bind_post(bind, ui_bind_apply_float, &value);
+}
+
+bool ui_bind_set_float(ui_bind_t *bind, float value)
+{
+    return ui_bind_set_float2(bind, value, 0.0f);
+}
+
+bool ui_bind_set_invalid(ui_bind_t *bind)
+{
+    if (bind == NULL || bind->type != UI_BIND_FLOAT) {
+        return false;
+    }
+    ui_cmd_value_t value = {0};
+    return ui_bind_post(bind, ui_bind_apply_invalid, &value);
+}
+
+bool ui_bind_set_bool(ui_bind_t *bind, bool value)
+{
+    if (bind == NULL || bind->type != UI_BIND_BOOL) {
+        return false;
+    }
+    ui_cmd_value_t cmd_value = { .flag = value };
+    return ui_bind_post(bind, ui_bind_apply_bool, &cmd_value);
+}
+
+bool ui_bind_set_string(ui_bind_t *bind, const char *value)
+{
+    if (bind == NULL || bind->type != UI_BIND_STRING || value == NULL) {
+        return false;
+    }
+    ui_cmd_value_t cmd_value = {0};
+    strncpy(cmd_value.text, value, UI_BIND_TEXT_SIZE - 1);
+    return ui_bind_post(bind, ui_bind_apply_string, &cmd_value);
+}
+
+void ui_bind_get_stats(ui_bind_group_t *group, ui_bind_stats_t *stats)
+{
+    if (group == NULL || stats == NULL) {
+        return;
+    }
+    ui_cmd_stats_t queue_stats;
+    ui_cmd_get_stats(group->queue, &queue_stats);
+    stats->sets = (uint32_t)atomic_load_explicit(&group->sets, memory_order_relaxed);
+    stats->dropped = (uint32_t)atomic_load_explicit(&group->dropped, memory_order_relaxed);
+    stats->reposted = group->reposted;
+    stats->coalesced = queue_stats.coalesced;
+    stats->unchanged = group->unchanged;
+    stats->same_text = group->same_text;
+    stats->redraws = group->redraws;
+    stats->drain_us_max = queue_stats.drain_us_max;
+}
@@ -0,0 +1,133 @@
+
+#ifndef _UI_CMD_H
+#define _UI_CMD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "lvgl.h"
+
+
+#define UI_CMD_QUEUE_SIZE       32      // Slots, must be a power of two
+#define UI_CMD_BATCH_MAX        16      // Commands applied per drain
+#define UI_CMD_TEXT_SIZE        64
+#define UI_CMD_MAX_VALUES       2
+#define UI_CMD_DRAIN_PERIOD_MS  LV_DISP_DEF_REFR_PERIOD  // Once per frame
+
+
+typedef enum {
+    UI_CMD_SET_LABEL_TEXT = 0,
+    UI_CMD_APPLY,
+} ui_cmd_type_t;
+
+// Payload of UI_CMD_APPLY, copied into the queue by the producer
+typedef union {
+    float values[UI_CMD_MAX_VALUES];
+    bool flag;
+    char text[UI_CMD_TEXT_SIZE];
+} ui_cmd_value_t;
+
+// Applies UI_CMD_APPLY in the LVGL task
+typedef void (*ui_cmd_apply_cb_t)(void *target, const ui_cmd_value_t *value);
+
+// Runs in the LVGL task before each batch is taken, e.g. to post again what found the queue full
+typedef void (*ui_cmd_drain_cb_t)(void *arg);
+
+typedef struct {
+    ui_cmd_type_t type;
+    union {
+        struct {
+            lv_obj_t *label;
+            char text[UI_CMD_TEXT_SIZE];
+        } label_text;
+        struct {
+            ui_cmd_apply_cb_t fn;
+            void *target;       // A later command for the same target supersedes this one
+            ui_cmd_value_t value;
+        } apply;
+    };
+} ui_cmd_t;
+
+typedef struct {
+    uint32_t posted;
+    uint32_t dropped;           // Queue full
+    uint32_t applied;
+    uint32_t coalesced;         // Superseded by a later command in the same batch
+    uint32_t batches;
+    uint32_t drain_us_max;      // Longest drain, i.e. LVGL lock time spent on commands
+    uint32_t drain_us_total;
+} ui_cmd_stats_t;
+
+// Queue slot: the sequence number tells producers and the consumer whose turn it is
+typedef struct {
+    atomic_uint_fast32_t seq;
+    ui_cmd_t cmd;
+} ui_cmd_slot_t;
+
+// Bounded multi-producer, single-consumer queue drained by an LVGL timer
+typedef struct {
+    ui_cmd_slot_t slots[UI_CMD_QUEUE_SIZE];
+    atomic_uint_fast32_t enqueue_pos;
+    uint32_t dequeue_pos;               // Consumer only
+    atomic_uint_fast32_t posted;
+    atomic_uint_fast32_t dropped;
+    ui_cmd_t batch[UI_CMD_BATCH_MAX];   // Consumer only: commands of the current drain
+    ui_cmd_stats_t stats;               // Consumer-side counters (word-sized, safe to read anywhere)
+    lv_timer_t *timer;
+    ui_cmd_drain_cb_t drain_cb;         // Optional
+    void *drain_arg;
+} ui_cmd_queue_t;
+
+
+/**
+ * @brief Create the queue and its drain timer (call from the LVGL task or with the LVGL lock held)
+ * @return ui_cmd_queue_t* Returns a pointer to the instance on success, NULL on failure
+ */
+ui_cmd_queue_t* ui_cmd_create(void);
+
+/**
+ * @brief Delete the drain timer and release the queue; pending commands are discarded (LVGL lock held)
+ * @param queue Instance pointer
+ */
+void ui_cmd_delete(ui_cmd_queue_t *queue);
+
+/**
+ * @brief Post a command without blocking (any task, never takes the LVGL lock)
+ * @param queue Instance pointer
+ * @param cmd Command to copy into the queue
+ * @return bool Returns false when the queue is full (the command is counted as dropped)
+ */
+bool ui_cmd_post(ui_cmd_queue_t *queue, const ui_cmd_t *cmd);
+
+/**
+ * @brief Post UI_CMD_SET_LABEL_TEXT (text is truncated to UI_CMD_TEXT_SIZE - 1)
+ */
+bool ui_cmd_post_label_text(ui_cmd_queue_t *queue, lv_obj_t *label, const char *text);
+
+/**
+ * @brief Post UI_CMD_APPLY: fn(target, value) runs in the LVGL task
+ */
+bool ui_cmd_post_apply(ui_cmd_queue_t *queue, ui_cmd_apply_cb_t fn, void *target, const ui_cmd_value_t *value);
+
+/**
+ * @brief Set the callback run before each batch (call with the LVGL lock held)
+ * @param queue Instance pointer
+ * @param cb Callback, NULL to remove it
+ * @param arg Passed to cb
+ */
+void ui_cmd_set_drain_cb(ui_cmd_queue_t *queue, ui_cmd_drain_cb_t cb, void *arg);
+
+/**
+ * @brief Apply every pending command now instead of one batch per frame (LVGL task or lock held)
+ * @param queue Instance pointer
+ */
+void ui_cmd_drain(ui_cmd_queue_t *queue);
+
+/**
+ * @brief Copy the counters
+ * @param queue Instance pointer
+ * @param stats Stats output pointer
+ */
+void ui_cmd_get_stats(ui_cmd_queue_t *queue, ui_cmd_stats_t *stats);
+
+#endif // _UI_CMD_H
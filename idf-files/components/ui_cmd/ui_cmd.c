@@ -0,0 +1,257 @@
+#include "ui_cmd.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <sdkconfig.h>
+#include <esp_log.h>
+#if CONFIG_IDF_TARGET_LINUX
+#include <time.h>
+#else
+#include <esp_timer.h>
+#endif
+
+#define TAG "UICmd"
+
+#define UI_CMD_MASK     (UI_CMD_QUEUE_SIZE - 1)
+
+_Static_assert((UI_CMD_QUEUE_SIZE & UI_CMD_MASK) == 0, "UI_CMD_QUEUE_SIZE must be a power of two");
+
+// ---------------------- Internal implementation functions ----------------------
+
+static int64_t ui_cmd_now_us(void)
+{
+#if CONFIG_IDF_TARGET_LINUX
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#else
+    return esp_timer_get_time();
+#endif
+}
+
+/**
+ * @brief Take the oldest command (consumer only)
+ * @return bool Returns false when the queue is empty
+ */
+static bool ui_cmd_pop(ui_cmd_queue_t *queue, ui_cmd_t *cmd)
+{
+    uint32_t pos = queue->dequeue_pos;
+    ui_cmd_slot_t *slot = &queue->slots[pos & UI_CMD_MASK];
+    uint_fast32_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+
+    if ((int32_t)(seq - (pos + 1)) < 0) {
+        return false;   // The producer of this slot has not finished yet
+    }
+    *cmd = slot->cmd;
+    // Hand the slot back to producers for the next lap
+    atomic_store_explicit(&slot->seq, pos + UI_CMD_QUEUE_SIZE, memory_order_release);
+    queue->dequeue_pos = pos + 1;
+    return true;
+}
+
+/**
+ * @brief Check whether a later command in the batch overrides this one
+ */
+static bool ui_cmd_superseded(const ui_cmd_t *batch, size_t index, size_t count)
+{
+    const ui_cmd_t *cmd = &batch[index];
+    for (size_t i = index + 1; i < count; i++) {
+        if (batch[i].type != cmd->type) {
+            continue;
+        }
+        if (cmd->type == UI_CMD_APPLY ? batch[i].apply.target == cmd->apply.target
+                                      : batch[i].label_text.label == cmd->label_text.label) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void ui_cmd_apply(const ui_cmd_t *cmd)
+{
+    switch (cmd->type) {
+        case UI_CMD_SET_LABEL_TEXT:
+            // Skip identical text to avoid invalidating the label
+            if (strcmp(lv_label_get_text(cmd->label_text.label), cmd->label_text.text) != 0) {
+                lv_label_set_text(cmd->label_text.label, cmd->label_text.text);
+            }
+            break;
+        case UI_CMD_APPLY:
+            cmd->apply.fn(cmd->apply.target, &cmd->apply.value);
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Apply up to UI_CMD_BATCH_MAX commands (LVGL task, lock already held)
+ * @return size_t Returns the number of commands taken from the queue
+ */
+static size_t ui_cmd_drain_batch(ui_cmd_queue_t *queue)
+{
+    size_t count = 0;
+
+    if (queue->drain_cb) {
+        queue->drain_cb(queue->drain_arg);
+    }
+    while (count < UI_CMD_BATCH_MAX && ui_cmd_pop(queue, &queue->batch[count])) {
+        count++;
+    }
+    if (count == 0) {
+        return 0;
+    }
+
+    int64_t start = ui_cmd_now_us();
+    for (size_t i = 0; i < count; i++) {
+        if (ui_cmd_superseded(queue->batch, i, count)) {
+            queue->stats.coalesced++;
+            continue;
+        }
+        ui_cmd_apply(&queue->batch[i]);
+        queue->stats.applied++;
+    }
+    uint32_t elapsed = (uint32_t)(ui_cmd_now_us() - start);
+
+    queue->stats.batches++;
+    queue->stats.drain_us_total += elapsed;
+    if (elapsed > queue->stats.drain_us_max) {
+        queue->stats.drain_us_max = elapsed;
+    }
+    return count;
+}
+
+/**
+ * @brief Drain one batch per frame (runs in the LVGL task, lock already held)
+ */
+static void ui_cmd_timer_cb(lv_timer_t *timer)
+{
+    ui_cmd_drain_batch((ui_cmd_queue_t*)timer->user_data);
+}
+
+// ---------------------- External API functions ----------------------
+
+ui_cmd_queue_t* ui_cmd_create(void)
+{
+    ui_cmd_queue_t *queue = (ui_cmd_queue_t*)calloc(1, sizeof(ui_cmd_queue_t));
+    if (queue == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate ui_cmd_queue_t");
+        return NULL;
+    }
+    for (uint32_t i = 0; i < UI_CMD_QUEUE_SIZE; i++) {
+        atomic_init(&queue->slots[i].seq, i);
+    }
+    atomic_init(&queue->enqueue_pos, 0);
+    atomic_init(&queue->posted, 0);
+    atomic_init(&queue->dropped, 0);
+
+    queue->timer = lv_timer_create(ui_cmd_timer_cb, UI_CMD_DRAIN_PERIOD_MS, queue);
+    if (queue->timer == NULL) {
+        ESP_LOGE(TAG, "Failed to create drain timer");
+        free(queue);
+        return NULL;
+    }
+    return queue;
+}
+
+void ui_cmd_delete(ui_cmd_queue_t *queue)
+{
+    if (queue == NULL) {
+        return;
+    }
+    lv_timer_del(queue->timer);
+    free(queue);
+}
+
+bool ui_cmd_post(ui_cmd_queue_t *queue, const ui_cmd_t *cmd)
+{
+    if (queue == NULL || cmd == NULL) {
+        return false;
+    }
+
+    uint_fast32_t pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+    ui_cmd_slot_t *slot;
+    while (1) {
+        slot = &queue->slots[pos & UI_CMD_MASK];
+        uint_fast32_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        int32_t diff = (int32_t)(seq - pos);
+        if (diff == 0) {
+            // Slot free for this lap: claim the position
+            if (atomic_compare_exchange_weak_explicit(&queue->enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // The consumer has not released this slot yet: full
+            atomic_fetch_add_explicit(&queue->dropped, 1, memory_order_relaxed);
+            return false;
+        } else {
+            pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+        }
+    }
+
+    slot->cmd = *cmd;
+    atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+    atomic_fetch_add_explicit(&queue->posted, 1, memory_order_relaxed);
+    return true;
+}
+
+bool ui_cmd_post_label_text(ui_cmd_queue_t *queue, lv_obj_t *label, const char *text)
+{
+    if (label == NULL || text == NULL) {
+        return false;
+    }
+    ui_cmd_t cmd = {
+        .type = UI_CMD_SET_LABEL_TEXT,
+        .label_text.label = label,
+    };
+    strncpy(cmd.label_text.text, text, sizeof(cmd.label_text.text) - 1);
+    return ui_cmd_post(queue, &cmd);
+}
+
+bool ui_cmd_post_apply(ui_cmd_queue_t *queue, ui_cmd_apply_cb_t fn, void *target, const ui_cmd_value_t *value)
+{
+    if (fn == NULL || value == NULL) {
+        return false;
+    }
+    ui_cmd_t cmd = {
+        .type = UI_CMD_APPLY,
+        .apply.fn = fn,
+        .apply.target = target,
+        .apply.value = *value,
+    };
+    return ui_cmd_post(queue, &cmd);
+}
+
+void ui_cmd_set_drain_cb(ui_cmd_queue_t *queue, ui_cmd_drain_cb_t cb, void *arg)
+{
+    if (queue == NULL) {
+        return;
+    }
+    queue->drain_cb = cb;
+    queue->drain_arg = arg;
+}
+
+void ui_cmd_drain(ui_cmd_queue_t *queue)
+{
+    if (queue == NULL) {
+        return;
+    }
+    // Bounded to one queue's worth, plus a batch for what the drain callback posts: commands
+    // posted meanwhile wait for the next drain
+    for (size_t i = 0; i < UI_CMD_QUEUE_SIZE / UI_CMD_BATCH_MAX + 1; i++) {
+        if (ui_cmd_drain_batch(queue) == 0) {
+            break;
+        }
+    }
+}
+
+void ui_cmd_get_stats(ui_cmd_queue_t *queue, ui_cmd_stats_t *stats)
+{
+    if (queue == NULL || stats == NULL) {
+        return;
+    }
+    *stats = queue->stats;
+    stats->posted = (uint32_t)atomic_load_explicit(&queue->posted, memory_order_relaxed);
+    stats->dropped = (uint32_t)atomic_load_explicit(&queue->dropped, memory_order_relaxed);
+}
@@ -0,0 +1,58 @@
+
+#ifndef _UI_LAYOUT_H
+#define _UI_LAYOUT_H
+
+#include <stdint.h>
+#include <esp_err.h>
+#include "lvgl.h"
+
+
+#define UI_LAYOUT_MAX_OBJS  64      // Objects per layout
+#define UI_LAYOUT_ROOT      (-1)    // Parent or alignment target: the object the layout is built on
+
+// Declare a layout defined in a generated file, like LV_IMG_DECLARE()
+#define UI_LAYOUT_DECLARE(name)  extern const ui_layout_t name
+
+
+typedef enum {
+    UI_LAYOUT_OBJ = 0,
+    UI_LAYOUT_LABEL,
+    UI_LAYOUT_BTN,
+    UI_LAYOUT_IMG,              // Created without a source: set it with lv_img_set_src() after the build
+    UI_LAYOUT_CHART,            // Type, points and series are set after the build
+} ui_layout_type_t;
+
+// One object, generated by idf-files/tools/ui_layout.py; parents and alignment targets come earlier in the table
+typedef struct {
+    uint8_t type;               // ui_layout_type_t
+    int8_t parent;              // Object index, or UI_LAYOUT_ROOT
+    int8_t align_to;            // Object index, or UI_LAYOUT_ROOT to align in the parent
+    uint8_t align;              // lv_align_t; LV_ALIGN_DEFAULT leaves the position alone
+    lv_coord_t x;               // Alignment offset
+    lv_coord_t y;
+    lv_coord_t w;               // w and h 0 keep the theme's size
+    lv_coord_t h;
+    const lv_style_t *style;    // Const style of the main part (LV_STYLE_CONST_INIT), NULL for none
+    const char *text;           // Label text, shown without a copy; NULL for none
+} ui_layout_obj_t;
+
+typedef struct {
+    const char *name;
+    const lv_style_t *root_style;   // Added to the object the layout is built on, NULL for none
+    const ui_layout_obj_t *objs;
+    uint16_t count;
+} ui_layout_t;
+
+
+/**
+ * @brief Create the objects of a layout (call with the LVGL lock held)
+ * Styles and texts stay in the read-only tables: nothing is copied to the heap except the objects themselves.
+ * @param layout Generated layout
+ * @param root Object to build on, usually lv_scr_act()
+ * @param objs Receives the layout->count created objects, indexed by the generated <NAME>_<ID> macros; NULL if not needed
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG for a malformed table, ESP_ERR_NO_MEM if an object could not be created
+ * (or its widget is disabled in the LVGL configuration)
+ */
+esp_err_t ui_layout_build(const ui_layout_t *layout, lv_obj_t *root, lv_obj_t **objs);
+
+#endif // _UI_LAYOUT_H
@@ -0,0 +1,82 @@
+#include "ui_layout.h"
+
+#include <esp_log.h>
+
+#define TAG "UiLayout"
+
+// ---------------------- Internal implementation functions ----------------------
+
+static lv_obj_t* ui_layout_create_obj(const ui_layout_obj_t *desc, lv_obj_t *parent)
+{
+    switch (desc->type) {
+    case UI_LAYOUT_LABEL:
+        return lv_label_create(parent);
+    case UI_LAYOUT_BTN:
+        return lv_btn_create(parent);
+    case UI_LAYOUT_IMG:
+#if LV_USE_IMG
+        return lv_img_create(parent);
+#else
+        return NULL;
+#endif
+    case UI_LAYOUT_CHART:
+#if LV_USE_CHART
+        return lv_chart_create(parent);
+#else
+        return NULL;
+#endif
+    default:
+        return lv_obj_create(parent);
+    }
+}
+
+// ---------------------- External API functions ----------------------
+
+esp_err_t ui_layout_build(const ui_layout_t *layout, lv_obj_t *root, lv_obj_t **objs)
+{
+    if (layout == NULL || root == NULL || layout->count > UI_LAYOUT_MAX_OBJS) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    lv_obj_t *local[UI_LAYOUT_MAX_OBJS];
+    if (objs == NULL) {
+        objs = local;
+    }
+
+    if (layout->root_style) {
+        lv_obj_add_style(root, (lv_style_t*)layout->root_style, LV_PART_MAIN);
+    }
+
+    for (uint16_t i = 0; i < layout->count; i++) {
+        const ui_layout_obj_t *desc = &layout->objs[i];
+        if (desc->parent >= (int)i || desc->align_to >= (int)i) {
+            ESP_LOGE(TAG, "%s: object %u refers to a later object", layout->name, i);
+            return ESP_ERR_INVALID_ARG;
+        }
+        lv_obj_t *parent = desc->parent == UI_LAYOUT_ROOT ? root : objs[desc->parent];
+        lv_obj_t *obj = ui_layout_create_obj(desc, parent);
+        if (obj == NULL) {
+            ESP_LOGE(TAG, "%s: out of memory at object %u", layout->name, i);
+            return ESP_ERR_NO_MEM;
+        }
+        objs[i] = obj;
+
+        // Same order as a hand-written screen: style, size, text, then position
+        if (desc->style) {
+            lv_obj_add_style(obj, (lv_style_t*)desc->style, LV_PART_MAIN);     // Const styles are never written
+        }
+        if (desc->w != 0 && desc->h != 0) {
+            lv_obj_set_size(obj, desc->w, desc->h);
+        }
+        if (desc->text && desc->type == UI_LAYOUT_LABEL) {
+            lv_label_set_text_static(obj, desc->text);
+        }
+        if (desc->align != LV_ALIGN_DEFAULT) {
+            if (desc->align_to == UI_LAYOUT_ROOT) {
+                lv_obj_align(obj, desc->align, desc->x, desc->y);
+            } else {
+                lv_obj_align_to(obj, objs[desc->align_to], desc->align, desc->x, desc->y);
+            }
+        }
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+"""Convert an image into a compressed RGB565 asset for the img_pack component.
+
+The output is a C file defining a `const img_pack_asset_t <name>`. At run time,
+img_pack_load() decodes it into a PSRAM buffer, or img_pack_cache_get() decodes
+it on demand. The stream is QOI-style, working on RGB565 components:
+
+    00iiiiii            INDEX  pixel = index[i]
+    01rrggbb            DIFF   dr, dg, db in -2..1 (bias 2)
+    10gggggg rrrrbbbb   LUMA   dg in -32..31, dr - dg/2 and db - dg/2 in -8..7
+    11llllll            RUN    previous pixel repeated l + 1 times (1..62)
+    11111110 lo hi      RGB    literal RGB565, little endian
+
+The header is "IPK1", then width and height (u16 little endian), a flags byte
+and 3 reserved bytes. The index is a 64-entry table hashed by (3r + 5g + 7b).
+
+Usage:
+    python img_pack.py background.png -o main/ui/image_both_pack.c --name image_both_pack
+    python img_pack.py background.png --stats      # sizes only, nothing written
+
+Pillow is required to read images (pip install pillow).
+"""
+
+import argparse
+import os
+import sys
+
+MAGIC = b"IPK1"
+HEADER_SIZE = 12
+OP_INDEX = 0x00
+OP_DIFF = 0x40
+OP_LUMA = 0x80
+OP_RUN = 0xC0
+OP_RGB = 0xFE
+MAX_RUN = 62
+
+
+def rgb888_to_565(r, g, b):
+    return ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)
+
+
+def pixel_hash(px):
+    return ((px >> 11) * 3 + ((px >> 5) & 63) * 5 + (px & 31) * 7) & 63
+
+
+def wrap(value, bits):
+    """Signed difference modulo 2^bits"""
+    half = 1 << (bits - 1)
+    return ((value + half) & ((1 << bits) - 1)) - half
+
+
+def encode(pixels, width, height):
+    """Encode RGB565 pixels (row-major ints) into an IPK1 stream"""
+    if len(pixels) != width * height:
+        raise ValueError("pixel count does not match the size")
+
+    out = bytearray(MAGIC)
+    out += width.to_bytes(2, "little") + height.to_bytes(2, "little")
+    out += bytes(4)
+
+    index = [0] * 64
+    prev = 0
+    run = 0
+    last = len(pixels) - 1
+    for i, px in enumerate(pixels):
+        if px == prev:
+            run += 1
+            if run == MAX_RUN or i == last:
+                out.append(OP_RUN | (run - 1))
+                run = 0
+            continue
+        if run:
+            out.append(OP_RUN | (run - 1))
+            run = 0
+
+        h = pixel_hash(px)
+        if index[h] == px:
+            out.append(OP_INDEX | h)
+        else:
+            index[h] = px
+            dr = wrap((px >> 11) - (prev >> 11), 5)
+            dg = wrap(((px >> 5) & 63) - ((prev >> 5) & 63), 6)
+            db = wrap((px & 31) - (prev & 31), 5)
+            dg_half = (dg + 32) // 2 - 16
+            if -2 <= dr <= 1 and -2 <= dg <= 1 and -2 <= db <= 1:
+                out.append(OP_DIFF | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2))
+            elif -32 <= dg <= 31 and -8 <= dr - dg_half <= 7 and -8 <= db - dg_half <= 7:
+                out.append(OP_LUMA | (dg + 32))
+                out.append(((dr - dg_half + 8) << 4) | (db - dg_half + 8))
+            else:
+                out.append(OP_RGB)
+                out += px.to_bytes(2, "little")
+        prev = px
+    return bytes(out)
+
+
+def load_image(path, background):
+    try:
+        from PIL import Image
+    except ImportError:
+        sys.exit("Pillow is required: pip install pillow")
+
+    img = Image.open(path).convert("RGBA")
+    # Full-screen assets are opaque: flatten any transparency onto the background color
+    flat = Image.new("RGBA", img.size, background + (255,))
+    flat.alpha_composite(img)
+    pixels = [rgb888_to_565(r, g, b) for r, g, b, _ in flat.getdata()]
+    return pixels, img.size[0], img.size[1]
+
+
+def write_c(path, name, data, width, height, source):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    with open(path, "w", newline="\n") as f:
+        f.write("// Generated by idf-files/tools/img_pack.py from %s, do not edit\n" % os.path.basename(source))
+        f.write("// %ux%u RGB565, %u bytes (raw RGB565: %u bytes)\n" % (width, height, len(data), width * height * 2))
+        f.write('#include "img_pack.h"\n\n')
+        f.write("static const uint8_t %s_data[] = {\n%s\n};\n\n" % (name, "\n".join(lines)))
+        f.write("const img_pack_asset_t %s = {\n" % name)
+        f.write('    .name = "%s",\n' % name)
+        f.write("    .data = %s_data,\n" % name)
+        f.write("    .size = sizeof(%s_data),\n" % name)
+        f.write("};\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert an image into an img_pack RGB565 asset")
+    parser.add_argument("image", help="PNG/JPG/BMP input")
+    parser.add_argument("-o", "--output", help="C file to write")
+    parser.add_argument("--name", help="asset symbol, default: <input name>_pack")
+    parser.add_argument("--background", default="000000", help="RGB hex color under transparent pixels")
+    parser.add_argument("--stats", action="store_true", help="only print the flash sizes")
+    args = parser.parse_args()
+
+    background = tuple(int(args.background[i:i + 2], 16) for i in (0, 2, 4))
+    pixels, width, height = load_image(args.image, background)
+    data = encode(pixels, width, height)
+
+    raw_alpha = width * height * 3   # LVGL converter, CF_TRUE_COLOR_ALPHA at 16 bit
+    raw = width * height * 2         # CF_TRUE_COLOR at 16 bit
+    print("%s: %ux%u" % (args.image, width, height))
+    print("  raw RGB565+A8 (CF_TRUE_COLOR_ALPHA): %9u bytes" % raw_alpha)
+    print("  raw RGB565    (CF_TRUE_COLOR):       %9u bytes" % raw)
+    print("  img_pack:                            %9u bytes (%.1f%% of raw RGB565)" % (len(data), 100.0 * len(data) / raw))
+
+    if args.stats:
+        return
+    if not args.output:
+        parser.error("--output is required unless --stats is given")
+    name = args.name or os.path.splitext(os.path.basename(args.image))[0] + "_pack"
+    write_c(args.output, name, data, width, height, args.image)
+    print("  wrote %s (%s)" % (args.output, name))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,286 @@
+#!/usr/bin/env python3
+"""Compile a JSON screen layout into const tables for the ui_layout component.
+
+The output is a C file and a header next to it. The C file holds one
+LV_STYLE_CONST_INIT style per entry of "styles" and a `const ui_layout_t
+<name>` table of objects; ui_layout_build() creates the objects from it.
+The header declares the layout and one <NAME>_<ID> index per object id.
+
+    {
+      "name": "hello_layout",
+      "styles": {
+        "screen": {"bg_color": "#FFFFFF", "bg_opa": "cover"},
+        "frame":  {"border_width": 4, "radius": 10, "pad_all": 20}
+      },
+      "root_style": "screen",
+      "objects": [
+        {"id": "frame", "type": "obj", "style": "frame",
+         "size": ["content", "content"], "align": "center",
+         "children": [
+           {"id": "title", "type": "label", "text": "Hello", "align": "top_mid"},
+           {"type": "label", "text": "World", "align": "out_bottom_mid",
+            "align_to": "title", "pos": [0, 10]}
+         ]}
+      ]
+    }
+
+Object keys: type (obj, label, btn, img, chart), id, style, size ([w, h]: pixels,
+"content" or "N%"), align (an LV_ALIGN_* name in lower case), align_to (id
+of an earlier object, default: the parent), pos (alignment offset), text
+and children. An img gets its source, and a chart its type, points and
+series, from the code after ui_layout_build(). Style values: "#RRGGBB"
+colors, "cover"/"transp" or 0..255 opacities, "montserrat_N" fonts and
+integers. pad_all, pad_hor and pad_ver expand to the single sides.
+
+Usage:
+    python ui_layout.py hello_layout.json -o main/ui/hello_layout.c
+    python ui_layout.py hello_layout.json -o main/ui/hello_layout.c --check
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+MAX_OBJS = 64   # UI_LAYOUT_MAX_OBJS
+
+TYPES = {"obj": "UI_LAYOUT_OBJ", "label": "UI_LAYOUT_LABEL", "btn": "UI_LAYOUT_BTN",
+         "img": "UI_LAYOUT_IMG", "chart": "UI_LAYOUT_CHART"}
+
+ALIGNS = [
+    "default", "top_left", "top_mid", "top_right", "bottom_left", "bottom_mid", "bottom_right",
+    "left_mid", "right_mid", "center",
+    "out_top_left", "out_top_mid", "out_top_right", "out_bottom_left", "out_bottom_mid", "out_bottom_right",
+    "out_left_top", "out_left_mid", "out_left_bottom", "out_right_top", "out_right_mid", "out_right_bottom",
+]
+
+# Style property -> value kind
+PROPS = {
+    "bg_color": "color", "bg_grad_color": "color", "border_color": "color", "outline_color": "color",
+    "shadow_color": "color", "text_color": "color", "line_color": "color",
+    "bg_opa": "opa", "border_opa": "opa", "outline_opa": "opa", "shadow_opa": "opa", "text_opa": "opa",
+    "line_opa": "opa", "opa": "opa",
+    "text_font": "font",
+    "text_align": "text_align",
+    "width": "coord", "height": "coord", "min_width": "coord", "max_width": "coord",
+    "border_width": "int", "outline_width": "int", "outline_pad": "int", "radius": "int",
+    "shadow_width": "int", "shadow_ofs_x": "int", "shadow_ofs_y": "int", "shadow_spread": "int",
+    "pad_top": "int", "pad_bottom": "int", "pad_left": "int", "pad_right": "int",
+    "pad_row": "int", "pad_column": "int", "line_width": "int",
+    "text_letter_space": "int", "text_line_space": "int",
+}
+
+SHORTHANDS = {
+    "pad_all": ("pad_top", "pad_bottom", "pad_left", "pad_right"),
+    "pad_hor": ("pad_left", "pad_right"),
+    "pad_ver": ("pad_top", "pad_bottom"),
+}
+
+
+class LayoutError(Exception):
+    pass
+
+
+def c_ident(text):
+    if not re.match(r"^[A-Za-z_][A-Za-z0-9_]*$", text):
+        raise LayoutError("'%s' is not a valid C identifier" % text)
+    return text
+
+
+def c_string(text):
+    return '"%s"' % text.replace("\\", "\\\\").replace('"', '\\"').replace("\n", "\\n")
+
+
+def coord(value, what):
+    if isinstance(value, int):
+        return str(value)
+    if value == "content":
+        return "LV_SIZE_CONTENT"
+    m = re.match(r"^(-?\d+)%$", str(value))
+    if m:
+        return "LV_PCT(%s)" % m.group(1)
+    raise LayoutError("%s: bad size '%s'" % (what, value))
+
+
+def style_value(prop, value):
+    kind = PROPS[prop]
+    if kind == "color":
+        m = re.match(r"^#([0-9A-Fa-f]{6})$", str(value))
+        if not m:
+            raise LayoutError("%s: colors are written #RRGGBB" % prop)
+        rgb = m.group(1)
+        return "LV_COLOR_MAKE(0x%s, 0x%s, 0x%s)" % (rgb[0:2], rgb[2:4], rgb[4:6])
+    if kind == "opa":
+        if value in ("cover", "transp"):
+            return "LV_OPA_%s" % value.upper()
+        if isinstance(value, int) and 0 <= value <= 255:
+            return str(value)
+        raise LayoutError("%s: opacity is 0..255, 'cover' or 'transp'" % prop)
+    if kind == "font":
+        return "&lv_font_%s" % c_ident(value)
+    if kind == "text_align":
+        if value not in ("auto", "left", "center", "right"):
+            raise LayoutError("%s: auto, left, center or right" % prop)
+        return "LV_TEXT_ALIGN_%s" % value.upper()
+    if kind == "coord":
+        return coord(value, prop)
+    if not isinstance(value, int):
+        raise LayoutError("%s: integer expected" % prop)
+    return str(value)
+
+
+def style_props(name, props):
+    out = []
+    for prop, value in props.items():
+        for single in SHORTHANDS.get(prop, (prop,)):
+            if single not in PROPS:
+                raise LayoutError("style %s: unknown property '%s'" % (name, prop))
+            out.append("LV_STYLE_CONST_%s(%s)" % (single.upper(), style_value(single, value)))
+    return out
+
+
+def index_ref(index):
+    return "UI_LAYOUT_ROOT" if index < 0 else str(index)
+
+
+def flatten(objects, parent, out, ids):
+    """Depth first, so every parent comes before its children"""
+    for obj in objects:
+        index = len(out)
+        if index >= MAX_OBJS:
+            raise LayoutError("more than %d objects" % MAX_OBJS)
+        obj_id = obj.get("id")
+        if obj_id is not None:
+            if obj_id in ids:
+                raise LayoutError("duplicate id '%s'" % obj_id)
+            ids[c_ident(obj_id)] = index
+        out.append((obj, parent))
+        flatten(obj.get("children", []), index, out, ids)
+
+
+def compile_layout(layout, name):
+    styles = {c_ident(style): style_props(style, props) for style, props in layout.get("styles", {}).items()}
+
+    def style_ref(style):
+        if style is None:
+            return "NULL"
+        if style not in styles:
+            raise LayoutError("unknown style '%s'" % style)
+        return "&%s_%s" % (name, style)
+
+    flat = []
+    ids = {}
+    flatten(layout.get("objects", []), -1, flat, ids)
+
+    rows = []
+    for index, (obj, parent) in enumerate(flat):
+        what = obj.get("id", "object %d" % index)
+        unknown = set(obj) - {"id", "type", "style", "size", "align", "align_to", "pos", "text", "children"}
+        if unknown:
+            raise LayoutError("%s: unknown keys %s" % (what, ", ".join(sorted(unknown))))
+        obj_type = obj.get("type", "obj")
+        if obj_type not in TYPES:
+            raise LayoutError("%s: type is one of %s" % (what, ", ".join(TYPES)))
+        if "text" in obj and obj_type != "label":
+            raise LayoutError("%s: only labels have text" % what)
+        align = obj.get("align", "default")
+        if align not in ALIGNS:
+            raise LayoutError("%s: unknown align '%s'" % (what, align))
+        align_to = -1
+        if "align_to" in obj:
+            if ids.get(obj["align_to"], index) >= index:
+                raise LayoutError("%s: align_to must name an earlier object" % what)
+            align_to = ids[obj["align_to"]]
+        x, y = obj.get("pos", [0, 0])
+        w, h = ("0", "0")
+        if "size" in obj:
+            w, h = (coord(v, what) for v in obj["size"])
+        text = c_string(obj["text"]) if "text" in obj else "NULL"
+        rows.append("    {%s, %s, %s, LV_ALIGN_%s, %d, %d, %s, %s, %s, %s},%s" % (
+            TYPES[obj_type], index_ref(parent), index_ref(align_to), align.upper(), x, y, w, h,
+            style_ref(obj.get("style")), text, "  // %s" % obj["id"] if "id" in obj else ""))
+
+    return styles, style_ref(layout.get("root_style")), rows, ids
+
+
+def render_files(c_path, name, source, styles, root_style, rows, ids):
+    h_path = os.path.splitext(c_path)[0] + ".h"
+    banner = "// Generated by idf-files/tools/ui_layout.py from %s, do not edit\n" % os.path.basename(source)
+    guard = "_%s_H" % name.upper()
+
+    h = [banner]
+    h.append("#ifndef %s\n#define %s\n\n" % (guard, guard))
+    h.append('#include "ui_layout.h"\n\n')
+    for obj_id, index in ids.items():
+        h.append("#define %s_%s %d\n" % (name.upper(), obj_id.upper(), index))
+    h.append("#define %s_COUNT %d\n\n" % (name.upper(), len(rows)))
+    h.append("UI_LAYOUT_DECLARE(%s);\n\n" % name)
+    h.append("#endif // %s\n" % guard)
+
+    c = [banner]
+    c.append('#include "%s"\n\n' % os.path.basename(h_path))
+    for style, props in styles.items():
+        c.append("static const lv_style_const_prop_t %s_%s_props[] = {\n" % (name, style))
+        for prop in props:
+            c.append("    %s,\n" % prop)
+        c.append("    LV_STYLE_PROP_INV,\n};\n")
+        c.append("static LV_STYLE_CONST_INIT(%s_%s, %s_%s_props);\n\n" % (name, style, name, style))
+    c.append("// type, parent, align_to, align, x, y, w, h, style, text\n")
+    c.append("static const ui_layout_obj_t %s_objs[] = {\n%s\n};\n\n" % (name, "\n".join(rows)))
+    c.append("const ui_layout_t %s = {\n" % name)
+    c.append('    .name = "%s",\n' % name)
+    c.append("    .root_style = %s,\n" % root_style)
+    c.append("    .objs = %s_objs,\n" % name)
+    c.append("    .count = sizeof(%s_objs) / sizeof(%s_objs[0]),\n" % (name, name))
+    c.append("};\n")
+    return {c_path: "".join(c), h_path: "".join(h)}
+
+
+def stale_files(files):
+    """Return the files whose content on disk differs from the generated one."""
+    stale = []
+    for path, text in files.items():
+        try:
+            with open(path, encoding="utf-8", newline="") as f:
+                if f.read() == text:
+                    continue
+        except FileNotFoundError:
+            pass
+        stale.append(path)
+    return stale
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compile a JSON screen layout into ui_layout tables")
+    parser.add_argument("layout", help="JSON layout")
+    parser.add_argument("-o", "--output", required=True, help="C file to write; the header goes next to it")
+    parser.add_argument("--name", help="layout symbol, default: \"name\" of the layout or the input name")
+    parser.add_argument("--check", action="store_true",
+                        help="write nothing, fail when the checked-in files differ from the JSON")
+    args = parser.parse_args()
+
+    with open(args.layout, encoding="utf-8") as f:
+        layout = json.load(f)
+    name = args.name or layout.get("name") or os.path.splitext(os.path.basename(args.layout))[0]
+    try:
+        styles, root_style, rows, ids = compile_layout(layout, c_ident(name))
+    except LayoutError as e:
+        sys.exit("%s: %s" % (args.layout, e))
+    files = render_files(args.output, name, args.layout, styles, root_style, rows, ids)
+
+    if args.check:
+        stale = stale_files(files)
+        if stale:
+            sys.exit("%s: %s out of date, run ui_layout.py %s -o %s" % (
+                args.layout, " and ".join(stale), args.layout, args.output))
+        return
+    for path, text in files.items():
+        with open(path, "w", encoding="utf-8", newline="\n") as f:
+            f.write(text)
+    print("%s: %u styles, %u objects" % (args.layout, len(styles), len(rows)))
+    print("  wrote %s (%s)" % (" and ".join(files), name))
+
+
+if __name__ == "__main__":
+    main()